@@ -39,6 +39,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <errno.h>
 #include <unistd.h>
 #include <sys/time.h>
 #include <nuttx/config.h>
@@ -54,6 +55,7 @@ typedef struct
   char *nnb_path;
   char *pgm_path;
   bool skip_norm;
+  int bench_count;
 } my_setting_t;
 
 /****************************************************************************
@@ -103,17 +105,110 @@ static void convert_datatype(dnn_runtime_t * rt)
     }
 }
 
+static int compare_ulong(const void *a, const void *b)
+{
+  unsigned long x = *(const unsigned long *)a;
+  unsigned long y = *(const unsigned long *)b;
+  return (x > y) - (x < y);
+}
+
+static void print_percentiles(unsigned long *samples, int count,
+                              const char *unit)
+{
+  qsort(samples, count, sizeof(unsigned long), compare_ulong);
+  printf("p50=%lu p90=%lu p99=%lu max=%lu %s\n",
+         samples[(count - 1) * 50 / 100], samples[(count - 1) * 90 / 100],
+         samples[(count - 1) * 99 / 100], samples[count - 1], unit);
+}
+
+static int run_benchmark(dnn_runtime_t * rt, const void *inputs[], int count)
+{
+  int ret = 0;
+  int run, layer;
+  int layer_num;
+  unsigned long *e2e;
+  unsigned long *cycles = NULL;
+  dnn_layer_profile_t *profile = NULL;
+  struct timeval begin, end;
+
+  /* per-layer figures are available if CONFIG_DNN_RT_PROFILE=y */
+  layer_num = dnn_runtime_profile(rt, NULL, 0);
+  if (layer_num < 0)
+    {
+      layer_num = 0;
+    }
+
+  e2e = (unsigned long *)malloc(count * sizeof(unsigned long));
+  if (layer_num > 0)
+    {
+      cycles = (unsigned long *)malloc(count * layer_num *
+                                       sizeof(unsigned long));
+      profile = (dnn_layer_profile_t *) malloc(layer_num *
+                                               sizeof(dnn_layer_profile_t));
+    }
+  if (e2e == NULL || (layer_num > 0 && (cycles == NULL || profile == NULL)))
+    {
+      printf("no memory for %d runs\n", count);
+      ret = -ENOMEM;
+      goto bye;
+    }
+
+  for (run = 0; run < count; run++)
+    {
+      gettimeofday(&begin, 0);
+      ret = dnn_runtime_forward(rt, inputs, 1);
+      gettimeofday(&end, 0);
+      if (ret)
+        {
+          printf("dnn_runtime_forward() failed due to %d\n", ret);
+          goto bye;
+        }
+
+      e2e[run] = (end.tv_sec - begin.tv_sec) * 1000000ul +
+        end.tv_usec - begin.tv_usec;
+      if (layer_num > 0)
+        {
+          dnn_runtime_profile(rt, profile, layer_num);
+          for (layer = 0; layer < layer_num; layer++)
+            {
+              cycles[layer * count + run] = profile[layer].cycles;
+            }
+        }
+    }
+
+  printf("benchmark: %d runs\n", count);
+  for (layer = 0; layer < layer_num; layer++)
+    {
+      printf("layer[%d] function=%u scratch=%lu output=%lu: ", layer,
+             profile[layer].function_type,
+             (unsigned long)profile[layer].scratch_bytes,
+             (unsigned long)profile[layer].output_bytes);
+      print_percentiles(&cycles[layer * count], count, "cycles");
+    }
+  printf("forward: ");
+  print_percentiles(e2e, count, "us");
+
+bye:
+  free(profile);
+  free(cycles);
+  free(e2e);
+  return ret;
+}
+
 static void parse_args(int argc, char *argv[], my_setting_t * setting)
 {
   /* parse options by getopt() */
   int opt;
-  while ((opt = getopt(argc, argv, "s")) != -1)
+  while ((opt = getopt(argc, argv, "sn:")) != -1)
     {
       switch (opt)
         {
         case 's':              /* skip normalization */
           setting->skip_norm = true;
           break;
+        case 'n':              /* number of benchmark runs */
+          setting->bench_count = atoi(optarg);
+          break;
         }
     }
 
@@ -218,6 +313,12 @@ int dnnrt_lenet_main(int argc, char *argv[])
   proc_time -= (float)begin.tv_sec + (float)begin.tv_usec / 1.0e6;
   printf("inference time=%.3f\n", proc_time);
 
+  /* Step-E: optionally repeat inference to measure latency distribution */
+  if (setting.bench_count > 0)
+    {
+      ret = run_benchmark(&rt, inputs, setting.bench_count);
+    }
+
 fin:
   /* Step-F: free memories allocated to dnn_runtime_t */
   dnn_runtime_finalize(&rt);
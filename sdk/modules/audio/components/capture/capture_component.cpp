@@ -911,6 +911,7 @@ bool CaptureComponent::init(const CaptureComponentParam& param)
   init_param.fade_en        = false;
   init_param.p_error_func   = m_dma_err_cb;
   init_param.p_dmadone_func = m_dma_done_cb;
+  init_param.min_size       = param.init_param.dma_min_size;
 
   m_callback = param.init_param.callback;
   m_err_callback = param.init_param.err_callback;
@@ -124,6 +124,7 @@ struct InitCaptureComponentParam
   uint8_t          preset_num;
   CaptureDoneCB    callback;
   CaptureErrorCB   err_callback;
+  uint16_t         dma_min_size; /* 0: default of the DMAC */
 };
 
 struct ActCaptureComponentParam
@@ -65,13 +65,48 @@ uint32_t PackingComponent::init_apu(InitPackingParam *param)
   m_in_bitwidth  = param->in_bytelength * 8;
   m_out_bitwidth = param->out_bytelength * 8;
 
+  /* Select converter */
+
+  static const struct
+  {
+    uint16_t in_bitwidth;
+    uint16_t out_bitwidth;
+    ConvFunc func;
+  } conv_table[] =
+  {
+    { BitWidth32bit, BitWidth24bit, cnv32to24 },
+    { BitWidth24bit, BitWidth32bit, cnv24to32 },
+    { BitWidth16bit, BitWidth24bit, cnv16to24 },
+    { BitWidth24bit, BitWidth16bit, cnv24to16 },
+    { BitWidth16bit, BitWidth32bit, cnv16to32 },
+    { BitWidth32bit, BitWidth16bit, cnv32to16 },
+  };
+
+  m_convfunc = NULL;
+
+  for (uint32_t i = 0; i < sizeof(conv_table) / sizeof(conv_table[0]); i++)
+    {
+      if ((conv_table[i].in_bitwidth == m_in_bitwidth)
+       && (conv_table[i].out_bitwidth == m_out_bitwidth))
+        {
+          m_convfunc = conv_table[i].func;
+          break;
+        }
+    }
+
+  if (m_convfunc == NULL)
+    {
+      FILTER_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+      return AS_ECODE_COMMAND_PARAM_BIT_LENGTH;
+    }
+
   return AS_ECODE_OK;
 }
 
 /*--------------------------------------------------------------------*/
 bool PackingComponent::exec_apu(ExecPackingParam *param)
 {
-  void (PackingComponent::*convfunc)(uint32_t, int8_t *, int8_t *);
+  uint32_t samples = 0;
   uint32_t outsize = 0;
   bool result = false;
 
@@ -86,28 +121,21 @@ bool PackingComponent::exec_apu(ExecPackingParam *param)
 
   /* Execute packing */
 
-  if ((m_in_bitwidth == BitWidth32bit) && (m_out_bitwidth == BitWidth24bit))
-    {
-      convfunc = &PackingComponent::cnv32to24;
-      outsize  = param->in_buffer.size * BitWidth24bit / BitWidth32bit;
-    }
-  else if ((m_in_bitwidth == BitWidth24bit) && (m_out_bitwidth == BitWidth32bit))
-    {
-      convfunc = &PackingComponent::cnv24to32;
-      outsize  = param->in_buffer.size * BitWidth32bit / BitWidth24bit;
-    }
-  else
+  if (m_convfunc == NULL)
     {
       return false;
     }
 
+  samples = param->in_buffer.size / (m_in_bitwidth / 8);
+  outsize = samples * (m_out_bitwidth / 8);
+
   /* Excec convert */
 
   if (outsize <= param->out_buffer.size)
     {
-      (this->*convfunc)(param->in_buffer.size / (m_in_bitwidth / 8),
-                        reinterpret_cast<int8_t *>(param->in_buffer.p_buffer),
-                        reinterpret_cast<int8_t *>(param->out_buffer.p_buffer));
+      m_convfunc(samples,
+                 reinterpret_cast<int8_t *>(param->in_buffer.p_buffer),
+                 reinterpret_cast<int8_t *>(param->out_buffer.p_buffer));
 
       param->out_buffer.size = outsize;
 
@@ -131,45 +159,6 @@ bool PackingComponent::flush_apu(StopPackingParam *param)
   return true;
 }
 
-/*--------------------------------------------------------------------*/
-void PackingComponent::cnv32to24(uint32_t samples, int8_t *in, int8_t *out)
-{
-  /** For Little endian data ! **/
-
-  uint32_t *p_in  = (uint32_t *)in;
-  uint32_t *p_out = (uint32_t *)out;
-
-  for (uint32_t cnt = 0; cnt < samples / 4; cnt++)
-    {
-      *(p_out+0) = (uint32_t)(((*(p_in+0) & 0xFFFFFF00) >> 8 ) + ((*(p_in+1) & 0x0000FF00) << 16));
-      *(p_out+1) = (uint32_t)(((*(p_in+1) & 0xFFFF0000) >> 16) + ((*(p_in+2) & 0x00FFFF00) << 8 ));
-      *(p_out+2) = (uint32_t)(((*(p_in+2) & 0xFF000000) >> 24) + ((*(p_in+3) & 0xFFFFFF00) >> 0 ));
-
-      p_out +=3;
-      p_in  +=4;
-    }
-}
-
-/*--------------------------------------------------------------------*/
-void PackingComponent::cnv24to32(uint32_t samples, int8_t *in, int8_t *out)
-{
-  /** For Little endian data ! **/
-
-  uint32_t *p_in  = (uint32_t *)in;
-  uint32_t *p_out = (uint32_t *)out;
-
-  for (uint32_t cnt = 0; cnt < samples / 4; cnt++)
-    {
-      *(p_out+0) = (uint32_t)( (*(p_in+0) & 0x00FFFFFF) << 8 );
-      *(p_out+1) = (uint32_t)(((*(p_in+0) & 0xFF000000) >> 16) + ((*(p_in+1) & 0x0000FFFF) << 16));
-      *(p_out+2) = (uint32_t)(((*(p_in+1) & 0xFFFF0000) >> 8 ) + ((*(p_in+2) & 0x000000FF) << 24));
-      *(p_out+3) = (uint32_t)(  *(p_in+2) & 0xFFFFFF00);
-
-      p_out +=4;
-      p_in  +=3;
-    }
-}
-
 /*--------------------------------------------------------------------*/
 void PackingComponent::send_resp(FilterComponentEvent evt, bool result, BufferHeader outbuf)
 {
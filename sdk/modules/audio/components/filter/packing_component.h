@@ -40,6 +40,7 @@
 #include "wien2_common_defs.h"
 #include "debug/dbg_log.h"
 #include "filter_component.h"
+#include "packing_kernel.h"
 
 __WIEN2_BEGIN_NAMESPACE
 using namespace MemMgrLite;
@@ -47,6 +48,7 @@ using namespace MemMgrLite;
 /*--------------------------------------------------------------------*/
 enum BitWidth
 {
+  BitWidth16bit = 16,
   BitWidth24bit = 24,
   BitWidth32bit = 32,
 };
@@ -87,15 +89,16 @@ class PackingComponent : public FilterComponent
 {
 private:
 
+  typedef void (*ConvFunc)(uint32_t samples, int8_t *in, int8_t *out);
+
   uint16_t m_in_bitwidth;
   uint16_t m_out_bitwidth;
+  ConvFunc m_convfunc;
 
   uint32_t init_apu(InitPackingParam *param);
   bool exec_apu(ExecPackingParam *param);
   bool flush_apu(StopPackingParam *param);
 
-  void cnv32to24(uint32_t samples, int8_t *in, int8_t *out);
-  void cnv24to32(uint32_t samples, int8_t *in, int8_t *out);
   void send_resp(FilterComponentEvent evt, bool result, BufferHeader outbuf);
 
 public:
@@ -103,6 +106,7 @@ public:
   PackingComponent() :
       m_in_bitwidth(32)
     , m_out_bitwidth(24)
+    , m_convfunc(cnv32to24)
     {}
   ~PackingComponent() {}
 
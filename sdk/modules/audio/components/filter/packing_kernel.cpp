@@ -0,0 +1,313 @@
+/****************************************************************************
+ * modules/audio/components/filter/packing_kernel.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "components/filter/packing_kernel.h"
+
+#define IS_WORD_ALIGNED(in, out) \
+          ((((uintptr_t)(in) | (uintptr_t)(out)) & 0x3) == 0)
+
+/*--------------------------------------------------------------------*/
+/* Halfword packing.
+ * Use PKHBT/PKHTB instructions on cores with DSP extension
+ * (e.g. Cortex-M4), otherwise portable shift and mask.
+ */
+/*--------------------------------------------------------------------*/
+#ifdef __ARM_FEATURE_DSP
+static inline uint32_t pkhbt(uint32_t bottom, uint32_t top)
+{
+  uint32_t result;
+  __asm__ ("pkhbt %0, %1, %2" : "=r" (result) : "r" (bottom), "r" (top));
+  return result;
+}
+
+static inline uint32_t pkhbt_lsl8(uint32_t bottom, uint32_t top)
+{
+  uint32_t result;
+  __asm__ ("pkhbt %0, %1, %2, lsl #8"
+           : "=r" (result) : "r" (bottom), "r" (top));
+  return result;
+}
+
+static inline uint32_t pkhbt_lsl16(uint32_t bottom, uint32_t top)
+{
+  uint32_t result;
+  __asm__ ("pkhbt %0, %1, %2, lsl #16"
+           : "=r" (result) : "r" (bottom), "r" (top));
+  return result;
+}
+
+static inline uint32_t pkhtb_asr16(uint32_t top, uint32_t bottom)
+{
+  uint32_t result;
+  __asm__ ("pkhtb %0, %1, %2, asr #16"
+           : "=r" (result) : "r" (top), "r" (bottom));
+  return result;
+}
+#else
+static inline uint32_t pkhbt(uint32_t bottom, uint32_t top)
+{
+  return (bottom & 0x0000FFFF) | (top & 0xFFFF0000);
+}
+
+static inline uint32_t pkhbt_lsl8(uint32_t bottom, uint32_t top)
+{
+  return (bottom & 0x0000FFFF) | ((top << 8) & 0xFFFF0000);
+}
+
+static inline uint32_t pkhbt_lsl16(uint32_t bottom, uint32_t top)
+{
+  return (bottom & 0x0000FFFF) | (top << 16);
+}
+
+static inline uint32_t pkhtb_asr16(uint32_t top, uint32_t bottom)
+{
+  return (top & 0xFFFF0000) | (bottom >> 16);
+}
+#endif /* __ARM_FEATURE_DSP */
+
+__WIEN2_BEGIN_NAMESPACE
+
+/*--------------------------------------------------------------------*/
+/* Packing kernels.
+ * All of them are for little endian data. Word aligned buffers are
+ * converted by 4 samples at once, and the rest (or all samples of
+ * unaligned buffers) are converted by byte.
+ */
+/*--------------------------------------------------------------------*/
+void cnv32to24(uint32_t samples, int8_t *in, int8_t *out)
+{
+  uint32_t blocks = IS_WORD_ALIGNED(in, out) ? samples / 4 : 0;
+  uint32_t *p_in  = (uint32_t *)in;
+  uint32_t *p_out = (uint32_t *)out;
+
+  for (uint32_t cnt = 0; cnt < blocks; cnt++)
+    {
+      uint32_t w0 = *(p_in+0);
+      uint32_t w1 = *(p_in+1);
+      uint32_t w2 = *(p_in+2);
+      uint32_t w3 = *(p_in+3);
+
+      *(p_out+0) = (w0 >> 8) | ((w1 & 0x0000FF00) << 16);
+      *(p_out+1) = pkhbt_lsl8(w1 >> 16, w2);
+      *(p_out+2) = (w2 >> 24) | (w3 & 0xFFFFFF00);
+
+      p_out +=3;
+      p_in  +=4;
+    }
+
+  uint8_t *b_in  = (uint8_t *)p_in;
+  uint8_t *b_out = (uint8_t *)p_out;
+
+  for (uint32_t cnt = blocks * 4; cnt < samples; cnt++)
+    {
+      b_out[0] = b_in[1];
+      b_out[1] = b_in[2];
+      b_out[2] = b_in[3];
+
+      b_out += 3;
+      b_in  += 4;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void cnv24to32(uint32_t samples, int8_t *in, int8_t *out)
+{
+  uint32_t blocks = IS_WORD_ALIGNED(in, out) ? samples / 4 : 0;
+  uint32_t *p_in  = (uint32_t *)in;
+  uint32_t *p_out = (uint32_t *)out;
+
+  for (uint32_t cnt = 0; cnt < blocks; cnt++)
+    {
+      uint32_t w0 = *(p_in+0);
+      uint32_t w1 = *(p_in+1);
+      uint32_t w2 = *(p_in+2);
+
+      *(p_out+0) = w0 << 8;
+      *(p_out+1) = pkhbt_lsl16((w0 >> 16) & 0x0000FF00, w1);
+      *(p_out+2) = ((w1 & 0xFFFF0000) >> 8) | (w2 << 24);
+      *(p_out+3) = w2 & 0xFFFFFF00;
+
+      p_out +=4;
+      p_in  +=3;
+    }
+
+  uint8_t *b_in  = (uint8_t *)p_in;
+  uint8_t *b_out = (uint8_t *)p_out;
+
+  for (uint32_t cnt = blocks * 4; cnt < samples; cnt++)
+    {
+      b_out[0] = 0;
+      b_out[1] = b_in[0];
+      b_out[2] = b_in[1];
+      b_out[3] = b_in[2];
+
+      b_out += 4;
+      b_in  += 3;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void cnv16to24(uint32_t samples, int8_t *in, int8_t *out)
+{
+  uint32_t blocks = IS_WORD_ALIGNED(in, out) ? samples / 4 : 0;
+  uint32_t *p_in  = (uint32_t *)in;
+  uint32_t *p_out = (uint32_t *)out;
+
+  for (uint32_t cnt = 0; cnt < blocks; cnt++)
+    {
+      uint32_t w0 = *(p_in+0);
+      uint32_t w1 = *(p_in+1);
+
+      *(p_out+0) = (w0 << 8) & 0x00FFFF00;
+      *(p_out+1) = (w0 >> 16) | (w1 << 24);
+      *(p_out+2) = pkhbt((w1 >> 8) & 0x000000FF, w1);
+
+      p_out +=3;
+      p_in  +=2;
+    }
+
+  uint8_t *b_in  = (uint8_t *)p_in;
+  uint8_t *b_out = (uint8_t *)p_out;
+
+  for (uint32_t cnt = blocks * 4; cnt < samples; cnt++)
+    {
+      b_out[0] = 0;
+      b_out[1] = b_in[0];
+      b_out[2] = b_in[1];
+
+      b_out += 3;
+      b_in  += 2;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void cnv24to16(uint32_t samples, int8_t *in, int8_t *out)
+{
+  uint32_t blocks = IS_WORD_ALIGNED(in, out) ? samples / 4 : 0;
+  uint32_t *p_in  = (uint32_t *)in;
+  uint32_t *p_out = (uint32_t *)out;
+
+  for (uint32_t cnt = 0; cnt < blocks; cnt++)
+    {
+      uint32_t w0 = *(p_in+0);
+      uint32_t w1 = *(p_in+1);
+      uint32_t w2 = *(p_in+2);
+
+      *(p_out+0) = pkhbt_lsl16(w0 >> 8, w1);
+      *(p_out+1) = pkhbt((w1 >> 24) | (w2 << 8), w2);
+
+      p_out +=2;
+      p_in  +=3;
+    }
+
+  uint8_t *b_in  = (uint8_t *)p_in;
+  uint8_t *b_out = (uint8_t *)p_out;
+
+  for (uint32_t cnt = blocks * 4; cnt < samples; cnt++)
+    {
+      b_out[0] = b_in[1];
+      b_out[1] = b_in[2];
+
+      b_out += 2;
+      b_in  += 3;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void cnv16to32(uint32_t samples, int8_t *in, int8_t *out)
+{
+  uint32_t blocks = IS_WORD_ALIGNED(in, out) ? samples / 4 : 0;
+  uint32_t *p_in  = (uint32_t *)in;
+  uint32_t *p_out = (uint32_t *)out;
+
+  for (uint32_t cnt = 0; cnt < blocks; cnt++)
+    {
+      uint32_t w0 = *(p_in+0);
+      uint32_t w1 = *(p_in+1);
+
+      *(p_out+0) = w0 << 16;
+      *(p_out+1) = w0 & 0xFFFF0000;
+      *(p_out+2) = w1 << 16;
+      *(p_out+3) = w1 & 0xFFFF0000;
+
+      p_out +=4;
+      p_in  +=2;
+    }
+
+  uint8_t *b_in  = (uint8_t *)p_in;
+  uint8_t *b_out = (uint8_t *)p_out;
+
+  for (uint32_t cnt = blocks * 4; cnt < samples; cnt++)
+    {
+      b_out[0] = 0;
+      b_out[1] = 0;
+      b_out[2] = b_in[0];
+      b_out[3] = b_in[1];
+
+      b_out += 4;
+      b_in  += 2;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void cnv32to16(uint32_t samples, int8_t *in, int8_t *out)
+{
+  uint32_t blocks = IS_WORD_ALIGNED(in, out) ? samples / 4 : 0;
+  uint32_t *p_in  = (uint32_t *)in;
+  uint32_t *p_out = (uint32_t *)out;
+
+  for (uint32_t cnt = 0; cnt < blocks; cnt++)
+    {
+      *(p_out+0) = pkhtb_asr16(*(p_in+1), *(p_in+0));
+      *(p_out+1) = pkhtb_asr16(*(p_in+3), *(p_in+2));
+
+      p_out +=2;
+      p_in  +=4;
+    }
+
+  uint8_t *b_in  = (uint8_t *)p_in;
+  uint8_t *b_out = (uint8_t *)p_out;
+
+  for (uint32_t cnt = blocks * 4; cnt < samples; cnt++)
+    {
+      b_out[0] = b_in[2];
+      b_out[1] = b_in[3];
+
+      b_out += 2;
+      b_in  += 4;
+    }
+}
+
+__WIEN2_END_NAMESPACE
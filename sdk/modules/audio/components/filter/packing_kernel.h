@@ -0,0 +1,62 @@
+/****************************************************************************
+ * modules/audio/components/filter/packing_kernel.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#ifndef PACKING_KERNEL_H
+#define PACKING_KERNEL_H
+
+#include <stdint.h>
+
+#include "wien2_common_defs.h"
+
+__WIEN2_BEGIN_NAMESPACE
+
+/*--------------------------------------------------------------------*/
+/* Packing kernels used by PackingComponent.
+ * They convert little endian samples between 16, 24 and 32 bit width.
+ * They have no dependency on the component, so that they can be
+ * measured on the host (see test/bench_packing.cpp).
+ */
+/*--------------------------------------------------------------------*/
+void cnv32to24(uint32_t samples, int8_t *in, int8_t *out);
+void cnv24to32(uint32_t samples, int8_t *in, int8_t *out);
+void cnv16to24(uint32_t samples, int8_t *in, int8_t *out);
+void cnv24to16(uint32_t samples, int8_t *in, int8_t *out);
+void cnv16to32(uint32_t samples, int8_t *in, int8_t *out);
+void cnv32to16(uint32_t samples, int8_t *in, int8_t *out);
+
+__WIEN2_END_NAMESPACE
+
+#endif /* PACKING_KERNEL_H */
@@ -0,0 +1,177 @@
+/****************************************************************************
+ * modules/audio/components/filter/test/bench_packing.cpp
+ *
+ *   Copyright 2026 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "components/filter/packing_kernel.h"
+
+using namespace Wien2;
+
+#define BENCH_SAMPLES  4096
+#define BENCH_REPEAT   2000
+
+typedef void (*ConvFunc)(uint32_t samples, int8_t *in, int8_t *out);
+
+struct bench_kernel_s
+{
+  const char *name;
+  uint32_t in_bytes;
+  uint32_t out_bytes;
+  ConvFunc func;
+};
+
+static const struct bench_kernel_s s_kernels[] =
+{
+  { "32to24", 4, 3, cnv32to24 },
+  { "24to32", 3, 4, cnv24to32 },
+  { "16to24", 2, 3, cnv16to24 },
+  { "24to16", 3, 2, cnv24to16 },
+  { "16to32", 2, 4, cnv16to32 },
+  { "32to16", 4, 2, cnv32to16 },
+};
+
+/* One spare word lets the buffers be shifted by a byte to take the
+ * unaligned path.
+ */
+
+static uint32_t s_in[BENCH_SAMPLES + 1];
+static uint32_t s_out[BENCH_SAMPLES + 1];
+static uint32_t s_ref[BENCH_SAMPLES + 1];
+
+static double now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Byte-wise reference: keep the most significant bytes of each sample
+ * and zero fill the least significant ones, as the kernels do.
+ */
+
+static void reference(const struct bench_kernel_s *k, uint32_t samples,
+                      const uint8_t *in, uint8_t *out)
+{
+  for (uint32_t i = 0; i < samples; i++)
+    {
+      for (uint32_t j = 0; j < k->out_bytes; j++)
+        {
+          int32_t src = (int32_t)(j + k->in_bytes) - (int32_t)k->out_bytes;
+
+          out[j] = (src < 0) ? 0 : in[src];
+        }
+
+      in  += k->in_bytes;
+      out += k->out_bytes;
+    }
+}
+
+static double run(const struct bench_kernel_s *k, uint32_t offset)
+{
+  int8_t *in  = (int8_t *)s_in + offset;
+  int8_t *out = (int8_t *)s_out + offset;
+  double start;
+  int r;
+
+  start = now_ns();
+  for (r = 0; r < BENCH_REPEAT; r++)
+    {
+      k->func(BENCH_SAMPLES, in, out);
+    }
+
+  /* MB/s of input data */
+
+  return (double)BENCH_SAMPLES * k->in_bytes * BENCH_REPEAT * 1e3 /
+         (now_ns() - start);
+}
+
+static int check(const struct bench_kernel_s *k, uint32_t offset,
+                 uint32_t samples)
+{
+  uint8_t *in  = (uint8_t *)s_in + offset;
+  uint8_t *out = (uint8_t *)s_out + offset;
+  uint8_t *ref = (uint8_t *)s_ref + offset;
+
+  memset(s_out, 0xa5, sizeof(s_out));
+  memset(s_ref, 0xa5, sizeof(s_ref));
+
+  k->func(samples, (int8_t *)in, (int8_t *)out);
+  reference(k, samples, in, ref);
+
+  if (memcmp(s_out, s_ref, sizeof(s_out)) != 0)
+    {
+      printf("bench_packing: %s differs (offset %u, %u samples)\n",
+             k->name, (unsigned)offset, (unsigned)samples);
+      return 1;
+    }
+
+  return 0;
+}
+
+int main(void)
+{
+  uint32_t i;
+  uint32_t samples;
+
+  srand(1);
+  for (i = 0; i < sizeof(s_in); i++)
+    {
+      ((uint8_t *)s_in)[i] = (uint8_t)rand();
+    }
+
+  for (i = 0; i < sizeof(s_kernels) / sizeof(s_kernels[0]); i++)
+    {
+      const struct bench_kernel_s *k = &s_kernels[i];
+
+      /* Remainders of 0 to 3 samples after the 4 sample blocks */
+
+      for (samples = BENCH_SAMPLES - 3; samples <= BENCH_SAMPLES; samples++)
+        {
+          if (check(k, 0, samples) || check(k, 1, samples))
+            {
+              return 1;
+            }
+        }
+
+      printf("cnv%s: aligned %.0f MB/s, unaligned %.0f MB/s\n",
+             k->name, run(k, 0), run(k, 1));
+    }
+
+  return 0;
+}
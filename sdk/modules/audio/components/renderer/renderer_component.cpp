@@ -478,7 +478,8 @@ bool AS_init_renderer(RenderComponentHandler handle,
                       RenderDoneCB callback,
                       RenderErrorCB err_callback,
                       void *p_requester,
-                      uint8_t bit_length)
+                      uint8_t bit_length,
+                      uint16_t dma_min_size)
 {
   RendererComponent::RendererComponentParam param;
 
@@ -488,6 +489,7 @@ bool AS_init_renderer(RenderComponentHandler handle,
   param.init_render_param.callback    = callback;
   param.init_render_param.p_requester = p_requester;
   param.init_render_param.err_callback = err_callback;
+  param.init_render_param.dma_min_size = dma_min_size;
 
   if (!s_pFactory->parse(handle, MSG_AUD_BB_CMD_INIT, param))
     {
@@ -766,6 +768,7 @@ bool RendererComponent::init(const RendererComponentParam& param)
   init_param.p_error_func   = m_dma_err_cb;
   init_param.fade_en        = true;
   init_param.p_dmadone_func = m_dma_done_cb;
+  init_param.min_size       = param.init_render_param.dma_min_size;
 
   m_callback    = param.init_render_param.callback;
   m_p_requester = param.init_render_param.p_requester;
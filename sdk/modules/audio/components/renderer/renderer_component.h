@@ -72,7 +72,8 @@ bool AS_init_renderer(RenderComponentHandler handle,
                       RenderDoneCB callback,
                       RenderErrorCB err_callback,
                       void *p_requester,
-                      uint8_t bit_length);
+                      uint8_t bit_length,
+                      uint16_t dma_min_size);
 
 bool AS_exec_renderer(RenderComponentHandler handle,
                       void *addr,
@@ -112,6 +113,7 @@ public:
     RenderDoneCB           callback;
     RenderErrorCB err_callback;
     void                   *p_requester;
+    uint16_t               dma_min_size; /* 0: default of the DMAC */
   };
 
   struct ExecRenderCompParam
@@ -60,6 +60,7 @@ typedef struct AudioDrvDmaInitParam_
   uint8_t           dma_byte_len;
   uint8_t           ch_num;
   bool              fade_en;
+  uint16_t          min_size;
 } AudioDrvDmaInitParam;
 
 typedef struct AudioDrvDmaRunParam_
@@ -306,7 +306,7 @@ bool AsDmaDrv::init(void *p_param)
     }
   else
     {
-      m_min_size = DMAC_MIN_SIZE_INT;
+      m_min_size = initParam->min_size;
     }
 
   if (!m_level_ctrl.init(initParam->dmac_id, true, true))
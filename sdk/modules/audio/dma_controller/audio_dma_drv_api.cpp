@@ -53,7 +53,9 @@ static E_AS initDmac(asInitDmacParam *pInitDmacParam)
 
   if (pInitDmacParam->p_dmadone_func != NULL)
     {
-      dmacMinimumSize[pInitDmacParam->dmacId] = DMAC_MIN_SIZE_INT;
+      dmacMinimumSize[pInitDmacParam->dmacId] =
+        (pInitDmacParam->min_size != 0) ?
+          pInitDmacParam->min_size : DMAC_MIN_SIZE_INT;
       param.p_dmadone_func = pInitDmacParam->p_dmadone_func;
     }
   else
@@ -76,7 +78,8 @@ static E_AS initDmac(asInitDmacParam *pInitDmacParam)
       param.dma_byte_len = AS_DMAC_BYTE_WT_16BIT;
     }
 
-  param.fade_en = pInitDmacParam->fade_en;
+  param.fade_en  = pInitDmacParam->fade_en;
+  param.min_size = dmacMinimumSize[pInitDmacParam->dmacId];
 
   rtCodeBB = AS_AudioDrvDmaInit(&param);
 
@@ -98,6 +101,14 @@ E_AS AS_InitDmac(asInitDmacParam *pInitDmacParam)
       return E_AS_INITDMAC_NULL;
     }
 
+  if (pInitDmacParam->min_size != 0 &&
+      (pInitDmacParam->min_size < DMAC_MIN_SIZE_POL ||
+       pInitDmacParam->min_size > DMAC_MIN_SIZE_INT))
+    {
+      DMAC_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+      return E_AS_DMAC_SIZE_MIN_ERR;
+    }
+
   E_AS rtCode = initDmac(pInitDmacParam);
 
   return rtCode;
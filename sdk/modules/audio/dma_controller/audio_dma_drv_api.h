@@ -273,6 +273,11 @@ typedef struct
   AS_ErrorCb   p_error_func;     /* [in] DMAC transfer error callback */
   AS_DmaDoneCb p_dmadone_func;   /* [in] DMAC transfer done callback */
   bool         fade_en;          /* [in] auto fade mode, TRUE:ENABLE */
+  uint16_t     min_size;         /* [in] min transfer size (samples) of
+                                  *      interrupt mode, DMAC_MIN_SIZE_POL
+                                  *      to DMAC_MIN_SIZE_INT.
+                                  *      0:DMAC_MIN_SIZE_INT
+                                  */
 } asInitDmacParam;
 
 /**
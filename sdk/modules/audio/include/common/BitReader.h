@@ -0,0 +1,182 @@
+/****************************************************************************
+ * modules/audio/include/common/BitReader.h
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_AUDIO_INCLUDE_COMMON_BITREADER_H
+#define __MODULES_AUDIO_INCLUDE_COMMON_BITREADER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Maximum bit length which can be peeked at once.
+ * (The cache holds at least 25 bits after refilled)
+ */
+
+#define BITREADER_MAX_PEEK_BITS  25
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* MSB first bit reader over a byte buffer.
+ * Bytes are loaded into a 32-bit cache on demand, so each field is
+ * extracted by shifts only. Bytes after the end of the buffer are
+ * never accessed and read as 0.
+ */
+
+struct bit_reader_s
+{
+  const uint8_t *ptr;  /* Next byte to be loaded into the cache */
+  const uint8_t *end;  /* End of the buffer */
+  uint32_t cache;      /* Unread bits, left aligned */
+  uint32_t cache_bits; /* Number of valid bits in the cache */
+};
+typedef struct bit_reader_s BitReader;
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/* Load bytes until the cache holds more than 24 bits. */
+
+static inline void bitReaderRefill(BitReader *br)
+{
+  while (br->cache_bits <= 24)
+    {
+      uint32_t byte = (br->ptr < br->end) ? *br->ptr : 0;
+
+      br->ptr++;
+      br->cache |= byte << (24 - br->cache_bits);
+      br->cache_bits += 8;
+    }
+}
+
+/* Start reading from the bit_offset-th bit (MSB first) of ptr. */
+
+static inline void bitReaderInit(BitReader *br,
+                                 const uint8_t *ptr,
+                                 size_t size,
+                                 uint32_t bit_offset)
+{
+  br->ptr = ptr;
+  br->end = ptr + size;
+  br->cache = 0;
+  br->cache_bits = 0;
+  bitReaderRefill(br);
+
+  br->cache <<= bit_offset;
+  br->cache_bits -= bit_offset;
+}
+
+/* Get next length bits without consuming them.
+ * (0 < length <= BITREADER_MAX_PEEK_BITS)
+ */
+
+static inline uint32_t bitReaderPeek(BitReader *br, uint32_t length)
+{
+  if (br->cache_bits < length)
+    {
+      bitReaderRefill(br);
+    }
+
+  return br->cache >> (32 - length);
+}
+
+/* Consume length bits which have been peeked. */
+
+static inline void bitReaderSkip(BitReader *br, uint32_t length)
+{
+  br->cache = (length < 32) ? (br->cache << length) : 0;
+  br->cache_bits -= length;
+}
+
+/* Get next length bits. (0 < length <= 32) */
+
+static inline uint32_t bitReaderRead(BitReader *br, uint32_t length)
+{
+  uint32_t value;
+
+  if (length > BITREADER_MAX_PEEK_BITS)
+    {
+      value = bitReaderPeek(br, length - 16) << 16;
+      bitReaderSkip(br, length - 16);
+      length = 16;
+    }
+  else
+    {
+      value = 0;
+    }
+
+  value |= bitReaderPeek(br, length);
+  bitReaderSkip(br, length);
+
+  return value;
+}
+
+/* Discard next length bits. Whole bytes beyond the cache are skipped
+ * without being loaded.
+ */
+
+static inline void bitReaderAdvance(BitReader *br, uint32_t length)
+{
+  if (length <= br->cache_bits)
+    {
+      bitReaderSkip(br, length);
+      return;
+    }
+
+  length -= br->cache_bits;
+  br->ptr += length / 8;
+  br->cache = 0;
+  br->cache_bits = 0;
+  bitReaderRefill(br);
+  bitReaderSkip(br, length % 8);
+}
+
+/* Address of the byte which contains the next unread bit. */
+
+static inline const uint8_t *bitReaderBytePtr(const BitReader *br)
+{
+  return br->ptr - (br->cache_bits + 7) / 8;
+}
+
+#endif /* __MODULES_AUDIO_INCLUDE_COMMON_BITREADER_H */
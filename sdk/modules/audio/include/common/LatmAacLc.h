@@ -312,12 +312,14 @@ typedef struct info_stream_mux_config_s InfoStreamMuxConfig;
  * Get top of next LATM
  *
  * arg1 : Top of LOAS/LATM(ex, top of payload)
- * arg2 : Top of information structure (see above)
+ * arg2 : Byte length of data from arg1. Bits beyond it are read as 0.
+ * arg3 : Top of information structure (see above)
  *
  * return : Top of next LATM frame begin with current LATM frame which is appointed by arg1.
  *          0=NG(AudioObjectType which is written in LATM header is out of support)
  */
 FAR uint8_t *AACLC_getNextLatm(FAR uint8_t *ptr_readbuff,
+                               uint32_t size,
                                FAR InfoStreamMuxConfig *ptr_stream_mux_config);
 
 #endif /* __MODULES_AUDIO_INCLUDE_COMMON_LATMAACLC_H_ */
@@ -91,22 +91,21 @@
 #define MP3PARSER_PRIVATEBIT_ISOUSED 1    /* '1' */
 #define MP3PARSER_EMPHASIS_RESERVED  2    /* '10' */
 
-/* Members of 2nd byte */
-
-#define MP3PARSER_GET_ID(byte)          ((byte & 0x08) >> 3)
-#define MP3PARSER_GET_LAYER(byte)       ((byte & 0x06) >> 1)
-#define MP3PARSER_GET_PROTECTION(byte)   (byte & 0x01)
-/* Members of 3rd byte */
-#define MP3PARSER_GET_BR(byte)          ((byte & 0xF0) >> 4)
-#define MP3PARSER_GET_FS(byte)          ((byte & 0x0C) >> 2)
-#define MP3PARSER_GET_PADDING(byte)     ((byte & 0x02) >> 1)
-#define MP3PARSER_GET_PRIVATE(byte)      (byte & 0x01)
-/* Members of 4th byte */
-#define MP3PARSER_GET_MODE(byte)        ((byte & 0xC0) >> 6)
-#define MP3PARSER_GET_MODEEXT(byte)     ((byte & 0x30) >> 4)
-#define MP3PARSER_GET_CPRIGHT(byte)     ((byte & 0x08) >> 3)
-#define MP3PARSER_GET_ORGHOME(byte)     ((byte & 0x04) >> 2)
-#define MP3PARSER_GET_EMPHAS(byte)       (byte & 0x02)
+/* Bit length of header fields */
+
+#define MP3PARSER_BITS_SYNCWORD      12
+#define MP3PARSER_BITS_ID            1
+#define MP3PARSER_BITS_LAYER         2
+#define MP3PARSER_BITS_PROTECTION    1
+#define MP3PARSER_BITS_BR            4
+#define MP3PARSER_BITS_FS            2
+#define MP3PARSER_BITS_PADDING       1
+#define MP3PARSER_BITS_PRIVATE       1
+#define MP3PARSER_BITS_MODE          2
+#define MP3PARSER_BITS_MODEEXT       2
+#define MP3PARSER_BITS_CPRIGHT       1
+#define MP3PARSER_BITS_ORGHOME       1
+#define MP3PARSER_BITS_EMPHAS        2
 
 #define MP3PARSER_BITLENGTH_BYTE     8      /* Bit length per a byte */
 #define MP3PARSER_SLOTLENGTH_LAYER1  4      /* 1-slot length of LAYER1 */
@@ -332,54 +331,27 @@ struct mp3parser_handle_s
 typedef struct mp3parser_handle_s MP3PARSER_Handle;
 
 /*--------------------------------------------------------------------------*/
-#if 0  /* BitField Structure -(Now not used, however, it remains as "header information" comment */
-#ifdef WINDOWS
-/** MP3 header - bit field
- *  (for little endian)
- */
-
-struct mp3parser_header_s
-{
-  uint8_t  syncword1 : 8;             /* [0] bit0-7 */
-  uint8_t  protection_bit : 1;        /* [1] bit7 */
-  uint8_t  layer : 2;                 /* [1] bit5-6 */
-  uint8_t  id : 1;                    /* [1] bit4 */
-  uint8_t  syncword2 : 4;             /* [1] bit0-3 */
-  uint8_t  private_bit : 1;           /* [2] bit7 */
-  uint8_t  padding_bit : 1;           /* [2] bit6 */
-  uint8_t  sampling_frequency : 2;    /* [2] bit4-5 */
-  uint8_t  bitrate_index : 4;         /* [2] bit0-3 */
-  uint8_t  emphasis : 2;              /* [3] bit6-7 */
-  uint8_t  original_home : 1;         /* [3] bit5 */
-  uint8_t  copyright : 1;             /* [3] bit4 */
-  uint8_t  mode_extension : 2;        /* [3] bit2-3 */
-  uint8_t  mode : 2;                  /* [3] bit0-1 */
-};
-typedef struct mp3parser_header_s Mp3ParserHeader;
-#else
-/** MP3 header - bit field
- *  (for big endian)
+/** MP3 header fields
+ *  (Read from the head in this order, MSB first)
  */
 
 struct mp3parser_header_s
 {
-  unsigned int  syncword : 12;           /* [0] bit0-7 [1] bit0-3 */
-  unsigned int  id : 1;                  /* [1] bit4 */
-  unsigned int  layer : 2;               /* [1] bit5-6 */
-  unsigned int  protection_bit : 1;      /* [1] bit7 */
-  unsigned int  bitrate_index : 4;       /* [2] bit0-3 */
-  unsigned int  sampling_frequency : 2;  /* [2] bit4-5 */
-  unsigned int  padding_bit : 1;         /* [2] bit6 */
-  unsigned int  private_bit : 1;         /* [2] bit7 */
-  unsigned int  mode : 2;                /* [3] bit0-1 */
-  unsigned int  mode_extension : 2;      /* [3] bit2-3 */
-  unsigned int  copyright : 1;           /* [3] bit4 */
-  unsigned int  original_home : 1;       /* [3] bit5 */
-  unsigned int  emphasis : 2;            /* [3] bit6-7 */
+  uint16_t syncword;           /* 12 bits */
+  uint8_t  id;                 /* 1 bit */
+  uint8_t  layer;              /* 2 bits */
+  uint8_t  protection_bit;     /* 1 bit */
+  uint8_t  bitrate_index;      /* 4 bits */
+  uint8_t  sampling_frequency; /* 2 bits */
+  uint8_t  padding_bit;        /* 1 bit */
+  uint8_t  private_bit;        /* 1 bit */
+  uint8_t  mode;               /* 2 bits */
+  uint8_t  mode_extension;     /* 2 bits */
+  uint8_t  copyright;          /* 1 bit */
+  uint8_t  original_home;      /* 1 bit */
+  uint8_t  emphasis;           /* 2 bits */
 };
 typedef struct mp3parser_header_s Mp3ParserHeader;
-#endif
-#endif
 
 /* MP3 header info */
 
@@ -734,6 +706,8 @@ Mp3ParserReturnValueOfSyncSearch mp3parser_distribute_processing( \
 int32_t mp3parser_get_frameheader(FAR MP3PARSER_Handle *ptr_hndl,
                                   FAR Mp3ParserLocalInfo *ptr_info,
                                   FAR uint8_t *ptr_local_buff);
+void mp3parser_read_header(FAR const uint8_t *ptr_head,
+                           FAR Mp3ParserHeader *ptr_header);
 Mp3ParserReturnValueOfFile mp3parser_buffer_check_tag( \
                              FAR MP3PARSER_Handle *ptr_hndl,
                              FAR Mp3ParserLocalInfo *ptr_info);
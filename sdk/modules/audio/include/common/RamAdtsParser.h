@@ -139,6 +139,47 @@ int32_t AdtsParser_ReadFrame(FAR AdtsHandle *pHandle,
                              FAR uint16_t *usResult,
                              FAR AdtsParserErrorDetail *uipErrDetail);
 
+/*!
+ * @brief Refer to a frame of ADTS Data without copying it
+ *
+ * The data before the frame is discarded, but the frame itself is kept
+ * in the FIFO until AdtsParser_DiscardFrame() is called.
+ *
+ * @param[in] pHandle Pointer to ADTS-DATA access handle
+ *
+ * @param[out] pFrame Regions of the frame in the FIFO (including header)
+ *
+ * @param[out] uiSize Frame size
+ *
+ * @param[out] usResult Result of header validity check
+ *
+ * @param[out] uipErrDetail Error Detail
+ *
+ * @return Function return code
+ */
+
+int32_t AdtsParser_PeekFrame(FAR AdtsHandle *pHandle,
+                             FAR CMN_SimpleFifoPeekHandle *pFrame,
+                             FAR uint32_t *uiSize,
+                             FAR uint16_t *usResult,
+                             FAR AdtsParserErrorDetail *uipErrDetail);
+
+/*!
+ * @brief Discard a frame referred by AdtsParser_PeekFrame()
+ *
+ * @param[in] pHandle Pointer to ADTS-DATA access handle
+ *
+ * @param[in] uiSize Frame size
+ *
+ * @param[out] uipErrDetail Error Detail
+ *
+ * @return Function return code
+ */
+
+int32_t AdtsParser_DiscardFrame(FAR AdtsHandle *pHandle,
+                                uint32_t uiSize,
+                                FAR AdtsParserErrorDetail *uipErrDetail);
+
 /*!
  * @brief Finalize ADTS Parser
  *
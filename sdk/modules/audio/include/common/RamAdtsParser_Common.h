@@ -77,10 +77,17 @@
             ((hdr1 & ADTSPARSER_SYNCWORD_2) == ADTSPARSER_SYNCWORD_2)) ? \
             ADTS_OK : ADTS_ERR)
 
-/*----- Profile -----*/
+/*----- Bit length of header fields (in order from the head) -----*/
 
-#define ADTS_MASK_PROFILE     0xC0    /* Mask [2] */
-#define ADTS_PROFILE_AACLC    0x40    /* profile=AAC-LC */
+#define ADTS_BITS_SYNCWORD         12
+#define ADTS_BITS_ID_TO_PROTECTION 4  /* id, layer, protection bit */
+#define ADTS_BITS_PROFILE          2
+#define ADTS_BITS_SAMPLING_RATE    4
+#define ADTS_BITS_PRIVATE_TO_START 8  /* private bit ... copyright id start */
+#define ADTS_BITS_FRAMELENGTH      13
+
+#define ADTS_SYNCWORD         0xFFF
+#define ADTS_PROFILE_AACLC    1       /* profile=AAC-LC */
 
 /*----- SamplingFrequency -----*/
 
@@ -93,22 +100,6 @@
           (AdtsSamplingFrequency[((hdr2 & ADTS_MASK_SAMPLING_RATE) >> \
             ADTS_RSHIFT_SAMPLING_RATE)])
 
-/*----- FrameLength -----*/
-
-#define ADTS_MASK_FRAMELENGTH_3    0x03    /* Mask [3] */
-#define ADTS_MASK_FRAMELENGTH_4    0xFF    /* Mask [4] */
-#define ADTS_MASK_FRAMELENGTH_5    0xE0    /* Mask [5] */
-#define ADTS_LSHIFT_FRAMELENGTH_3  11      /* Left shift width after mask */
-#define ADTS_LSHIFT_FRAMELENGTH_4  3       /* Left shift width after mask */
-#define ADTS_RSHIFT_FRAMELENGTH_5  5       /* Right shift width after mask */
-
-/* Macro for get frame size */
-
-#define ADTS_GET_FRAMELENGTH(hdr3,hdr4,hdr5)  \
-          (((hdr3 & ADTS_MASK_FRAMELENGTH_3) << ADTS_LSHIFT_FRAMELENGTH_3) | \
-          ((hdr4 & ADTS_MASK_FRAMELENGTH_4) << ADTS_LSHIFT_FRAMELENGTH_4) | \
-          ((hdr5 & ADTS_MASK_FRAMELENGTH_5) >> ADTS_RSHIFT_FRAMELENGTH_5))
-
 #define ADTSPARSER_SYNCWORD_SEARCH_SIZE 3
 
 /****************************************************************************
@@ -95,6 +95,31 @@ struct AudioMngCmdCmpltResult
  * Inline Functions
  ****************************************************************************/
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+/* StopBB completion of the sound effector carries the latency in
+ * sub_result. Minimum [us] is in the upper 16 bits and maximum [us]
+ * is in the lower 16 bits, each saturated to UINT16_MAX.
+ */
+
+static inline uint32_t AS_PackStopBBLatency(uint32_t min_us, uint32_t max_us)
+{
+  min_us = (min_us > UINT16_MAX) ? UINT16_MAX : min_us;
+  max_us = (max_us > UINT16_MAX) ? UINT16_MAX : max_us;
+
+  return (min_us << 16) | max_us;
+}
+
+static inline uint32_t AS_UnpackStopBBMinLatency(uint32_t sub_result)
+{
+  return sub_result >> 16;
+}
+
+static inline uint32_t AS_UnpackStopBBMaxLatency(uint32_t sub_result)
+{
+  return sub_result & UINT16_MAX;
+}
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
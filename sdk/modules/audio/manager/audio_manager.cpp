@@ -2063,6 +2063,9 @@ uint32_t AudioManager::setPlayerStatusParamCheck(uint8_t  input_dev,
   switch (input_dev)
     {
       case AS_SETPLAYER_INPUTDEVICE_RAM:
+#ifdef CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT
+      case AS_SETPLAYER_INPUTDEVICE_FILE:
+#endif
         break;
 
       default:
@@ -2269,6 +2272,9 @@ void AudioManager::setRecorder(AudioCommand &cmd)
     {
       case AS_SETRECDR_STS_OUTPUTDEVICE_EMMC:
       case AS_SETRECDR_STS_OUTPUTDEVICE_RAM:
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+      case AS_SETRECDR_STS_OUTPUTDEVICE_FILE:
+#endif
         break;
 
       default:
@@ -2565,13 +2571,28 @@ void AudioManager::cmpltOnSoundFx(const AudioMngCmdCmpltResult &cmd)
 
       case AUDCMD_STOPBB:
         m_SubState = AS_MNG_SUB_STATUS_BASEBANDREADY;
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+        sendStopBBResult(cmd.sub_result);
+        return;
+#else
         result_code = AUDRLT_STOPBBCMPLT;
         break;
+#endif
 
       case AUDCMD_INITMFE:
         result_code = AUDRLT_INITMFECMPLT;
         break;
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+      case AUDCMD_INITMPP:
+        result_code = AUDRLT_INITMPPCMPLT;
+        break;
+
+      case AUDCMD_SETMPPPARAM:
+        result_code = AUDRLT_SETMPPCMPLT;
+        break;
+
+#endif
 #endif  /* AS_FEATURE_EFFECTOR_ENABLE */
 #ifdef AS_FEATURE_RECOGNIZER_ENABLE
       case AUDCMD_STARTVOICECOMMAND:
@@ -2858,6 +2879,28 @@ void AudioManager::sendResult(uint8_t code, uint8_t sub_code, uint8_t instance_i
   F_ASSERT(er == ERR_OK);
 }
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+/*--------------------------------------------------------------------------*/
+void AudioManager::sendStopBBResult(uint32_t latency)
+{
+  AudioResult packet;
+  packet.header.packet_length = LENGTH_AUDRLT_STOPBBCMPLT;
+  packet.header.result_code   = AUDRLT_STOPBBCMPLT;
+  packet.header.sub_code      = 0;
+  packet.header.instance_id   = 0;
+
+  packet.stop_bb_cmplt_param.min_latency = AS_UnpackStopBBMinLatency(latency);
+  packet.stop_bb_cmplt_param.max_latency = AS_UnpackStopBBMaxLatency(latency);
+
+  err_t er = MsgLib::send<AudioResult>(s_appMid,
+                                       MsgPriNormal,
+                                       MSG_AUD_MGR_RST,
+                                       m_selfDtq,
+                                       packet);
+  F_ASSERT(er == ERR_OK);
+}
+#endif
+
 /*--------------------------------------------------------------------------*/
 void AudioManager::sendErrRespResult(uint8_t  sub_code,
                                      uint8_t  module_id,
@@ -219,6 +219,9 @@ private:
   uint32_t powerOffBaseBand(uint8_t power_id);
   
   void sendResult(uint8_t code, uint8_t sub_code = 0, uint8_t instance_id = 0);
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+  void sendStopBBResult(uint32_t latency);
+#endif
   void sendErrRespResult(uint8_t  sub_code,
                          uint8_t  module_id,
                          uint32_t error_code,
@@ -139,19 +139,33 @@ void MicFrontEndObject::run(void)
 {
   err_t        err_code;
   MsgQueBlock* que;
-  MsgPacket*   msg;
+  MsgPacket*   msg[MSG_RECV_BATCH_NUM];
+  uint16_t     num;
 
   err_code = MsgLib::referMsgQueBlock(m_msgq_id.micfrontend, &que);
   F_ASSERT(err_code == ERR_OK);
 
   while(1)
     {
-      err_code = que->recv(TIME_FOREVER, &msg);
+      err_code = que->recvBatch(TIME_FOREVER, msg, MSG_RECV_BATCH_NUM, &num);
       F_ASSERT(err_code == ERR_OK);
 
-      parse(msg);
+      /* Stop the batch when a high priority message arrives.
+       * The rest of the batch is received again after it.
+       */
+
+      uint16_t done = 0;
+      while (done < num)
+        {
+          parse(msg[done++]);
+
+          if (done < num && que->hasNewHighMsg(msg, num))
+            {
+              break;
+            }
+        }
 
-      err_code = que->pop();
+      err_code = que->popBatch(msg, num, done);
       F_ASSERT(err_code == ERR_OK);
     }
 }
@@ -526,6 +540,7 @@ void MicFrontEndObject::init(MsgPacket *msg)
   cap_comp_param.init_param.preset_num        = CAPTURE_PRESET_NUM;
   cap_comp_param.init_param.callback          = capture_done_callback;
   cap_comp_param.init_param.err_callback      = capture_error_callback;
+  cap_comp_param.init_param.dma_min_size      = 0;
   cap_comp_param.handle                       = m_capture_hdlr;
 
   if (!AS_init_capture(&cap_comp_param))
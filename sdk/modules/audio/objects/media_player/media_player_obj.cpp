@@ -219,6 +219,10 @@ PlayerObj::PlayerObj(AsPlayerMsgQueId_t msgq_id, AsPlayerPoolId_t pool_id, AsPla
   m_callback(NULL),
   m_pcm_path(AsPcmDataReply)
 {
+#ifdef CONFIG_AUDIOUTILS_PLAYER_GAPLESS
+  m_next_input_device_handler = NULL;
+  m_trim_carry_size           = 0;
+#endif
 }
 
 /*--------------------------------------------------------------------------*/
@@ -226,19 +230,33 @@ void PlayerObj::run(void)
 {
   err_t        err_code;
   MsgQueBlock *que;
-  MsgPacket   *msg;
+  MsgPacket   *msg[MSG_RECV_BATCH_NUM];
+  uint16_t     num;
 
   err_code = MsgLib::referMsgQueBlock(m_msgq_id.player, &que);
   F_ASSERT(err_code == ERR_OK);
 
   while(1)
     {
-      err_code = que->recv(TIME_FOREVER, &msg);
+      err_code = que->recvBatch(TIME_FOREVER, msg, MSG_RECV_BATCH_NUM, &num);
       F_ASSERT(err_code == ERR_OK);
 
-      parse(msg);
+      /* Stop the batch when a high priority message arrives.
+       * The rest of the batch is received again after it.
+       */
+
+      uint16_t done = 0;
+      while (done < num)
+        {
+          parse(msg[done++]);
 
-      err_code = que->pop();
+          if (done < num && que->hasNewHighMsg(msg, num))
+            {
+              break;
+            }
+        }
+
+      err_code = que->popBatch(msg, num, done);
       F_ASSERT(err_code == ERR_OK);
     }
 }
@@ -321,6 +339,18 @@ PlayerObj::MsgProc PlayerObj::MsgProcTbl[AUD_PLY_MSG_NUM][PlayerStateNum] =
     &PlayerObj::setGain,             /*   WaitEsEndState.     */
     &PlayerObj::setGain,             /*   UnderflowState.     */
     &PlayerObj::setGain,             /*   WaitStopState.      */
+  },
+
+  /* Message type: MSG_AUD_PLY_CMD_SETNEXT */
+  {                                  /* Player status:        */
+    &PlayerObj::illegalEvt,          /*   BootedState.        */
+    &PlayerObj::illegalEvt,          /*   ReadyState.         */
+    &PlayerObj::parseSubState,       /*   PrePlayParentState. */
+    &PlayerObj::setNext,             /*   PlayState.          */
+    &PlayerObj::illegalEvt,          /*   StoppingState.      */
+    &PlayerObj::setNext,             /*   WaitEsEndState.     */
+    &PlayerObj::illegalEvt,          /*   UnderflowState.     */
+    &PlayerObj::illegalEvt,          /*   WaitStopState.      */
   }
 };
 
@@ -379,6 +409,15 @@ PlayerObj::MsgProc PlayerObj::PlayerSubStateTbl[AUD_PLY_MSG_NUM][SubStateNum] =
     &PlayerObj::setGain,                   /*   SubStatePrePlayStopping.  */
     &PlayerObj::setGain,                   /*   SubStatePrePlayWaitEsEnd. */
     &PlayerObj::setGain,                   /*   SubStatePrePlayUnderflow. */
+  },
+
+  /* Message type: MSG_AUD_PLY_CMD_SETNEXT. */
+
+  {                                        /* Player sub status:          */
+    &PlayerObj::setNext,                   /*   SubStatePrePlay.          */
+    &PlayerObj::illegalEvt,                /*   SubStatePrePlayStopping.  */
+    &PlayerObj::setNext,                   /*   SubStatePrePlayWaitEsEnd. */
+    &PlayerObj::illegalEvt,                /*   SubStatePrePlayUnderflow. */
   }
 };
 
@@ -516,7 +555,8 @@ void PlayerObj::illegalEvt(MsgPacket *msg)
     AsPlayerEventPlay,
     AsPlayerEventStop,
     AsPlayerEventDeact,
-    AsPlayerEventSetGain
+    AsPlayerEventSetGain,
+    AsPlayerEventSetNext
   };
 
   reply(table[idx], (MsgType)msgtype, AS_ECODE_STATE_VIOLATION);
@@ -545,6 +585,11 @@ void PlayerObj::activate(MsgPacket *msg)
       return;
     }
 
+#ifdef CONFIG_AUDIOUTILS_PLAYER_GAPLESS
+  m_input_device              = act.param.input_device;
+  m_next_input_device_handler = NULL;
+#endif
+
   switch (act.param.input_device)
     {
       case AS_SETPLAYER_INPUTDEVICE_RAM:
@@ -555,6 +600,16 @@ void PlayerObj::activate(MsgPacket *msg)
         }
         break;
 
+#ifdef CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT
+      case AS_SETPLAYER_INPUTDEVICE_FILE:
+        {
+          m_input_device_handler = &m_in_file_device_handler;
+          in_device_handle.p_file_device_handle =
+            act.param.file_handler;
+        }
+        break;
+#endif
+
     default:
       reply(AsPlayerEventAct,
             msg->getType(),
@@ -1272,6 +1327,126 @@ void PlayerObj::setGain(MsgPacket *msg)
   /* Response is sent after decoder_component done */
 }
 
+/*--------------------------------------------------------------------------*/
+void PlayerObj::setNext(MsgPacket *msg)
+{
+#ifdef CONFIG_AUDIOUTILS_PLAYER_GAPLESS
+  AsSetNextPlayerParam param =
+    msg->moveParam<PlayerCommand>().set_next_param;
+
+  PlayerInputDeviceHandler::PlayerInHandle in_device_handle;
+  PlayerInputDeviceHandler *next_handler;
+  uint32_t rst;
+
+  MEDIA_PLAYER_DBG("SETNEXT: codec %d, fs %d\n",
+                   param.init_param.codec_type,
+                   param.init_param.sampling_rate);
+
+  if (m_next_input_device_handler != NULL)
+    {
+      reply(AsPlayerEventSetNext,
+            msg->getType(),
+            AS_ECODE_STATE_VIOLATION);
+      return;
+    }
+
+  /* Use the handler of the same type which is not playing now. */
+
+  switch (m_input_device)
+    {
+      case AS_SETPLAYER_INPUTDEVICE_RAM:
+        next_handler = (m_input_device_handler == &m_in_ram_device_handler) ?
+                       &m_in_ram_next_device_handler :
+                       &m_in_ram_device_handler;
+        in_device_handle.p_ram_device_handle = param.ram_handler;
+        break;
+
+#ifdef CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT
+      case AS_SETPLAYER_INPUTDEVICE_FILE:
+        next_handler = (m_input_device_handler == &m_in_file_device_handler) ?
+                       &m_in_file_next_device_handler :
+                       &m_in_file_device_handler;
+        in_device_handle.p_file_device_handle = param.file_handler;
+        break;
+#endif
+
+      default:
+        reply(AsPlayerEventSetNext,
+              msg->getType(),
+              AS_ECODE_COMMAND_PARAM_INPUT_DEVICE);
+        return;
+    }
+
+  if (!next_handler->initialize(&in_device_handle))
+    {
+      MEDIA_PLAYER_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+      reply(AsPlayerEventSetNext,
+            msg->getType(),
+            AS_ECODE_COMMAND_PARAM_INPUT_HANDLER);
+      return;
+    }
+
+  rst = next_handler->setParam(param.init_param);
+  if (rst != AS_ECODE_OK)
+    {
+      MEDIA_PLAYER_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+      reply(AsPlayerEventSetNext, msg->getType(), rst);
+      return;
+    }
+
+  /* Start the next track in advance, the head of es data is parsed
+   * (and file input begins to read ahead) while the current track
+   * is played.
+   */
+
+  rst = next_handler->start();
+  if (rst != AS_ECODE_OK)
+    {
+      next_handler->stop();
+      reply(AsPlayerEventSetNext, msg->getType(), rst);
+      return;
+    }
+
+  /* The decoder is continued as it is, so that the format must be
+   * the same as the current track.
+   */
+
+  if (next_handler->getCodecType() != m_input_device_handler->getCodecType())
+    {
+      rst = AS_ECODE_COMMAND_PARAM_CODEC_TYPE;
+    }
+  else if (next_handler->getSamplingRate() !=
+           m_input_device_handler->getSamplingRate())
+    {
+      rst = AS_ECODE_COMMAND_PARAM_SAMPLING_RATE;
+    }
+  else if (next_handler->getChannelNum() !=
+           m_input_device_handler->getChannelNum())
+    {
+      rst = AS_ECODE_COMMAND_PARAM_CHANNEL_NUMBER;
+    }
+  else if (next_handler->getBitLen() != m_input_device_handler->getBitLen())
+    {
+      rst = AS_ECODE_COMMAND_PARAM_BIT_LENGTH;
+    }
+
+  if (rst != AS_ECODE_OK)
+    {
+      next_handler->stop();
+      reply(AsPlayerEventSetNext, msg->getType(), rst);
+      return;
+    }
+
+  m_next_input_device_handler = next_handler;
+
+  reply(AsPlayerEventSetNext, msg->getType(), AS_ECODE_OK);
+#else
+  msg->moveParam<PlayerCommand>();
+
+  reply(AsPlayerEventSetNext, msg->getType(), AS_ECODE_COMMAND_NOT_SUPPOT);
+#endif
+}
+
 /*--------------------------------------------------------------------------*/
 void PlayerObj::parseSubState(MsgPacket *msg)
 {
@@ -1375,6 +1550,10 @@ uint32_t PlayerObj::startPlay(uint32_t* dsp_inf)
       return rst;
     }
 
+#ifdef CONFIG_AUDIOUTILS_PLAYER_GAPLESS
+  resetTrim();
+#endif
+
   init_dec_comp_param.codec_type          = m_codec_type;
   init_dec_comp_param.input_sampling_rate =
       m_input_device_handler->getSamplingRate();
@@ -1440,12 +1619,39 @@ void PlayerObj::stopPlay(void)
     }
 
   m_input_device_handler->stop();
+
+#ifdef CONFIG_AUDIOUTILS_PLAYER_GAPLESS
+  if (m_next_input_device_handler != NULL)
+    {
+      m_next_input_device_handler->stop();
+      m_next_input_device_handler = NULL;
+    }
+
+  /* Remove the padding and the rest flushed from the decoder. */
+
+  if (m_input_device_handler->getCodecType() == AudCodecMP3)
+    {
+      uint64_t end = CONFIG_AUDIOUTILS_PLAYER_GAPLESS_MP3_DECODER_DELAY +
+                     m_es_in_pos;
+
+      addTrimWindow((end > m_track_padding) ? end - m_track_padding : 0,
+                    UINT64_MAX);
+    }
+#endif
 }
 
 /*--------------------------------------------------------------------------*/
 void PlayerObj::sendPcmToOwner(AsPcmDataParam& data)
 {
   data.bit_length = m_input_device_handler->getBitLen();
+
+#ifdef CONFIG_AUDIOUTILS_PLAYER_GAPLESS
+  if (m_input_device_handler->getCodecType() == AudCodecMP3)
+    {
+      trimPcm(data);
+    }
+#endif
+
   if (m_pcm_path == AsPcmDataReply)
     {
       /* Call callback function for PCM data notify */
@@ -1459,6 +1665,23 @@ void PlayerObj::sendPcmToOwner(AsPcmDataParam& data)
       data.identifier = m_pcm_dest.msg.identifier;
       data.callback   = pcm_send_done_callback;
 
+#ifdef CONFIG_AUDIOUTILS_PLAYER_PCM_BY_HANDLE
+      /* Only the memory handle is queued. Copy the parameter
+       * if no segment is available.
+       */
+
+      if ((m_pool_id.pcm_param.pool != NullPoolId.pool) &&
+          (MsgLib::sendByHandle<AsPcmDataParam>(m_pcm_dest.msg.id,
+                                                MsgPriNormal,
+                                                MSG_AUD_MIX_CMD_DATA,
+                                                s_msgq_id.player,
+                                                m_pool_id.pcm_param,
+                                                data) == ERR_OK))
+        {
+          return;
+        }
+#endif
+
       err_t er = MsgLib::send<AsPcmDataParam>(m_pcm_dest.msg.id,
                                               MsgPriNormal,
                                               MSG_AUD_MIX_CMD_DATA,
@@ -1520,7 +1743,35 @@ void* PlayerObj::getEs(uint32_t* size)
       return NULL;
     }
 
+#ifdef CONFIG_AUDIOUTILS_PLAYER_GAPLESS
+  uint32_t req_size = *size;
+  bool     result   = m_input_device_handler->getEs(mh.getVa(), size);
+
+  if (!result && (m_next_input_device_handler != NULL) && isTrackEnd())
+    {
+      /* End of the current track, continue with the next track. */
+
+      switchTrack();
+
+      *size  = req_size;
+      result = m_input_device_handler->getEs(mh.getVa(), size);
+    }
+
+  if (result && (m_input_device_handler->getCodecType() == AudCodecMP3))
+    {
+      if (m_check_lame_tag)
+        {
+          checkLameTag(static_cast<const uint8_t *>(mh.getVa()), *size);
+          m_check_lame_tag = false;
+        }
+
+      m_es_in_pos += m_input_device_handler->getSampleNumPerFrame();
+    }
+
+  if (result)
+#else
   if (m_input_device_handler->getEs(mh.getVa(), size))
+#endif
     {
       if (!m_es_buf_mh_que.push(mh))
         {
@@ -1605,6 +1856,269 @@ void PlayerObj::finalize()
     }
 }
 
+#ifdef CONFIG_AUDIOUTILS_PLAYER_GAPLESS
+/*--------------------------------------------------------------------------*/
+bool PlayerObj::isTrackEnd(void)
+{
+  /* Running out of es data is the end of the current track only when
+   * the application told so by the stop with AS_STOPPLAYER_ESEND, or
+   * the input device reached the end of its source. Otherwise it is an
+   * underflow of the current track.
+   */
+
+  if ((m_state == WaitEsEndState) ||
+      ((m_state == PrePlayParentState) &&
+       (m_sub_state == SubStatePrePlayWaitEsEnd)))
+    {
+      return true;
+    }
+
+  return m_input_device_handler->isEsEnd();
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerObj::switchTrack(void)
+{
+  bool is_mp3 = (m_input_device_handler->getCodecType() == AudCodecMP3);
+
+  MEDIA_PLAYER_DBG("NEXT TRACK:\n");
+
+  /* Remove the padding at the end of the current track. */
+
+  if (is_mp3 && (m_track_padding > 0))
+    {
+      uint64_t end = CONFIG_AUDIOUTILS_PLAYER_GAPLESS_MP3_DECODER_DELAY +
+                     m_es_in_pos;
+
+      addTrimWindow(end - m_track_padding, end);
+    }
+
+  m_input_device_handler->stop();
+
+  m_input_device_handler      = m_next_input_device_handler;
+  m_next_input_device_handler = NULL;
+
+  m_track_padding  = 0;
+  m_check_lame_tag = is_mp3;
+
+  /* Stop by the end of es data completes at the end of the current
+   * track, playback continues with the next track.
+   */
+
+  if (((m_state == WaitEsEndState) ||
+       ((m_state == PrePlayParentState) &&
+        (m_sub_state == SubStatePrePlayWaitEsEnd))) &&
+      !m_external_cmd_que.empty() &&
+      (m_external_cmd_que.top() == AsPlayerEventStop))
+    {
+      if (!m_external_cmd_que.pop())
+        {
+          MEDIA_PLAYER_ERR(AS_ATTENTION_SUB_CODE_QUEUE_POP_ERROR);
+        }
+
+      reply(AsPlayerEventStop, MSG_AUD_PLY_CMD_STOP, AS_ECODE_OK);
+
+      if (m_state == WaitEsEndState)
+        {
+          m_state = PlayState;
+        }
+      else
+        {
+          m_sub_state = SubStatePrePlay;
+        }
+    }
+  else if (m_callback != NULL)
+    {
+      m_callback(AsPlayerEventNextTrack, AS_ECODE_OK, 0);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerObj::resetTrim(void)
+{
+  m_trim_window_que.clear();
+
+  m_es_in_pos       = 0;
+  m_pcm_out_pos     = 0;
+  m_track_padding   = 0;
+  m_check_lame_tag  = false;
+  m_trim_carry_size = 0;
+
+  if (m_input_device_handler->getCodecType() == AudCodecMP3)
+    {
+      /* Output of the decoder is delayed from the first input sample. */
+
+      addTrimWindow(0, CONFIG_AUDIOUTILS_PLAYER_GAPLESS_MP3_DECODER_DELAY);
+      m_check_lame_tag = true;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerObj::addTrimWindow(uint64_t start, uint64_t end)
+{
+  TrimWindow window;
+
+  window.start = start;
+  window.end   = end;
+
+  if ((start >= end) || !m_trim_window_que.push(window))
+    {
+      MEDIA_PLAYER_WARN(AS_ATTENTION_SUB_CODE_QUEUE_PUSH_ERROR);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerObj::checkLameTag(const uint8_t *p_es, uint32_t size)
+{
+  /* The first frame of MP3 data may be a Xing/Info frame, which is
+   * decoded into silence. LAME tag following it holds encoder delay
+   * and padding of the track.
+   */
+
+  uint32_t spf  = m_input_device_handler->getSampleNumPerFrame();
+  uint64_t base = CONFIG_AUDIOUTILS_PLAYER_GAPLESS_MP3_DECODER_DELAY +
+                  m_es_in_pos;
+
+  m_track_padding = 0;
+
+  if ((size < 4) || (p_es[0] != 0xff) || ((p_es[1] & 0xe0) != 0xe0))
+    {
+      return;
+    }
+
+  bool     is_mpeg1 = ((p_es[1] & 0x18) == 0x18);
+  bool     is_mono  = ((p_es[3] & 0xc0) == 0xc0);
+  uint32_t pos      = 4 + (is_mpeg1 ? (is_mono ? 17 : 32) :
+                                      (is_mono ? 9 : 17));
+
+  if (!(p_es[1] & 0x01))
+    {
+      pos += 2; /* CRC */
+    }
+
+  if ((pos + 8 > size) ||
+      ((memcmp(&p_es[pos], "Xing", 4) != 0) &&
+       (memcmp(&p_es[pos], "Info", 4) != 0)))
+    {
+      return;
+    }
+
+  uint32_t flags = p_es[pos + 7];
+
+  pos += 8;
+  pos += (flags & 0x01) ? 4 : 0;   /* Frames. */
+  pos += (flags & 0x02) ? 4 : 0;   /* Bytes. */
+  pos += (flags & 0x04) ? 100 : 0; /* TOC. */
+  pos += (flags & 0x08) ? 4 : 0;   /* Quality. */
+
+  uint32_t delay = 0;
+  uint32_t pad   = 0;
+
+  if ((pos + 24 <= size) &&
+      ((memcmp(&p_es[pos], "LAME", 4) == 0) ||
+       (memcmp(&p_es[pos], "Lavc", 4) == 0) ||
+       (memcmp(&p_es[pos], "Lavf", 4) == 0)))
+    {
+      delay = (p_es[pos + 21] << 4) | (p_es[pos + 22] >> 4);
+      pad   = ((p_es[pos + 22] & 0x0f) << 8) | p_es[pos + 23];
+    }
+
+  /* Remove the tag frame itself and the encoder delay. */
+
+  addTrimWindow(base, base + spf + delay);
+
+  m_track_padding = pad;
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerObj::trimPcm(AsPcmDataParam& data)
+{
+  /* 24bit samples are held in 32bit words. */
+
+  uint32_t frame_size = m_input_device_handler->getChannelNum() *
+                        ((data.bit_length == AS_BITLENGTH_16) ?
+                          sizeof(int16_t) : sizeof(int32_t));
+  uint8_t *p_pcm      = static_cast<uint8_t *>(data.mh.getVa());
+  uint32_t out_num    = data.size / frame_size;
+  uint32_t in_num     = (data.is_end) ? out_num :
+                        m_input_device_handler->getSampleNumPerFrame();
+  uint64_t in_start   = m_pcm_out_pos;
+  uint64_t in_end     = m_pcm_out_pos + in_num;
+
+  m_pcm_out_pos = in_end;
+
+  /* Remove overlaps with trim windows. Input samples are mapped to
+   * output samples in proportion, output may be converted by SRC.
+   * Windows are in ascending order, start from the last one so that
+   * removal does not move the remaining ranges.
+   */
+
+  if ((out_num > 0) && (in_num > 0))
+    {
+      for (int i = m_trim_window_que.size() - 1; i >= 0; i--)
+        {
+          const TrimWindow& window = m_trim_window_que.at(i);
+
+          uint64_t cut_start = (window.start > in_start) ?
+                               window.start : in_start;
+          uint64_t cut_end   = (window.end < in_end) ? window.end : in_end;
+
+          if (cut_start >= cut_end)
+            {
+              continue;
+            }
+
+          uint32_t head = (cut_start - in_start) * out_num / in_num;
+          uint32_t tail = (cut_end - in_start) * out_num / in_num;
+          uint32_t num  = data.size / frame_size;
+
+          tail = (tail > num) ? num : tail;
+
+          memmove(&p_pcm[head * frame_size],
+                  &p_pcm[tail * frame_size],
+                  (num - tail) * frame_size);
+
+          data.size -= (tail - head) * frame_size;
+        }
+
+      while (!m_trim_window_que.empty() &&
+             (m_trim_window_que.top().end <= in_end))
+        {
+          m_trim_window_que.pop();
+        }
+    }
+
+  /* Output mixer drops too short data, hold it and send with
+   * the following data.
+   */
+
+  if ((m_trim_carry_size > 0) && (data.size > 0 || data.is_end) &&
+      (data.size + m_trim_carry_size <= m_max_pcm_buff_size))
+    {
+      memmove(&p_pcm[m_trim_carry_size], p_pcm, data.size);
+      memcpy(p_pcm, m_trim_carry, m_trim_carry_size);
+
+      data.size        += m_trim_carry_size;
+      m_trim_carry_size = 0;
+    }
+
+  if (!data.is_end && (data.size > 0) &&
+      (data.size < TrimMinSampleNum * frame_size) &&
+      (m_trim_carry_size + data.size <= TrimCarrySize))
+    {
+      memcpy(&m_trim_carry[m_trim_carry_size], p_pcm, data.size);
+
+      m_trim_carry_size += data.size;
+      data.size          = 0;
+    }
+
+  if (data.size == 0)
+    {
+      data.is_valid = false;
+    }
+}
+#endif /* CONFIG_AUDIOUTILS_PLAYER_GAPLESS */
+
 /*--------------------------------------------------------------------------*/
 bool PlayerObj::checkAndSetMemPool()
 {
@@ -1647,6 +2161,24 @@ bool PlayerObj::checkAndSetMemPool()
       m_max_src_work_buff_size = (MemMgrLite::Manager::getPoolSize(m_pool_id.src_work)) /
         (MemMgrLite::Manager::getPoolNumSegs(m_pool_id.src_work));
     }
+
+#ifdef CONFIG_AUDIOUTILS_PLAYER_PCM_BY_HANDLE
+  if (m_pool_id.pcm_param.pool != NullPoolId.pool)
+    {
+      if (!MemMgrLite::Manager::isPoolAvailable(m_pool_id.pcm_param))
+        {
+          MEDIA_PLAYER_ERR(AS_ATTENTION_SUB_CODE_MEMHANDLE_ALLOC_ERROR);
+          return false;
+        }
+      if ((int)(sizeof(AsPcmDataParam)) >
+          (MemMgrLite::Manager::getPoolSize(m_pool_id.pcm_param))/
+          (MemMgrLite::Manager::getPoolNumSegs(m_pool_id.pcm_param)))
+        {
+          MEDIA_PLAYER_ERR(AS_ATTENTION_SUB_CODE_MEMHANDLE_ALLOC_ERROR);
+          return false;
+        }
+    }
+#endif
   return true;
 }
 
@@ -1767,6 +2299,9 @@ static bool CreatePlayerMulti(AsPlayerId id, AsPlayerMsgQueId_t msgq_id,AsPlayer
   tmp.pcm.pool = pool_id.pcm;
   tmp.dsp.pool = pool_id.dsp;
   tmp.src_work.pool = pool_id.src_work;
+#ifdef CONFIG_AUDIOUTILS_PLAYER_PCM_BY_HANDLE
+  tmp.pcm_param = NullPoolId;
+#endif
 
   return CreatePlayerMulti(id, msgq_id, tmp, attcb);
 
@@ -1812,6 +2347,9 @@ static bool CreatePlayer(AsPlayerId id, AsPlayerMsgQueId_t msgq_id, AsPlayerPool
   tmp.pcm.pool = pool_id.pcm;
   tmp.dsp.pool = pool_id.dsp;
   tmp.src_work = NullPoolId;
+#ifdef CONFIG_AUDIOUTILS_PLAYER_PCM_BY_HANDLE
+  tmp.pcm_param = NullPoolId;
+#endif
 
   return CreatePlayerMulti(id, msgq_id, tmp, NULL);
 
@@ -2004,6 +2542,35 @@ bool AS_RequestNextPlayerProcess(AsPlayerId id, FAR AsRequestNextParam *nextpara
   return true;
 }
 
+/*--------------------------------------------------------------------------*/
+bool AS_SetNextPlayer(AsPlayerId id, FAR AsSetNextPlayerParam *nextparam)
+{
+  /* Parameter check */
+
+  if (nextparam == NULL)
+    {
+      return false;
+    }
+
+  /* Set next track */
+
+  MsgQueId msgq_id = (id == AS_PLAYER_ID_0) ? s_msgq_id.player : s_sub_msgq_id.player;
+
+  PlayerCommand cmd;
+
+  cmd.player_id      = id;
+  cmd.set_next_param = *nextparam;
+
+  err_t er = MsgLib::send<PlayerCommand>(msgq_id,
+                                         MsgPriNormal,
+                                         MSG_AUD_PLY_CMD_SETNEXT,
+                                         s_msgq_id.mng,
+                                         cmd);
+  F_ASSERT(er == ERR_OK);
+
+  return true;
+}
+
 /*--------------------------------------------------------------------------*/
 bool AS_DeactivatePlayer(AsPlayerId id, FAR AsDeactivatePlayer *deactparam)
 {
@@ -122,6 +122,17 @@ private:
   AsPlayerId                m_player_id;
   PlayerInputDeviceHandler *m_input_device_handler;
   InputHandlerOfRAM         m_in_ram_device_handler;
+#ifdef CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT
+  InputHandlerOfFile        m_in_file_device_handler;
+#endif
+#ifdef CONFIG_AUDIOUTILS_PLAYER_GAPLESS
+  uint8_t                   m_input_device;
+  PlayerInputDeviceHandler *m_next_input_device_handler;
+  InputHandlerOfRAM         m_in_ram_next_device_handler;
+#  ifdef CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT
+  InputHandlerOfFile        m_in_file_next_device_handler;
+#  endif
+#endif
   void*                     m_p_dec_instance;
 
   uint32_t  m_max_es_buff_size;
@@ -153,6 +164,41 @@ private:
   AsPcmDataDest m_pcm_dest;
   AsPcmDataPath m_pcm_path;
 
+#ifdef CONFIG_AUDIOUTILS_PLAYER_GAPLESS
+  /* Samples to be removed from decoded data, counted in input
+   * samples from the start of decoding.
+   */
+
+  struct TrimWindow
+  {
+    uint64_t start;
+    uint64_t end;
+  };
+
+  /* Head and tail of two tracks. */
+
+  static const uint32_t MaxTrimWindowNum = 4;
+
+  /* Shorter data is dropped by mixer. */
+
+  static const uint32_t TrimMinSampleNum = 240;
+
+  /* Gapless trimming is for MP3, which has 2 channels at most. */
+
+  static const uint32_t TrimCarrySize =
+    TrimMinSampleNum * AS_CHANNEL_STEREO * sizeof(int32_t);
+
+  typedef s_std::Queue<TrimWindow, MaxTrimWindowNum> TrimWindowQueue;
+  TrimWindowQueue m_trim_window_que;
+
+  uint64_t m_es_in_pos;
+  uint64_t m_pcm_out_pos;
+  uint16_t m_track_padding;
+  bool     m_check_lame_tag;
+  uint32_t m_trim_carry_size;
+  uint8_t  m_trim_carry[TrimCarrySize];
+#endif
+
   void run(void);
   void parse(MsgPacket *);
   void parseSubState(MsgPacket *);
@@ -200,6 +246,8 @@ private:
 
   void setGain(MsgPacket *);
 
+  void setNext(MsgPacket *);
+
   uint32_t loadCodec(AudioCodec codec,
                      AsInitPlayerParam *param,
                      uint32_t* dsp_inf);
@@ -252,6 +300,14 @@ private:
     }
 
   void finalize();
+#ifdef CONFIG_AUDIOUTILS_PLAYER_GAPLESS
+  bool isTrackEnd(void);
+  void switchTrack(void);
+  void resetTrim(void);
+  void addTrimWindow(uint64_t start, uint64_t end);
+  void checkLameTag(const uint8_t *p_es, uint32_t size);
+  void trimPcm(AsPcmDataParam& data);
+#endif
   bool checkAndSetMemPool();
   bool judgeMultiCore(uint32_t sampling_rate, uint8_t bit_length);
 };
@@ -37,6 +37,13 @@
  * Included Files
  ****************************************************************************/
 
+#ifdef CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT
+#  include <errno.h>
+#  include <string.h>
+#  include <unistd.h>
+#  include <sys/stat.h>
+#  include <nuttx/kmalloc.h>
+#endif
 #include "objects/media_player/player_input_device_handler.h"
 #include "memutils/simple_fifo/CMN_SimpleFifo.h"
 #include "audio/audio_high_level_api.h"
@@ -57,6 +64,25 @@ __WIEN2_BEGIN_NAMESPACE
                                  (bit_length) / 8 : ((bit_length) / 8) + 1 \
                                 )
 
+#ifdef CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT
+/* Reads are issued in multiples of the file system sector size. */
+
+#define FILE_READ_ALIGN         512
+#define FILE_ALIGN_UP(sz)       (((sz) + FILE_READ_ALIGN - 1) & \
+                                 ~(FILE_READ_ALIGN - 1))
+#define FILE_ALIGN_DOWN(sz)     ((sz) & ~(FILE_READ_ALIGN - 1))
+
+#define FILE_FIFO_SIZE \
+  FILE_ALIGN_DOWN(CONFIG_AUDIOUTILS_PLAYER_FILE_FIFO_SIZE)
+
+/* Worst case bit rate [bps] used when the application does not tell it. */
+
+#define FILE_MAX_BITRATE_MP3    320000
+#define FILE_MAX_BITRATE_AAC    576000
+#define FILE_MAX_BITRATE_OPUS   510000
+#define FILE_DEFAULT_FS         48000
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -263,6 +289,11 @@ bool InputHandlerOfRAM::getEs(void* p_es, uint32_t* es_byte_size)
     {
       case InputDataManagerObject::EsExist:
         {
+          if (!m_read_notify)
+            {
+              return true;
+            }
+
           if (m_in_device_handler.notification_threshold_size == 0)
             {
               m_in_device_handler.callback_function(*es_byte_size);
@@ -289,4 +320,359 @@ bool InputHandlerOfRAM::getEs(void* p_es, uint32_t* es_byte_size)
   return false;
 }
 
+#ifdef CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT
+/*--------------------------------------------------------------------*/
+void InputHandlerOfFile::readDone(uint32_t size)
+{
+  /* Never called, the read notification is disabled.
+   * Refill is requested from getEs() instead.
+   */
+}
+
+/*--------------------------------------------------------------------*/
+void *InputHandlerOfFile::readFile(void *p_ext, void *p_dest,
+                                   const void *p_src, size_t size)
+{
+  InputHandlerOfFile *p_this = static_cast<InputHandlerOfFile *>(p_ext);
+  uint8_t *p_buf = static_cast<uint8_t *>(p_dest);
+  size_t   done  = 0;
+
+  /* p_src is not referred. The data comes from the file directly
+   * into the fifo area, so no intermediate buffer is needed.
+   */
+
+  while (done < size && p_this->m_read_result == 0)
+    {
+      ssize_t ret = read(p_this->m_fd, &p_buf[done], size - done);
+      if (ret > 0)
+        {
+          done += ret;
+        }
+      else if (ret == 0)
+        {
+          /* File was truncated while playing. */
+
+          break;
+        }
+      else if (errno != EINTR)
+        {
+          p_this->m_read_result = -errno;
+        }
+    }
+
+  /* The fifo region is already reserved. Fill the rest with zero
+   * and treat it as the end of file.
+   */
+
+  if (done < size)
+    {
+      memset(&p_buf[done], 0, size - done);
+      p_this->m_remain_size = 0;
+    }
+
+  return p_dest;
+}
+
+/*--------------------------------------------------------------------*/
+void *InputHandlerOfFile::readerEntry(void *p_arg)
+{
+  InputHandlerOfFile *p_this = static_cast<InputHandlerOfFile *>(p_arg);
+
+  for (; ; )
+    {
+      if (sem_wait(&p_this->m_refill_sem) != 0)
+        {
+          continue;
+        }
+
+      if (p_this->m_quit)
+        {
+          break;
+        }
+
+      p_this->m_refill_req = false;
+      p_this->fill();
+    }
+
+  return NULL;
+}
+
+/*--------------------------------------------------------------------*/
+uint32_t InputHandlerOfFile::calcReadSize(const AsInitPlayerParam& param)
+{
+  uint32_t bit_rate = m_bit_rate;
+
+  if (bit_rate == 0)
+    {
+      switch (param.codec_type)
+        {
+          case AS_CODECTYPE_WAV:
+            bit_rate = ((param.sampling_rate == AS_SAMPLINGRATE_AUTO) ?
+                        FILE_DEFAULT_FS : param.sampling_rate) *
+                       param.channel_number *
+                       BIT_TO_BYTE(param.bit_length) * 8;
+            break;
+          case AS_CODECTYPE_AAC:
+          case AS_CODECTYPE_MEDIA:
+            bit_rate = FILE_MAX_BITRATE_AAC;
+            break;
+          case AS_CODECTYPE_OPUS:
+            bit_rate = FILE_MAX_BITRATE_OPUS;
+            break;
+          case AS_CODECTYPE_MP3:
+          default:
+            bit_rate = FILE_MAX_BITRATE_MP3;
+            break;
+        }
+    }
+
+  uint32_t size = FILE_ALIGN_UP((uint64_t)bit_rate / 8 *
+                                CONFIG_AUDIOUTILS_PLAYER_FILE_READ_PERIOD /
+                                1000);
+  uint32_t max  = FILE_ALIGN_DOWN(FILE_FIFO_SIZE / 2);
+
+  if (size < FILE_READ_ALIGN)
+    {
+      size = FILE_READ_ALIGN;
+    }
+  if (size > max)
+    {
+      size = max;
+    }
+
+  return size;
+}
+
+/*--------------------------------------------------------------------*/
+void InputHandlerOfFile::fill()
+{
+  while (!m_eof && !m_quit)
+    {
+      /* Align the first read to the sector boundary so that the
+       * following reads do not straddle sectors.
+       */
+
+      off_t    pos  = lseek(m_fd, 0, SEEK_CUR);
+      uint32_t size = m_read_size - (pos & (FILE_READ_ALIGN - 1));
+
+      if (pos < 0)
+        {
+          m_read_result = -errno;
+          size          = 0;
+        }
+      else if ((off_t)size > m_remain_size)
+        {
+          size = m_remain_size;
+        }
+
+      if (size > 0)
+        {
+          if (CMN_SimpleFifoGetVacantSize(&m_fifo) < size)
+            {
+              break;
+            }
+
+          CMN_SimpleFifoOfferWithSpecificCopier(&m_fifo,
+                                                m_fifo_area,
+                                                size,
+                                                readFile,
+                                                this);
+          m_remain_size = (m_remain_size > (off_t)size) ?
+                          m_remain_size - size : 0;
+        }
+
+      if (m_read_result < 0 || m_remain_size <= 0)
+        {
+          m_eof = true;
+          if (m_end_callback)
+            {
+              m_end_callback(m_read_result);
+            }
+        }
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void InputHandlerOfFile::stopReader()
+{
+  if (m_reader_active)
+    {
+      m_quit = true;
+      sem_post(&m_refill_sem);
+      pthread_join(m_reader, NULL);
+      sem_destroy(&m_refill_sem);
+      m_reader_active = false;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void InputHandlerOfFile::release()
+{
+  stopReader();
+
+  if (m_fifo_area != NULL)
+    {
+      kmm_free(m_fifo_area);
+      m_fifo_area = NULL;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+bool InputHandlerOfFile::initialize(PlayerInHandle* p_handle)
+{
+  if (p_handle->p_file_device_handle == NULL ||
+      p_handle->p_file_device_handle->fd < 0)
+    {
+      return false;
+    }
+
+  m_fd           = p_handle->p_file_device_handle->fd;
+  m_bit_rate     = p_handle->p_file_device_handle->bit_rate;
+  m_end_callback = p_handle->p_file_device_handle->callback_function;
+
+  /* Es data is parsed by the RAM input with the internal fifo. */
+
+  AsPlayerInputDeviceHdlrForRAM ram_handler;
+  PlayerInHandle                ram_handle;
+
+  ram_handler.simple_fifo_handler         = &m_fifo;
+  ram_handler.callback_function           = readDone;
+  ram_handler.notification_threshold_size = 0;
+  ram_handle.p_ram_device_handle          = &ram_handler;
+
+  if (!InputHandlerOfRAM::initialize(&ram_handle))
+    {
+      return false;
+    }
+
+  disableReadNotification();
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+uint32_t InputHandlerOfFile::setParam(const AsInitPlayerParam& param)
+{
+  uint32_t rst = InputHandlerOfRAM::setParam(param);
+  if (rst != AS_ECODE_OK)
+    {
+      return rst;
+    }
+
+  m_read_size = calcReadSize(param);
+
+  return AS_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------*/
+uint32_t InputHandlerOfFile::start()
+{
+  struct stat st;
+  off_t       pos;
+
+  release();
+
+  if (m_read_size == 0 || fstat(m_fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+      (pos = lseek(m_fd, 0, SEEK_CUR)) < 0)
+    {
+      return AS_ECODE_COMMAND_PARAM_INPUT_HANDLER;
+    }
+
+  /* Make the fifo a multiple of the read size, so that the ring
+   * buffer wraps at a read boundary and each read stays one request
+   * when reading starts at a sector boundary.
+   */
+
+  uint32_t fifo_size = FILE_FIFO_SIZE / m_read_size * m_read_size;
+
+  m_fifo_area = static_cast<uint8_t *>(kmm_malloc(fifo_size));
+  if (m_fifo_area == NULL)
+    {
+      return AS_ECODE_CHECK_MEMORY_POOL_ERROR;
+    }
+
+  if (CMN_SimpleFifoInitialize(&m_fifo, m_fifo_area, fifo_size, NULL) != 0)
+    {
+      release();
+      return AS_ECODE_COMMAND_PARAM_INPUT_HANDLER;
+    }
+
+  m_remain_size = st.st_size - pos;
+  m_read_result = 0;
+  m_eof         = false;
+  m_quit        = false;
+  m_refill_req  = false;
+
+  /* Prefill here, the es source parses the head of es data on start. */
+
+  fill();
+
+  uint32_t rst = InputHandlerOfRAM::start();
+  if (rst != AS_ECODE_OK)
+    {
+      release();
+      return rst;
+    }
+
+  if (!m_eof)
+    {
+      pthread_attr_t     attr;
+      struct sched_param sch_param;
+
+      sem_init(&m_refill_sem, 0, 0);
+
+      pthread_attr_init(&attr);
+      pthread_attr_setstacksize(&attr,
+        CONFIG_AUDIOUTILS_PLAYER_FILE_READER_STACK_SIZE);
+      sch_param.sched_priority = CONFIG_AUDIOUTILS_PLAYER_FILE_READER_PRIORITY;
+      pthread_attr_setschedparam(&attr, &sch_param);
+
+      int ret = pthread_create(&m_reader, &attr, readerEntry, this);
+      pthread_attr_destroy(&attr);
+
+      if (ret != 0)
+        {
+          sem_destroy(&m_refill_sem);
+          InputHandlerOfRAM::stop();
+          release();
+          return AS_ECODE_COMMAND_PARAM_INPUT_HANDLER;
+        }
+
+      pthread_setname_np(m_reader, "player_file");
+      m_reader_active = true;
+    }
+
+  return AS_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------*/
+bool InputHandlerOfFile::getEs(void* p_es, uint32_t* es_byte_size)
+{
+  bool ret = InputHandlerOfRAM::getEs(p_es, es_byte_size);
+
+  /* Wake up the reader once a whole read size became vacant. */
+
+  if (m_reader_active && !m_eof && !m_refill_req &&
+      CMN_SimpleFifoGetVacantSize(&m_fifo) >= m_read_size)
+    {
+      m_refill_req = true;
+      sem_post(&m_refill_sem);
+    }
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------*/
+bool InputHandlerOfFile::stop()
+{
+  /* Stop the reader before the es source, the fifo is freed here. */
+
+  stopReader();
+  InputHandlerOfRAM::stop();
+  release();
+
+  return true;
+}
+#endif /* CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT */
+
 __WIEN2_END_NAMESPACE
@@ -58,6 +58,12 @@
 #ifdef CONFIG_AUDIOUTILS_PLAYER_CODEC_OPUS
 #  include "objects/stream_parser/ram_opus_data_source.h"
 #endif
+#ifdef CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT
+#  include <pthread.h>
+#  include <semaphore.h>
+#  include <sys/types.h>
+#  include "memutils/simple_fifo/CMN_SimpleFifo.h"
+#endif
 
 __WIEN2_BEGIN_NAMESPACE
 
@@ -84,6 +90,9 @@ public:
       union
       {
         AsPlayerInputDeviceHdlrForRAM* p_ram_device_handle;
+#ifdef CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT
+        AsPlayerInputDeviceHdlrForFile* p_file_device_handle;
+#endif
       };
     };
 
@@ -93,6 +102,16 @@ public:
   virtual bool getEs(void* p_es, uint32_t* es_byte_size) = 0;
   virtual bool stop() = 0;
 
+  /* Whether no more es data will come after getEs() fails. An empty
+   * SimpleFifo of the RAM input is not the end, since the application
+   * may still write to it.
+   */
+
+  virtual bool isEsEnd()
+    {
+      return false;
+    }
+
   uint32_t getSamplingRate()
     {
       return m_es_sampling_rate;
@@ -159,7 +178,8 @@ public:
     PlayerInputDeviceHandler(),
     m_wav_au_size(0),
     m_p_es_source_hdl(NULL),
-    m_notification_read_es_size(0)
+    m_notification_read_es_size(0),
+    m_read_notify(true)
     {
       m_codec_type = AudCodecLPCM;
     }
@@ -172,10 +192,21 @@ public:
   virtual bool getEs(void* p_es, uint32_t* es_byte_size);
   virtual bool stop();
 
+protected:
+  /* Stop calling the read done callback from getEs(),
+   * for a subclass which feeds the fifo by itself.
+   */
+
+  void disableReadNotification()
+    {
+      m_read_notify = false;
+    }
+
 private:
   uint32_t                m_wav_au_size;
   InputDataManagerObject *m_p_es_source_hdl;
   uint32_t                m_notification_read_es_size;
+  bool                    m_read_notify;
 
   AsPlayerInputDeviceHdlrForRAM m_in_device_handler;
 #ifdef CONFIG_AUDIOUTILS_PLAYER_CODEC_MP3
@@ -192,6 +223,74 @@ private:
 #endif
 };
 
+/*--------------------------------------------------------------------*/
+#ifdef CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT
+/* Reads es data from a file descriptor into an internal SimpleFifo
+ * and parses it with the RAM input es sources. A read-ahead task
+ * refills the fifo whenever getEs() leaves at least one read size
+ * of vacant space, so the player task never waits for the file system.
+ */
+
+class InputHandlerOfFile : public InputHandlerOfRAM
+{
+public:
+  InputHandlerOfFile():
+    InputHandlerOfRAM(),
+    m_fd(-1),
+    m_bit_rate(0),
+    m_end_callback(NULL),
+    m_fifo_area(NULL),
+    m_read_size(0),
+    m_remain_size(0),
+    m_read_result(0),
+    m_eof(false),
+    m_quit(false),
+    m_refill_req(false),
+    m_reader_active(false)
+    {}
+
+  ~InputHandlerOfFile() {}
+
+  virtual bool initialize(PlayerInHandle* p_handle);
+  virtual uint32_t setParam(const AsInitPlayerParam& param);
+  virtual uint32_t start();
+  virtual bool getEs(void* p_es, uint32_t* es_byte_size);
+  virtual bool stop();
+
+  virtual bool isEsEnd()
+    {
+      return m_eof;
+    }
+
+private:
+  uint32_t calcReadSize(const AsInitPlayerParam& param);
+  void     fill();
+  void     stopReader();
+  void     release();
+
+  static void  readDone(uint32_t size);
+  static void *readFile(void *p_ext, void *p_dest,
+                        const void *p_src, size_t size);
+  static void *readerEntry(void *p_arg);
+
+  int                               m_fd;
+  uint32_t                          m_bit_rate;
+  AudioFileInputEndCallbackFunction m_end_callback;
+
+  CMN_SimpleFifoHandle              m_fifo;
+  uint8_t                          *m_fifo_area;
+  uint32_t                          m_read_size;
+  off_t                             m_remain_size;
+  int                               m_read_result;
+  volatile bool                     m_eof;
+  volatile bool                     m_quit;
+  volatile bool                     m_refill_req;
+  bool                              m_reader_active;
+  sem_t                             m_refill_sem;
+  pthread_t                         m_reader;
+};
+#endif /* CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT */
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
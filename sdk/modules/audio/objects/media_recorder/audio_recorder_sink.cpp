@@ -37,6 +37,12 @@
  * Included Files
  ****************************************************************************/
 
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+#  include <errno.h>
+#  include <string.h>
+#  include <unistd.h>
+#  include <nuttx/kmalloc.h>
+#endif
 #include "memutils/simple_fifo/CMN_SimpleFifo.h"
 #include "memutils/memory_manager/MemHandle.h"
 #include "audio_recorder_sink.h"
@@ -48,6 +54,11 @@ __WIEN2_BEGIN_NAMESPACE
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+#define FILE_BLOCK_SIZE \
+  (CONFIG_AUDIOUTILS_RECORDER_FILE_BLOCK_SIZE & ~(512 - 1))
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -68,15 +79,383 @@ __WIEN2_BEGIN_NAMESPACE
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+void *AudioRecorderSink::writerEntry(void *p_arg)
+{
+  AudioRecorderSink *p_this = static_cast<AudioRecorderSink *>(p_arg);
+
+  for (; ; )
+    {
+      if (sem_wait(&p_this->m_write_sem) != 0)
+        {
+          continue;
+        }
+
+      /* Write queued blocks in order. */
+
+      while (p_this->m_busy[p_this->m_write_idx])
+        {
+          uint8_t  idx  = p_this->m_write_idx;
+          uint8_t *p_buf = p_this->m_block[idx];
+          uint32_t len  = p_this->m_block_len[idx];
+          uint32_t done = p_this->m_block_top[idx];
+
+          while (done < len && p_this->m_write_result == 0)
+            {
+              ssize_t ret = ::write(p_this->m_file_hdlr.fd,
+                                    &p_buf[done],
+                                    len - done);
+              if (ret > 0)
+                {
+                  done += ret;
+                }
+              else if (ret == 0)
+                {
+                  p_this->m_write_result = -ENOSPC;
+                }
+              else if (errno != EINTR)
+                {
+                  p_this->m_write_result = -errno;
+                }
+            }
+
+          p_this->m_write_idx = idx ^ 1;
+          p_this->m_busy[idx] = false;
+        }
+
+      if (p_this->m_quit)
+        {
+          break;
+        }
+    }
+
+  return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+void AudioRecorderSink::queueBlock(void)
+{
+  m_block_top[m_fill_idx] = m_fill_top;
+  m_block_len[m_fill_idx] = m_fill_size;
+  m_busy[m_fill_idx]      = true;
+  sem_post(&m_write_sem);
+
+  m_fill_idx ^= 1;
+  m_fill_top  = 0;
+  m_fill_size = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+void AudioRecorderSink::stopWriter(void)
+{
+  if (m_writer_active)
+    {
+      m_quit = true;
+      sem_post(&m_write_sem);
+      pthread_join(m_writer, NULL);
+      sem_destroy(&m_write_sem);
+      m_writer_active = false;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+void AudioRecorderSink::releaseBlock(void)
+{
+  stopWriter();
+
+  if (m_block[0] != NULL)
+    {
+      kmm_free(m_block[0]);
+      m_block[0] = NULL;
+      m_block[1] = NULL;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+bool AudioRecorderSink::writeFile(const uint8_t *p_data, uint32_t size)
+{
+  /* Once a write to the file fails, later data is not appended. */
+
+  if (m_write_result != 0)
+    {
+      MEDIA_RECORDER_WARN(AS_ATTENTION_SUB_CODE_RESOURCE_ERROR);
+      return false;
+    }
+
+  /* Check the room for the whole data before copying any of it.
+   * The block being filled, or the next one, may still be written
+   * by the writer task when the file system is slower than the encoder.
+   */
+
+  uint8_t  next_idx = m_fill_idx ^ 1;
+  uint32_t room     = 0;
+
+  if (!m_busy[m_fill_idx])
+    {
+      room = FILE_BLOCK_SIZE - m_fill_size;
+      if (!m_busy[next_idx])
+        {
+          room += FILE_BLOCK_SIZE;
+        }
+    }
+
+  /* Drop the whole data, so that frames (or LPCM samples) are not cut.
+   * Recording resumes with later data when the writer task has freed
+   * a block.
+   */
+
+  if (room < size)
+    {
+      m_overflow = true;
+      MEDIA_RECORDER_WARN(AS_ATTENTION_SUB_CODE_SIMPLE_FIFO_OVERFLOW);
+      return false;
+    }
+
+  while (size > 0)
+    {
+      uint32_t len = FILE_BLOCK_SIZE - m_fill_size;
+      if (len > size)
+        {
+          len = size;
+        }
+
+      memcpy(&m_block[m_fill_idx][m_fill_size], p_data, len);
+      m_fill_size += len;
+      m_data_size += len;
+      p_data      += len;
+      size        -= len;
+
+      if (m_fill_size == FILE_BLOCK_SIZE)
+        {
+          queueBlock();
+        }
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+bool AudioRecorderSink::finalizeFile(void)
+{
+  if (m_block[0] == NULL)
+    {
+      return true;
+    }
+
+  /* Write the last partial block and wait for the writer task. */
+
+  if (m_fill_size > 0 && !m_busy[m_fill_idx])
+    {
+      queueBlock();
+    }
+
+  stopWriter();
+
+  bool  result  = (m_write_result == 0);
+  off_t end_pos = m_start_pos + m_data_size;
+
+  if (m_wav_enable)
+    {
+      WAVHEADER header;
+
+      end_pos += sizeof(WAVHEADER);
+
+      m_wav_format.getHeader(&header, m_data_size);
+      if (lseek(m_file_hdlr.fd, m_start_pos, SEEK_SET) < 0 ||
+          ::write(m_file_hdlr.fd, &header, sizeof(WAVHEADER)) !=
+            static_cast<ssize_t>(sizeof(WAVHEADER)))
+        {
+          result = false;
+        }
+    }
+
+  /* Drop the area allocated at start but not recorded. */
+
+  if (m_file_hdlr.prealloc_size > 0 &&
+      ftruncate(m_file_hdlr.fd, end_pos) != 0)
+    {
+      result = false;
+    }
+
+  lseek(m_file_hdlr.fd, end_pos, SEEK_SET);
+
+  releaseBlock();
+
+  if (!result)
+    {
+      MEDIA_RECORDER_WARN(AS_ATTENTION_SUB_CODE_RESOURCE_ERROR);
+    }
+  else if (m_overflow)
+    {
+      /* The file is complete, but some data was dropped. */
+
+      MEDIA_RECORDER_WARN(AS_ATTENTION_SUB_CODE_SIMPLE_FIFO_OVERFLOW);
+    }
+
+  return result;
+}
+#endif /* CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT */
+
+/*--------------------------------------------------------------------------*/
 bool AudioRecorderSink::init(const InitAudioRecSinkParam_s &param)
 {
+  m_output_device = param.output_device;
+
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+  if (m_output_device == AS_SETRECDR_STS_OUTPUTDEVICE_FILE)
+    {
+      if (param.init_audio_file_sink.output_device_hdlr.fd < 0)
+        {
+          return false;
+        }
+
+      releaseBlock();
+
+      m_file_hdlr  = param.init_audio_file_sink.output_device_hdlr;
+      m_wav_enable = false;
+      return true;
+    }
+#endif
+
   m_output_device_hdlr = param.init_audio_ram_sink.output_device_hdlr;
   return true;
 }
 
+/*--------------------------------------------------------------------------*/
+bool AudioRecorderSink::setFormat(const AsInitRecorderParam &param)
+{
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+  if (m_output_device == AS_SETRECDR_STS_OUTPUTDEVICE_FILE)
+    {
+      m_wav_enable = (m_file_hdlr.wav_header &&
+                      param.codec_type == AS_CODECTYPE_LPCM);
+      if (m_wav_enable)
+        {
+          return m_wav_format.init(FORMAT_ID_PCM,
+                                   param.channel_number,
+                                   param.sampling_rate,
+                                   param.bit_length);
+        }
+    }
+#endif
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t AudioRecorderSink::start(void)
+{
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+  if (m_output_device == AS_SETRECDR_STS_OUTPUTDEVICE_FILE)
+    {
+      releaseBlock();
+
+      m_start_pos = lseek(m_file_hdlr.fd, 0, SEEK_CUR);
+      if (m_start_pos < 0)
+        {
+          return AS_ECODE_COMMAND_PARAM_OUTPUT_HANDLER;
+        }
+
+      /* Allocate clusters in advance, so that block writes do not
+       * search the free cluster while recording. Recording works
+       * without it, then the file is not truncated on finalize.
+       */
+
+      if (m_file_hdlr.prealloc_size > 0 &&
+          ftruncate(m_file_hdlr.fd,
+                    m_start_pos + m_file_hdlr.prealloc_size) != 0)
+        {
+          MEDIA_RECORDER_WARN(AS_ATTENTION_SUB_CODE_RESOURCE_ERROR);
+          m_file_hdlr.prealloc_size = 0;
+        }
+
+      m_block[0] = static_cast<uint8_t *>(kmm_malloc(FILE_BLOCK_SIZE * 2));
+      if (m_block[0] == NULL)
+        {
+          MEDIA_RECORDER_ERR(AS_ATTENTION_SUB_CODE_ALLOC_HEAP_MEMORY);
+          return AS_ECODE_CHECK_MEMORY_POOL_ERROR;
+        }
+      m_block[1] = m_block[0] + FILE_BLOCK_SIZE;
+
+      m_busy[0]      = false;
+      m_busy[1]      = false;
+      m_fill_idx     = 0;
+      m_write_idx    = 0;
+      m_write_result = 0;
+      m_overflow     = false;
+      m_data_size    = 0;
+      m_quit         = false;
+
+      /* Header is written here and rewritten with the sizes
+       * on finalize.
+       */
+
+      off_t data_pos = m_start_pos;
+
+      if (m_wav_enable)
+        {
+          WAVHEADER header;
+          m_wav_format.getHeader(&header, 0);
+          if (::write(m_file_hdlr.fd, &header, sizeof(WAVHEADER)) !=
+                static_cast<ssize_t>(sizeof(WAVHEADER)))
+            {
+              releaseBlock();
+              return AS_ECODE_COMMAND_PARAM_OUTPUT_HANDLER;
+            }
+
+          data_pos += sizeof(WAVHEADER);
+        }
+
+      /* Blocks are aligned to the file offset, not to the start
+       * position. The first block is filled from the offset of the
+       * data in the block.
+       */
+
+      m_fill_top  = data_pos % FILE_BLOCK_SIZE;
+      m_fill_size = m_fill_top;
+
+      pthread_attr_t     attr;
+      struct sched_param sch_param;
+
+      sem_init(&m_write_sem, 0, 0);
+
+      pthread_attr_init(&attr);
+      pthread_attr_setstacksize(&attr,
+        CONFIG_AUDIOUTILS_RECORDER_FILE_WRITER_STACK_SIZE);
+      sch_param.sched_priority =
+        CONFIG_AUDIOUTILS_RECORDER_FILE_WRITER_PRIORITY;
+      pthread_attr_setschedparam(&attr, &sch_param);
+
+      int ret = pthread_create(&m_writer, &attr, writerEntry, this);
+      pthread_attr_destroy(&attr);
+
+      if (ret != 0)
+        {
+          MEDIA_RECORDER_ERR(AS_ATTENTION_SUB_CODE_TASK_CREATE_ERROR);
+          sem_destroy(&m_write_sem);
+          releaseBlock();
+          return AS_ECODE_COMMAND_PARAM_OUTPUT_HANDLER;
+        }
+
+      pthread_setname_np(m_writer, "recorder_file");
+      m_writer_active = true;
+    }
+#endif
+
+  return AS_ECODE_OK;
+}
+
 /*--------------------------------------------------------------------------*/
 bool AudioRecorderSink::write(const AudioRecSinkData_s &param)
 {
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+  if (m_output_device == AS_SETRECDR_STS_OUTPUTDEVICE_FILE)
+    {
+      return writeFile(static_cast<const uint8_t *>(param.mh.getVa()),
+                       param.byte_size);
+    }
+#endif
+
   if (param.byte_size > 0) {
     if (CMN_SimpleFifoGetVacantSize(static_cast<CMN_SimpleFifoHandle *>
         (m_output_device_hdlr.simple_fifo_handler)) < param.byte_size)
@@ -101,6 +480,13 @@ bool AudioRecorderSink::write(const AudioRecSinkData_s &param)
 /*--------------------------------------------------------------------------*/
 bool AudioRecorderSink::finalize(void)
 {
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+  if (m_output_device == AS_SETRECDR_STS_OUTPUTDEVICE_FILE)
+    {
+      return finalizeFile();
+    }
+#endif
+
   return true;
 }
 
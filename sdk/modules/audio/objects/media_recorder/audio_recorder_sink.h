@@ -42,6 +42,12 @@
 
 #include "wien2_common_defs.h"
 #include "wien2_internal_packet.h"
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+#  include <pthread.h>
+#  include <semaphore.h>
+#  include <sys/types.h>
+#  include "audio/utilities/wav_containerformat.h"
+#endif
 
 __WIEN2_BEGIN_NAMESPACE
 
@@ -65,12 +71,28 @@ public:
   AsRecorderOutputDeviceHdlr output_device_hdlr;
 };
 
+/* Parameters for initializing sinker of voice recorder
+ * that writes output data to a file.
+ */
+
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+struct InitAudioRecFileSinkParam_s
+{
+public:
+  AsRecorderOutputDeviceHdlrForFile output_device_hdlr;
+};
+#endif
+
 /* Parameters for initializing sinker of voice recorder. */
 
 struct InitAudioRecSinkParam_s
 {
 public:
+  uint8_t output_device;
   InitAudioRecRamSinkParam_s init_audio_ram_sink;
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+  InitAudioRecFileSinkParam_s init_audio_file_sink;
+#endif
 };
 
 /* Data to the sinker of voice recorder. */
@@ -85,16 +107,63 @@ public:
 class AudioRecorderSink
 {
 public:
-  AudioRecorderSink() {}
+  AudioRecorderSink()
+    {
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+      m_block[0]      = NULL;
+      m_block[1]      = NULL;
+      m_writer_active = false;
+#endif
+    }
 
   ~AudioRecorderSink() {}
 
   bool init(const InitAudioRecSinkParam_s &param);
+  bool setFormat(const AsInitRecorderParam &param);
+  uint32_t start(void);
   bool write(const AudioRecSinkData_s &param);
   bool finalize(void);
 
 private:
+  uint8_t                    m_output_device;
   AsRecorderOutputDeviceHdlr m_output_device_hdlr;
+
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+  bool writeFile(const uint8_t *p_data, uint32_t size);
+  bool finalizeFile(void);
+  void queueBlock(void);
+  void stopWriter(void);
+  void releaseBlock(void);
+
+  static void *writerEntry(void *p_arg);
+
+  AsRecorderOutputDeviceHdlrForFile m_file_hdlr;
+  WavContainerFormat                m_wav_format;
+  bool                              m_wav_enable;
+  off_t                             m_start_pos;
+  uint32_t                          m_data_size;
+
+  /* Double buffer. The recorder task fills one block while the
+   * writer task writes the other one. A block corresponds to a block
+   * aligned area of the file, and the data of it is from m_block_top
+   * to m_block_len. Only the first one starts at the middle.
+   */
+
+  uint8_t                          *m_block[2];
+  uint32_t                          m_block_top[2];
+  uint32_t                          m_block_len[2];
+  volatile bool                     m_busy[2];
+  uint8_t                           m_fill_idx;
+  uint32_t                          m_fill_top;
+  uint32_t                          m_fill_size;
+  uint8_t                           m_write_idx;
+  volatile int                      m_write_result;
+  bool                              m_overflow;   /* Some data dropped. */
+  volatile bool                     m_quit;
+  bool                              m_writer_active;
+  sem_t                             m_write_sem;
+  pthread_t                         m_writer;
+#endif
 };
 
 /****************************************************************************
@@ -512,6 +512,16 @@ void MediaRecorderObjectTask::activate(MsgPacket *msg)
           act.param.output_device_handler;
         break;
 
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+      case AS_SETRECDR_STS_OUTPUTDEVICE_FILE:
+        if (act.param.file_handler == NULL)
+          {
+            reply(AsRecorderEventAct, msg->getType(), AS_ECODE_COMMAND_PARAM_OUTPUT_HANDLER);
+            return;
+          }
+        break;
+#endif
+
       default:
         MEDIA_RECORDER_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
         reply(AsRecorderEventAct, msg->getType(), AS_ECODE_COMMAND_PARAM_OUTPUT_DEVICE);
@@ -521,13 +531,25 @@ void MediaRecorderObjectTask::activate(MsgPacket *msg)
   /* Init Sink */
 
   InitAudioRecSinkParam_s init_sink;
+  init_sink.output_device = m_output_device;
   if (m_output_device == AS_SETRECDR_STS_OUTPUTDEVICE_RAM)
     {
       init_sink.init_audio_ram_sink.output_device_hdlr =
         *m_p_output_device_handler;
     }
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+  else if (m_output_device == AS_SETRECDR_STS_OUTPUTDEVICE_FILE)
+    {
+      init_sink.init_audio_file_sink.output_device_hdlr =
+        *act.param.file_handler;
+    }
+#endif
 
-  m_rec_sink.init(init_sink);
+  if (!m_rec_sink.init(init_sink))
+    {
+      reply(AsRecorderEventAct, msg->getType(), AS_ECODE_COMMAND_PARAM_OUTPUT_HANDLER);
+      return;
+    }
 
   /* Transit to Ready */
 
@@ -660,6 +682,11 @@ void MediaRecorderObjectTask::init(MsgPacket *msg)
   rst = initEnc(&cmd.init_param);
   m_output_buf_mh_que.clear();
 
+  if (rst == AS_ECODE_OK && !m_rec_sink.setFormat(cmd.init_param))
+    {
+      rst = AS_ECODE_COMMAND_PARAM_OUTPUT_HANDLER;
+    }
+
   /* Reply */
 
   reply(AsRecorderEventInit, msg->getType(), rst);
@@ -749,6 +776,15 @@ void MediaRecorderObjectTask::startOnReady(MsgPacket *msg)
 {
   msg->moveParam<RecorderCommand>();
 
+  /* Prepare sink */
+
+  uint32_t rst = m_rec_sink.start();
+  if (rst != AS_ECODE_OK)
+    {
+      reply(AsRecorderEventStart, msg->getType(), rst);
+      return;
+    }
+
   /* Transit to Active */
 
   m_state = RecorderStateActive;
@@ -1556,6 +1592,12 @@ uint32_t MediaRecorderObjectTask::isValidActivateParam(
         m_output_device = AS_SETRECDR_STS_OUTPUTDEVICE_RAM;
         break;
 
+#ifdef CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT
+      case AS_SETRECDR_STS_OUTPUTDEVICE_FILE:
+        m_output_device = AS_SETRECDR_STS_OUTPUTDEVICE_FILE;
+        break;
+#endif
+
       default:
         MEDIA_RECORDER_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
         return AS_ECODE_COMMAND_PARAM_OUTPUT_DEVICE;
@@ -109,11 +109,14 @@ int OutputMixObjectTask::getHandle(MsgPacket* msg)
       case MSG_AUD_MIX_CMD_CLKRECOVERY:
       case MSG_AUD_MIX_CMD_INITMPP:
       case MSG_AUD_MIX_CMD_SETMPP:
+      case MSG_AUD_MIX_CMD_ADPCLKRCV:
         handle = msg->peekParam<OutputMixerCommand>().handle;
         break;
 
       case MSG_AUD_MIX_CMD_DATA:
-        handle = msg->peekParam<AsPcmDataParam>().identifier;
+        handle = (msg->isHandleParam()) ?
+                   msg->peekParamByHandle<AsPcmDataParam>().identifier :
+                   msg->peekParam<AsPcmDataParam>().identifier;
         break;
 
       default:
@@ -477,6 +480,33 @@ bool AS_FrameTermFineControlOutputMixer(uint8_t handle, FAR AsFrameTermFineContr
   return true;
 }
 
+/*--------------------------------------------------------------------------*/
+bool AS_AdaptiveClockRecoveryOutputMixer(uint8_t handle, FAR AsAdaptiveClockRecovery *adpclkparam)
+{
+  /* Parameter check */
+
+  if (adpclkparam == NULL)
+    {
+      return false;
+    }
+
+  /* Set adaptive clock recovery */
+
+  OutputMixerCommand cmd;
+
+  cmd.handle       = handle;
+  cmd.adpclk_param = *adpclkparam;
+
+  err_t er = MsgLib::send<OutputMixerCommand>(s_msgq_id.mixer,
+                                              MsgPriNormal,
+                                              MSG_AUD_MIX_CMD_ADPCLKRCV,
+                                              s_msgq_id.mng,
+                                              cmd);
+  F_ASSERT(er == ERR_OK);
+
+  return true;
+}
+
 /*--------------------------------------------------------------------------*/
 bool AS_InitPostprocOutputMixer(uint8_t handle, FAR AsInitPostProc *initppparam)
 {
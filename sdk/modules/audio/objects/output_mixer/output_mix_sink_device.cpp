@@ -57,6 +57,13 @@ __WIEN2_BEGIN_NAMESPACE
 #define DMA_MIN_SAMPLE               240  /* DMA minimum Samples. */
 #define DMA_MAX_SAMPLE               1024 /* DMA maximum Samples. */
 
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV
+#define ADPCLK_INTEGRAL_SAMPLE       48000   /* Time base of integral gain. */
+#define ADPCLK_PPM                   1000000 /* One sample in ppm. */
+#define ADPCLK_AVERAGE \
+  CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV_AVERAGE
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -226,6 +233,15 @@ OutputMixToHPI2S::MsgProc OutputMixToHPI2S::MsgProcTbl[AUD_MIX_MSG_NUM][StateNum
     &OutputMixToHPI2S::set_postproc,          /*  Stopping               */
     &OutputMixToHPI2S::set_postproc,          /*  Underflow              */
   },
+
+  /* Message type: ADAPTIVE CLKRECOVERY */
+  {                                           /* OutputMixToHPI2S State: */
+    &OutputMixToHPI2S::illegal,               /*  Booted                 */
+    &OutputMixToHPI2S::adaptive_clock_recovery, /*  Ready                */
+    &OutputMixToHPI2S::adaptive_clock_recovery, /*  Active               */
+    &OutputMixToHPI2S::adaptive_clock_recovery, /*  Stopping             */
+    &OutputMixToHPI2S::adaptive_clock_recovery, /*  Underflow            */
+  },
 };
 
 /*--------------------------------------------------------------------------*/
@@ -264,6 +280,19 @@ void OutputMixToHPI2S::reply(MsgQueId requester_dtq,
     }
 }
 
+/*--------------------------------------------------------------------------*/
+AsPcmDataParam OutputMixToHPI2S::moveInputData(MsgPacket* msg)
+{
+  /* Pcm data parameter is copied, or sent by reference to a segment. */
+
+  if (msg->isHandleParam())
+    {
+      return msg->moveParamByHandle<AsPcmDataParam>();
+    }
+
+  return msg->moveParam<AsPcmDataParam>();
+}
+
 /*--------------------------------------------------------------------------*/
 void OutputMixToHPI2S::illegal(MsgPacket* msg)
 {
@@ -282,6 +311,7 @@ void OutputMixToHPI2S::illegal(MsgPacket* msg)
       case MSG_AUD_MIX_CMD_CLKRECOVERY:
       case MSG_AUD_MIX_CMD_INITMPP:
       case MSG_AUD_MIX_CMD_SETMPP:
+      case MSG_AUD_MIX_CMD_ADPCLKRCV:
         msg->moveParam<OutputMixerCommand>();
         break;
 
@@ -290,7 +320,7 @@ void OutputMixToHPI2S::illegal(MsgPacket* msg)
         break;
 
       case MSG_AUD_MIX_CMD_DATA:
-        msg->moveParam<AsPcmDataParam>();
+        moveInputData(msg);
 
       default:
         break;
@@ -417,8 +447,7 @@ void OutputMixToHPI2S::deact(MsgPacket* msg)
 /*--------------------------------------------------------------------------*/
 void OutputMixToHPI2S::input_data_on_ready(MsgPacket* msg)
 {
-  AsPcmDataParam input =
-    msg->moveParam<AsPcmDataParam>();
+  AsPcmDataParam input = moveInputData(msg);
 
   /* Exec postfilter */
 
@@ -438,19 +467,25 @@ void OutputMixToHPI2S::input_data_on_ready(MsgPacket* msg)
                         &render_done_callback,
                         &render_err_callback,
                         static_cast<void*>(this),
-                        input.bit_length))
+                        input.bit_length,
+                        0))
     {
       return;
     }
 
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV
+  /* Take the target level again at the start of rendering. */
+
+  m_adpclk_locked = false;
+#endif
+
   m_state = Active;
 }
 
 /*--------------------------------------------------------------------------*/
 void OutputMixToHPI2S::input_data_on_active(MsgPacket* msg)
 {
-  AsPcmDataParam input =
-    msg->moveParam<AsPcmDataParam>();
+  AsPcmDataParam input = moveInputData(msg);
 
   /* Exec postfilter */
 
@@ -508,10 +543,23 @@ void OutputMixToHPI2S::postdone_on_active(MsgPacket* msg)
 
   if (check_sample(&cmplt.output) && cmplt.result)
     {
+      int8_t adjust;
+
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV
+      if (m_adpclk.enable)
+        {
+          adjust = get_adaptive_adjustment(cmplt.output);
+        }
+      else
+#endif
+        {
+          adjust = get_period_adjustment();
+        }
+
       send_renderer(m_render_comp_handler,
                     cmplt.output.mh.getPa(),
                     cmplt.output.size,
-                    get_period_adjustment(),
+                    adjust,
                     cmplt.output.is_valid,
                     cmplt.output.bit_length);
 
@@ -546,8 +594,7 @@ void OutputMixToHPI2S::postdone_on_stopping(MsgPacket* msg)
 /*--------------------------------------------------------------------------*/
 void OutputMixToHPI2S::input_data_on_under(MsgPacket* msg)
 {
-  AsPcmDataParam input =
-    msg->moveParam<AsPcmDataParam>();
+  AsPcmDataParam input = moveInputData(msg);
 
   /* If end-data, publish render stop */
 
@@ -687,6 +734,136 @@ void OutputMixToHPI2S::clock_recovery(MsgPacket* msg)
   return;
 }
 
+/*--------------------------------------------------------------------------*/
+void OutputMixToHPI2S::adaptive_clock_recovery(MsgPacket* msg)
+{
+  OutputMixerCommand cmd =
+    msg->moveParam<OutputMixerCommand>();
+
+  AsOutputMixDoneParam done_param;
+
+  done_param.handle    = cmd.handle;
+  done_param.done_type = OutputMixSetAdpClkRcvDone;
+
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV
+  OUTPUT_MIX_DBG("ADAPTIVE CLOCK RECOVERY: enable %d, target %d, band %d\n",
+                 cmd.adpclk_param.enable,
+                 cmd.adpclk_param.target_level,
+                 cmd.adpclk_param.band);
+
+  /* Check Paramete. */
+
+  if (cmd.adpclk_param.enable &&
+      ((cmd.adpclk_param.simple_fifo_handler == NULL) ||
+       (cmd.adpclk_param.band == 0)))
+    {
+      OUTPUT_MIX_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+      done_param.result = false;
+    }
+  else
+    {
+      m_adpclk        = cmd.adpclk_param;
+      m_adpclk_locked = false;
+
+      done_param.result = true;
+    }
+#else
+  done_param.result = false;
+#endif
+
+  reply(m_requester_dtq, MSG_AUD_MIX_CMD_ADPCLKRCV, &done_param);
+}
+
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV
+/*--------------------------------------------------------------------------*/
+int8_t OutputMixToHPI2S::get_adaptive_adjustment(const AsPcmDataParam& data)
+{
+  uint32_t byte_size_per_sample = ((data.bit_length == AS_BITLENGTH_16) ?
+                                   BYTE_SIZE_PER_SAMPLE :
+                                   BYTE_SIZE_PER_SAMPLE_HIGHRES);
+  uint32_t sample_num = data.size / byte_size_per_sample;
+  uint32_t level      = CMN_SimpleFifoGetOccupiedSize(
+    static_cast<CMN_SimpleFifoHandle *>(m_adpclk.simple_fifo_handler));
+
+  if (!m_adpclk_locked)
+    {
+      m_adpclk_target   = (m_adpclk.target_level != 0) ?
+                          m_adpclk.target_level : level;
+      m_adpclk_average  = level << ADPCLK_AVERAGE;
+      m_adpclk_integral = 0;
+      m_adpclk_phase    = 0;
+      m_adpclk_locked   = true;
+    }
+
+  /* Average the level, source writes in bursts. */
+
+  m_adpclk_average = m_adpclk_average - (m_adpclk_average >> ADPCLK_AVERAGE)
+                     + level;
+
+  int64_t band    = m_adpclk.band;
+  int64_t max_ppm = m_adpclk.max_ppm;
+  int64_t error   = (int64_t)(m_adpclk_average >> ADPCLK_AVERAGE) -
+                    (int64_t)m_adpclk_target;
+  int64_t ppm;
+
+  /* PI control of output period. Positive correction means that
+   * the source is faster than output, shorten the output period.
+   */
+
+  if (error > band)
+    {
+      ppm = max_ppm;
+    }
+  else if (error < -band)
+    {
+      ppm = -max_ppm;
+    }
+  else
+    {
+      int64_t limit = max_ppm * band * ADPCLK_INTEGRAL_SAMPLE;
+
+      m_adpclk_integral +=
+        CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV_KI * error * sample_num;
+
+      if (m_adpclk_integral > limit)
+        {
+          m_adpclk_integral = limit;
+        }
+      else if (m_adpclk_integral < -limit)
+        {
+          m_adpclk_integral = -limit;
+        }
+
+      ppm = (CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV_KP * error +
+             m_adpclk_integral / ADPCLK_INTEGRAL_SAMPLE) / band;
+
+      ppm = (ppm > max_ppm) ? max_ppm : ((ppm < -max_ppm) ? -max_ppm : ppm);
+    }
+
+  /* Accumulate correction as fraction of sample, and remove or insert
+   * one sample when it reaches a whole sample. At most one sample per
+   * period can be adjusted.
+   */
+
+  m_adpclk_phase += ppm * sample_num;
+
+  if (m_adpclk_phase >= ADPCLK_PPM)
+    {
+      m_adpclk_phase = (m_adpclk_phase >= 2 * ADPCLK_PPM) ?
+                       0 : m_adpclk_phase - ADPCLK_PPM;
+      return OutputMixAdvance;
+    }
+  else if (m_adpclk_phase <= -ADPCLK_PPM)
+    {
+      m_adpclk_phase = (m_adpclk_phase <= -2 * ADPCLK_PPM) ?
+                       0 : m_adpclk_phase + ADPCLK_PPM;
+      return OutputMixDelay;
+    }
+
+  return OutputMixNoAdjust;
+}
+#endif /* CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV */
+
 /*--------------------------------------------------------------------------*/
 int8_t OutputMixToHPI2S::get_period_adjustment(void)
 {
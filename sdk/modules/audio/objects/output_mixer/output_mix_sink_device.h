@@ -101,7 +101,12 @@ public:
     m_callback(NULL),
     m_adjust_direction(OutputMixNoAdjust),
     m_adjustment_times(0)
-    {}
+    {
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV
+      m_adpclk.enable = 0;
+      m_adpclk_locked = false;
+#endif
+    }
 
     MsgQueId m_self_dtq, m_requester_dtq, m_apu_dtq;
     MemMgrLite::PoolId m_apu_pool_id;
@@ -160,6 +165,15 @@ private:
   int8_t m_adjust_direction;
   int32_t m_adjustment_times;
 
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV
+  AsAdaptiveClockRecovery m_adpclk;
+  bool     m_adpclk_locked;
+  uint32_t m_adpclk_target;
+  uint32_t m_adpclk_average;  /* Fill level scaled by averaging shift. */
+  int64_t  m_adpclk_integral;
+  int64_t  m_adpclk_phase;    /* Fraction of sample in ppm. */
+#endif
+
   uint32_t m_max_pcm_buff_size;
   uint32_t m_apucmd_pcm_buff_size;
 
@@ -167,6 +181,8 @@ private:
              MsgType msg_type,
              AsOutputMixDoneParam *done_param);
 
+  AsPcmDataParam moveInputData(MsgPacket *msg);
+
   void illegal(MsgPacket *msg);
   void act(MsgPacket *msg);
   void deact(MsgPacket *msg);
@@ -183,6 +199,7 @@ private:
   void done_on_stopping(MsgPacket *msg);
 
   void clock_recovery(MsgPacket *msg);
+  void adaptive_clock_recovery(MsgPacket *msg);
 
   void init_postproc(MsgPacket* msg);
   void set_postproc(MsgPacket* msg);
@@ -190,6 +207,9 @@ private:
   void parseOutputMixRst(MsgPacket *msg);
 
   int8_t get_period_adjustment(void);
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV
+  int8_t get_adaptive_adjustment(const AsPcmDataParam& data);
+#endif
   bool checkMemPool(void);
 };
 
@@ -52,6 +52,9 @@ static PoolId   s_i2s_in_pool_id;
 static PoolId   s_hp_out_pool_id;
 static PoolId   s_i2s_out_pool_id;
 static PoolId   s_mfe_out_pool_id;
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+static PoolId   s_postproc_pool_id;
+#endif
 static pid_t    s_effector_pid = -1;
 /* TODO: Hide to Class */
 
@@ -59,8 +62,18 @@ SoundEffectObject* s_effec_obj = NULL;
 
 #define DBG_MODULE DBG_MODULE_AS
 
-/* TODO: Is it better to be configurable ? */
+/* In low latency mode, capture/render period and processing block
+ * size is configured by Kconfig, and the DMA of the effector accepts
+ * transfers of one period. Other DMA users keep the default minimum.
+ */
+
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+#define MAX_CAPTURE_SAMPLE_NUM  (CONFIG_AUDIOUTILS_SOUND_EFFECTOR_PERIOD_SAMPLE)
+#define DMA_MIN_SAMPLE_NUM      (CONFIG_AUDIOUTILS_SOUND_EFFECTOR_PERIOD_SAMPLE)
+#else
 #define MAX_CAPTURE_SAMPLE_NUM  (240)
+#define DMA_MIN_SAMPLE_NUM      (0) /* Default of the DMAC */
+#endif
 
 /* TODO: Now 16bit fixed. It have to be configurable. */
 #define AC_IN_BYTE_LEN  (2)
@@ -128,6 +141,9 @@ bool AS_CreateEffector(FAR AsCreateEffectorParam_t *param, AudioAttentionCb attc
   s_hp_out_pool_id  = param->pool_id.sphp_out;
   s_i2s_out_pool_id = param->pool_id.i2s_out;
   s_mfe_out_pool_id = param->pool_id.mfe_out;
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+  s_postproc_pool_id = param->pool_id.postproc_dsp;
+#endif
 
   s_effector_pid = task_create("SEFFECT_OBJ",
                                150,
@@ -168,6 +184,64 @@ bool AS_DeleteEffector(void)
   return true;
 }
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+/*--------------------------------------------------------------------*/
+bool AS_InitPostprocEffector(FAR AsInitEffectorPostProc *initppparam)
+{
+  /* Parameter check */
+
+  if (initppparam == NULL)
+    {
+      return false;
+    }
+
+  /* Set Postfilter command param */
+
+  AudioCommand cmd;
+
+  cmd.header.command_code = AUDCMD_INITMPP;
+  cmd.header.sub_code     = 0;
+  cmd.init_postproc_param = *initppparam;
+
+  err_t er = MsgLib::send<AudioCommand>(s_self_dtq,
+                                        MsgPriNormal,
+                                        MSG_AUD_SEF_CMD_INITPOSTPROC,
+                                        s_manager_dtq,
+                                        cmd);
+  F_ASSERT(er == ERR_OK);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+bool AS_SetPostprocEffector(FAR AsSetEffectorPostProc *setppparam)
+{
+  /* Parameter check */
+
+  if (setppparam == NULL)
+    {
+      return false;
+    }
+
+  /* Set Postfilter command param */
+
+  AudioCommand cmd;
+
+  cmd.header.command_code = AUDCMD_SETMPPPARAM;
+  cmd.header.sub_code     = 0;
+  cmd.set_postproc_param  = *setppparam;
+
+  err_t er = MsgLib::send<AudioCommand>(s_self_dtq,
+                                        MsgPriNormal,
+                                        MSG_AUD_SEF_CMD_SETPOSTPROC,
+                                        s_manager_dtq,
+                                        cmd);
+  F_ASSERT(er == ERR_OK);
+
+  return true;
+}
+#endif
+
 extern "C" {
 
 /*--------------------------------------------------------------------*/
@@ -351,6 +425,23 @@ static bool xloud_done_callback(FilterCompCmpltParam *p_cmplt)
   return true;
 }
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+/*--------------------------------------------------------------------*/
+static bool postproc_done_callback(CustomProcCbParam *p_param,
+                                   void *p_requester)
+{
+  err_t er = MsgLib::send<CustomProcCbParam>(s_self_dtq,
+                                             MsgPriNormal,
+                                             MSG_AUD_SEF_CMD_POSTPROC_DONE,
+                                             NULL,
+                                             *p_param);
+
+  F_ASSERT(er == ERR_OK);
+
+  return true;
+}
+#endif
+
 } /* extern "C" */
 
 /*--------------------------------------------------------------------*/
@@ -491,6 +582,45 @@ SoundEffectObject::MsgProc SoundEffectObject::MsgProcTbl[AUD_SEF_MSG_NUM][SoundF
     &SoundEffectObject::illegal,                  /*   SoundFXRunState      */
     &SoundEffectObject::filterDoneCmplt           /*   SoundFXStoppingState */
   },
+
+  /* POSTPROC_DONE */
+  {                                               /* SoundEffector Status:  */
+    &SoundEffectObject::illegal,                  /*   SoundFXBootedState   */
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+    &SoundEffectObject::postDone,                 /*   SoundFXReadyState    */
+    &SoundEffectObject::postDone,                 /*   SoundFXRunState      */
+    &SoundEffectObject::postDone                  /*   SoundFXStoppingState */
+#else
+    &SoundEffectObject::illegal,                  /*   SoundFXReadyState    */
+    &SoundEffectObject::illegal,                  /*   SoundFXRunState      */
+    &SoundEffectObject::illegal                   /*   SoundFXStoppingState */
+#endif
+  },
+
+  /* INITPOSTPROC */
+  {                                               /* SoundEffector Status:  */
+    &SoundEffectObject::illegal,                  /*   SoundFXBootedState   */
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+    &SoundEffectObject::initPostProc,             /*   SoundFXReadyState    */
+#else
+    &SoundEffectObject::illegal,                  /*   SoundFXReadyState    */
+#endif
+    &SoundEffectObject::illegal,                  /*   SoundFXRunState      */
+    &SoundEffectObject::illegal                   /*   SoundFXStoppingState */
+  },
+
+  /* SETPOSTPROC */
+  {                                               /* SoundEffector Status:  */
+    &SoundEffectObject::illegal,                  /*   SoundFXBootedState   */
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+    &SoundEffectObject::setPostProc,              /*   SoundFXReadyState    */
+    &SoundEffectObject::setPostProc,              /*   SoundFXRunState      */
+#else
+    &SoundEffectObject::illegal,                  /*   SoundFXReadyState    */
+    &SoundEffectObject::illegal,                  /*   SoundFXRunState      */
+#endif
+    &SoundEffectObject::illegal                   /*   SoundFXStoppingState */
+  },
 };
 /*--------------------------------------------------------------------*/
 void SoundEffectObject::illegal(MsgPacket *msg)
@@ -553,12 +683,14 @@ void SoundEffectObject::act(MsgPacket *msg)
                         &render_done_callback,
                         &render_error_callback,
                         static_cast<void*>(this),
-                        AS_BITLENGTH_16)
+                        AS_BITLENGTH_16,
+                        DMA_MIN_SAMPLE_NUM)
    || !AS_init_renderer(m_i2s_render_comp_handler,
                         &render_done_callback,
                         &render_error_callback,
                         static_cast<void*>(this),
-                        AS_BITLENGTH_16))
+                        AS_BITLENGTH_16,
+                        DMA_MIN_SAMPLE_NUM))
     {
       sendAudioCmdCmplt(cmd, AS_ECODE_DMAC_INITIALIZE_ERROR);
       return;
@@ -591,6 +723,32 @@ void SoundEffectObject::act(MsgPacket *msg)
       m_filter_mode |= FILTER_MODE_MPPEAX;
     }
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+  /* MFE and MPP work on fixed frame size of their libraries and
+   * cannot follow the short period. Only through path with
+   * post filter is available.
+   */
+
+  if (m_filter_mode & FILTER_MODE_MFE)
+    {
+      sendAudioCmdCmplt(cmd, AS_ECODE_COMMAND_PARAM_WITH_MFE);
+      return;
+    }
+
+  if (m_filter_mode & FILTER_MODE_MPPEAX)
+    {
+      sendAudioCmdCmplt(cmd, AS_ECODE_COMMAND_PARAM_WITH_MPP);
+      return;
+    }
+
+  if (cmd.set_baseband_status_param.with_PostProc
+        >= AS_SET_BBSTS_WITH_POSTPROC_NUM)
+    {
+      sendAudioCmdCmplt(cmd, AS_ECODE_COMMAND_PARAM_FUNCTION_ENABLE);
+      return;
+    }
+#endif
+
   if (m_filter_mode != FILTER_MODE_THROUGH)
     {
       uint32_t rst = AS_ECODE_OK;
@@ -672,6 +830,50 @@ void SoundEffectObject::act(MsgPacket *msg)
         }
     }
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+  /* Activate post filter at the last step, so that no later step
+   * of ACT fails with it loaded.
+   */
+
+  uint32_t pp_dsp_inf = 0;
+  uint32_t pp_rst =
+    AS_postproc_activate(&m_p_postproc_instance,
+                         s_postproc_pool_id,
+                         s_dsp_dtq,
+                         postproc_done_callback,
+                         "POSTPROC",
+                         static_cast<void *>(this),
+                         &pp_dsp_inf,
+                         (AS_SET_BBSTS_WITH_POSTPROC_ACTIVE ==
+                          cmd.set_baseband_status_param.with_PostProc)
+                           ? ProcTypeUserDefFilter : ProcTypeThrough);
+
+  if (pp_rst != AS_ECODE_OK)
+    {
+      /* Instance is created even if loading DSP fails. */
+
+      if (m_p_postproc_instance)
+        {
+          AS_postproc_deactivate(m_p_postproc_instance);
+          m_p_postproc_instance = NULL;
+        }
+
+      sendAudioCmdCmplt(cmd, pp_rst, pp_dsp_inf);
+      return;
+    }
+
+  /* Cycle counter is the time base of latency measurement. */
+
+  up_perf_init(NULL);
+
+  m_cycles_per_us = up_perf_getfreq() / 1000000;
+
+  if (m_cycles_per_us == 0)
+    {
+      m_cycles_per_us = 1;
+    }
+#endif
+
   m_state = SoundFXReadyState;
 
   sendAudioCmdCmplt(cmd, AS_ECODE_OK);
@@ -690,6 +892,19 @@ void SoundEffectObject::deact(MsgPacket* msg)
   AS_release_render_comp_handler(m_hp_render_comp_handler);
   AS_release_render_comp_handler(m_i2s_render_comp_handler);
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+  if (m_p_postproc_instance)
+    {
+      if (!AS_postproc_deactivate(m_p_postproc_instance))
+        {
+          sendAudioCmdCmplt(cmd, AS_ECODE_DSP_UNLOAD_ERROR);
+          return;
+        }
+
+      m_p_postproc_instance = NULL;
+    }
+#endif
+
   if (m_filter_mode != FILTER_MODE_THROUGH)
     {
       FilterComponentType mpp_acttype = FilterComponentTypeNum;
@@ -869,6 +1084,12 @@ void SoundEffectObject::startOnReady(MsgPacket *msg)
   m_i2s_in_sync_cnt = 0;
   m_capt_sync_wait_flg = true;
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+  m_capt_time_que.clear();
+  m_latency_min = UINT32_MAX;
+  m_latency_max = 0;
+#endif
+
   m_state = SoundFXRunState;
 
   sendAudioCmdCmplt(cmd, AS_ECODE_OK);
@@ -1014,6 +1235,14 @@ void SoundEffectObject::input(CaptureDataParam& param)
         }
       else
         {
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+          /* Post filter works in place on the captured buffer and
+           * it is rendered as it is. Rendering and stop process are
+           * done on postDone().
+           */
+
+          execPostProc(param.buf.cap_mh, param.buf.sample, param.end_flag);
+#else
           /* case of MFE is through */
           FilterCompCmpltParam render_param;
 
@@ -1054,6 +1283,7 @@ void SoundEffectObject::input(CaptureDataParam& param)
                   return;
                 }
             }
+#endif
         }
     }
   else
@@ -1235,6 +1465,130 @@ void SoundEffectObject::filterDoneCmplt(MsgPacket *msg)
   (void)param;
 }
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+/*--------------------------------------------------------------------*/
+void SoundEffectObject::postDone(MsgPacket *msg)
+{
+  CustomProcCbParam post_done = msg->moveParam<CustomProcCbParam>();
+
+  /* If it is not return of Exec, no need to rendering. */
+
+  if (post_done.event_type != CustomProcExec)
+    {
+      AS_postproc_recv_done(m_p_postproc_instance, NULL);
+      return;
+    }
+
+  CustomProcCmpltParam cmplt;
+
+  AS_postproc_recv_done(m_p_postproc_instance, &cmplt);
+
+  if (!cmplt.result)
+    {
+      SOUNDFX_ERR(AS_ATTENTION_SUB_CODE_DSP_EXEC_ERROR);
+    }
+
+  /* Output is the captured buffer itself. Hold it until DMA done
+   * instead of copying to SP/HP output buffer.
+   */
+
+  SoundFxBufParam hpout;
+  hpout.mh        = cmplt.output.mh;
+  hpout.sample    = cmplt.output.sample;
+  hpout.is_end    = cmplt.output.is_end;
+  hpout.capt_time = m_capt_time_que.top();
+
+  if (!m_capt_time_que.pop())
+    {
+      SOUNDFX_ERR(AS_ATTENTION_SUB_CODE_QUEUE_POP_ERROR);
+    }
+
+  if (!m_hp_out_buf_mh_que.push(hpout))
+    {
+      SOUNDFX_ERR(AS_ATTENTION_SUB_CODE_QUEUE_PUSH_ERROR);
+      return;
+    }
+
+  FilterCompCmpltParam render_param;
+
+  render_param.out_buffer.p_buffer =
+    reinterpret_cast<unsigned long*>(cmplt.output.mh.getPa());
+
+  render_param.out_buffer.size = cmplt.output.size;
+
+  execHpSpOutRender(&render_param);
+
+  /* stop process */
+
+  if (m_state.get() != SoundFXRunState)
+    {
+      if (!cmplt.output.is_end)
+        {
+          return;
+        }
+
+      if (!AS_stop_renderer(m_hp_render_comp_handler,
+                            AS_DMASTOPMODE_NORMAL))
+        {
+          return;
+        }
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void SoundEffectObject::initPostProc(MsgPacket *msg)
+{
+  AudioCommand cmd = msg->moveParam<AudioCommand>();
+
+  SOUNDFX_DBG("INIT POSTPROC:\n");
+
+  InitCustomProcParam param;
+
+  param.is_userdraw = true;
+  param.packet.addr = cmd.init_postproc_param.addr;
+  param.packet.size = cmd.init_postproc_param.size;
+
+  /* Init Postproc (Copy packet to MH internally, and wait return from DSP) */
+
+  uint32_t rst = AS_postproc_init(&param, m_p_postproc_instance);
+
+  /* Command packet is not allocated if memory pool is short. */
+
+  if (rst != AS_ECODE_CHECK_MEMORY_POOL_ERROR)
+    {
+      AS_postproc_recv_done(m_p_postproc_instance, NULL);
+    }
+
+  sendAudioCmdCmplt(cmd, rst);
+}
+
+/*--------------------------------------------------------------------*/
+void SoundEffectObject::setPostProc(MsgPacket *msg)
+{
+  AudioCommand cmd = msg->moveParam<AudioCommand>();
+
+  SOUNDFX_DBG("SET POSTPROC:\n");
+
+  SetCustomProcParam param;
+
+  param.is_userdraw = true;
+  param.packet.addr = cmd.set_postproc_param.addr;
+  param.packet.size = cmd.set_postproc_param.size;
+
+  /* Set Postproc (Copy packet to MH internally).
+   * Reply from DSP is received on postDone().
+   */
+
+  if (!AS_postproc_setparam(&param, m_p_postproc_instance))
+    {
+      sendAudioCmdCmplt(cmd, AS_ECODE_QUEUE_OPERATION_ERROR);
+      return;
+    }
+
+  sendAudioCmdCmplt(cmd, AS_ECODE_OK);
+}
+#endif
+
 /*--------------------------------------------------------------------*/
 void SoundEffectObject::dmaOutDoneCmpltOnActive(MsgPacket *msg)
 {
@@ -1268,7 +1622,27 @@ void SoundEffectObject::dmaOutDoneCmpltOnStopping(MsgPacket *msg)
         }
 
       m_state = SoundFXReadyState;
+
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+      /* Report measured latency with StopBB result. */
+
+      uint32_t lat_min = m_latency_min;
+      uint32_t lat_max = m_latency_max;
+
+      if (lat_min > lat_max)
+        {
+          /* No frame has been rendered. */
+
+          lat_min = 0;
+        }
+
+      SOUNDFX_DBG("LATENCY: min %d us, max %d us\n", lat_min, lat_max);
+
+      sendAudioCmdCmplt(ext_cmd, AS_ECODE_OK,
+                        AS_PackStopBBLatency(lat_min, lat_max));
+#else
       sendAudioCmdCmplt(ext_cmd, AS_ECODE_OK);
+#endif
     }
 }
 
@@ -1286,6 +1660,12 @@ void SoundEffectObject::freeOutBuf(cxd56_audio_dma_t dmac_select_id)
         break;
 
       case CXD56_AUDIO_DMAC_I2S0_DOWN:
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+        if (!m_hp_out_buf_mh_que.empty())
+          {
+            measureLatency(m_hp_out_buf_mh_que.top().capt_time);
+          }
+#endif
         freeHpOutBuf();
         break;
 
@@ -1415,6 +1795,7 @@ uint32_t SoundEffectObject::initMfe(const AudioCommand& cmd)
   /* TODO: Fixed valuse */
   cap_comp_param.init_param.capture_bit_width = AudPcm16Bit;
   cap_comp_param.init_param.callback          = capture_done_callback;
+  cap_comp_param.init_param.dma_min_size      = DMA_MIN_SAMPLE_NUM;
   cap_comp_param.handle                       = m_capture_from_mic_hdlr;
 
   if (!AS_init_capture(&cap_comp_param))
@@ -1430,6 +1811,7 @@ uint32_t SoundEffectObject::initMfe(const AudioCommand& cmd)
   /* TODO: Fixed value */
   cap_comp_param.init_param.capture_bit_width = AudPcm16Bit;
   cap_comp_param.init_param.callback          = capture_done_callback;
+  cap_comp_param.init_param.dma_min_size      = DMA_MIN_SAMPLE_NUM;
   cap_comp_param.handle                       = m_capture_from_i2s_hdlr;
 
   if (!AS_init_capture(&cap_comp_param))
@@ -1612,6 +1994,66 @@ void SoundEffectObject::execMpp(MemMgrLite::MemHandle mh,
     }
 }
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+/*--------------------------------------------------------------------*/
+void SoundEffectObject::execPostProc(MemMgrLite::MemHandle mh,
+                                     int32_t sample,
+                                     bool is_end)
+{
+  ExecCustomProcParam exec;
+
+  exec.input.identifier = 0;
+  exec.input.callback   = NULL;
+  exec.input.mh         = mh;
+  exec.input.sample     = sample;
+  exec.input.size       = sample * MAX_I2S_IN_CH_NUM * I2S_IN_BYTE_LEN;
+  exec.input.is_end     = is_end;
+  exec.input.is_valid   = true;
+  exec.input.bit_length = AS_BITLENGTH_16;
+
+  /* Process in place. Output is written back to the captured buffer. */
+
+  exec.output_mh = mh;
+
+  if (!AS_postproc_exec(&exec, m_p_postproc_instance))
+    {
+      SOUNDFX_ERR(AS_ATTENTION_SUB_CODE_DSP_EXEC_ERROR);
+      return;
+    }
+
+  /* Capture done of this frame has just been received. */
+
+  if (!m_capt_time_que.push(up_perf_gettime()))
+    {
+      SOUNDFX_ERR(AS_ATTENTION_SUB_CODE_QUEUE_PUSH_ERROR);
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void SoundEffectObject::measureLatency(uint32_t capt_time)
+{
+  /* Latency is the time from capture done to render done of the
+   * same frame. The first sample of the frame is captured and played
+   * one period before each of them, so it is also the latency of
+   * every sample. Both times are taken when their notification is
+   * received, so dispatch delay of the message queue is cancelled.
+   * Delay of codec and analog part is not included.
+   */
+
+  uint32_t latency = (up_perf_gettime() - capt_time) / m_cycles_per_us;
+
+  if (latency < m_latency_min)
+    {
+      m_latency_min = latency;
+    }
+
+  if (latency > m_latency_max)
+    {
+      m_latency_max = latency;
+    }
+}
+#endif
+
 /*--------------------------------------------------------------------*/
 void* SoundEffectObject::allocHpOutBuf()
 {
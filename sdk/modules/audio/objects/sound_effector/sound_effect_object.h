@@ -50,6 +50,10 @@
 #include "components/capture/capture_component.h"
 #include "components/filter/filter_api.h"
 #include "components/renderer/renderer_component.h"
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+#include <arch/chip/perf.h>
+#include "components/customproc/postproc_api.h"
+#endif
 #include "debug/dbg_log.h"
 
 __WIEN2_BEGIN_NAMESPACE
@@ -91,6 +95,12 @@ private:
     , m_capt_sync_wait_flg(true)
     , m_mfe_instance(NULL)
     , m_mpp_instance(NULL)
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+    , m_p_postproc_instance(NULL)
+    , m_latency_min(UINT32_MAX)
+    , m_latency_max(0)
+    , m_cycles_per_us(1)
+#endif
     {}
 
   enum SoundEffectState
@@ -138,6 +148,9 @@ private:
     MemMgrLite::MemHandle mh;
     uint32_t sample;
     bool is_end;
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+    uint32_t capt_time;
+#endif
   };
 
   /* TODO: Check validity of queue num. */
@@ -159,6 +172,22 @@ private:
   FilterComponent *m_mfe_instance;
   FilterComponent *m_mpp_instance;
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+  void *m_p_postproc_instance;
+
+  /* Time of capture done of frames in post filter [cycle]. */
+
+  s_std::Queue<uint32_t, CAP_BUF_QUEUE_SIZE> m_capt_time_que;
+
+  /* Measured latency from capture done to render done
+   * of SP/HP output [us].
+   */
+
+  uint32_t m_latency_min;
+  uint32_t m_latency_max;
+  uint32_t m_cycles_per_us;
+#endif
+
   typedef void (SoundEffectObject::*MsgProc)(MsgPacket*);
   static  MsgProc MsgProcTbl[AUD_SEF_MSG_NUM][SoundFXStateNum];
 
@@ -180,6 +209,11 @@ private:
   void dmaOutDoneCmpltOnStopping(MsgPacket* msg);
   void setParam(MsgPacket* msg);
   void filterDoneCmplt(MsgPacket* msg);
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+  void postDone(MsgPacket* msg);
+  void initPostProc(MsgPacket* msg);
+  void setPostProc(MsgPacket* msg);
+#endif
 
   void input(CaptureDataParam& param);
 
@@ -190,6 +224,10 @@ private:
   void execHpSpOutRender(FilterCompCmpltParam *param);
   void execMfe(MemMgrLite::MemHandle mh, int32_t sample, bool is_end);
   void execMpp(MemMgrLite::MemHandle mh, int32_t sample, bool is_end);
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+  void execPostProc(MemMgrLite::MemHandle mh, int32_t sample, bool is_end);
+  void measureLatency(uint32_t capt_time);
+#endif
 
   void* allocHpOutBuf();
   void* allocI2SOutBuf();
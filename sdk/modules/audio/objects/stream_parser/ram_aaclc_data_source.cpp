@@ -124,6 +124,9 @@ InputDataManagerObject::GetEsResult
           read_size = max_es_buf_size;
 
           /* Read ADTS frames.
+           * The frame is copied, not peeked, because the decoder reads
+           * es_buf after this returns, when the FIFO area of the frame
+           * may be refilled by the application.
            * (Results of the validity check and details of the error
            *  are currently unused.)
            */
@@ -174,7 +177,8 @@ InputDataManagerObject::GetEsResult
 
       InfoStreamMuxConfig stream_mux_config;
       memset(&stream_mux_config, 0, sizeof(InfoStreamMuxConfig));
-      uint8_t *rest = AACLC_getNextLatm(peek_data, &stream_mux_config);
+      uint8_t *rest = AACLC_getNextLatm(peek_data, payload_size,
+                                        &stream_mux_config);
       if (rest != 0)
         {
           *es_size = stream_mux_config.info_stream_frame[0].frame_length;
@@ -271,7 +275,8 @@ bool RamAACLCDataSource::getSamplingRate(FAR uint32_t *p_sampling_rate)
       InfoStreamMuxConfig stream_mux_config;
       memset(&stream_mux_config, 0, sizeof(InfoStreamMuxConfig));
 
-      uint8_t *rest = AACLC_getNextLatm(peek_data, &stream_mux_config);
+      uint8_t *rest = AACLC_getNextLatm(peek_data, payload_size,
+                                        &stream_mux_config);
       if (rest == 0)
         {
           return false;
@@ -44,6 +44,12 @@
 
 #include <audio/utilities/playlist.h>
 
+#include "track_scanner.h"
+
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+#include "track_db.h"
+#endif
+
 /*--------------------------------------------------------------------------*/
 bool Playlist::init(const char *playlist_path)
 {
@@ -62,6 +68,17 @@ bool Playlist::init(const char *playlist_path)
 
   this->open("r");
 
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+  /* Open binary track database. It is made from track database
+   * if not exist or out of date.
+   */
+
+  if (!this->openTrackDb(false))
+    {
+      return false;
+    }
+#endif
+
   /* Create alias list. */
 
   this->updatePlaylist(ListTypeAllTrack, "");
@@ -216,6 +233,19 @@ bool Playlist::getNextTrack(FAR Track *track)
         }
     }
 
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+  /* Increment index, and get track info from binary track database. */
+
+  this->m_play_idx++;
+
+  if (!this->m_track_db->read(this->m_alias_list.at(this->m_play_idx), track))
+    {
+      this->m_play_idx--;
+      return false;
+    }
+
+  return true;
+#else
   /* Clear EOF indicator. (Calling fseek() dows not clear them.) */
 
   clearerr(this->m_track_db_fp);
@@ -247,6 +277,7 @@ bool Playlist::getNextTrack(FAR Track *track)
     }
 
   return this->parseTrackInfo(track, line, sizeof(line));
+#endif
 }
 
 /*--------------------------------------------------------------------------*/
@@ -284,6 +315,19 @@ bool Playlist::getPrevTrack(Track *track)
         }
     }
 
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+  /* Decrement index, and get track info from binary track database. */
+
+  this->m_play_idx--;
+
+  if (!this->m_track_db->read(this->m_alias_list.at(this->m_play_idx), track))
+    {
+      this->m_play_idx++;
+      return false;
+    }
+
+  return true;
+#else
   /* Clear EOF indicator. (Calling fseek() dows not clear them.) */
 
   clearerr(this->m_track_db_fp);
@@ -317,6 +361,7 @@ bool Playlist::getPrevTrack(Track *track)
     }
 
   return this->parseTrackInfo(track, line, sizeof(line));
+#endif
 }
 
 /*--------------------------------------------------------------------------*/
@@ -361,6 +406,16 @@ bool Playlist::updatePlaylist(ListType type, FAR const char *key_str)
       return false;
     }
 
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+  /* Pick up tracks by index of binary track database. */
+
+  bool ret = TrackDb::writeListHeader(list_fp)
+          && this->writeAliasList(type, key_str, list_fp);
+
+  fclose(list_fp);
+
+  return ret;
+#else
   /* Move file pointer to top of file. */
 
   if (fseek(this->m_track_db_fp, 0, SEEK_SET) != 0)
@@ -411,6 +466,7 @@ bool Playlist::updatePlaylist(ListType type, FAR const char *key_str)
   fseek(this->m_track_db_fp, 0, SEEK_SET);
 
   return true;
+#endif
 }
 
 /*--------------------------------------------------------------------------*/
@@ -427,6 +483,10 @@ bool Playlist::addTrack(FAR const char *key_str, int track_no)
   uint32_t seek_offset = sizeof(data) * track_no;
   int      read_size = 0;
 
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+  seek_offset += sizeof(TrackDbListHeader);
+#endif
+
   /* Check argument */
 
   if (key_str == NULL)
@@ -460,6 +520,14 @@ bool Playlist::addTrack(FAR const char *key_str, int track_no)
       return false;
     }
 
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+  if (!TrackDb::checkListHeader(fp))
+    {
+      fclose(fp);
+      return false;
+    }
+#endif
+
   fseek(fp, seek_offset, SEEK_SET);
 
   read_size = fread(&data, 1, sizeof(data), fp);
@@ -471,7 +539,36 @@ bool Playlist::addTrack(FAR const char *key_str, int track_no)
   if (read_size == sizeof(data))
     {
       this->getFileName(ListTypeUser, key_str, file_name, sizeof(file_name));
+
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+      /* Check header of existing list, or write it to new list. */
+
+      fp = fopen(file_name, "r");
+      if (fp != NULL)
+        {
+          bool valid = TrackDb::checkListHeader(fp);
+          fclose(fp);
+
+          if (!valid)
+            {
+              _err("list for [%s] is not for binary track db.\n", key_str);
+              return false;
+            }
+
+          fp = fopen(file_name, "a");
+        }
+      else
+        {
+          fp = fopen(file_name, "w");
+          if (fp != NULL && !TrackDb::writeListHeader(fp))
+            {
+              fclose(fp);
+              return false;
+            }
+        }
+#else
       fp = fopen(file_name, "a");
+#endif
       if (fp == NULL)
         {
           return false;
@@ -520,6 +617,18 @@ bool Playlist::removeTrack(FAR const char *key_str, uint32_t remove_pos)
       return false;
     }
 
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+  /* Copy header of list. */
+
+  if (!TrackDb::checkListHeader(fp_org) || !TrackDb::writeListHeader(fp_tmp))
+    {
+      fclose(fp_org);
+      fclose(fp_tmp);
+      unlink(file_name_tmp);
+      return false;
+    }
+#endif
+
   /* Copy track from original to tmp except to be removed. */
 
   for (uint32_t idx = 0; ; idx++)
@@ -643,11 +752,89 @@ bool Playlist::updateTrackDb(const char *audiofile_root_path)
         }
     }
 
+  return this->reloadTrackDb();
+}
+
+/*--------------------------------------------------------------------------*/
+bool Playlist::updateTrackDb(const char *audiofile_root_path, UpdateMode mode)
+{
+  char db_path[FileNameMaxLength];
+  char tmp_path[FileNameMaxLength + 4];
+
+  /* Check argument */
+
+  if (audiofile_root_path == NULL || mode >= NumOfUpdateMode)
+    {
+      return false;
+    }
+
+  if (mode == UpdateModeSimple)
+    {
+      return this->updateTrackDb(audiofile_root_path);
+    }
+
+  /* Write to temporary file, because current track database is
+   * referred in incremental mode.
+   */
+
+  snprintf(db_path,
+           sizeof(db_path),
+           "%s/%s",
+           m_playlist_path,
+           this->m_track_db_file_name);
+  snprintf(tmp_path, sizeof(tmp_path), "%s_tmp", db_path);
+
+  FAR FILE *tmp_fp = fopen(tmp_path, "w");
+  if (tmp_fp == NULL)
+    {
+      printf("%s cannot opened.\n", tmp_path);
+      return false;
+    }
+
+  TrackScanner scanner;
+  bool ret = scanner.scan(audiofile_root_path,
+                          (mode == UpdateModeIncremental) ? db_path : NULL,
+                          tmp_fp);
+
+  fclose(tmp_fp);
+
+  if (!ret)
+    {
+      unlink(tmp_path);
+      return false;
+    }
+
+  /* Replace track database. */
+
+  this->close();
+  this->m_track_db_fp = NULL;
+
+  unlink(db_path);
+  if (rename(tmp_path, db_path) != 0)
+    {
+      printf("Cannot rename file. %s -> %s\n", tmp_path, db_path);
+    }
+
+  return this->reloadTrackDb();
+}
+
+/*--------------------------------------------------------------------------*/
+bool Playlist::reloadTrackDb(void)
+{
   /* Reopen track database with read mode. */
 
   this->close();
   this->open("r");
 
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+  /* Rebuild binary track database. */
+
+  if (!this->openTrackDb(true))
+    {
+      return false;
+    }
+#endif
+
   /* Delete all playlist. */
 
   this->deleteAll();
@@ -768,6 +955,14 @@ bool Playlist::isTargetTrack(ListType       type,
         rtcd = false;
         break;
 
+      case ListTypeCodec:
+        {
+          uint8_t codec_type;
+          rtcd = (this->parseCodecType(key_str, &codec_type) &&
+                  (track->codec_type == codec_type));
+        }
+        break;
+
       default:
         rtcd = true;
         break;
@@ -797,6 +992,18 @@ bool Playlist::loadAliasList(void)
       return false;
     }
 
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+  /* Reject lists which were not made from binary track database. */
+
+  if (!TrackDb::checkListHeader(list_fp))
+    {
+      _err("list for [%s] is not for binary track db. update it.\n",
+           this->m_list_key);
+      fclose(list_fp);
+      return false;
+    }
+#endif
+
   /* Clear list. */
 
   this->m_alias_list.clear();
@@ -873,12 +1080,11 @@ bool Playlist::readLine(FAR char *line, uint32_t line_size)
                     sizeof(this->m_line_buffer),
                     this->m_track_db_fp);
 
-  /* EOF indicator will be on when file read and read size is 0.
-   * So, check EOF after fread().
+  /* EOF indicator will be on also when the last line is read
+   * with the rest of file. So, check read size instead of EOF.
    */
 
-  int ret = feof(this->m_track_db_fp);
-  if (ret != 0)
+  if (read_size <= 0)
     {
       return false;
     }
@@ -1066,27 +1272,52 @@ bool Playlist::parseTrackInfo(FAR Track *track,
     {
       return false;
     }
+  if (!this->parseCodecType(tp, &track->codec_type))
+    {
+      return false;
+    }
+
+  /* Skip flag, and get duration if exists. */
+
+  if ((strtok(NULL, ",") != NULL) && ((tp = strtok(NULL, ",")) != NULL))
+    {
+      track->duration = strtoul(tp, NULL, 10);
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+bool Playlist::parseCodecType(FAR const char *str, FAR uint8_t *codec_type)
+{
+  /* Check arguments */
+
+  if (str == NULL || codec_type == NULL)
+    {
+      return false;
+    }
+
   char codec[16] = { '\0' };
-  strncpy(codec, tp, sizeof(codec) - 1);
+  strncpy(codec, str, sizeof(codec) - 1);
   if ((strncmp(codec, "wav", sizeof(codec)) == 0) ||
       (strncmp(codec, "WAV", sizeof(codec)) == 0))
     {
-      track->codec_type = AS_CODECTYPE_WAV;
+      *codec_type = AS_CODECTYPE_WAV;
     }
   else if ((strncmp(codec, "mp3", sizeof(codec)) == 0) ||
            (strncmp(codec, "MP3", sizeof(codec)) == 0))
     {
-      track->codec_type = AS_CODECTYPE_MP3;
+      *codec_type = AS_CODECTYPE_MP3;
     }
   else if ((strncmp(codec, "aac", sizeof(codec)) == 0) ||
            (strncmp(codec, "AAC", sizeof(codec)) == 0))
     {
-      track->codec_type = AS_CODECTYPE_AAC;
+      *codec_type = AS_CODECTYPE_AAC;
     }
   else if ((strncmp(codec, "opus", sizeof(codec)) == 0) ||
            (strncmp(codec, "OPUS", sizeof(codec)) == 0))
     {
-      track->codec_type = AS_CODECTYPE_OPUS;
+      *codec_type = AS_CODECTYPE_OPUS;
     }
   else
     {
@@ -1152,6 +1383,16 @@ bool Playlist::getFileName(ListType       type,
                    key_str);
           break;
 
+      case ListTypeCodec:
+          snprintf(file_name,
+                   max_length - 1,
+                   "%s/%s%s%s.bin",
+                   m_playlist_path,
+                   prefix,
+                   "codec_",
+                   key_str);
+          break;
+
       default:
           snprintf(file_name,
                    max_length - 1,
@@ -1168,3 +1409,167 @@ bool Playlist::getFileName(ListType       type,
 
   return true;
 }
+
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+/*--------------------------------------------------------------------------*/
+bool Playlist::openTrackDb(bool rebuild)
+{
+  char csv_path[FileNameMaxLength];
+  char db_path[FileNameMaxLength];
+
+  snprintf(csv_path,
+           sizeof(csv_path),
+           "%s/%s",
+           m_playlist_path,
+           this->m_track_db_file_name);
+  snprintf(db_path,
+           sizeof(db_path),
+           "%s/%s.tdb",
+           m_playlist_path,
+           this->m_track_db_file_name);
+
+  struct stat csv_stat;
+  if (stat(csv_path, &csv_stat) != 0)
+    {
+      printf("Track db(playlist) %s is not exist.\n", csv_path);
+      return false;
+    }
+
+  if (this->m_track_db == NULL)
+    {
+      this->m_track_db = new TrackDb();
+    }
+
+  /* Use existing database if it is made from current track database. */
+
+  if (!rebuild &&
+      this->m_track_db->open(db_path, csv_stat.st_size, csv_stat.st_mtime))
+    {
+      return true;
+    }
+
+  if (this->m_track_db_fp == NULL || !this->m_track_db->create(db_path))
+    {
+      return false;
+    }
+
+  /* Convert all lines of track database. */
+
+  clearerr(this->m_track_db_fp);
+  fseek(this->m_track_db_fp, 0, SEEK_SET);
+
+  while (true)
+    {
+      char line[LineMaxLength] =
+        {
+          '\0'
+        };
+      if (!this->readLine(line, sizeof(line)))
+        {
+          break;
+        }
+
+      Track track;
+      if (!this->parseTrackInfo(&track, line, sizeof(line)))
+        {
+          _warn("Skip invalid track [%s]\n", line);
+          continue;
+        }
+
+      if (!this->m_track_db->append(&track))
+        {
+          this->m_track_db->close();
+          return false;
+        }
+    }
+
+  clearerr(this->m_track_db_fp);
+  fseek(this->m_track_db_fp, 0, SEEK_SET);
+
+  if (!this->m_track_db->commit(csv_stat.st_size, csv_stat.st_mtime))
+    {
+      printf("Track db %s create error.\n", db_path);
+      return false;
+    }
+
+  printf("Track db %s is created. [%d tracks]\n",
+         db_path,
+         this->m_track_db->size());
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void Playlist::closeTrackDb(void)
+{
+  if (this->m_track_db != NULL)
+    {
+      delete this->m_track_db;
+      this->m_track_db = NULL;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+bool Playlist::writeAliasList(ListType       type,
+                              FAR const char *key_str,
+                              FAR FILE       *list_fp)
+{
+  TrackDb::IndexType index;
+  Track              key;
+  uint32_t           rec_no;
+
+  memset(&key, 0, sizeof(key));
+
+  switch (type)
+    {
+      case ListTypeAllTrack:
+        for (rec_no = 0; rec_no < this->m_track_db->size(); rec_no++)
+          {
+            if (fwrite(&rec_no, sizeof(rec_no), 1, list_fp) != 1)
+              {
+                printf("File write error.\n");
+                return false;
+              }
+          }
+        return true;
+
+      case ListTypeArtist:
+        strncpy(key.author, key_str, sizeof(key.author) - 1);
+        index = TrackDb::IndexArtist;
+        break;
+
+      case ListTypeAlbum:
+        strncpy(key.album, key_str, sizeof(key.album) - 1);
+        index = TrackDb::IndexAlbum;
+        break;
+
+      case ListTypeCodec:
+        if (!this->parseCodecType(key_str, &key.codec_type))
+          {
+            return false;
+          }
+        index = TrackDb::IndexCodec;
+        break;
+
+      case ListTypeUser:
+        _err("User define list is made by addTrack(), not by index.\n");
+        return false;
+
+      default:
+        return false;
+    }
+
+  for (bool found = this->m_track_db->findFirst(index, &key, &rec_no);
+       found;
+       found = this->m_track_db->findNext(&rec_no))
+    {
+      if (fwrite(&rec_no, sizeof(rec_no), 1, list_fp) != 1)
+        {
+          printf("File write error.\n");
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif /* CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB */
@@ -0,0 +1,565 @@
+/****************************************************************************
+ * modules/audio/playlist/track_db.cpp
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "debug.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "track_db.h"
+
+/*--------------------------------------------------------------------------*/
+static void record_to_track(FAR const TrackDbRecord *record,
+                            FAR Track               *track)
+{
+  memcpy(track->title, record->title, sizeof(track->title));
+  memcpy(track->author, record->author, sizeof(track->author));
+  memcpy(track->album, record->album, sizeof(track->album));
+
+  track->channel_number = record->channel_number;
+  track->bit_length     = record->bit_length;
+  track->sampling_rate  = record->sampling_rate;
+  track->codec_type     = record->codec_type;
+  track->duration       = record->duration;
+}
+
+/*--------------------------------------------------------------------------*/
+static long record_offset(uint32_t rec_no)
+{
+  return sizeof(TrackDbHeader) + rec_no * sizeof(TrackDbRecord);
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackDb::open(FAR const char *path, uint32_t src_size, uint32_t src_mtime)
+{
+  this->close();
+
+  this->m_fp = fopen(path, "r");
+  if (this->m_fp == NULL)
+    {
+      return false;
+    }
+
+  /* Check whether the database is made from the current csv file. */
+
+  if ((fread(&this->m_header, sizeof(m_header), 1, this->m_fp) != 1)
+   || (this->m_header.magic != Magic)
+   || (this->m_header.version != Version)
+   || (this->m_header.record_size != sizeof(TrackDbRecord))
+   || (this->m_header.src_size != src_size)
+   || (this->m_header.src_mtime != src_mtime))
+    {
+      fclose(this->m_fp);
+      this->m_fp = NULL;
+      return false;
+    }
+
+  this->m_record_num = this->m_header.record_num;
+  this->invalidateCache();
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void TrackDb::close(void)
+{
+  if (this->m_fp != NULL)
+    {
+      fclose(this->m_fp);
+      this->m_fp = NULL;
+    }
+
+  if (this->m_build_fp != NULL)
+    {
+      char tmp_path[sizeof(m_build_path) + 4];
+      snprintf(tmp_path, sizeof(tmp_path), "%s_tmp", this->m_build_path);
+
+      fclose(this->m_build_fp);
+      this->m_build_fp = NULL;
+      unlink(tmp_path);
+    }
+
+  this->m_record_num = 0;
+  this->m_find_pos   = 0;
+  this->m_find_end   = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackDb::create(FAR const char *path)
+{
+  this->close();
+
+  snprintf(this->m_build_path, sizeof(this->m_build_path), "%s", path);
+
+  char tmp_path[sizeof(m_build_path) + 4];
+  snprintf(tmp_path, sizeof(tmp_path), "%s_tmp", this->m_build_path);
+
+  this->m_build_fp = fopen(tmp_path, "w+");
+  if (this->m_build_fp == NULL)
+    {
+      printf("Track db %s open error.\n", tmp_path);
+      return false;
+    }
+
+  /* Reserve header area. It is written by commit(). */
+
+  memset(&this->m_header, 0, sizeof(this->m_header));
+  if (fwrite(&this->m_header, sizeof(this->m_header), 1, this->m_build_fp)
+        != 1)
+    {
+      this->close();
+      return false;
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackDb::append(FAR const Track *track)
+{
+  TrackDbRecord record;
+
+  if (this->m_build_fp == NULL || track == NULL)
+    {
+      return false;
+    }
+
+  memset(&record, 0, sizeof(record));
+  memcpy(record.title, track->title, sizeof(record.title));
+  memcpy(record.author, track->author, sizeof(record.author));
+  memcpy(record.album, track->album, sizeof(record.album));
+
+  record.sampling_rate  = track->sampling_rate;
+  record.channel_number = track->channel_number;
+  record.bit_length     = track->bit_length;
+  record.codec_type     = track->codec_type;
+  record.duration       = track->duration;
+
+  if (fwrite(&record, sizeof(record), 1, this->m_build_fp) != 1)
+    {
+      printf("Track db write error.\n");
+      return false;
+    }
+
+  this->m_record_num++;
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackDb::commit(uint32_t src_size, uint32_t src_mtime)
+{
+  if (this->m_build_fp == NULL)
+    {
+      return false;
+    }
+
+  /* Append indexes after record table. */
+
+  for (int type = IndexArtist; type < NumOfIndex; type++)
+    {
+      if (!this->buildIndex(static_cast<IndexType>(type),
+                            &this->m_header.index_offset[type]))
+        {
+          this->close();
+          return false;
+        }
+    }
+
+  /* Write header at last, then the database becomes valid. */
+
+  this->m_header.magic       = Magic;
+  this->m_header.version     = Version;
+  this->m_header.record_size = sizeof(TrackDbRecord);
+  this->m_header.record_num  = this->m_record_num;
+  this->m_header.src_size    = src_size;
+  this->m_header.src_mtime   = src_mtime;
+
+  if ((fseek(this->m_build_fp, 0, SEEK_SET) != 0)
+   || (fwrite(&this->m_header, sizeof(this->m_header), 1, this->m_build_fp)
+         != 1))
+    {
+      this->close();
+      return false;
+    }
+
+  fclose(this->m_build_fp);
+  this->m_build_fp = NULL;
+
+  char tmp_path[sizeof(m_build_path) + 4];
+  snprintf(tmp_path, sizeof(tmp_path), "%s_tmp", this->m_build_path);
+
+  unlink(this->m_build_path);
+  if (rename(tmp_path, this->m_build_path) != 0)
+    {
+      printf("Cannot rename file. %s -> %s\n", tmp_path, this->m_build_path);
+      unlink(tmp_path);
+      return false;
+    }
+
+  return this->open(this->m_build_path, src_size, src_mtime);
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackDb::writeListHeader(FAR FILE *fp)
+{
+  TrackDbListHeader header;
+
+  header.magic    = ListMagic;
+  header.version  = ListVersion;
+  header.reserved = 0;
+
+  return fwrite(&header, sizeof(header), 1, fp) == 1;
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackDb::checkListHeader(FAR FILE *fp)
+{
+  TrackDbListHeader header;
+
+  return (fread(&header, sizeof(header), 1, fp) == 1)
+      && (header.magic == ListMagic)
+      && (header.version == ListVersion);
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackDb::buildIndex(IndexType type, FAR uint32_t *offset)
+{
+  FAR TrackDbIndexEntry *entries = NULL;
+  FAR TrackDbRecord     *records = this->m_cache[0].records;
+  Track                 track;
+
+  if (fseek(this->m_build_fp, 0, SEEK_END) != 0)
+    {
+      return false;
+    }
+
+  *offset = ftell(this->m_build_fp);
+
+  if (this->m_record_num == 0)
+    {
+      return true;
+    }
+
+  entries = static_cast<FAR TrackDbIndexEntry *>
+              (malloc(this->m_record_num * sizeof(TrackDbIndexEntry)));
+  if (entries == NULL)
+    {
+      printf("No memory for track db index. [%d tracks]\n",
+             this->m_record_num);
+      return false;
+    }
+
+  /* Read back record table block by block, using cache area as buffer. */
+
+  this->invalidateCache();
+
+  for (uint32_t top = 0; top < this->m_record_num; top += RecordsPerBlock)
+    {
+      uint32_t num = this->m_record_num - top;
+      num = (num > RecordsPerBlock) ? RecordsPerBlock : num;
+
+      if ((fseek(this->m_build_fp, record_offset(top), SEEK_SET) != 0)
+       || (fread(records, sizeof(TrackDbRecord), num, this->m_build_fp)
+             != num))
+        {
+          free(entries);
+          return false;
+        }
+
+      for (uint32_t i = 0; i < num; i++)
+        {
+          record_to_track(&records[i], &track);
+          entries[top + i].hash   = hashOf(type, &track);
+          entries[top + i].rec_no = top + i;
+        }
+    }
+
+  qsort(entries, this->m_record_num, sizeof(TrackDbIndexEntry), compareEntry);
+
+  bool ret = true;
+
+  if ((fseek(this->m_build_fp, *offset, SEEK_SET) != 0)
+   || (fwrite(entries,
+              sizeof(TrackDbIndexEntry),
+              this->m_record_num,
+              this->m_build_fp) != this->m_record_num))
+    {
+      printf("Track db write error.\n");
+      ret = false;
+    }
+
+  free(entries);
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackDb::read(uint32_t rec_no, FAR Track *track)
+{
+  if (this->m_fp == NULL || track == NULL || rec_no >= this->m_record_num)
+    {
+      return false;
+    }
+
+  uint32_t block_no = rec_no / RecordsPerBlock;
+  FAR CacheBlock *block =
+    &this->m_cache[block_no % CONFIG_AUDIOUTILS_PLAYLIST_DB_CACHE_BLOCKS];
+
+  if (block->block_no != block_no)
+    {
+      uint32_t top = block_no * RecordsPerBlock;
+      uint32_t num = this->m_record_num - top;
+      num = (num > RecordsPerBlock) ? RecordsPerBlock : num;
+
+      if ((fseek(this->m_fp, record_offset(top), SEEK_SET) != 0)
+       || (fread(block->records, sizeof(TrackDbRecord), num, this->m_fp)
+             != num))
+        {
+          block->block_no = UINT32_MAX;
+          return false;
+        }
+
+      block->block_no = block_no;
+    }
+
+  record_to_track(&block->records[rec_no % RecordsPerBlock], track);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackDb::findFirst(IndexType       type,
+                        FAR const Track *key,
+                        FAR uint32_t    *rec_no)
+{
+  if (this->m_fp == NULL || key == NULL || type >= NumOfIndex)
+    {
+      return false;
+    }
+
+  this->m_find_type = type;
+  this->m_find_key  = *key;
+  this->m_find_hash = hashOf(type, key);
+
+  /* Binary search for the first entry of the hash. */
+
+  uint32_t low  = 0;
+  uint32_t high = this->m_record_num;
+
+  while (low < high)
+    {
+      uint32_t mid = low + (high - low) / 2;
+
+      if (!this->readEntries(mid, 1))
+        {
+          return false;
+        }
+
+      if (this->m_entries[0].hash < this->m_find_hash)
+        {
+          low = mid + 1;
+        }
+      else
+        {
+          high = mid;
+        }
+    }
+
+  this->m_find_pos  = low;
+  this->m_find_end  = this->m_record_num;
+  this->m_entry_num = 0;
+
+  return this->findNext(rec_no);
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackDb::findNext(FAR uint32_t *rec_no)
+{
+  Track track;
+
+  if (rec_no == NULL)
+    {
+      return false;
+    }
+
+  while (this->m_find_pos < this->m_find_end)
+    {
+      if ((this->m_find_pos < this->m_entry_top)
+       || (this->m_find_pos >= this->m_entry_top + this->m_entry_num))
+        {
+          uint32_t num = this->m_find_end - this->m_find_pos;
+          num = (num > IndexBufferNum) ? IndexBufferNum : num;
+
+          if (!this->readEntries(this->m_find_pos, num))
+            {
+              this->m_find_pos = this->m_find_end;
+              return false;
+            }
+        }
+
+      FAR TrackDbIndexEntry *entry =
+        &this->m_entries[this->m_find_pos - this->m_entry_top];
+
+      if (entry->hash != this->m_find_hash)
+        {
+          this->m_find_pos = this->m_find_end;
+          break;
+        }
+
+      this->m_find_pos++;
+
+      /* Hash may collide, so compare key itself. */
+
+      if (this->read(entry->rec_no, &track)
+       && isSameKey(this->m_find_type, &track, &this->m_find_key))
+        {
+          *rec_no = entry->rec_no;
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackDb::readEntries(uint32_t pos, uint32_t num)
+{
+  long offset = this->m_header.index_offset[this->m_find_type] +
+                pos * sizeof(TrackDbIndexEntry);
+
+  this->m_entry_num = 0;
+
+  if ((fseek(this->m_fp, offset, SEEK_SET) != 0)
+   || (fread(this->m_entries, sizeof(TrackDbIndexEntry), num, this->m_fp)
+         != num))
+    {
+      return false;
+    }
+
+  this->m_entry_top = pos;
+  this->m_entry_num = num;
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void TrackDb::invalidateCache(void)
+{
+  for (int i = 0; i < CONFIG_AUDIOUTILS_PLAYLIST_DB_CACHE_BLOCKS; i++)
+    {
+      this->m_cache[i].block_no = UINT32_MAX;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t TrackDb::hashOf(IndexType type, FAR const Track *track)
+{
+  FAR const char *str;
+  size_t         len;
+  uint32_t       hash = 2166136261u;
+
+  switch (type)
+    {
+      case IndexArtist:
+        str = track->author;
+        len = sizeof(track->author);
+        break;
+
+      case IndexAlbum:
+        str = track->album;
+        len = sizeof(track->album);
+        break;
+
+      default:
+        str = reinterpret_cast<FAR const char *>(&track->codec_type);
+        len = sizeof(track->codec_type);
+        break;
+    }
+
+  /* FNV-1a */
+
+  for (size_t i = 0; i < len && (type == IndexCodec || str[i] != '\0'); i++)
+    {
+      hash ^= static_cast<uint8_t>(str[i]);
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackDb::isSameKey(IndexType       type,
+                        FAR const Track *track,
+                        FAR const Track *key)
+{
+  switch (type)
+    {
+      case IndexArtist:
+        return (strncmp(track->author, key->author, sizeof(track->author))
+                  == 0);
+
+      case IndexAlbum:
+        return (strncmp(track->album, key->album, sizeof(track->album)) == 0);
+
+      case IndexCodec:
+        return (track->codec_type == key->codec_type);
+
+      default:
+        return false;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+int TrackDb::compareEntry(FAR const void *a, FAR const void *b)
+{
+  FAR const TrackDbIndexEntry *ea =
+    static_cast<FAR const TrackDbIndexEntry *>(a);
+  FAR const TrackDbIndexEntry *eb =
+    static_cast<FAR const TrackDbIndexEntry *>(b);
+
+  if (ea->hash != eb->hash)
+    {
+      return (ea->hash < eb->hash) ? -1 : 1;
+    }
+
+  if (ea->rec_no != eb->rec_no)
+    {
+      return (ea->rec_no < eb->rec_no) ? -1 : 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,204 @@
+/****************************************************************************
+ * modules/audio/playlist/track_db.h
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef MODULES_AUDIO_PLAYLIST_TRACK_DB_H
+#define MODULES_AUDIO_PLAYLIST_TRACK_DB_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <audio/utilities/playlist.h>
+
+/* Binary track database.
+ *
+ * File layout:
+ *   TrackDbHeader
+ *   TrackDbRecord x record_num               (ordered as in csv file)
+ *   TrackDbIndexEntry x record_num           (artist index)
+ *   TrackDbIndexEntry x record_num           (album index)
+ *   TrackDbIndexEntry x record_num           (codec index)
+ *
+ * Index entries are sorted by key hash and record number, so records
+ * which have the same key are found by one binary search.
+ *
+ * Alias lists (alias_list_*.bin) start with TrackDbListHeader and hold
+ * record numbers. Lists written in csv mode hold file offsets of the csv
+ * file and have no header, so they are rejected instead of misread.
+ */
+
+struct TrackDbHeader
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t record_size;
+  uint32_t record_num;
+  uint32_t src_size;
+  uint32_t src_mtime;
+  uint32_t index_offset[3];
+};
+
+struct TrackDbRecord
+{
+  char     title[64];
+  char     author[64];
+  char     album[64];
+  uint32_t sampling_rate;
+  uint8_t  channel_number;
+  uint8_t  bit_length;
+  uint8_t  codec_type;
+  uint8_t  reserved;
+  uint32_t duration;
+};
+
+struct TrackDbListHeader
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+};
+
+struct TrackDbIndexEntry
+{
+  uint32_t hash;
+  uint32_t rec_no;
+};
+
+class TrackDb
+{
+public:
+  enum IndexType
+  {
+    IndexArtist = 0,
+    IndexAlbum,
+    IndexCodec,
+    NumOfIndex,
+  };
+
+  TrackDb() :
+    m_fp(NULL),
+    m_build_fp(NULL),
+    m_record_num(0),
+    m_find_type(IndexArtist),
+    m_find_hash(0),
+    m_find_pos(0),
+    m_find_end(0),
+    m_entry_top(0),
+    m_entry_num(0)
+  {
+    invalidateCache();
+  }
+
+  ~TrackDb()
+  {
+    close();
+  }
+
+  /* Open database. Fails if it does not exist or if it was built
+   * from a csv file of other size or modification time.
+   */
+
+  bool open(FAR const char *path, uint32_t src_size, uint32_t src_mtime);
+  void close(void);
+
+  /* Build database. Call create(), append() for each track, then
+   * commit(). commit() sorts the indexes and opens the database.
+   */
+
+  bool create(FAR const char *path);
+  bool append(FAR const Track *track);
+  bool commit(uint32_t src_size, uint32_t src_mtime);
+
+  uint32_t size(void) const
+  {
+    return m_record_num;
+  }
+
+  bool read(uint32_t rec_no, FAR Track *track);
+
+  /* Find records whose key field is same as that of key track. */
+
+  bool findFirst(IndexType type, FAR const Track *key, FAR uint32_t *rec_no);
+  bool findNext(FAR uint32_t *rec_no);
+
+  /* Write or check TrackDbListHeader at the current position of an
+   * alias list file.
+   */
+
+  static bool writeListHeader(FAR FILE *fp);
+  static bool checkListHeader(FAR FILE *fp);
+
+private:
+  static const uint32_t Magic           = 0x42444c50; /* "PLDB" */
+  static const uint16_t Version         = 2;
+  static const uint32_t ListMagic       = 0x4c414c50; /* "PLAL" */
+  static const uint16_t ListVersion     = 1;
+  static const uint32_t RecordsPerBlock = 8;
+  static const uint32_t IndexBufferNum  = 16;
+
+  struct CacheBlock
+  {
+    uint32_t      block_no;
+    TrackDbRecord records[RecordsPerBlock];
+  };
+
+  static uint32_t hashOf(IndexType type, FAR const Track *track);
+  static bool isSameKey(IndexType       type,
+                        FAR const Track *track,
+                        FAR const Track *key);
+  static int compareEntry(FAR const void *a, FAR const void *b);
+
+  bool buildIndex(IndexType type, FAR uint32_t *offset);
+  bool readEntries(uint32_t pos, uint32_t num);
+  void invalidateCache(void);
+
+  FAR FILE      *m_fp;
+  FAR FILE      *m_build_fp;
+  char          m_build_path[128];
+  TrackDbHeader m_header;
+  uint32_t      m_record_num;
+
+  CacheBlock    m_cache[CONFIG_AUDIOUTILS_PLAYLIST_DB_CACHE_BLOCKS];
+
+  IndexType         m_find_type;
+  Track             m_find_key;
+  uint32_t          m_find_hash;
+  uint32_t          m_find_pos;
+  uint32_t          m_find_end;
+  uint32_t          m_entry_top;
+  uint32_t          m_entry_num;
+  TrackDbIndexEntry m_entries[IndexBufferNum];
+};
+
+#endif /* MODULES_AUDIO_PLAYLIST_TRACK_DB_H */
@@ -0,0 +1,830 @@
+/****************************************************************************
+ * modules/audio/playlist/track_scanner.cpp
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "debug.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "audio/utilities/wav_containerformat_parser.h"
+#ifdef CONFIG_AUDIOUTILS_PLAYER_CODEC_MP3
+#include "common/Mp3Parser.h"
+#endif
+#ifdef CONFIG_AUDIOUTILS_PLAYER_CODEC_AAC
+#include "common/RamAdtsParser.h"
+#endif
+#include "memutils/simple_fifo/CMN_SimpleFifo.h"
+
+#include "track_scanner.h"
+
+/* Field index of track database line. */
+
+enum TrackDbField
+{
+  FieldName = 0,
+  FieldAuthor,
+  FieldAlbum,
+  FieldChannel,
+  FieldBitLength,
+  FieldSamplingRate,
+  FieldCodec,
+  FieldFlag,
+  FieldDuration,
+  FieldSize,
+  FieldMtime,
+  NumOfField,
+};
+
+#define ID3V2_HEADER_SIZE  10
+#define ADTS_HEADER_SIZE   7
+#define ADTS_FRAME_SAMPLES 1024
+
+/*--------------------------------------------------------------------------*/
+static int split_line(FAR char *line, FAR char *field[], int max)
+{
+  int num = 0;
+
+  line[strcspn(line, "\r\n")] = '\0';
+
+  while (num < max)
+    {
+      field[num++] = line;
+
+      line = strchr(line, ',');
+      if (line == NULL)
+        {
+          break;
+        }
+
+      *line++ = '\0';
+    }
+
+  return num;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool is_supported_codec(FAR const char *codec)
+{
+  return ((strcasecmp(codec, "wav") == 0) ||
+          (strcasecmp(codec, "mp3") == 0) ||
+          (strcasecmp(codec, "aac") == 0) ||
+          (strcasecmp(codec, "opus") == 0));
+}
+
+/*--------------------------------------------------------------------------*/
+static FAR void *read_file_copier(FAR void       *ext_info,
+                                  FAR void       *dest,
+                                  FAR const void *src,
+                                  size_t         size)
+{
+  /* Read file directly into FIFO buffer, instead of copying from src. */
+
+  size_t read_size = fread(dest, 1, size, static_cast<FAR FILE *>(ext_info));
+  if (read_size < size)
+    {
+      memset(static_cast<FAR uint8_t *>(dest) + read_size,
+             0,
+             size - read_size);
+    }
+
+  return dest;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool read_head(FAR const char        *path,
+                      FAR CMN_SimpleFifoHandle *fifo,
+                      FAR uint8_t           *head_buf,
+                      FAR uint32_t          *data_size)
+{
+  uint8_t  id3[ID3V2_HEADER_SIZE];
+  uint32_t offset = 0;
+
+  FAR FILE *fp = fopen(path, "r");
+  if (fp == NULL)
+    {
+      return false;
+    }
+
+  /* Skip ID3v2 tag. It may be larger than the head size
+   * because of a cover picture.
+   */
+
+  if ((fread(id3, 1, sizeof(id3), fp) == sizeof(id3)) &&
+      (id3[0] == 'I') && (id3[1] == 'D') && (id3[2] == '3'))
+    {
+      offset = ID3V2_HEADER_SIZE +
+               (((id3[6] & 0x7f) << 21) | ((id3[7] & 0x7f) << 14) |
+                ((id3[8] & 0x7f) << 7)  |  (id3[9] & 0x7f));
+
+      /* Footer is present. */
+
+      if (id3[5] & 0x10)
+        {
+          offset += ID3V2_HEADER_SIZE;
+        }
+    }
+
+  *data_size = (*data_size > offset) ? (*data_size - offset) : 0;
+
+  uint32_t read_size = (*data_size < CONFIG_AUDIOUTILS_PLAYLIST_SCAN_HEAD_SIZE)
+                         ? *data_size : CONFIG_AUDIOUTILS_PLAYLIST_SCAN_HEAD_SIZE;
+
+  bool ret = false;
+
+  if ((read_size > 0) &&
+      (fseek(fp, offset, SEEK_SET) == 0) &&
+      (CMN_SimpleFifoInitialize(fifo,
+                                head_buf,
+                                CONFIG_AUDIOUTILS_PLAYLIST_SCAN_HEAD_SIZE + 1,
+                                NULL) == 0))
+    {
+      ret = (CMN_SimpleFifoOfferWithSpecificCopier(fifo,
+                                                   head_buf,
+                                                   read_size,
+                                                   read_file_copier,
+                                                   fp) == read_size);
+    }
+
+  fclose(fp);
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool parse_wav(FAR const char *path, FAR TrackScanInfo *info)
+{
+  WavContainerFormatParser parser;
+  fmt_chunk_t              fmt;
+
+  handel_wav_parser handle = parser.parseChunk(path, &fmt);
+  if (handle == NULL)
+    {
+      return false;
+    }
+
+  uint32_t data_size =
+    static_cast<FAR handel_wav_parser_t *>(handle)->data_size;
+
+  parser.resetParser(handle);
+
+  info->channel_number = fmt.channel;
+  info->bit_length     = fmt.bit;
+  info->sampling_rate  = fmt.rate;
+  info->duration       = (fmt.avgbyte == 0) ? 0 :
+    static_cast<uint32_t>((static_cast<uint64_t>(data_size) * 1000) /
+                          fmt.avgbyte);
+
+  return true;
+}
+
+#ifdef CONFIG_AUDIOUTILS_PLAYER_CODEC_MP3
+/*--------------------------------------------------------------------------*/
+static bool parse_mp3(FAR const char     *path,
+                      FAR TrackScanInfo *info,
+                      FAR uint8_t       *head_buf)
+{
+  CMN_SimpleFifoHandle fifo;
+  MP3PARSER_Handle     handle;
+  MP3PARSER_Config     config;
+  Mp3ParserLocalInfo   local_info;
+  uint8_t              local_buff[MP3PARSER_LOCAL_READFILE_BUFFERSIZE];
+  uint32_t             data_size = info->size;
+
+  if (!read_head(path, &fifo, head_buf, &data_size))
+    {
+      return false;
+    }
+
+  memset(&handle, 0, sizeof(handle));
+  memset(&config, 0, sizeof(config));
+
+  if ((Mp3Parser_initialize(&handle, &fifo, &config) != MP3PARSER_SUCCESS) ||
+      (mp3parser_get_frameheader(&handle, &local_info, local_buff)
+         != MP3PARSER_SUCCESS))
+    {
+      return false;
+    }
+
+  Mp3Parser_finalize(&handle);
+
+  Mp3ParserHeader header;
+  mp3parser_read_header(local_info.uhd.copy_byte, &header);
+
+  uint8_t id     = header.id;
+  uint8_t layer  = header.layer;
+  uint8_t br_idx = header.bitrate_index;
+  uint8_t fs_idx = header.sampling_frequency;
+  int32_t bitrate;
+
+  if (id == Mp3ParserMpeg1)
+    {
+      info->sampling_rate = mp3_parser_v1_sampling_frequency[fs_idx];
+      bitrate = mp3_parser_v1_bitrate[layer][br_idx];
+    }
+  else
+    {
+      info->sampling_rate = mp3_parser_v2_sampling_frequency[fs_idx];
+      bitrate = mp3_parser_v2_bitrate[layer][br_idx];
+    }
+
+  /* Mode 3 is single channel. */
+
+  info->channel_number =
+    (header.mode == 3) ? 1 : 2;
+  info->bit_length = 16;
+
+  /* Duration is estimated by bitrate of the 1st frame. */
+
+  info->duration = (bitrate <= 0) ? 0 :
+    static_cast<uint32_t>((static_cast<uint64_t>(data_size) * 8 * 1000) /
+                          bitrate);
+
+  return true;
+}
+#endif /* CONFIG_AUDIOUTILS_PLAYER_CODEC_MP3 */
+
+#ifdef CONFIG_AUDIOUTILS_PLAYER_CODEC_AAC
+/*--------------------------------------------------------------------------*/
+static bool parse_adts(FAR const char     *path,
+                       FAR TrackScanInfo *info,
+                       FAR uint8_t       *head_buf)
+{
+  CMN_SimpleFifoHandle     fifo;
+  CMN_SimpleFifoPeekHandle frame;
+  AdtsHandle               handle;
+  AdtsParserErrorDetail    err;
+  uint32_t                 frame_size;
+  uint16_t                 result;
+  uint8_t                  header[ADTS_HEADER_SIZE];
+  uint32_t                 data_size = info->size;
+
+  if (!read_head(path, &fifo, head_buf, &data_size))
+    {
+      return false;
+    }
+
+  bool ret =
+    (AdtsParser_Initialize(&handle, &fifo, &err) == ADTS_OK) &&
+    (AdtsParser_GetSamplingRate(&handle, &info->sampling_rate, &err)
+       == ADTS_OK) &&
+    (AdtsParser_PeekFrame(&handle, &frame, &frame_size, &result, &err)
+       == ADTS_OK) &&
+    (CMN_SimpleFifoCopyFromPeekHandle(&frame, header, sizeof(header))
+       == sizeof(header));
+
+  AdtsParser_Finalize(&handle, &err);
+
+  if (!ret || info->sampling_rate == 0 || frame_size == 0)
+    {
+      return false;
+    }
+
+  info->channel_number = ((header[2] & 0x01) << 2) | (header[3] >> 6);
+  info->bit_length     = 16;
+
+  /* Duration is estimated by size of the 1st frame. */
+
+  info->duration =
+    static_cast<uint32_t>((static_cast<uint64_t>(data_size / frame_size) *
+                           ADTS_FRAME_SAMPLES * 1000) /
+                          info->sampling_rate);
+
+  return true;
+}
+#endif /* CONFIG_AUDIOUTILS_PLAYER_CODEC_AAC */
+
+/*--------------------------------------------------------------------------*/
+TrackScanner::TrackScanner() :
+  m_old_fp(NULL),
+  m_old_entries(NULL),
+  m_old_num(0),
+  m_job_num(0),
+  m_run_num(0),
+  m_next_job(0),
+  m_done_num(0),
+  m_quit(false),
+  m_worker_num(0)
+{
+  memset(m_root_path, 0, sizeof(m_root_path));
+  pthread_mutex_init(&m_lock, NULL);
+  pthread_cond_init(&m_work_cond, NULL);
+  pthread_cond_init(&m_done_cond, NULL);
+}
+
+/*--------------------------------------------------------------------------*/
+TrackScanner::~TrackScanner()
+{
+  stopWorkers();
+  freeOldDb();
+  pthread_cond_destroy(&m_done_cond);
+  pthread_cond_destroy(&m_work_cond);
+  pthread_mutex_destroy(&m_lock);
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackScanner::scan(FAR const char *root_path,
+                        FAR const char *old_db_path,
+                        FAR FILE       *out_fp)
+{
+  char path[PathMaxLength + sizeof(TrackScanInfo::name)];
+  bool ret = true;
+
+  /* Check arguments */
+
+  if (root_path == NULL || out_fp == NULL)
+    {
+      return false;
+    }
+
+  snprintf(m_root_path, sizeof(m_root_path), "%s", root_path);
+
+  FAR DIR *dir_descriptor = opendir(m_root_path);
+  if (dir_descriptor == NULL)
+    {
+      printf("Cannot open folder.\n");
+      return false;
+    }
+
+  /* If old database is not available, all files are parsed. */
+
+  if (old_db_path != NULL && !this->loadOldDb(old_db_path))
+    {
+      _warn("Old track db is not used.\n");
+    }
+
+  if (!this->startWorkers())
+    {
+      closedir(dir_descriptor);
+      freeOldDb();
+      return false;
+    }
+
+  uint32_t total  = 0;
+  uint32_t reused = 0;
+
+  while (ret)
+    {
+      FAR struct dirent *dir_ent = readdir(dir_descriptor);
+
+      if (dir_ent != NULL && DTYPE_FILE == dir_ent->d_type)
+        {
+          FAR TrackScanInfo *info = &m_jobs[m_job_num];
+          struct stat       file_stat;
+
+          FAR const char *ext = strrchr(dir_ent->d_name, '.');
+          if (ext == NULL || !is_supported_codec(ext + 1))
+            {
+              continue;
+            }
+
+          memset(info, 0, sizeof(TrackScanInfo));
+          strncpy(info->name, dir_ent->d_name, sizeof(info->name) - 1);
+          strncpy(info->codec, ext + 1, sizeof(info->codec) - 1);
+
+          snprintf(path, sizeof(path), "%s/%s", m_root_path, info->name);
+          if (stat(path, &file_stat) == 0)
+            {
+              info->size  = file_stat.st_size;
+              info->mtime = file_stat.st_mtime;
+            }
+
+          m_job_reused[m_job_num] = this->lookupOldDb(info);
+          reused += m_job_reused[m_job_num] ? 1 : 0;
+          total++;
+
+          if (++m_job_num < JobNum)
+            {
+              continue;
+            }
+        }
+      else if (dir_ent != NULL)
+        {
+          continue;
+        }
+
+      /* Parse files by workers, then write lines in directory order. */
+
+      this->runJobs();
+      ret = this->writeJobs(out_fp);
+
+      if (dir_ent == NULL)
+        {
+          break;
+        }
+    }
+
+  this->stopWorkers();
+  this->freeOldDb();
+
+  if (closedir(dir_descriptor) != 0)
+    {
+      _err("FS_Closedir error.\n");
+    }
+
+  printf("track database is created. [%d tracks, %d parsed]\n",
+         total,
+         total - reused);
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackScanner::loadOldDb(FAR const char *old_db_path)
+{
+  char     line[256];
+  uint32_t capacity = 0;
+
+  m_old_fp = fopen(old_db_path, "r");
+  if (m_old_fp == NULL)
+    {
+      return false;
+    }
+
+  /* Make index of file name hash and line offset. */
+
+  while (true)
+    {
+      long offset = ftell(m_old_fp);
+
+      if (fgets(line, sizeof(line), m_old_fp) == NULL)
+        {
+          break;
+        }
+
+      if (m_old_num == capacity)
+        {
+          capacity = (capacity == 0) ? 64 : capacity * 2;
+
+          FAR OldEntry *entries = static_cast<FAR OldEntry *>
+            (realloc(m_old_entries, capacity * sizeof(OldEntry)));
+          if (entries == NULL)
+            {
+              freeOldDb();
+              return false;
+            }
+
+          m_old_entries = entries;
+        }
+
+      line[strcspn(line, ",\r\n")] = '\0';
+
+      m_old_entries[m_old_num].hash   = hashOf(line);
+      m_old_entries[m_old_num].offset = offset;
+      m_old_num++;
+    }
+
+  qsort(m_old_entries, m_old_num, sizeof(OldEntry), compareEntry);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void TrackScanner::freeOldDb(void)
+{
+  if (m_old_fp != NULL)
+    {
+      fclose(m_old_fp);
+      m_old_fp = NULL;
+    }
+
+  free(m_old_entries);
+  m_old_entries = NULL;
+  m_old_num     = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackScanner::lookupOldDb(FAR TrackScanInfo *info)
+{
+  char      line[256];
+  FAR char  *field[NumOfField];
+  uint32_t  hash = hashOf(info->name);
+  uint32_t  low  = 0;
+  uint32_t  high = m_old_num;
+
+  strncpy(info->author, "unknown artist", sizeof(info->author) - 1);
+  strncpy(info->album, "unknown album", sizeof(info->album) - 1);
+
+  while (low < high)
+    {
+      uint32_t mid = low + (high - low) / 2;
+
+      if (m_old_entries[mid].hash < hash)
+        {
+          low = mid + 1;
+        }
+      else
+        {
+          high = mid;
+        }
+    }
+
+  for (; low < m_old_num && m_old_entries[low].hash == hash; low++)
+    {
+      if ((fseek(m_old_fp, m_old_entries[low].offset, SEEK_SET) != 0) ||
+          (fgets(line, sizeof(line), m_old_fp) == NULL))
+        {
+          continue;
+        }
+
+      int num = split_line(line, field, NumOfField);
+      if (num <= FieldAlbum || strcmp(field[FieldName], info->name) != 0)
+        {
+          continue;
+        }
+
+      /* Keep artist and album, which may be edited by user. */
+
+      strncpy(info->author, field[FieldAuthor], sizeof(info->author) - 1);
+      strncpy(info->album, field[FieldAlbum], sizeof(info->album) - 1);
+
+      if ((num < NumOfField) ||
+          (strtoul(field[FieldSize], NULL, 10) != info->size) ||
+          (strtoul(field[FieldMtime], NULL, 10) != info->mtime))
+        {
+          return false;
+        }
+
+      /* Not modified. Reuse metadata. */
+
+      info->channel_number = atoi(field[FieldChannel]);
+      info->bit_length     = atoi(field[FieldBitLength]);
+      info->sampling_rate  = strtoul(field[FieldSamplingRate], NULL, 10);
+      info->duration       = strtoul(field[FieldDuration], NULL, 10);
+      info->parsed         = true;
+
+      return true;
+    }
+
+  return false;
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackScanner::startWorkers(void)
+{
+  pthread_attr_t attr;
+
+  m_quit     = false;
+  m_job_num  = 0;
+  m_run_num  = 0;
+  m_next_job = 0;
+  m_done_num = 0;
+
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, CONFIG_AUDIOUTILS_PLAYLIST_SCAN_STACK_SIZE);
+
+  for (m_worker_num = 0;
+       m_worker_num < CONFIG_AUDIOUTILS_PLAYLIST_SCAN_WORKERS;
+       m_worker_num++)
+    {
+      int ret = pthread_create(&m_workers[m_worker_num],
+                               &attr,
+                               workerEntry,
+                               static_cast<pthread_addr_t>(this));
+      if (ret != 0)
+        {
+          _err("Failed to create scan worker, error=%d\n", ret);
+          break;
+        }
+    }
+
+  pthread_attr_destroy(&attr);
+
+  if (m_worker_num == 0)
+    {
+      return false;
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void TrackScanner::stopWorkers(void)
+{
+  pthread_mutex_lock(&m_lock);
+  m_quit = true;
+  pthread_cond_broadcast(&m_work_cond);
+  pthread_mutex_unlock(&m_lock);
+
+  for (int i = 0; i < m_worker_num; i++)
+    {
+      pthread_join(m_workers[i], NULL);
+    }
+
+  m_worker_num = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+void TrackScanner::runJobs(void)
+{
+  if (m_job_num == 0)
+    {
+      return;
+    }
+
+  pthread_mutex_lock(&m_lock);
+
+  m_run_num  = m_job_num;
+  m_next_job = 0;
+  m_done_num = 0;
+  pthread_cond_broadcast(&m_work_cond);
+
+  while (m_done_num < m_run_num)
+    {
+      pthread_cond_wait(&m_done_cond, &m_lock);
+    }
+
+  m_run_num = 0;
+
+  pthread_mutex_unlock(&m_lock);
+}
+
+/*--------------------------------------------------------------------------*/
+bool TrackScanner::writeJobs(FAR FILE *out_fp)
+{
+  char line[256];
+  bool ret = true;
+
+  for (uint32_t i = 0; i < m_job_num; i++)
+    {
+      FAR TrackScanInfo *info = &m_jobs[i];
+
+      /* If metadata is not available, use provisional value. */
+
+      if (!info->parsed)
+        {
+          info->channel_number = 2;
+          info->bit_length     = 16;
+          info->sampling_rate  = 44100;
+          info->duration       = 0;
+        }
+
+      snprintf(line, sizeof(line),
+               "%s,%s,%s,%d,%d,%d,%s,0,%d,%d,%d\r\n",
+               info->name,
+               info->author,
+               info->album,
+               info->channel_number,
+               info->bit_length,
+               info->sampling_rate,
+               info->codec,
+               info->duration,
+               info->size,
+               info->mtime);
+
+      if (fputs(line, out_fp) < 0)
+        {
+          printf("File write error.\n");
+          ret = false;
+          break;
+        }
+    }
+
+  m_job_num = 0;
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+FAR void *TrackScanner::workerEntry(FAR void *arg)
+{
+  FAR TrackScanner *scanner = static_cast<FAR TrackScanner *>(arg);
+
+  /* One more byte for FIFO management. */
+
+  FAR uint8_t *head_buf = static_cast<FAR uint8_t *>
+    (malloc(CONFIG_AUDIOUTILS_PLAYLIST_SCAN_HEAD_SIZE + 1));
+
+  pthread_mutex_lock(&scanner->m_lock);
+
+  while (true)
+    {
+      while (!scanner->m_quit && scanner->m_next_job >= scanner->m_run_num)
+        {
+          pthread_cond_wait(&scanner->m_work_cond, &scanner->m_lock);
+        }
+
+      if (scanner->m_quit)
+        {
+          break;
+        }
+
+      uint32_t idx = scanner->m_next_job++;
+
+      pthread_mutex_unlock(&scanner->m_lock);
+
+      if (!scanner->m_job_reused[idx] && head_buf != NULL)
+        {
+          parseFile(scanner->m_root_path, &scanner->m_jobs[idx], head_buf);
+        }
+
+      pthread_mutex_lock(&scanner->m_lock);
+
+      if (++scanner->m_done_num == scanner->m_run_num)
+        {
+          pthread_cond_signal(&scanner->m_done_cond);
+        }
+    }
+
+  pthread_mutex_unlock(&scanner->m_lock);
+
+  free(head_buf);
+
+  return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+void TrackScanner::parseFile(FAR const char     *root_path,
+                             FAR TrackScanInfo *info,
+                             FAR uint8_t       *head_buf)
+{
+  char path[PathMaxLength + sizeof(TrackScanInfo::name)];
+
+  snprintf(path, sizeof(path), "%s/%s", root_path, info->name);
+
+  if (strcasecmp(info->codec, "wav") == 0)
+    {
+      info->parsed = parse_wav(path, info);
+    }
+#ifdef CONFIG_AUDIOUTILS_PLAYER_CODEC_MP3
+  else if (strcasecmp(info->codec, "mp3") == 0)
+    {
+      info->parsed = parse_mp3(path, info, head_buf);
+    }
+#endif
+#ifdef CONFIG_AUDIOUTILS_PLAYER_CODEC_AAC
+  else if (strcasecmp(info->codec, "aac") == 0)
+    {
+      info->parsed = parse_adts(path, info, head_buf);
+    }
+#endif
+  else
+    {
+      info->parsed = false;
+    }
+
+  if (!info->parsed)
+    {
+      _warn("Cannot get metadata of %s\n", info->name);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t TrackScanner::hashOf(FAR const char *name)
+{
+  uint32_t hash = 2166136261u;
+
+  /* FNV-1a */
+
+  for (; *name != '\0'; name++)
+    {
+      hash ^= static_cast<uint8_t>(*name);
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+
+/*--------------------------------------------------------------------------*/
+int TrackScanner::compareEntry(FAR const void *a, FAR const void *b)
+{
+  uint32_t ha = static_cast<FAR const OldEntry *>(a)->hash;
+  uint32_t hb = static_cast<FAR const OldEntry *>(b)->hash;
+
+  return (ha < hb) ? -1 : ((ha > hb) ? 1 : 0);
+}
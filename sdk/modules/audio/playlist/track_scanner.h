@@ -0,0 +1,129 @@
+/****************************************************************************
+ * modules/audio/playlist/track_scanner.h
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef MODULES_AUDIO_PLAYLIST_TRACK_SCANNER_H
+#define MODULES_AUDIO_PLAYLIST_TRACK_SCANNER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+
+/* Information of one audio file. */
+
+struct TrackScanInfo
+{
+  char     name[64];
+  char     author[64];
+  char     album[64];
+  char     codec[8];
+  uint32_t size;
+  uint32_t mtime;
+  uint32_t sampling_rate;
+  uint32_t duration;       /* msec */
+  uint8_t  channel_number;
+  uint8_t  bit_length;
+  bool     parsed;         /* Metadata is valid. */
+};
+
+/* Track database scanner.
+ *
+ * Reads the head of each audio file and gets channel number, bit length,
+ * sampling rate and duration of it, by worker threads. Files which are
+ * same size and time stamp as in the previous track database are not
+ * read again.
+ */
+
+class TrackScanner
+{
+public:
+  TrackScanner();
+  ~TrackScanner();
+
+  /* Scan files in root_path and write track database lines to out_fp.
+   * If old_db_path is not NULL, metadata in it is reused.
+   */
+
+  bool scan(FAR const char *root_path,
+            FAR const char *old_db_path,
+            FAR FILE       *out_fp);
+
+private:
+  static const uint32_t JobNum        = 16;
+  static const uint32_t PathMaxLength = 128;
+
+  struct OldEntry
+  {
+    uint32_t hash;
+    uint32_t offset;
+  };
+
+  bool loadOldDb(FAR const char *old_db_path);
+  void freeOldDb(void);
+  bool lookupOldDb(FAR TrackScanInfo *info);
+
+  bool startWorkers(void);
+  void stopWorkers(void);
+  void runJobs(void);
+  bool writeJobs(FAR FILE *out_fp);
+
+  static FAR void *workerEntry(FAR void *arg);
+  static void parseFile(FAR const char     *root_path,
+                        FAR TrackScanInfo *info,
+                        FAR uint8_t       *head_buf);
+  static uint32_t hashOf(FAR const char *name);
+  static int compareEntry(FAR const void *a, FAR const void *b);
+
+  char            m_root_path[PathMaxLength];
+
+  FAR FILE        *m_old_fp;
+  FAR OldEntry    *m_old_entries;
+  uint32_t        m_old_num;
+
+  TrackScanInfo   m_jobs[JobNum];
+  bool            m_job_reused[JobNum];
+  uint32_t        m_job_num;
+  uint32_t        m_run_num;
+  uint32_t        m_next_job;
+  uint32_t        m_done_num;
+  bool            m_quit;
+
+  pthread_mutex_t m_lock;
+  pthread_cond_t  m_work_cond;
+  pthread_cond_t  m_done_cond;
+  pthread_t       m_workers[CONFIG_AUDIOUTILS_PLAYLIST_SCAN_WORKERS];
+  int             m_worker_num;
+};
+
+#endif /* MODULES_AUDIO_PLAYLIST_TRACK_SCANNER_H */
@@ -43,6 +43,7 @@
 #include <stdlib.h>
 
 #include "common/LatmAacLc.h"
+#include "common/BitReader.h"
 
 /* Syncword to use with LATM / LOAS.
  * (Compare after obtaining with 11bit value -> long value)
@@ -144,8 +145,10 @@ typedef enum latm_flt_e LatmFlt;
 struct latm_local_info_s
 {
   uint8_t  *ptr_check_latm;    /* Current pointer */
+  uint8_t  *ptr_end;           /* End of the data given by the caller */
   uint32_t  total_bit_length;  /* Cumulative bit length read in */
   uint32_t  stream_cnt;        /* = StreamID */
+  BitReader br;                /* Reader positioned at total_bit_length */
 
   /* Temporarily use for data passing purpose. */
 
@@ -165,21 +168,6 @@ struct use_chunk_info_s
 };
 typedef struct use_chunk_info_s UseChunkInfo;
 
-/* Mask value at bit processing. */
-
-static const uint8_t BitMaskLessByteTable[9] =
-{
-  0x00,  /* 0-bit. */
-  0x80,  /* 1-bit. */
-  0xC0,  /* 2-bit. */
-  0xE0,  /* 3-bit. */
-  0xF0,  /* 4-bit. */
-  0xF8,  /* 5-bit. */
-  0xFC,  /* 6-bit. */
-  0xFE,  /* 7-bit. */
-  0xFF   /* 8-bit. */
-};
-
 #ifdef WINDOWS
 /*--------------------------------------------------------------------------*/
 static inline uint32_t convByteToLong(uint8_t byte_value[], uint8_t max_byte)
@@ -209,107 +197,73 @@ static inline uint32_t convByteToLong(uint8_t byte_value[], uint8_t max_byte)
 #endif
 
 /*--------------------------------------------------------------------------*/
-static uint8_t bitReadLessByte(LatmLocalInfo *ptr_info,
-                               uint32_t length_for_read)
+static void bitReadStart(LatmLocalInfo *ptr_info)
 {
-  uint8_t rtn_value = 0;
+  size_t size = 0;
 
-  uint8_t modulo_bit =
-    (uint8_t)(ptr_info->total_bit_length % LATM_BIT_OF_BYTE);
-
-  /* Check if it spans 2 bytes.(modulo_bit is the start bit) */
+  /* Position the reader at the bit remainder of the current pointer.
+   * Following reads advance the reader without reloading the bytes,
+   * and bits after the end of the data are read as 0.
+   */
 
-  if ((LATM_BIT_OF_BYTE - modulo_bit) >= (uint8_t)length_for_read)
+  if (ptr_info->ptr_check_latm < ptr_info->ptr_end)
     {
-      /* When it does not span 2 byte. */
-
-      rtn_value =
-        (*(ptr_info->ptr_check_latm) &
-          (BitMaskLessByteTable[length_for_read] >> modulo_bit));
-      ptr_info->total_bit_length += length_for_read;
-
-      if (ptr_info->total_bit_length % LATM_BIT_OF_BYTE)
-        {
-          rtn_value >>=
-            (LATM_BIT_OF_BYTE - (ptr_info->total_bit_length %
-              LATM_BIT_OF_BYTE));
-        }
+      size = ptr_info->ptr_end - ptr_info->ptr_check_latm;
     }
-  else
-    {
-      /* Read 1st byte. */
-
-      rtn_value =
-        (*(ptr_info->ptr_check_latm) & ~BitMaskLessByteTable[modulo_bit]);
 
-      /* Since the return value is 1 byte, it shifts to the upper bit side. */
-
-      rtn_value <<= (length_for_read - (LATM_BIT_OF_BYTE - modulo_bit));
-
-      /* If total_bit_length is last added with length_for_read,
-       * this line is not needed
-       */
-
-      ptr_info->total_bit_length += (LATM_BIT_OF_BYTE - modulo_bit);
-
-      /* Advance pointer for byte again. */
-
-      (ptr_info->ptr_check_latm)++;
-
-      /* Calculate the number of bits in 2nd byte. */
+  bitReaderInit(&ptr_info->br,
+                ptr_info->ptr_check_latm,
+                size,
+                (ptr_info->total_bit_length % LATM_BIT_OF_BYTE));
+}
 
-      modulo_bit = (length_for_read - (LATM_BIT_OF_BYTE - modulo_bit));
+/*--------------------------------------------------------------------------*/
+static void bitReadEnd(LatmLocalInfo *ptr_info)
+{
+  /* Set the current pointer to the byte which has the next bit. */
 
-      /* Reads the 2nd byte and sets the value combined with 1st byte
-       * as the return value.
-       */
+  ptr_info->ptr_check_latm = (uint8_t *)bitReaderBytePtr(&ptr_info->br);
+}
 
-      rtn_value |=
-        ((*(ptr_info->ptr_check_latm) & BitMaskLessByteTable[modulo_bit]) >>
-          (LATM_BIT_OF_BYTE - modulo_bit));
-      ptr_info->total_bit_length += modulo_bit;
-    }
+/*--------------------------------------------------------------------------*/
+static uint32_t bitReadCore(LatmLocalInfo *ptr_info,
+                            uint32_t length_for_read)
+{
+  ptr_info->total_bit_length += length_for_read;
 
-  /* Advance the pointer when there are no remaining bits after processing. */
+  return bitReaderRead(&ptr_info->br, length_for_read);
+}
 
-  if (!(ptr_info->total_bit_length % LATM_BIT_OF_BYTE))
-    {
-      (ptr_info->ptr_check_latm)++;
-    }
+/*--------------------------------------------------------------------------*/
+static void bitSkip(LatmLocalInfo *ptr_info, uint32_t length_for_skip)
+{
+  ptr_info->total_bit_length += length_for_skip;
+  bitReaderAdvance(&ptr_info->br, length_for_skip);
+}
 
-  return rtn_value;
+/*--------------------------------------------------------------------------*/
+static uint8_t bitReadLessByte(LatmLocalInfo *ptr_info,
+                               uint32_t length_for_read)
+{
+  return (uint8_t)bitReadCore(ptr_info, length_for_read);
 }
 
 /*--------------------------------------------------------------------------*/
 static uint32_t bitReadLessLong(LatmLocalInfo *ptr_info,
                                 uint32_t length_for_read)
 {
-  uint32_t i = 0;
-  uint8_t  byte_value[4] =
-  {
-    0
-  };
-
-  uint8_t max_byte = (length_for_read / LATM_BIT_OF_BYTE);
-  uint8_t modulo_bit = (length_for_read % LATM_BIT_OF_BYTE);
+  uint8_t byte_value[4];
 
-  /* Read the bit remainder first. */
+  uint8_t max_byte =
+    ((length_for_read + LATM_BIT_OF_BYTE - 1) / LATM_BIT_OF_BYTE);
 
-  if (modulo_bit)
-    {
-      byte_value[0] = bitReadLessByte(ptr_info, modulo_bit);
-      i = 1;
-      max_byte++;
-    }
+  uint32_t value = bitReadCore(ptr_info, length_for_read);
 
-  /* Process remaining by byte unit.
-   * (ptr_check_latm and total_bit_length are updated in bitReadLessByte ())
-   */
+  /* Split into bytes from the head. (The 1st byte has the bit remainder) */
 
-  while ((i < (int32_t)max_byte) && (i < sizeof(byte_value)))
+  for (int32_t i = 0, j = max_byte - 1; i < max_byte; i++, j--)
     {
-      byte_value[i] = bitReadLessByte(ptr_info, LATM_BIT_OF_BYTE);
-      i++;
+      byte_value[i] = (uint8_t)(value >> (j * LATM_BIT_OF_BYTE));
     }
 
   /* Convert byte array to long. */
@@ -467,6 +421,8 @@ static bool serachNextBitsForSyncWord(LatmLocalInfo *ptr_info,
       /* Fit the read pointer to the cumulative bit. */
 
       backup.ptr_check_latm = (ptr_info->ptr_check_latm + byte_of_total);
+      backup.ptr_end = ptr_info->ptr_end;
+      bitReadStart(&backup);
 
       /* Read specified bit length. */
 
@@ -494,6 +450,7 @@ static int32_t AACLC_checkLOAS(LatmLocalInfo *ptr_info)
    */
 
   temp.ptr_check_latm = ptr_info->ptr_check_latm;
+  temp.ptr_end = ptr_info->ptr_end;
   temp.total_bit_length = ptr_info->total_bit_length;
 
   /* Search syncword. */
@@ -508,6 +465,7 @@ static int32_t AACLC_checkLOAS(LatmLocalInfo *ptr_info)
       temp.ptr_check_latm =
         (ptr_info->ptr_check_latm +
           (temp.total_bit_length / LATM_BIT_OF_BYTE));
+      bitReadStart(&temp);
 
       /* Get the frame length after updating pointer and cumulative bit. */
 
@@ -1348,9 +1306,7 @@ static int32_t isoPayloadMux(LatmLocalInfo *ptr_info,
   int32_t rtn_length = 0;
   uint32_t payload_length = 0;
 
-  /* We do not call the payload (raw_data), so we only update
-   * total_bit_length and ptr_check_latm.
-   */
+  /* We do not call the payload (raw_data), so we only skip it. */
 
   if (ptr_stream_mux_config->all_streams_sametime_framing)
     {
@@ -1393,9 +1349,9 @@ static int32_t isoPayloadMux(LatmLocalInfo *ptr_info,
           ptr_stream_mux_config->info_stream_id[i].payload_offset =
             ptr_info->total_bit_length;
 
-          /* Add bit length for payload. */
+          /* Skip bit length for payload. */
 
-          ptr_info->total_bit_length += payload_length;
+          bitSkip(ptr_info, payload_length);
           rtn_length += payload_length;
         }
     }
@@ -1443,17 +1399,13 @@ static int32_t isoPayloadMux(LatmLocalInfo *ptr_info,
             info_stream_id[(ptr_chunk_info->stream_cnt_chunk[i])].
               payload_offset = ptr_info->total_bit_length;
 
-          /* Add bit length for payload. */
+          /* Skip bit length for payload. */
 
-          ptr_info->total_bit_length += payload_length;
+          bitSkip(ptr_info, payload_length);
           rtn_length += payload_length;
         }
     }
 
-  /* Update ptr_check_latm. */
-
-  ptr_info->ptr_check_latm += (ptr_info->total_bit_length / LATM_BIT_OF_BYTE);
-
   return rtn_length;
 }
 
@@ -1851,15 +1803,19 @@ static int32_t isoAudioMuxElement(LatmLocalInfo *ptr_info,
   uci.num_chunk = 0;
   /* Fit to ISO standard AudioMuxElement(). */
 
+  /* Read all fields of this element through one reader. */
+
+  bitReadStart(ptr_info);
+
   /* [ISO standard] Check the first bit. */
 
-  if (!(*(ptr_info->ptr_check_latm) & 0x80))
+  uint8_t use_same_stream_mux = bitReadLessByte(ptr_info, 1);
+  rtn_length++;
+
+  if (!use_same_stream_mux)
     {
       /* UseSameStreamMux processing. */
 
-      ptr_info->total_bit_length++;
-      rtn_length++;
-
       /* Set information in StreamMuxConfig to local table. */
 
       dummy_length = isoStreamMuxConfig(ptr_info, ptr_stream_mux_config);
@@ -1876,9 +1832,6 @@ static int32_t isoAudioMuxElement(LatmLocalInfo *ptr_info,
     }
   else
     {
-      ptr_info->total_bit_length++;
-      rtn_length++;
-
       /* Check if there is StreamMuxConfig information for the last time. */
 
       if ((ptr_stream_mux_config->max_stream_id < LATM_MIN_STREAM_ID) ||
@@ -1931,15 +1884,9 @@ static int32_t isoAudioMuxElement(LatmLocalInfo *ptr_info,
           dummy_length = ptr_stream_mux_config->other_data_len_bits;
           rtn_length += dummy_length;
 
-          /* Add the bit length of otherData. */
-
-          ptr_info->total_bit_length +=
-            ptr_stream_mux_config->other_data_len_bits;
+          /* Skip the bit length of otherData. */
 
-          /* The current pointer ptr_check_latm is updated. */
-
-          ptr_info->ptr_check_latm +=
-            (ptr_info->total_bit_length / LATM_BIT_OF_BYTE);
+          bitSkip(ptr_info, ptr_stream_mux_config->other_data_len_bits);
         }
     }
   else
@@ -1949,17 +1896,23 @@ static int32_t isoAudioMuxElement(LatmLocalInfo *ptr_info,
 
   rtn_length += iso_byteAlignment(ptr_info);
 
+  /* Reflect the read position to the current pointer. */
+
+  bitReadEnd(ptr_info);
+
   return rtn_length;
 }
 
 /*--------------------------------------------------------------------------*/
 uint8_t *AACLC_getNextLatm(uint8_t *ptr_readbuff,
+                           uint32_t size,
                            InfoStreamMuxConfig *ptr_stream_mux_config)
 {
   LatmLocalInfo info;
 
   info.total_bit_length = 0;
   info.ptr_check_latm = ptr_readbuff;
+  info.ptr_end = ptr_readbuff + size;
 
   /* Check LOAS.(If LOAS 2 bytes later LATM header) */
 
@@ -40,62 +40,52 @@
 
 #include "common/RamAdtsParser.h"
 #include "common/RamAdtsParser_Common.h"
-
-static uint8_t poll_buff[PARSER_LOCAL_POLL_BUFFERSIZE];
+#include "common/BitReader.h"
 
 /*--------------------------------------------------------------------------*/
-static int32_t adtsparser_skip_data(AdtsHandle *pHandle, uint8_t *pReadData)
+/* Get a byte of the peeked region without copying it. */
+
+static inline uint8_t adtsparser_peek_byte(const CMN_SimpleFifoPeekHandle *pView,
+                                           uint32_t idx)
 {
-  size_t size = 0;
+  return (idx < pView->m_szChunk[0]) ?
+           pView->m_pChunk[0][idx] :
+           pView->m_pChunk[1][idx - pView->m_szChunk[0]];
+}
+
+/*--------------------------------------------------------------------------*/
+/* Discard data by advancing the read pointer. (No copy) */
 
+static int32_t adtsparser_skip_data(AdtsHandle *pHandle)
+{
   size_t occupied_size =
     CMN_SimpleFifoGetOccupiedSize(pHandle->pSimpleFifoHandler);
   if (pHandle->parse_size > occupied_size)
     {
       pHandle->parse_size = occupied_size;
     }
-  if (pHandle->parse_size <= PARSER_LOCAL_POLL_BUFFERSIZE)
+  if (pHandle->parse_size)
     {
-      size = CMN_SimpleFifoPoll(pHandle->pSimpleFifoHandler,
-                                pReadData,
-                                pHandle->parse_size);
-      if (!size)
+      if (!CMN_SimpleFifoPoll(pHandle->pSimpleFifoHandler,
+                              NULL,
+                              pHandle->parse_size))
         {
           return AdtsParserConnotDataAccess;
         }
     }
-  else
-    {
-      uint32_t i = 0;
-      for (i = 0;
-           i < (pHandle->parse_size - PARSER_LOCAL_POLL_BUFFERSIZE);
-           i += PARSER_LOCAL_POLL_BUFFERSIZE)
-        {
-          size = CMN_SimpleFifoPoll(pHandle->pSimpleFifoHandler,
-                                    pReadData,
-                                    PARSER_LOCAL_POLL_BUFFERSIZE);
-          if (!size)
-            {
-              return AdtsParserConnotDataAccess;
-            }
-        }
-      uint32_t remainder = pHandle->parse_size - i;
-      if (remainder)
-        {
-          size = CMN_SimpleFifoPoll(pHandle->pSimpleFifoHandler,
-                                    pReadData,
-                                    remainder);
-          if (!size)
-            {
-              return AdtsParserConnotDataAccess;
-            }
-        }
-    }
   pHandle->parse_size = 0;
 
   return AdtsParserNormal;
 }
 
+/*--------------------------------------------------------------------------*/
+static void adtsparser_skip_all_data(AdtsHandle *pHandle)
+{
+  pHandle->parse_size =
+    CMN_SimpleFifoGetOccupiedSize(pHandle->pSimpleFifoHandler);
+  adtsparser_skip_data(pHandle);
+}
+
 /*--------------------------------------------------------------------------*/
 static int32_t adtsparser_pool_data(AdtsHandle *pHandle, int8_t *pReadData)
 {
@@ -120,55 +110,154 @@ static int32_t adtsparser_pool_data(AdtsHandle *pHandle, int8_t *pReadData)
 }
 
 /*--------------------------------------------------------------------------*/
-static int32_t adtsparser_peek_data(AdtsHandle *pHandle,
-                                    uint8_t *pReadData,
+static int32_t adtsparser_peek_view(AdtsHandle *pHandle,
+                                    CMN_SimpleFifoPeekHandle *pView,
                                     uint32_t peekSize)
 {
-  CMN_SimpleFifoPeekHandle pPeekHandle;
-
   size_t size = CMN_SimpleFifoPeekWithOffset(pHandle->pSimpleFifoHandler,
-                                             &pPeekHandle,
+                                             pView,
                                              peekSize,
                                              pHandle->current_pos);
   if (!size)
     {
       return AdtsParserConnotDataAccess;
     }
-  size =
-    CMN_SimpleFifoCopyFromPeekHandle(&pPeekHandle, (void *)pReadData, size);
-  if (!size)
-    {
-      return AdtsParserConnotDataAccess;
-    }
   pHandle->parse_size = size;
 
   return AdtsParserNormal;
 }
 
 /*--------------------------------------------------------------------------*/
-static int32_t adtsparser_syncword_search(uint8_t *pReadData,
-                                          uint8_t *syncword_idx)
+/* Search syncword on the peeked region of all stored data.
+ * search_pos is set to the offset of syncword.
+ */
+
+static int32_t adtsparser_syncword_search(AdtsHandle *pHandle)
 {
-  for (int i = 0; i < 2; i++)
+  CMN_SimpleFifoPeekHandle view;
+
+  size_t occupied_size =
+    CMN_SimpleFifoGetOccupiedSize(pHandle->pSimpleFifoHandler);
+  if (occupied_size < ADTSPARSER_SYNCWORD_SEARCH_SIZE)
+    {
+      return AdtsParserConnotDataAccess;
+    }
+
+  pHandle->current_pos = 0;
+  if (adtsparser_peek_view(pHandle, &view, occupied_size) !=
+       AdtsParserNormal)
+    {
+      return AdtsParserConnotDataAccess;
+    }
+
+  uint8_t hdr0 = adtsparser_peek_byte(&view, 0);
+  for (uint32_t i = 0; i + 1 < occupied_size; i++)
     {
-      if (ADTS_CHECK_SYNCWORD(*(pReadData+(i)), *(pReadData+(i + 1))) ==
-           ADTS_OK)
+      uint8_t hdr1 = adtsparser_peek_byte(&view, i + 1);
+      if (ADTS_CHECK_SYNCWORD(hdr0, hdr1) == ADTS_OK)
         {
           /* Because it is conceivable that a coincident sync word matches,
            * check the following data.
            */
 
-          uint8_t consistency_check;
-          consistency_check = *(pReadData+(i + 1));
-          if (((consistency_check & 0x0F) == 1) ||
-               ((consistency_check & 0x0F) == 0))
+          if (((hdr1 & 0x0F) == 1) || ((hdr1 & 0x0F) == 0))
             {
-              *syncword_idx = i;
+              pHandle->search_pos = i;
               return AdtsParserNormal;
             }
         }
+      hdr0 = hdr1;
     }
-  return AdtsParserCannotGetHeader;
+
+  return AdtsParserConnotDataAccess;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Find the next frame and check its header.
+ * The data before the frame is discarded.
+ */
+
+static int32_t adtsparser_get_frame(AdtsHandle *pHandle,
+                                    CMN_SimpleFifoPeekHandle *pHeader,
+                                    uint32_t *pFrameSize,
+                                    uint16_t *usResult,
+                                    AdtsParserErrorDetail *uipErrDetail)
+{
+  pHandle->current_pos = 0;
+  pHandle->search_pos  = 0;
+
+  if (adtsparser_syncword_search(pHandle) != AdtsParserNormal)
+    {
+      adtsparser_skip_all_data(pHandle);
+      *uipErrDetail = AdtsParserConnotDataAccess;
+      return ADTS_ERR;
+    }
+
+  if (pHandle->search_pos != 0)
+    {
+      pHandle->parse_size = pHandle->search_pos;
+      if (adtsparser_skip_data(pHandle) != AdtsParserNormal)
+        {
+          *uipErrDetail = AdtsParserConnotDataAccess;
+          return ADTS_ERR;
+        }
+    }
+
+  /* Read header information. */
+
+  pHandle->current_pos = 0;
+  if (adtsparser_peek_view(pHandle, pHeader, ADTS_HEADER_SIZE) !=
+       AdtsParserNormal)
+    {
+      adtsparser_skip_all_data(pHandle);
+      *uipErrDetail = AdtsParserConnotDataAccess;
+      return ADTS_ERR;
+    }
+
+  /* The fields are read in order through one reader. */
+
+  uint8_t hdr[ADTS_HEADER_SIZE];
+  for (uint32_t i = 0; i < ADTS_HEADER_SIZE; i++)
+    {
+      hdr[i] = adtsparser_peek_byte(pHeader, i);
+    }
+
+  BitReader br;
+  bitReaderInit(&br, hdr, ADTS_HEADER_SIZE, 0);
+
+  /* Check syncword. */
+
+  if (bitReaderRead(&br, ADTS_BITS_SYNCWORD) != ADTS_SYNCWORD)
+    {
+      *usResult |= HDR_SYNCWORD_NG;
+      *uipErrDetail = AdtsParserCannotGetHeader;
+      return ADTS_ERR;
+    }
+
+  bitReaderAdvance(&br, ADTS_BITS_ID_TO_PROTECTION);
+
+  /* Checking the profile. */
+
+  if (bitReaderRead(&br, ADTS_BITS_PROFILE) != ADTS_PROFILE_AACLC)
+    {
+      *usResult |= HDR_PROFILE_NG;
+    }
+
+  /* Check sampling rate. */
+
+  uint32_t fs_index = bitReaderRead(&br, ADTS_BITS_SAMPLING_RATE);
+  if (AdtsSamplingFrequency[fs_index] == 0)
+    {
+      *usResult |= HDR_SAMLERATE_NG;
+    }
+
+  bitReaderAdvance(&br, ADTS_BITS_PRIVATE_TO_START);
+
+  /* Extract frame size.(including header) */
+
+  *pFrameSize = bitReaderRead(&br, ADTS_BITS_FRAMELENGTH);
+
+  return ADTS_OK;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -195,7 +284,6 @@ int32_t AdtsParser_Initialize(AdtsHandle *pHandle,
   return rc;
 }
 
-
 /*--------------------------------------------------------------------------*/
 int32_t AdtsParser_ReadFrame(AdtsHandle *pHandle,
                              int8_t *pBuff,
@@ -217,124 +305,123 @@ int32_t AdtsParser_ReadFrame(AdtsHandle *pHandle,
 
   if ((pHandle) && (pBuff) && (pSize) && (usResult) && (uipErrDetail))
     {
-      size_t occupied_size = 0;
-      pHandle->current_pos = 0;
-      pHandle->search_pos  = 0;
-      while (1)
+      CMN_SimpleFifoPeekHandle header;
+      uint32_t frame_size = 0;
+
+      if (adtsparser_get_frame(pHandle,
+                               &header,
+                               &frame_size,
+                               usResult,
+                               uipErrDetail) != ADTS_OK)
         {
-          int32_t rst = adtsparser_peek_data(pHandle,
-                                             poll_buff,
-                                             ADTSPARSER_SYNCWORD_SEARCH_SIZE);
-          if (rst != AdtsParserNormal)
-            {
-              occupied_size =
-                CMN_SimpleFifoGetOccupiedSize(pHandle->pSimpleFifoHandler);
-              pHandle->parse_size = occupied_size;
-              adtsparser_skip_data(pHandle, poll_buff);
-              *uipErrDetail = AdtsParserConnotDataAccess;
-              return rc;
-            }
-          pHandle->search_pos++;
-          pHandle->current_pos = pHandle->search_pos;
+          return rc;
+        }
 
-          uint8_t syncword_idx;
-          if (adtsparser_syncword_search(poll_buff, &syncword_idx) ==
-               AdtsParserNormal)
+      *uipErrDetail = AdtsParserAbnormalHeader;
+
+      if (frame_size <= *pSize)
+        {
+          *uipErrDetail = AdtsParserNormal;
+          pHandle->parse_size = frame_size;
+
+          /* Reading a frame.(including header)
+           * This is the only copy from FIFO to the result buffer.
+           */
+
+          if (adtsparser_pool_data(pHandle, pBuff) == AdtsParserNormal)
             {
-              if (syncword_idx == 0)
-                {
-                  pHandle->search_pos = (pHandle->search_pos - 1);
-                }
-              break;
+              pHandle->parse_size = 0;
+              *pSize = frame_size;
+              rc = ADTS_OK;
             }
-        }
-      if (pHandle->search_pos != 0)
-        {
-          pHandle->parse_size = pHandle->search_pos;
-          if (adtsparser_skip_data(pHandle, poll_buff) != AdtsParserNormal)
+          else
             {
+              adtsparser_skip_all_data(pHandle);
               *uipErrDetail = AdtsParserConnotDataAccess;
-              return rc;
+              *usResult |= HDR_FRAMESIZE_NG;
+              *pSize = 0;
             }
         }
-
-      /* Read header information. */
-
-      pHandle->current_pos = 0;
-      if (adtsparser_peek_data(pHandle, poll_buff, ADTS_HEADER_SIZE) !=
-           AdtsParserNormal)
+      else
         {
-          occupied_size =
-            CMN_SimpleFifoGetOccupiedSize(pHandle->pSimpleFifoHandler);
-          pHandle->parse_size = occupied_size;
-          adtsparser_skip_data(pHandle, poll_buff);
-          *uipErrDetail = AdtsParserConnotDataAccess;
-          return rc;
+          *usResult |= HDR_FRAMESIZE_NG;
+          *uipErrDetail = AdtsParserShortageBuffer;
         }
+    }
+  return rc;
+}
 
+/*--------------------------------------------------------------------------*/
+int32_t AdtsParser_PeekFrame(AdtsHandle *pHandle,
+                             CMN_SimpleFifoPeekHandle *pFrame,
+                             uint32_t *pSize,
+                             uint16_t *usResult,
+                             AdtsParserErrorDetail *uipErrDetail)
+{
+  int32_t rc = ADTS_ERR;
 
-      /* Check syncword. */
+  if (usResult)
+    {
+      *usResult = HDR_OK;
+    }
 
-      if (ADTS_CHECK_SYNCWORD(*poll_buff, *(poll_buff + 1)) == ADTS_OK)
-        {
-          *uipErrDetail = AdtsParserAbnormalHeader;
+  if (uipErrDetail)
+    {
+      *uipErrDetail = AdtsParserAbnormalArg;
+    }
 
-          /* Checking the profile. */
+  if ((pHandle) && (pFrame) && (pSize) && (usResult) && (uipErrDetail))
+    {
+      uint32_t frame_size = 0;
 
-          if ((*(poll_buff + 2) & ADTS_MASK_PROFILE) != ADTS_PROFILE_AACLC)
-            {
-              *usResult |= HDR_PROFILE_NG;
-            }
+      if (adtsparser_get_frame(pHandle,
+                               pFrame,
+                               &frame_size,
+                               usResult,
+                               uipErrDetail) != ADTS_OK)
+        {
+          return rc;
+        }
 
-          /* Check sampling rate. */
+      /* Refer to the whole frame.(including header) */
 
-          if (ADTS_GET_SAMPLING_RATE(*(poll_buff + 2)) == 0)
-            {
-              *usResult |= HDR_SAMLERATE_NG;
-            }
+      pHandle->current_pos = 0;
+      if (adtsparser_peek_view(pHandle, pFrame, frame_size) !=
+           AdtsParserNormal)
+        {
+          adtsparser_skip_all_data(pHandle);
+          *uipErrDetail = AdtsParserConnotDataAccess;
+          *usResult |= HDR_FRAMESIZE_NG;
+          *pSize = 0;
+          return rc;
+        }
 
-          /* Extract frame size.(including header) */
+      pHandle->parse_size = frame_size;
+      *pSize = frame_size;
+      *uipErrDetail = AdtsParserNormal;
+      rc = ADTS_OK;
+    }
+  return rc;
+}
 
-          uint32_t frame_size =
-            ADTS_GET_FRAMELENGTH(*(poll_buff + 3),
-                                 *(poll_buff + 4),
-                                 *(poll_buff + 5));
+/*--------------------------------------------------------------------------*/
+int32_t AdtsParser_DiscardFrame(AdtsHandle *pHandle,
+                                uint32_t uiSize,
+                                AdtsParserErrorDetail *uipErrDetail)
+{
+  int32_t rc = ADTS_ERR;
 
-          if (frame_size <= *pSize)
-            {
-              *uipErrDetail = AdtsParserNormal;
-              pHandle->parse_size = frame_size;
-
-              /* Reading a frame.(including header) */
-
-              if (adtsparser_pool_data(pHandle, pBuff) == AdtsParserNormal)
-                {
-                  pHandle->parse_size = 0;
-                  *pSize = frame_size;
-                  rc = ADTS_OK;
-                }
-              else
-                {
-                  occupied_size =
-                    CMN_SimpleFifoGetOccupiedSize(pHandle->pSimpleFifoHandler);
-                  pHandle->parse_size = occupied_size;
-                  adtsparser_skip_data(pHandle, poll_buff);
-                  *uipErrDetail = AdtsParserConnotDataAccess;
-                  *usResult |= HDR_FRAMESIZE_NG;
-                  *pSize = 0;
-                }
-            }
-          else
-            {
-              *usResult |= HDR_FRAMESIZE_NG;
-              *uipErrDetail = AdtsParserShortageBuffer;
-            }
-        }
-      else
-        {
-          *usResult |= HDR_SYNCWORD_NG;
-          *uipErrDetail = AdtsParserCannotGetHeader;
-        }
+  if (uipErrDetail)
+    {
+      *uipErrDetail = AdtsParserAbnormalArg;
+    }
+
+  if ((pHandle) && (uipErrDetail))
+    {
+      pHandle->parse_size = uiSize;
+      *uipErrDetail = adtsparser_skip_data(pHandle) == AdtsParserNormal ?
+                        AdtsParserNormal : AdtsParserConnotDataAccess;
+      rc = (*uipErrDetail == AdtsParserNormal) ? ADTS_OK : ADTS_ERR;
     }
   return rc;
 }
@@ -380,34 +467,20 @@ int32_t AdtsParser_GetSamplingRate(AdtsHandle *pHandle,
 
   if ((pHandle) && (pSmplingRate) && (uipErrDetail))
     {
+      CMN_SimpleFifoPeekHandle header;
+
       pHandle->current_pos = 0;
       pHandle->search_pos  = 0;
-      while (1)
+      if (adtsparser_syncword_search(pHandle) != AdtsParserNormal)
         {
-          if (adtsparser_peek_data(pHandle, poll_buff, 3) != AdtsParserNormal)
-            {
-              *uipErrDetail = AdtsParserConnotDataAccess;
-              return rc;
-            }
-          pHandle->search_pos++;
-          pHandle->current_pos = pHandle->search_pos;
-
-          uint8_t syncword_idx;
-          if (adtsparser_syncword_search(poll_buff, &syncword_idx) ==
-               AdtsParserNormal)
-            {
-              if (syncword_idx == 0)
-                {
-                  pHandle->search_pos = (pHandle->search_pos - 1);
-                }
-              break;
-            }
+          *uipErrDetail = AdtsParserConnotDataAccess;
+          return rc;
         }
 
       /* Read header information. */
 
       pHandle->current_pos = pHandle->search_pos;
-      if (adtsparser_peek_data(pHandle, poll_buff, ADTS_HEADER_SIZE) !=
+      if (adtsparser_peek_view(pHandle, &header, ADTS_HEADER_SIZE) !=
            AdtsParserNormal)
         {
           *uipErrDetail = AdtsParserConnotDataAccess;
@@ -416,9 +489,13 @@ int32_t AdtsParser_GetSamplingRate(AdtsHandle *pHandle,
 
       /* Check syncword. */
 
-      if (ADTS_CHECK_SYNCWORD(*poll_buff, *(poll_buff + 1)) == ADTS_OK)
+      uint8_t hdr0 = adtsparser_peek_byte(&header, 0);
+      uint8_t hdr1 = adtsparser_peek_byte(&header, 1);
+      uint8_t hdr2 = adtsparser_peek_byte(&header, 2);
+
+      if (ADTS_CHECK_SYNCWORD(hdr0, hdr1) == ADTS_OK)
         {
-          *pSmplingRate = ADTS_GET_SAMPLING_RATE(*(poll_buff + 2));
+          *pSmplingRate = ADTS_GET_SAMPLING_RATE(hdr2);
           *uipErrDetail = AdtsParserNormal;
           rc = ADTS_OK;
         }
@@ -39,6 +39,7 @@
 #include <string.h>
 
 #include "common/Mp3Parser.h"
+#include "common/BitReader.h"
 
 /*--------------------------------------------------------------------------*/
 static inline
@@ -135,6 +136,31 @@ static inline
   return Mp3ParserReturnFileFavorable;
 }
 
+/*--------------------------------------------------------------------------*/
+void mp3parser_read_header(const uint8_t *ptr_head,
+                           Mp3ParserHeader *ptr_header)
+{
+  BitReader br;
+
+  /* Read all fields in order through one reader. */
+
+  bitReaderInit(&br, ptr_head, MP3PARSER_HEADSIZE, 0);
+
+  ptr_header->syncword = bitReaderRead(&br, MP3PARSER_BITS_SYNCWORD);
+  ptr_header->id = bitReaderRead(&br, MP3PARSER_BITS_ID);
+  ptr_header->layer = bitReaderRead(&br, MP3PARSER_BITS_LAYER);
+  ptr_header->protection_bit = bitReaderRead(&br, MP3PARSER_BITS_PROTECTION);
+  ptr_header->bitrate_index = bitReaderRead(&br, MP3PARSER_BITS_BR);
+  ptr_header->sampling_frequency = bitReaderRead(&br, MP3PARSER_BITS_FS);
+  ptr_header->padding_bit = bitReaderRead(&br, MP3PARSER_BITS_PADDING);
+  ptr_header->private_bit = bitReaderRead(&br, MP3PARSER_BITS_PRIVATE);
+  ptr_header->mode = bitReaderRead(&br, MP3PARSER_BITS_MODE);
+  ptr_header->mode_extension = bitReaderRead(&br, MP3PARSER_BITS_MODEEXT);
+  ptr_header->copyright = bitReaderRead(&br, MP3PARSER_BITS_CPRIGHT);
+  ptr_header->original_home = bitReaderRead(&br, MP3PARSER_BITS_ORGHOME);
+  ptr_header->emphasis = bitReaderRead(&br, MP3PARSER_BITS_EMPHAS);
+}
+
 /*--------------------------------------------------------------------------*/
 static Mp3ParserReturnValueOfSyncSearch
   get_offset_mp3parser_search_sync(Mp3ParserLocalInfo *ptr_info)
@@ -172,17 +198,18 @@ static Mp3ParserReturnValueOfSyncSearch
               ptr_info->uhd.copy_byte[2] = *(ptr_check + 2);
               ptr_info->uhd.copy_byte[3] = *(ptr_check + 3);
 
+              Mp3ParserHeader header;
+              mp3parser_read_header(ptr_info->uhd.copy_byte, &header);
+
               /*  Check data integrity. */
 
-              if (MP3PARSER_GET_LAYER(ptr_info->uhd.copy_byte[1]) ==
-                   Mp3ParserLayerReserved)
+              if (header.layer == Mp3ParserLayerReserved)
                 {
                   /* As layer is reserved, continue syncword search. */
 
                   continue;
                 }
-              if (MP3PARSER_GET_FS(ptr_info->uhd.copy_byte[2]) ==
-                   MP3PARSER_FS_RESERVED)
+              if (header.sampling_frequency == MP3PARSER_FS_RESERVED)
                 {
                   /* As sampling_frequency is reserved,
                    * continue syncword search.
@@ -190,10 +217,8 @@ static Mp3ParserReturnValueOfSyncSearch
 
                   continue;
                 }
-              if ((MP3PARSER_GET_BR(ptr_info->uhd.copy_byte[2]) ==
-                   MP3PARSER_BITRATE_FREE) ||
-                   (MP3PARSER_GET_BR(ptr_info->uhd.copy_byte[2]) ==
-                   MP3PARSER_BITRATE_UNUSED))
+              if ((header.bitrate_index == MP3PARSER_BITRATE_FREE) ||
+                   (header.bitrate_index == MP3PARSER_BITRATE_UNUSED))
                 {
                   /* As bitrate_index is free or unused,
                    * continue syncword search.
@@ -201,8 +226,7 @@ static Mp3ParserReturnValueOfSyncSearch
 
                   continue;
                 }
-              if (MP3PARSER_GET_PRIVATE(ptr_info->uhd.copy_byte[2]) ==
-                   MP3PARSER_PRIVATEBIT_ISOUSED)
+              if (header.private_bit == MP3PARSER_PRIVATEBIT_ISOUSED)
                 {
                   /* Since unusable private_bit is used,
                    * continue syncword search.
@@ -210,8 +234,7 @@ static Mp3ParserReturnValueOfSyncSearch
 
                   continue;
                 }
-              if (MP3PARSER_GET_EMPHAS(ptr_info->uhd.copy_byte[3]) ==
-                   MP3PARSER_EMPHASIS_RESERVED)
+              if (header.emphasis == MP3PARSER_EMPHASIS_RESERVED)
                 {
                   /* As emphasis is reserved, continue syncword search. */
 
@@ -352,14 +375,14 @@ static Mp3ParserReturnValueOfSyncSearch
 
       /* Calculate frame length from header. */
 
-      uint8_t copy_byte1 = ptr_info->uhd.copy_byte[1];
-      uint8_t copy_byte2 = ptr_info->uhd.copy_byte[2];
+      Mp3ParserHeader header;
+      mp3parser_read_header(ptr_info->uhd.copy_byte, &header);
       ptr_info->frame_length_1 =
-        MP3PARSER_CALC_FRAME_SIZE(MP3PARSER_GET_ID(copy_byte1),
-                                  MP3PARSER_GET_LAYER(copy_byte1),
-                                  MP3PARSER_GET_BR(copy_byte2),
-                                  MP3PARSER_GET_FS(copy_byte2),
-                                  MP3PARSER_GET_PADDING(copy_byte2));
+        MP3PARSER_CALC_FRAME_SIZE(header.id,
+                                  header.layer,
+                                  header.bitrate_index,
+                                  header.sampling_frequency,
+                                  header.padding_bit);
       if (ptr_info->sync_offset_1 != 0)
         {
           ptr_hndl->current_offset = ptr_info->sync_offset_1;
@@ -781,19 +804,20 @@ int32_t  Mp3Parser_getSamplingRate(MP3PARSER_Handle *ptr_hndl,
 
   /* Get sampling rate.(convert index to value)*/
 
-  uint32_t idx = 0;
-  if (MP3PARSER_GET_ID(local_info.uhd.copy_byte[1]) == Mp3ParserMpeg1)
+  Mp3ParserHeader header;
+  mp3parser_read_header(local_info.uhd.copy_byte, &header);
+
+  uint32_t idx = header.sampling_frequency;
+  if (header.id == Mp3ParserMpeg1)
     {
       /* Versoin-1(MPEG-1). */
 
-      idx = MP3PARSER_GET_FS(local_info.uhd.copy_byte[2]);
       *ptr_sampling_rate = mp3_parser_v1_sampling_frequency[idx];
     }
   else
     {
       /* Versoin-2(MPEG-2). */
 
-      idx = MP3PARSER_GET_FS(local_info.uhd.copy_byte[2]);
       *ptr_sampling_rate = mp3_parser_v2_sampling_frequency[idx];
     }
 
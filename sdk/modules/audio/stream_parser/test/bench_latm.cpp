@@ -0,0 +1,292 @@
+/****************************************************************************
+ * modules/audio/stream_parser/test/bench_latm.cpp
+ *
+ *   Copyright 2026 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/LatmAacLc.h"
+#include "common/BitReader.h"
+
+#define BENCH_DATA_SIZE    8192
+#define BENCH_FIELD_NUM    8192
+#define BENCH_REPEAT       200
+#define BENCH_FRAME_REPEAT 100000
+#define BENCH_PAYLOAD_SIZE 300
+
+/* Byte-wise reader which the LATM parser used before the cached one.
+ * Each field is extracted from at most 2 bytes at the current pointer.
+ */
+
+struct byte_reader_s
+{
+  const uint8_t *ptr;
+  uint32_t total_bit_length;
+};
+
+static const uint8_t s_mask[9] =
+{
+  0x00, 0x80, 0xc0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfe, 0xff
+};
+
+static uint8_t byteReaderRead(struct byte_reader_s *br, uint32_t length)
+{
+  uint8_t value;
+  uint8_t modulo_bit = (uint8_t)(br->total_bit_length % 8);
+
+  if ((8 - modulo_bit) >= (uint8_t)length)
+    {
+      value = (*br->ptr & (s_mask[length] >> modulo_bit));
+      br->total_bit_length += length;
+      if (br->total_bit_length % 8)
+        {
+          value >>= (8 - (br->total_bit_length % 8));
+        }
+    }
+  else
+    {
+      value = (*br->ptr & ~s_mask[modulo_bit]);
+      value <<= (length - (8 - modulo_bit));
+      br->total_bit_length += (8 - modulo_bit);
+      br->ptr++;
+      modulo_bit = (length - (8 - modulo_bit));
+      value |= ((*br->ptr & s_mask[modulo_bit]) >> (8 - modulo_bit));
+      br->total_bit_length += modulo_bit;
+    }
+
+  if (!(br->total_bit_length % 8))
+    {
+      br->ptr++;
+    }
+
+  return value;
+}
+
+/* MSB first writer to build a LATM frame. */
+
+struct bit_writer_s
+{
+  uint8_t *ptr;
+  uint32_t bit_pos;
+};
+
+static void bitWrite(struct bit_writer_s *bw, uint32_t value, uint32_t length)
+{
+  while (length--)
+    {
+      uint32_t bit = (value >> length) & 1;
+      bw->ptr[bw->bit_pos / 8] |= bit << (7 - (bw->bit_pos % 8));
+      bw->bit_pos++;
+    }
+}
+
+static uint8_t s_data[BENCH_DATA_SIZE];
+static uint8_t s_widths[BENCH_FIELD_NUM];
+static uint8_t s_frame[BENCH_PAYLOAD_SIZE + 32];
+
+static double now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Read fields of 1 to 8 bits, as most of the LATM header fields are. */
+
+static int bench_bit_reader(void)
+{
+  struct byte_reader_s byte_reader;
+  BitReader br;
+  uint32_t sum_byte = 0;
+  uint32_t sum_cached = 0;
+  uint32_t bits = 0;
+  double t_byte;
+  double t_cached;
+  double start;
+  int i;
+  int r;
+
+  srand(1);
+  for (i = 0; i < BENCH_DATA_SIZE; i++)
+    {
+      s_data[i] = (uint8_t)rand();
+    }
+
+  for (i = 0; i < BENCH_FIELD_NUM; i++)
+    {
+      s_widths[i] = (uint8_t)(1 + rand() % 8);
+      bits += s_widths[i];
+    }
+
+  if (bits > BENCH_DATA_SIZE * 8)
+    {
+      printf("bench_latm: data is too short for the fields\n");
+      return 1;
+    }
+
+  /* Both readers must give the same fields. */
+
+  byte_reader.ptr = s_data;
+  byte_reader.total_bit_length = 0;
+  bitReaderInit(&br, s_data, sizeof(s_data), 0);
+  for (i = 0; i < BENCH_FIELD_NUM; i++)
+    {
+      uint32_t expect = byteReaderRead(&byte_reader, s_widths[i]);
+      uint32_t value = bitReaderRead(&br, s_widths[i]);
+
+      if (expect != value)
+        {
+          printf("bench_latm: field %d differs: %u != %u\n",
+                 i, (unsigned)value, (unsigned)expect);
+          return 1;
+        }
+    }
+
+  start = now_ns();
+  for (r = 0; r < BENCH_REPEAT; r++)
+    {
+      byte_reader.ptr = s_data;
+      byte_reader.total_bit_length = 0;
+      for (i = 0; i < BENCH_FIELD_NUM; i++)
+        {
+          sum_byte += byteReaderRead(&byte_reader, s_widths[i]);
+        }
+    }
+  t_byte = now_ns() - start;
+
+  start = now_ns();
+  for (r = 0; r < BENCH_REPEAT; r++)
+    {
+      bitReaderInit(&br, s_data, sizeof(s_data), 0);
+      for (i = 0; i < BENCH_FIELD_NUM; i++)
+        {
+          sum_cached += bitReaderRead(&br, s_widths[i]);
+        }
+    }
+  t_cached = now_ns() - start;
+
+  if (sum_byte != sum_cached)
+    {
+      printf("bench_latm: checksum differs\n");
+      return 1;
+    }
+
+  printf("bit reader: byte-wise %.2f ns/field, cached %.2f ns/field\n",
+         t_byte / (BENCH_REPEAT * BENCH_FIELD_NUM),
+         t_cached / (BENCH_REPEAT * BENCH_FIELD_NUM));
+  return 0;
+}
+
+/* AudioMuxElement with StreamMuxConfig of AAC-LC, 48kHz, 2ch and
+ * a payload of BENCH_PAYLOAD_SIZE bytes.
+ */
+
+static uint32_t build_frame(void)
+{
+  struct bit_writer_s bw;
+  uint32_t len = BENCH_PAYLOAD_SIZE;
+  uint32_t i;
+
+  memset(s_frame, 0, sizeof(s_frame));
+  bw.ptr = s_frame;
+  bw.bit_pos = 0;
+
+  bitWrite(&bw, 0, 1);     /* useSameStreamMux */
+  bitWrite(&bw, 0, 1);     /* audioMuxVersion */
+  bitWrite(&bw, 1, 1);     /* allStreamsSameTimeFraming */
+  bitWrite(&bw, 0, 6);     /* numSubFrames */
+  bitWrite(&bw, 0, 4);     /* numProgram */
+  bitWrite(&bw, 0, 3);     /* numLayer */
+  bitWrite(&bw, 2, 5);     /* audioObjectType: AAC-LC */
+  bitWrite(&bw, 3, 4);     /* samplingFrequencyIndex: 48kHz */
+  bitWrite(&bw, 2, 4);     /* channelConfiguration */
+  bitWrite(&bw, 0, 3);     /* frameLength, dependsOnCore, extension */
+  bitWrite(&bw, 0, 3);     /* frameLengthType */
+  bitWrite(&bw, 0xff, 8);  /* latmBufferFullness */
+  bitWrite(&bw, 0, 1);     /* otherDataPresent */
+  bitWrite(&bw, 0, 1);     /* crcCheckPresent */
+
+  for (; len >= 255; len -= 255)
+    {
+      bitWrite(&bw, 255, 8);  /* PayloadLengthInfo */
+    }
+  bitWrite(&bw, len, 8);
+
+  for (i = 0; i < BENCH_PAYLOAD_SIZE; i++)
+    {
+      bitWrite(&bw, i & 0xff, 8);  /* PayloadMux */
+    }
+
+  return (bw.bit_pos + 7) / 8;
+}
+
+static int bench_latm_frame(void)
+{
+  InfoStreamMuxConfig config;
+  uint32_t size = build_frame();
+  uint8_t *next = NULL;
+  double start;
+  int r;
+
+  start = now_ns();
+  for (r = 0; r < BENCH_FRAME_REPEAT; r++)
+    {
+      memset(&config, 0, sizeof(config));
+      next = AACLC_getNextLatm(s_frame, size, &config);
+    }
+  start = now_ns() - start;
+
+  if (next == NULL ||
+      config.info_stream_frame[0].frame_length != BENCH_PAYLOAD_SIZE)
+    {
+      printf("bench_latm: frame is not parsed\n");
+      return 1;
+    }
+
+  printf("AudioMuxElement: %.1f ns/frame\n", start / BENCH_FRAME_REPEAT);
+  return 0;
+}
+
+int main(void)
+{
+  if (bench_bit_reader() || bench_latm_frame())
+    {
+      return 1;
+    }
+
+  return 0;
+}
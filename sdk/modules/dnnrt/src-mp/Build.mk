@@ -45,10 +45,13 @@ INCLUDES := -I$(RUNTIME_EXTERN_DIR)/include
 INCLUDES += -I$(RUNTIME_EXTERN_SRCDIR)/runtime
 INCLUDES += -I$(RUNTIME_EXTERN_SRCDIR)/functions
 INCLUDES += -Isrc-mp
+INCLUDES += -Isrc/runtime
 
 CSRC_PATH += src-mp/runtime
+CSRC_PATH += src/runtime
 CSRCS += runtime_client.c
 CSRCS += mp_manager.c
+CSRCS += vbuffer_plan.c
 
 VPATH += $(CSRC_PATH)
 ROOTDEPPATH =$(foreach dir,$(CSRC_PATH), --dep-path $(dir))
@@ -32,6 +32,7 @@
  *
  ****************************************************************************/
 
+#include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
 #include <limits.h>
@@ -49,6 +50,11 @@ typedef struct lib_global_context
 {
   mptask_t bin_clone_task;
   dnn_mptask_t mptask[MAX_MP_CORE];
+  mp_api_call_t async_call[CONFIG_DNN_RT_ASYNC_DEPTH];  /* API calls posted
+                                                         * by
+                                                         * dnn_mpmgr_post_api() */
+  uint8_t async_head;           /* oldest call not acknowledged yet */
+  uint8_t async_pending;        /* number of calls not acknowledged yet */
   mp_message_buffer_t msg_buf;  /* messages send from master to library must be 
                                  * placed on Nuttx memory, * so reallocate
                                  * buffer here */
@@ -103,15 +109,8 @@ static void dnn_mpmgr_process_msg(dnn_mptask_t * task, int msg, uint32_t data)
 }
 
 static int
-dnn_mpmgr_send_msg(dnn_mptask_t * task, int8_t msgid, void *data, uint32_t ms)
+dnn_mpmgr_wait_ack(dnn_mptask_t * task, int8_t msgid, uint32_t ms)
 {
-  int ret = mpmq_send(&task->mq, msgid, (uint32_t) data);
-
-  if (ret < 0)
-    {
-      return ret;
-    }
-
   int resp;
   uint32_t rdata;
   for (;;)
@@ -144,9 +143,41 @@ dnn_mpmgr_send_msg(dnn_mptask_t * task, int8_t msgid, void *data, uint32_t ms)
   return 0;
 }
 
+static int
+dnn_mpmgr_send_msg(dnn_mptask_t * task, int8_t msgid, void *data, uint32_t ms)
+{
+  int ret = mpmq_send(&task->mq, msgid, (uint32_t) data);
+
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return dnn_mpmgr_wait_ack(task, msgid, ms);
+}
+
+static void dnn_mpmgr_pack_api(mp_api_call_t * api_call, int api,
+                               int num_args, va_list vl)
+{
+  int i;
+  int max_args = _S(api_call->arg);
+
+  if (num_args > max_args)
+    {
+      num_args = max_args;
+    }
+
+  memset(api_call, 0, sizeof(*api_call));
+  api_call->api = api;
+  for (i = 0; i < num_args; ++i)
+    {
+      api_call->arg[i] = va_arg(vl, int);
+    }
+}
+
 int dnn_mpmgr_call_api(int api, int num_args, ...)
 {
-  int i, ret;
+  int ret;
   mp_api_call_t api_call;
   lib_global_context_t *ctx = dnn_mpmgr_global_context();
   dnn_mptask_t *master = &ctx->mptask[0];
@@ -158,19 +189,16 @@ int dnn_mpmgr_call_api(int api, int num_args, ...)
       goto bye;
     }
 
-  int max_args = _S(api_call.arg);
-  if (num_args > max_args)
+  /* acknowledgements must not be mixed with the posted API call */
+  if (ctx->async_pending)
     {
-      num_args = max_args;
+      ret = -EBUSY;
+      goto bye;
     }
 
-  memset(&api_call, 0, sizeof(api_call));
-  api_call.api = api;
   va_start(vl, num_args);
-  for (i = 0; i < num_args; ++i)
-    {
-      api_call.arg[i] = va_arg(vl, int);
-    }
+  dnn_mpmgr_pack_api(&api_call, api, num_args, vl);
+  va_end(vl);
 
   ret = dnn_mpmgr_send_msg(master, MP_MSG_CALL_API, &api_call, 0);
   if (ret)
@@ -182,6 +210,64 @@ bye:
   return ret;
 }
 
+int dnn_mpmgr_post_api(int api, int num_args, ...)
+{
+  int ret;
+  mp_api_call_t *call;
+  lib_global_context_t *ctx = dnn_mpmgr_global_context();
+  dnn_mptask_t *master = &ctx->mptask[0];
+  va_list vl;
+
+  if (!master->in_use)
+    {
+      return -EPERM;
+    }
+
+  if (ctx->async_pending >= _S(ctx->async_call))
+    {
+      return -EBUSY;
+    }
+
+  /* MP core handles the posted calls one by one in the order of messages */
+  call = &ctx->async_call[(ctx->async_head + ctx->async_pending) %
+                          _S(ctx->async_call)];
+  va_start(vl, num_args);
+  dnn_mpmgr_pack_api(call, api, num_args, vl);
+  va_end(vl);
+
+  ret = mpmq_send(&master->mq, MP_MSG_CALL_API, (uint32_t) call);
+  if (ret == 0)
+    {
+      ctx->async_pending++;
+    }
+
+  return ret;
+}
+
+int dnn_mpmgr_poll_api(uint32_t ms)
+{
+  int ret;
+  lib_global_context_t *ctx = dnn_mpmgr_global_context();
+  dnn_mptask_t *master = &ctx->mptask[0];
+
+  if (!ctx->async_pending)
+    {
+      return -EPERM;
+    }
+
+  /* memory requests from MP core are served while waiting */
+  ret = dnn_mpmgr_wait_ack(master, MP_MSG_CALL_API, ms);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = ctx->async_call[ctx->async_head].ret;
+  ctx->async_head = (ctx->async_head + 1) % _S(ctx->async_call);
+  ctx->async_pending--;
+  return ret;
+}
+
 static int dnn_mpmgr_start_task(lib_global_context_t * ctx, int slave_num)
 {
   int i, ret = 0;
@@ -32,9 +32,83 @@
  *
  ****************************************************************************/
 
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <dnnrt/runtime.h>
 #include "runtime_client.h"
+#include "vbuffer_plan.h"
+
+#define MAX_ASYNC_INPUT_NUM (8)
+#define MAX_ARENA_RT_NUM (8)
+
+/* forward propagation submitted to MP core */
+typedef struct dnn_async_call
+{
+  dnn_runtime_t *rt;            /* NULL if this slot is free */
+  const void *inputs[MAX_ASYNC_INPUT_NUM];      /* read by MP core */
+  bool done;                    /* acknowledged by MP core */
+  int ret;                      /* its result */
+} dnn_async_call_t;
+
+/* arena planned for an initialized dnn_runtime_t */
+typedef struct dnn_rt_arena
+{
+  dnn_runtime_t *rt;
+  size_t bsize;
+} dnn_rt_arena_t;
+
+/* the calls not acknowledged yet always lie from s_async_head to
+ * s_async_tail, since MP core acknowledges them in the submitted order */
+static dnn_async_call_t s_async_calls[CONFIG_DNN_RT_ASYNC_DEPTH];
+static int s_async_head;
+static int s_async_tail;
+static dnn_rt_arena_t s_arenas[MAX_ARENA_RT_NUM];
+static size_t s_peak_arena_bsize;
+
+/* the worker packs variable buffers by the same planner, so running it
+ * here on the network gives the size of the arena the worker allocates */
+static void dnn_client_add_arena(dnn_runtime_t * rt,
+                                 const nn_network_t * network)
+{
+  int i;
+  dnn_vbuffer_alloc_info_t alloc_info;
+
+  if (dnn_peek_vbuffers(network, &alloc_info) != RT_RET_NOERROR ||
+      dnn_plan_vbuffers(network, &alloc_info) != RT_RET_NOERROR)
+    {
+      return;
+    }
+
+  for (i = 0; i < MAX_ARENA_RT_NUM; i++)
+    {
+      if (s_arenas[i].rt == NULL)
+        {
+          s_arenas[i].rt = rt;
+          s_arenas[i].bsize = alloc_info.arena_bsize;
+          break;
+        }
+    }
+
+  if (alloc_info.arena_bsize > s_peak_arena_bsize)
+    {
+      s_peak_arena_bsize = alloc_info.arena_bsize;
+    }
+}
+
+static void dnn_client_remove_arena(dnn_runtime_t * rt)
+{
+  int i;
+
+  for (i = 0; i < MAX_ARENA_RT_NUM; i++)
+    {
+      if (s_arenas[i].rt == rt)
+        {
+          s_arenas[i].rt = NULL;
+          s_arenas[i].bsize = 0u;
+        }
+    }
+}
 
 int dnn_initialize(dnn_config_t * config)
 {
@@ -75,12 +149,28 @@ int dnn_finalize(void)
 
 int dnn_runtime_initialize(dnn_runtime_t * rt, const nn_network_t * network)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_INIT, 2, rt, network);
+  int ret;
+
+  ret = dnn_mpmgr_call_api(DNNRT_API_RT_INIT, 2, rt, network);
+  if (ret == RT_RET_NOERROR)
+    {
+      dnn_client_add_arena(rt, network);
+    }
+
+  return ret;
 }
 
 int dnn_runtime_finalize(dnn_runtime_t * rt)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_FINI, 1, rt);
+  int ret;
+
+  ret = dnn_mpmgr_call_api(DNNRT_API_RT_FINI, 1, rt);
+  if (ret == RT_RET_NOERROR)
+    {
+      dnn_client_remove_arena(rt);
+    }
+
+  return ret;
 }
 
 int
@@ -90,6 +180,164 @@ dnn_runtime_forward(dnn_runtime_t * rt, const void *inputs[],
   return dnn_mpmgr_call_api(DNNRT_API_RT_FOWARD, 3, rt, inputs, input_num);
 }
 
+int dnn_runtime_profile(dnn_runtime_t * rt, dnn_layer_profile_t * profile,
+                        unsigned short length)
+{
+  /* the profiler is not available on multicore processing */
+  return -EPERM;
+}
+
+static size_t dnn_output_bsize(dnn_runtime_t * rt, unsigned char index)
+{
+  nn_variable_t *var = dnn_runtime_output_variable(rt, index);
+  int size = dnn_runtime_output_size(rt, index);
+
+  if (var == NULL || size < 0)
+    {
+      return 0;
+    }
+
+  if (var->type == NN_DATA_TYPE_FLOAT)
+    {
+      return size * sizeof(float);
+    }
+  else if (var->type == NN_DATA_TYPE_INT16)
+    {
+      return size * sizeof(int16_t);
+    }
+  else
+    {
+      return size * sizeof(int8_t);
+    }
+}
+
+int dnn_runtime_forward_batch(dnn_runtime_t * rt, const void *inputs[],
+                              unsigned char input_num, void *outputs[],
+                              unsigned short batch_num)
+{
+  int ret;
+  int output_num;
+  unsigned short b;
+  int i;
+
+  DNN_CHECK_NULL_RET(inputs, -EINVAL);
+  DNN_CHECK_NULL_RET(outputs, -EINVAL);
+  output_num = dnn_runtime_output_num(rt);
+  if (output_num < 0)
+    {
+      return output_num;
+    }
+
+  void *output_buf[output_num];
+  size_t output_bsize[output_num];
+
+  /* output buffers stay in place, so look them up once for all sets */
+  for (i = 0; i < output_num; i++)
+    {
+      output_buf[i] = dnn_runtime_output_buffer(rt, i);
+      output_bsize[i] = dnn_output_bsize(rt, i);
+    }
+
+  for (b = 0; b < batch_num; b++)
+    {
+      ret = dnn_runtime_forward(rt, &inputs[b * input_num], input_num);
+      if (ret != RT_RET_NOERROR)
+        {
+          return ret;
+        }
+
+      for (i = 0; i < output_num; i++)
+        {
+          void *out = outputs[b * output_num + i];
+          if (out != NULL)
+            {
+              memcpy(out, output_buf[i], output_bsize[i]);
+            }
+        }
+    }
+
+  return RT_RET_NOERROR;
+}
+
+int dnn_runtime_forward_submit(dnn_runtime_t * rt, const void *inputs[],
+                               unsigned char input_num)
+{
+  int ret;
+  int i;
+  dnn_async_call_t *call = &s_async_calls[s_async_tail];
+
+  DNN_CHECK_NULL_RET(rt, -EINVAL);
+  for (i = 0; i < CONFIG_DNN_RT_ASYNC_DEPTH; i++)
+    {
+      /* its outputs would be overwritten before they are polled */
+      if (s_async_calls[i].rt == rt)
+        {
+          return -EBUSY;
+        }
+    }
+  if (call->rt != NULL)
+    {
+      return -EBUSY;
+    }
+  if (input_num > _S(call->inputs))
+    {
+      return -EINVAL;
+    }
+
+  /* MP core reads the array of input pointers during forward propagation */
+  memcpy(call->inputs, inputs, input_num * sizeof(inputs[0]));
+  ret = dnn_mpmgr_post_api(DNNRT_API_RT_FOWARD, 3, rt, call->inputs,
+                           input_num);
+  if (ret == 0)
+    {
+      call->rt = rt;
+      call->done = false;
+      s_async_tail = (s_async_tail + 1) % CONFIG_DNN_RT_ASYNC_DEPTH;
+    }
+
+  return ret;
+}
+
+int dnn_runtime_forward_poll(dnn_runtime_t * rt, unsigned int ms)
+{
+  int ret;
+  int i;
+  dnn_async_call_t *call = NULL;
+  dnn_async_call_t *oldest;
+
+  for (i = 0; i < CONFIG_DNN_RT_ASYNC_DEPTH; i++)
+    {
+      if (rt != NULL && s_async_calls[i].rt == rt)
+        {
+          call = &s_async_calls[i];
+        }
+    }
+  if (call == NULL)
+    {
+      return -EPERM;
+    }
+
+  /* calls submitted earlier are acknowledged first, and their results are
+   * kept until they are polled */
+  while (!call->done)
+    {
+      ret = dnn_mpmgr_poll_api(ms == 0u ? MPMQ_NONBLOCK :
+                               ms == DNN_POLL_FOREVER ? 0u : ms);
+      if (ret == -EAGAIN || ret == -ETIMEDOUT)
+        {
+          return ret;
+        }
+
+      oldest = &s_async_calls[s_async_head];
+      oldest->ret = ret;
+      oldest->done = true;
+      s_async_head = (s_async_head + 1) % CONFIG_DNN_RT_ASYNC_DEPTH;
+    }
+
+  call->rt = NULL;
+  return call->ret;
+}
+
 int dnn_runtime_input_num(dnn_runtime_t * rt)
 {
   return dnn_mpmgr_call_api(DNNRT_API_RT_INPUT_NUM, 1, rt);
@@ -166,6 +414,7 @@ int dnn_nuttx_mallinfo(dnn_mallinfo_t * info)
 {
   DNN_CHECK_NULL_RET(info, -EINVAL);
   struct mallinfo mem;
+  int i;
 
   mem = mallinfo();
   info->cpu = 2;
@@ -173,5 +422,13 @@ int dnn_nuttx_mallinfo(dnn_mallinfo_t * info)
   info->used_bytes = mem.uordblks;
   info->largest_bytes = mem.mxordblk;
 
+  /* arenas planned by the worker for the initialized runtimes */
+  info->arena_bytes = 0u;
+  for (i = 0; i < MAX_ARENA_RT_NUM; i++)
+    {
+      info->arena_bytes += s_arenas[i].bsize;
+    }
+  info->peak_arena_bytes = s_peak_arena_bsize;
+
   return 0;
 }
@@ -143,6 +143,11 @@ extern "C"
   int dnn_mpmgr_unload(void);   /* unload MP image */
   int dnn_mpmgr_call_api(int api, int num_args, ...);   /* send API call *
                                                          * request */
+  int dnn_mpmgr_post_api(int api, int num_args, ...);   /* send API call *
+                                                         * request without *
+                                                         * waiting */
+  int dnn_mpmgr_poll_api(uint32_t ms);  /* wait for the oldest posted API *
+                                         * call */
 
 #  ifdef __cplusplus
 }
@@ -49,6 +49,7 @@ INCLUDES += -Isrc
 
 CSRCS +=  runtime_nnabla.c
 CSRCS +=  shared_chunk.c
+CSRCS +=  vbuffer_plan.c
 CSRCS +=  affine.c
 CSRCS +=  convolution.c
 CSRC_PATH += src/functions
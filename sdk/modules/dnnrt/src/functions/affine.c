@@ -207,12 +207,12 @@ static rt_function_error_t dnnrt_exec_affine_float(rt_function_t * f)
           y[i++] = sum1;
         }
 
+      /* bias is indexed by output neuron, not by sample */
       if (bias)
         {
-          float *b = bias + output_offset;
           for (i = 0; i < output_loop_size; i++)
             {
-              y[i] += b[i];
+              y[i] += bias[i];
             }
         }
     }
@@ -330,6 +330,6 @@ rt_return_value_t dnnrt_affine_alloc(nn_network_t * net, void *function_context)
       scratch_buf_bsize = sizeof(q15_t) * p->input_loop_size;
     }
 
-  dnn_req_scratch_buf(scratch_buf_bsize);
+  dnn_req_scratch_buf(f, scratch_buf_bsize);
   return RT_RET_FUNCTION_MATCH;
 }
@@ -53,6 +53,7 @@
 
 typedef int16_t fixed16_t;
 typedef int8_t fixed8_t;
+typedef rt_function_error_t(*conv_exec_func_t) (rt_function_t * f);
 
 /*
  * group (g) [default 1]: If g > 1, we restrict the connectivity of each filter
@@ -249,6 +250,296 @@ static rt_function_error_t dnnrt_exec_convolution_float(rt_function_t * f)
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
+/* depthwise convolution whose groups have one input channel each,
+ * or 1x1 pointwise convolution without padding and striding */
+typedef struct conv_fast
+{
+  const convolution_local_context_t *c;
+  nn_data_type_t type;
+  const void *im_in;
+  const void *wt;
+  const void *bias;
+  void *im_out;
+  int in_x;
+  int in_y;
+  int ch_in;
+  int ker_x;
+  int ker_y;
+  int out_x;
+  int out_y;
+  int multiplier;               /* output channels per group in depthwise */
+  uint16_t bias_shift;
+  uint16_t out_shift;
+} conv_fast_t;
+
+typedef void (*conv_fast_func_t) (const conv_fast_t * s, int begin, int end);
+
+static inline int32_t conv_fast_bias(const conv_fast_t * s, int ch)
+{
+  if (s->type == NN_DATA_TYPE_INT16)
+    {
+      return s->bias ? ((int32_t) ((const q15_t *)s->bias)[ch]
+                        << s->bias_shift) + NN_ROUND(s->out_shift) : 0;
+    }
+  else
+    {
+      return (s->bias ? (int32_t) ((const q7_t *)s->bias)[ch]
+              << s->bias_shift : 0) + NN_ROUND(s->out_shift);
+    }
+}
+
+static inline int conv_fast_begin(int pos, int stride, int pad)
+{
+  int begin = pad - pos * stride;
+  return begin > 0 ? begin : 0;
+}
+
+static inline int conv_fast_end(int pos, int stride, int pad, int ker, int in)
+{
+  int end = in + pad - pos * stride;
+  return end < ker ? end : ker;
+}
+
+/* each output channel reads a single input plane, so the kernel window is
+ * clipped to the input instead of expanding padded columns by im2col */
+static void dnnrt_convolution_depthwise_run(const conv_fast_t * s,
+                                            int begin, int end)
+{
+  const convolution_local_context_t *c = s->c;
+  int pad_x = c->pad.data[1];
+  int pad_y = c->pad.data[0];
+  int stride_x = c->stride.data[1];
+  int stride_y = c->stride.data[0];
+  int in_size = s->in_x * s->in_y;
+  int out_size = s->out_x * s->out_y;
+  int ker_size = s->ker_x * s->ker_y;
+  int ch, ox, oy, kx, ky;
+
+  for (ch = begin; ch < end; ch++)
+    {
+      int in_offset = (ch / s->multiplier) * in_size;
+      int out_offset = ch * out_size;
+
+      for (oy = 0; oy < s->out_y; oy++)
+        {
+          int ky_begin = conv_fast_begin(oy, stride_y, pad_y);
+          int ky_end = conv_fast_end(oy, stride_y, pad_y, s->ker_y, s->in_y);
+          int iy = oy * stride_y - pad_y;
+
+          for (ox = 0; ox < s->out_x; ox++)
+            {
+              int kx_begin = conv_fast_begin(ox, stride_x, pad_x);
+              int kx_end = conv_fast_end(ox, stride_x, pad_x, s->ker_x,
+                                         s->in_x);
+              int ix = ox * stride_x - pad_x;
+              int pos = oy * s->out_x + ox;
+
+              if (s->type == NN_DATA_TYPE_FLOAT)
+                {
+                  const float *in = (const float *)s->im_in + in_offset;
+                  const float *wt = (const float *)s->wt + ch * ker_size;
+                  float sum = s->bias ? ((const float *)s->bias)[ch] : 0;
+
+                  for (ky = ky_begin; ky < ky_end; ky++)
+                    {
+                      const float *row = in + (iy + ky) * s->in_x + ix;
+                      const float *w = wt + ky * s->ker_x;
+                      for (kx = kx_begin; kx < kx_end; kx++)
+                        {
+                          sum += w[kx] * row[kx];
+                        }
+                    }
+                  ((float *)s->im_out)[out_offset + pos] = sum;
+                }
+              else if (s->type == NN_DATA_TYPE_INT16)
+                {
+                  const q15_t *in = (const q15_t *)s->im_in + in_offset;
+                  const q15_t *wt = (const q15_t *)s->wt + ch * ker_size;
+                  q31_t sum = conv_fast_bias(s, ch);
+
+                  for (ky = ky_begin; ky < ky_end; ky++)
+                    {
+                      const q15_t *row = in + (iy + ky) * s->in_x + ix;
+                      const q15_t *w = wt + ky * s->ker_x;
+                      for (kx = kx_begin; kx < kx_end; kx++)
+                        {
+                          sum += w[kx] * row[kx];
+                        }
+                    }
+                  ((q15_t *) s->im_out)[out_offset + pos] =
+                    (q15_t) __SSAT((sum >> s->out_shift), 16);
+                }
+              else
+                {
+                  const q7_t *in = (const q7_t *)s->im_in + in_offset;
+                  const q7_t *wt = (const q7_t *)s->wt + ch * ker_size;
+                  q31_t sum = conv_fast_bias(s, ch);
+
+                  for (ky = ky_begin; ky < ky_end; ky++)
+                    {
+                      const q7_t *row = in + (iy + ky) * s->in_x + ix;
+                      const q7_t *w = wt + ky * s->ker_x;
+                      for (kx = kx_begin; kx < kx_end; kx++)
+                        {
+                          sum += w[kx] * row[kx];
+                        }
+                    }
+                  ((q7_t *) s->im_out)[out_offset + pos] =
+                    (q7_t) __SSAT((sum >> s->out_shift), 8);
+                }
+            }
+        }
+    }
+}
+
+/* a 1x1 convolution is a matrix product of weights and input planes.
+ * each output plane is accumulated row by row so that all the loads are
+ * sequential; fixed point planes accumulate in the q31 scratch buffer */
+static void dnnrt_convolution_pointwise_run(const conv_fast_t * s,
+                                            int begin, int end)
+{
+  int size = s->out_x * s->out_y;
+  int ch, ic, i;
+
+  for (ch = begin; ch < end; ch++)
+    {
+      if (s->type == NN_DATA_TYPE_FLOAT)
+        {
+          const float *in = (const float *)s->im_in;
+          const float *wt = (const float *)s->wt + ch * s->ch_in;
+          float *out = (float *)s->im_out + ch * size;
+          float bias = s->bias ? ((const float *)s->bias)[ch] : 0;
+
+          for (i = 0; i < size; i++)
+            {
+              out[i] = bias;
+            }
+          for (ic = 0; ic < s->ch_in; ic++, in += size)
+            {
+              float w = wt[ic];
+              for (i = 0; i < size; i++)
+                {
+                  out[i] += w * in[i];
+                }
+            }
+        }
+      else
+        {
+          q31_t *acc = (q31_t *) dnn_scratch_buf();
+          q31_t bias = conv_fast_bias(s, ch);
+
+          for (i = 0; i < size; i++)
+            {
+              acc[i] = bias;
+            }
+
+          if (s->type == NN_DATA_TYPE_INT16)
+            {
+              const q15_t *in = (const q15_t *)s->im_in;
+              const q15_t *wt = (const q15_t *)s->wt + ch * s->ch_in;
+              q15_t *out = (q15_t *) s->im_out + ch * size;
+
+              for (ic = 0; ic < s->ch_in; ic++, in += size)
+                {
+                  q31_t w = wt[ic];
+                  for (i = 0; i < size; i++)
+                    {
+                      acc[i] += w * in[i];
+                    }
+                }
+              for (i = 0; i < size; i++)
+                {
+                  out[i] = (q15_t) __SSAT((acc[i] >> s->out_shift), 16);
+                }
+            }
+          else
+            {
+              const q7_t *in = (const q7_t *)s->im_in;
+              const q7_t *wt = (const q7_t *)s->wt + ch * s->ch_in;
+              q7_t *out = (q7_t *) s->im_out + ch * size;
+
+              for (ic = 0; ic < s->ch_in; ic++, in += size)
+                {
+                  q31_t w = wt[ic];
+                  for (i = 0; i < size; i++)
+                    {
+                      acc[i] += w * in[i];
+                    }
+                }
+              for (i = 0; i < size; i++)
+                {
+                  out[i] = (q7_t) __SSAT((acc[i] >> s->out_shift), 8);
+                }
+            }
+        }
+    }
+}
+
+static rt_function_error_t dnnrt_exec_convolution_fast(rt_function_t * f,
+                                                       conv_fast_func_t func)
+{
+  convolution_local_context_t *c =
+    (convolution_local_context_t *) f->local_context;
+  convolution_private_t *p = (convolution_private_t *) (c->data);
+  rt_variable_t *x = f->inputs[X];
+  rt_variable_t *w = f->inputs[WEIGHT];
+  rt_variable_t *y = f->outputs[Y0];
+  rt_variable_t *bias = p->b_var.v;
+  int group = c->group;
+  int in_bsize = 0;
+  int out_bsize = 0;
+  int elem_bsize;
+  nn_size_t b;
+  conv_fast_t s;
+
+  s.c = c;
+  s.type = x->type;
+  s.wt = w->data;
+  s.bias = bias ? bias->data : NULL;
+  s.in_x = p->in_var.shape.data[W];
+  s.in_y = p->in_var.shape.data[H];
+  s.ch_in = p->in_var.shape.data[I];
+  s.ker_x = p->w_var.shape.data[W];
+  s.ker_y = p->w_var.shape.data[H];
+  s.out_x = p->out_var.shape.data[W];
+  s.out_y = p->out_var.shape.data[H];
+  s.multiplier = p->out_var.shape.data[I];
+  s.out_shift = 0;
+  s.bias_shift = 0;
+
+  elem_bsize = s.type == NN_DATA_TYPE_FLOAT ? sizeof(float) :
+    s.type == NN_DATA_TYPE_INT16 ? sizeof(fixed16_t) : sizeof(fixed8_t);
+  if (s.type != NN_DATA_TYPE_FLOAT)
+    {
+      s.out_shift = x->fp_pos + w->fp_pos - y->fp_pos;
+      if (bias)
+        {
+          s.bias_shift = x->fp_pos + w->fp_pos - bias->fp_pos;
+        }
+    }
+
+  in_bsize = group * s.ch_in * s.in_x * s.in_y * elem_bsize;
+  out_bsize = group * s.multiplier * s.out_x * s.out_y * elem_bsize;
+  for (b = 0; b < p->in_var.shape.data[0]; ++b)
+    {
+      s.im_in = (uint8_t *) x->data + b * in_bsize;
+      s.im_out = (uint8_t *) y->data + b * out_bsize;
+      func(&s, 0, group * s.multiplier);
+    }
+
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static rt_function_error_t dnnrt_exec_convolution_depthwise(rt_function_t * f)
+{
+  return dnnrt_exec_convolution_fast(f, dnnrt_convolution_depthwise_run);
+}
+
+static rt_function_error_t dnnrt_exec_convolution_pointwise(rt_function_t * f)
+{
+  return dnnrt_exec_convolution_fast(f, dnnrt_convolution_pointwise_run);
+}
+
 static int var_buf_size(rt_variable_t * var)
 {
   int elem_size = 0;
@@ -338,6 +629,34 @@ static inline int validate_params(rt_function_t * f, int *scratch_buf_bsize)
   return cond1 || cond2 || cond3;
 }
 
+/* choose a kernel from the layer shape once at initialization */
+static conv_exec_func_t dnnrt_select_convolution(rt_function_t * f,
+                                                  int *scratch_buf_bsize)
+{
+  convolution_local_context_t *c;
+  c = (convolution_local_context_t *) f->local_context;
+  convolution_private_t *p = (convolution_private_t *) (c->data);
+  int fixed = f->inputs[X]->type != NN_DATA_TYPE_FLOAT;
+
+  if (c->group > 1 && p->in_var.shape.data[I] == 1)
+    {
+      *scratch_buf_bsize = 0;
+      return dnnrt_exec_convolution_depthwise;
+    }
+
+  if (c->group == 1 && p->kernel_shape.data[0] == 1 &&
+      p->kernel_shape.data[1] == 1 && c->pad.data[0] == 0 &&
+      c->pad.data[1] == 0 && c->stride.data[0] == 1 &&
+      c->stride.data[1] == 1)
+    {
+      *scratch_buf_bsize = fixed ? sizeof(q31_t) *
+        p->out_var.shape.data[H] * p->out_var.shape.data[W] : 0;
+      return dnnrt_exec_convolution_pointwise;
+    }
+
+  return dnnrt_exec_convolution;
+}
+
 rt_return_value_t
 dnnrt_convolution_alloc(nn_network_t * net, void *function_context)
 {
@@ -357,8 +676,9 @@ dnnrt_convolution_alloc(nn_network_t * net, void *function_context)
       return RT_RET_FUNCTION_MATCH;
     }
 
-  func->func.exec_func = dnnrt_exec_convolution;
+  func->func.exec_func = dnnrt_select_convolution(&func->func,
+                                                  &scratch_buf_bsize);
 
-  dnn_req_scratch_buf(scratch_buf_bsize);
+  dnn_req_scratch_buf(&func->func, scratch_buf_bsize);
   return RT_RET_FUNCTION_MATCH;
 }
@@ -40,6 +40,7 @@
 #  include <sdk/debug.h>
 #  include <nnablart/functions.h>
 #  include <nnablart/runtime.h>
+#  include "vbuffer_plan.h"
 
 #  ifdef __cplusplus
 extern "C"
@@ -58,10 +59,6 @@ extern "C"
     }                                                                       \
   } while (0)
 
-/* dnnrt does NOT support rt_context_t with buffer variables
-   with more than MAX_VBUFFER_NUM */
-#  define MAX_VBUFFER_NUM  (16)
-
   /* structure to manage shared_chunks, which underlie
    * variable buffers in dnn_runtime_t. */
   struct dnn_shared_chunk;
@@ -77,17 +74,25 @@ extern "C"
     dnn_shared_chunk_t *next;   /* point to next shared_chunk in linked-list */
   };
 
-  /* structure to hold information about how to allocate
-   * dnn_shared_chunk_t::data to each rt_variable_buffer_context_t::buffer */
-  typedef struct dnn_vbuffer_alloc_info dnn_vbuffer_alloc_info_t;
-  struct dnn_vbuffer_alloc_info
+  /* forward propagation submitted and not polled yet */
+  typedef struct dnn_async_result
+  {
+    void *rt;                   /* NULL if this entry is free */
+    int ret;                    /* result of the forward propagation */
+  } dnn_async_result_t;
+
+#  ifdef CONFIG_DNN_RT_PROFILE
+  /* per-layer profile of a runtime. kept in a list of the global context
+   * so that dnn_runtime_t stays the same with or without profiling. */
+  struct dnn_profile_entry;
+  typedef struct dnn_profile_entry dnn_profile_entry_t;
+  struct dnn_profile_entry
   {
-    size_t bsize_list[MAX_VBUFFER_NUM]; /* size of each variable buffer in bytes */
-    void *addr_list[MAX_VBUFFER_NUM];   /* address of pre-allocated buffer */
-    size_t vbuffer_num;         /* length of bsize_list/addr_list */
-    uint8_t actual_alloc_count; /* how many times to allocate a shared_chunk to
-                                 * variable buffers in rt_initialize_context() */
+    void *ctx;                  /* rt_context_t this profile belongs to */
+    dnn_profile_entry_t *next;  /* point to next entry in linked-list */
+    dnn_layer_profile_t layers[];       /* profile of each function */
   };
+#  endif
 
   typedef struct dnn_global_context
   {
@@ -96,6 +101,15 @@ extern "C"
     int scratch_buf_bsize;
     void *scratch_buf;
     dnn_shared_chunk_t *chunks;
+    size_t peak_arena_bsize;    /* largest arena planned so far */
+    dnn_async_result_t async[CONFIG_DNN_RT_ASYNC_DEPTH];  /* results of
+                                                         * submitted forward
+                                                         * propagations */
+#  ifdef CONFIG_DNN_RT_PROFILE
+    dnn_profile_entry_t *profiles;      /* profiles of initialized runtimes */
+    void *init_ctx;             /* rt_context_t under initialization */
+    dnn_layer_profile_t *init_profile;  /* its profile */
+#  endif
     dnn_vbuffer_alloc_info_t *alloc_info;       /* allocation info of current
                                                  * network. the alloc_info is
                                                  * placed on stack of
@@ -114,11 +128,10 @@ extern "C"
   rt_return_value_t dnnrt_convolution_alloc(nn_network_t * net,
                                             void *function_context);
 
-  void dnn_req_scratch_buf(int size);
+  void dnn_req_scratch_buf(const rt_function_t * func, int size);
   void *dnn_scratch_buf(void);
 
-  int dnn_peek_vbuffers(const nn_network_t * net,
-                        dnn_vbuffer_alloc_info_t * alloc_info);
+  size_t dnn_chunks_bsize(dnn_global_context_t * ctx);
   void dnn_reset_chunk_usage(dnn_global_context_t * ctx);
   int dnn_preallocate_chunks(dnn_global_context_t * ctx,
                              dnn_vbuffer_alloc_info_t * alloc_info);
@@ -34,6 +34,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include <dnnrt/runtime.h>
 
 /* header inclusion under $(SDKDIR)/../externals/nnabla-c-runtime/include */
@@ -45,8 +46,90 @@
 
 #define WEIGHT (1)
 
+#ifdef CONFIG_DNN_RT_PROFILE
+#  ifdef __arm__
+#    include <arch/chip/perf.h>
+#  endif
+#endif
+
 static struct dnn_global_context s_dnn_gctx;
 
+#ifdef CONFIG_DNN_RT_PROFILE
+static void dnn_profile_start(void)
+{
+#  ifdef __arm__
+  up_perf_init(NULL);
+#  endif
+}
+
+/* measure a layer by the CPU cycle counter on the target,
+ * and by the monotonic clock elsewhere (cycles are not available) */
+static rt_function_error_t dnn_profile_exec(rt_function_t * f,
+                                            dnn_layer_profile_t * profile)
+{
+  rt_function_error_t err;
+#  ifdef __arm__
+  uint32_t start = up_perf_gettime();
+  err = f->exec_func(f);
+  profile->cycles = up_perf_gettime() - start;
+  profile->time_ns = (unsigned long)((uint64_t) profile->cycles *
+                                     1000000000ull / up_perf_getfreq());
+#  else
+  struct timespec begin, end;
+  clock_gettime(CLOCK_MONOTONIC, &begin);
+  err = f->exec_func(f);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  profile->cycles = 0ul;
+  profile->time_ns = (unsigned long)((end.tv_sec - begin.tv_sec) *
+                                     1000000000l + end.tv_nsec -
+                                     begin.tv_nsec);
+#  endif
+  return err;
+}
+
+static size_t dnn_variable_bsize(const rt_variable_t * var)
+{
+  size_t elem_size = var->type == NN_DATA_TYPE_FLOAT ? sizeof(float) :
+    var->type == NN_DATA_TYPE_INT16 ? sizeof(int16_t) : sizeof(int8_t);
+  size_t size = elem_size;
+
+  for (int i = 0; i < var->shape.size; i++)
+    {
+      size *= var->shape.data[i];
+    }
+  return size;
+}
+
+static dnn_layer_profile_t *dnn_profile_find(void *ctx)
+{
+  for (dnn_profile_entry_t * e = s_dnn_gctx.profiles; e != NULL; e = e->next)
+    {
+      if (e->ctx == ctx)
+        {
+          return e->layers;
+        }
+    }
+  return NULL;
+}
+
+static void dnn_profile_remove(void *ctx)
+{
+  dnn_profile_entry_t **pp = &s_dnn_gctx.profiles;
+
+  while (*pp != NULL)
+    {
+      if ((*pp)->ctx == ctx)
+        {
+          dnn_profile_entry_t *e = *pp;
+          *pp = e->next;
+          free(e);
+          return;
+        }
+      pp = &(*pp)->next;
+    }
+}
+#endif
+
 int dnn_initialize(dnn_config_t * config)
 {
   if (config != NULL && config->cpu_num != 1u)
@@ -77,6 +160,11 @@ int dnn_runtime_initialize(dnn_runtime_t * rt, const nn_network_t * network)
 
   /* peek variable buffer sizes and pre-allocate shared chunks to them */
   err = dnn_peek_vbuffers(network, &alloc_info);
+  if (err != RT_RET_NOERROR)
+    {
+      goto peek_err;
+    }
+  err = dnn_plan_vbuffers(network, &alloc_info);
   if (err != RT_RET_NOERROR)
     {
       goto peek_err;
@@ -109,15 +197,51 @@ int dnn_runtime_initialize(dnn_runtime_t * rt, const nn_network_t * network)
       goto rt_init_err;
     }
 
+#ifdef CONFIG_DNN_RT_PROFILE
+  /* scratch_buf each function requests is recorded in the profile */
+  dnn_profile_entry_t *entry =
+    calloc(1, sizeof(dnn_profile_entry_t) +
+           network->functions.size * sizeof(dnn_layer_profile_t));
+  if (entry == NULL)
+    {
+      err = -ENOMEM;
+      goto rt_init_err;
+    }
+  entry->ctx = ctx;
+  entry->next = s_dnn_gctx.profiles;
+  s_dnn_gctx.profiles = entry;
+  s_dnn_gctx.init_ctx = ctx;
+  s_dnn_gctx.init_profile = entry->layers;
+#endif
+
   /* initialize rt_context and count up required minimum size of scratch_buf */
   s_dnn_gctx.req_scratch_buf_bsize = 0;
   /* remove const to use the as-is rt_initialize_context() */
   err = (int)rt_initialize_context(ctx, (nn_network_t *) network);
+#ifdef CONFIG_DNN_RT_PROFILE
+  s_dnn_gctx.init_ctx = NULL;
+  s_dnn_gctx.init_profile = NULL;
+#endif
   if (err != RT_RET_NOERROR)
     {
       goto rt_init_err;
     }
 
+#ifdef CONFIG_DNN_RT_PROFILE
+  rt_context_t *c = (rt_context_t *) ctx;
+  dnn_layer_profile_t *profile = entry->layers;
+  for (int i = 0; i < c->num_of_functions; i++)
+    {
+      rt_function_t *f = &c->functions[i].func;
+      profile[i].function_type = (unsigned short)c->functions[i].info->type;
+      for (int j = 0; j < f->num_of_outputs; j++)
+        {
+          profile[i].output_bytes += dnn_variable_bsize(f->outputs[j]);
+        }
+    }
+  dnn_profile_start();
+#endif
+
   /* resize scratch buffer */
   if (s_dnn_gctx.req_scratch_buf_bsize > s_dnn_gctx.scratch_buf_bsize)
     {
@@ -137,6 +261,9 @@ int dnn_runtime_initialize(dnn_runtime_t * rt, const nn_network_t * network)
 
 scratch_buf_err:
 rt_init_err:
+#ifdef CONFIG_DNN_RT_PROFILE
+  dnn_profile_remove(rt->impl_ctx);
+#endif
   dnn_deallocate_chunks(&s_dnn_gctx, &alloc_info);
   rt_free_context(&rt->impl_ctx);
 rt_alloc_err:
@@ -149,6 +276,9 @@ peek_err:
 int dnn_runtime_finalize(dnn_runtime_t * rt)
 {
   DNN_CHECK_NULL_RET(rt, -EINVAL);
+#ifdef CONFIG_DNN_RT_PROFILE
+  dnn_profile_remove(rt->impl_ctx);
+#endif
 
   if (--s_dnn_gctx.rt_count == 0)
     {
@@ -161,6 +291,28 @@ int dnn_runtime_finalize(dnn_runtime_t * rt)
   return (int)rt_free_context((rt_context_pointer *) & (rt->impl_ctx));
 }
 
+#ifdef CONFIG_DNN_RT_PROFILE
+static int dnn_runtime_forward_profile(dnn_runtime_t * rt, rt_context_t * c)
+{
+  dnn_layer_profile_t *profile = dnn_profile_find(rt->impl_ctx);
+  rt_function_error_t err;
+
+  for (int i = 0; i < c->num_of_functions; i++)
+    {
+      rt_function_t *f = &c->functions[i].func;
+
+      err = dnn_profile_exec(f, &profile[i]);
+      if (err != RT_FUNCTION_ERROR_NOERROR)
+        {
+          dnn_err("layer %d failed (%d)\n", i, (int)err);
+          return -EIO;
+        }
+    }
+
+  return RT_RET_NOERROR;
+}
+#endif
+
 int dnn_runtime_forward(dnn_runtime_t * rt, const void *inputs[],
                         unsigned char input_num)
 {
@@ -177,7 +329,121 @@ int dnn_runtime_forward(dnn_runtime_t * rt, const void *inputs[],
       c->variables[c->input_variable_ids[i]].data = (void *)inputs[i];
     }
 
+#ifdef CONFIG_DNN_RT_PROFILE
+  return dnn_runtime_forward_profile(rt, c);
+#else
   return (int)rt_forward(ctx);
+#endif
+}
+
+int dnn_runtime_profile(dnn_runtime_t * rt, dnn_layer_profile_t * profile,
+                        unsigned short length)
+{
+  DNN_CHECK_NULL_RET(rt, -EINVAL);
+#ifdef CONFIG_DNN_RT_PROFILE
+  rt_context_t *c = (rt_context_t *) rt->impl_ctx;
+  int num;
+
+  if (c == NULL || (profile == NULL && length != 0u))
+    {
+      return -EINVAL;
+    }
+
+  num = c->num_of_functions < length ? c->num_of_functions : length;
+  memcpy(profile, dnn_profile_find(c), num * sizeof(dnn_layer_profile_t));
+  return c->num_of_functions;
+#else
+  return -EPERM;
+#endif
+}
+
+int dnn_runtime_forward_batch(dnn_runtime_t * rt, const void *inputs[],
+                              unsigned char input_num, void *outputs[],
+                              unsigned short batch_num)
+{
+  DNN_CHECK_NULL_RET(rt, -EINVAL);
+  DNN_CHECK_NULL_RET(inputs, -EINVAL);
+  DNN_CHECK_NULL_RET(outputs, -EINVAL);
+  rt_context_t *c = (rt_context_t *) rt->impl_ctx;
+  DNN_CHECK_NULL_RET(c, -EINVAL);
+  int output_num = c->num_of_outputs;
+  void *output_data[output_num];
+  int ret = RT_RET_NOERROR;
+  unsigned short b;
+  int i;
+
+  for (i = 0; i < output_num; i++)
+    {
+      output_data[i] = c->variables[c->output_variable_ids[i]].data;
+    }
+
+  /* the last function of each output writes it into the buffer of
+   * applications directly, and the variables are restored afterwards */
+  for (b = 0; b < batch_num && ret == RT_RET_NOERROR; b++)
+    {
+      for (i = 0; i < output_num; i++)
+        {
+          void *out = outputs[b * output_num + i];
+          c->variables[c->output_variable_ids[i]].data =
+            out != NULL ? out : output_data[i];
+        }
+      ret = dnn_runtime_forward(rt, &inputs[b * input_num], input_num);
+    }
+
+  for (i = 0; i < output_num; i++)
+    {
+      c->variables[c->output_variable_ids[i]].data = output_data[i];
+    }
+
+  return ret;
+}
+
+int dnn_runtime_forward_submit(dnn_runtime_t * rt, const void *inputs[],
+                               unsigned char input_num)
+{
+  DNN_CHECK_NULL_RET(rt, -EINVAL);
+  dnn_async_result_t *free_entry = NULL;
+  int i;
+
+  for (i = 0; i < CONFIG_DNN_RT_ASYNC_DEPTH; i++)
+    {
+      if (s_dnn_gctx.async[i].rt == rt)
+        {
+          /* its outputs would be overwritten before they are polled */
+          return -EBUSY;
+        }
+      else if (s_dnn_gctx.async[i].rt == NULL && free_entry == NULL)
+        {
+          free_entry = &s_dnn_gctx.async[i];
+        }
+    }
+
+  if (free_entry == NULL)
+    {
+      return -EBUSY;
+    }
+
+  /* no other CPU runs the network, so complete it here */
+  free_entry->ret = dnn_runtime_forward(rt, inputs, input_num);
+  free_entry->rt = rt;
+  return RT_RET_NOERROR;
+}
+
+int dnn_runtime_forward_poll(dnn_runtime_t * rt, unsigned int ms)
+{
+  int i;
+
+  DNN_CHECK_NULL_RET(rt, -EPERM);
+  for (i = 0; i < CONFIG_DNN_RT_ASYNC_DEPTH; i++)
+    {
+      if (s_dnn_gctx.async[i].rt == rt)
+        {
+          s_dnn_gctx.async[i].rt = NULL;
+          return s_dnn_gctx.async[i].ret;
+        }
+    }
+
+  return -EPERM;
 }
 
 int dnn_runtime_input_num(dnn_runtime_t * rt)
@@ -264,8 +530,23 @@ dnn_global_context_t *dnn_get_global_context(void)
   return &s_dnn_gctx;
 }
 
-void dnn_req_scratch_buf(int size)
+void dnn_req_scratch_buf(const rt_function_t * func, int size)
 {
+#ifdef CONFIG_DNN_RT_PROFILE
+  rt_context_t *c = (rt_context_t *) s_dnn_gctx.init_ctx;
+  if (c != NULL)
+    {
+      for (int i = 0; i < c->num_of_functions; i++)
+        {
+          if (&c->functions[i].func == func)
+            {
+              s_dnn_gctx.init_profile[i].scratch_bytes = size;
+              break;
+            }
+        }
+    }
+#endif
+
   if (size > s_dnn_gctx.req_scratch_buf_bsize)
     {
       s_dnn_gctx.req_scratch_buf_bsize = size;
@@ -292,6 +573,8 @@ int dnn_nuttx_mallinfo(dnn_mallinfo_t * info)
   info->total_bytes = mem.arena;
   info->used_bytes = mem.uordblks;
   info->largest_bytes = mem.mxordblk;
+  info->arena_bytes = dnn_chunks_bsize(&s_dnn_gctx);
+  info->peak_arena_bytes = s_dnn_gctx.peak_arena_bsize;
 
   return RT_RET_NOERROR;;
 }
@@ -33,6 +33,7 @@
  ****************************************************************************/
 
 #include <limits.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -44,12 +45,6 @@
 
 #define ALIGN(x, s) ((void*)((unsigned int)(((void*)(x)) + ((s) - 1)) & ~((s) - 1)))
 
-inline uint32_t round_up(uint32_t num, uint32_t multiple)
-{
-  uint32_t remain = num % multiple;
-  return remain == 0 ? num : num + multiple - remain;
-}
-
 static void dnn_shared_chunk_update_ref_count(dnn_global_context_t * ctx,
                                               void *p, int delta)
 {
@@ -121,86 +116,35 @@ void dnn_variable_free(void *p)
     }
 }
 
-int dnn_peek_vbuffers(const nn_network_t * n,
-                      dnn_vbuffer_alloc_info_t * alloc_info)
-{
-  int i;
-  int *list = (int *)NN_GET(n, n->buffers.list);
-
-  if (n->buffers.size > MAX_VBUFFER_NUM)
-    {
-      return -ENOMEM;
-    }
-
-  /* get each variable buffer size from network */
-  memset(alloc_info, 0, sizeof(*alloc_info));
-  alloc_info->vbuffer_num = n->buffers.size;
-  for (i = 0; i < alloc_info->vbuffer_num; i++)
-    {
-      if (n->version >= 3) 
-        {
-          alloc_info->bsize_list[i] = *(list + i);
-        }
-      else
-        {
-          alloc_info->bsize_list[i] = *(list + i) * sizeof(float);
-        }
-    }
-
-  return RT_RET_NOERROR;
-}
-
 static int dnn_shared_chunk_accommodate(dnn_shared_chunk_t * self,
-                                        size_t vbuffer_bsize)
+                                        size_t arena_bsize)
 {
   uint32_t remain;
   remain = (uint32_t) self->allocated_bsize - (uint32_t) self->used_bsize;
-  return remain >= round_up((uint32_t) vbuffer_bsize, 4u);
+  return remain >= (uint32_t) arena_bsize;
 }
 
 static inline
-  int dnn_shared_chunk_preallocate(dnn_shared_chunk_t * self,
-                                   uint8_t vbuffer_idx,
-                                   dnn_vbuffer_alloc_info_t * alloc_info)
+  void dnn_shared_chunk_preallocate(dnn_shared_chunk_t * self,
+                                    dnn_vbuffer_alloc_info_t * alloc_info)
 {
-  int ret = RT_RET_NOERROR;
-  size_t vbuffer_bsize = alloc_info->bsize_list[vbuffer_idx];
-  if (vbuffer_idx < alloc_info->vbuffer_num &&
-      dnn_shared_chunk_accommodate(self, vbuffer_bsize))
-    {
-      alloc_info->addr_list[vbuffer_idx] = self->data + self->used_bsize;
-      self->used_bsize += round_up((uint32_t) vbuffer_bsize, 4u);
-    }
-  else
+  void *arena = self->data + self->used_bsize;
+  for (uint8_t idx = 0; idx < alloc_info->vbuffer_num; idx++)
     {
-      ret = -EPERM;
+      alloc_info->addr_list[idx] = arena + alloc_info->offset_list[idx];
     }
-  return ret;
-}
-
-static
-  size_t dnn_vbuffer_alloc_info_remaining_bsize(dnn_vbuffer_alloc_info_t * info)
-{
-  size_t ret = 0u;
-  for (uint8_t idx = 0; idx < info->vbuffer_num; idx++)
-    {
-      if (info->addr_list[idx] == NULL)
-        {
-          ret += round_up(info->bsize_list[idx], 4u);
-        }
-    }
-  return ret;
+  self->used_bsize += alloc_info->arena_bsize;
 }
 
 static inline
   dnn_shared_chunk_t * dnn_create_chunk(dnn_global_context_t * ctx,
-                                        dnn_vbuffer_alloc_info_t * alloc_info)
+                                        size_t arena_bsize)
 {
   /* reserve memory for new_chunk */
   dnn_shared_chunk_t *new_chunk = NULL, *last;
   size_t chunk_bsize = 0u;
   chunk_bsize += sizeof(dnn_shared_chunk_t);
-  chunk_bsize += dnn_vbuffer_alloc_info_remaining_bsize(alloc_info);
+  chunk_bsize += arena_bsize;
   chunk_bsize += (4u - 1u);     // padding to 4-byte align new_chunk->data
   new_chunk = (dnn_shared_chunk_t *) malloc(chunk_bsize);
   if (new_chunk != NULL)
@@ -226,6 +170,17 @@ static inline
   return new_chunk;
 }
 
+size_t dnn_chunks_bsize(dnn_global_context_t * ctx)
+{
+  size_t ret = 0u;
+  dnn_shared_chunk_t *chunk;
+  for (chunk = ctx->chunks; chunk != NULL; chunk = chunk->next)
+    {
+      ret += chunk->allocated_bsize;
+    }
+  return ret;
+}
+
 void dnn_reset_chunk_usage(dnn_global_context_t * ctx)
 {
   dnn_shared_chunk_t *chunk;
@@ -250,55 +205,50 @@ void dnn_deallocate_chunks(dnn_global_context_t * ctx,
 /*
  * determine how to allocate shared_chunk to variable buffers (preallocate),
  * and store the result into dnn_vbuffer_alloc_info_t::addr_list.
- * This algorithm is composed of these 3 steps:
- *  1. find a shared_chunk for each variable buffer by the first-fit algorithm
- *    - don't create new shared_chunks in this step
- *  2. create a new single shared_chunk for all the variable buffers
- *     which didn't fit in existing shared_chunk in 1.
- *  3. slice the new single shared_chunk and allocate sliced pieces to
- *     variable buffers which didn't fit in existing shared_chunk in 1
+ * The offsets of variable buffers are planned by dnn_plan_vbuffers() in
+ * advance, so this function only has to find a place for the whole arena:
+ *  1. find a shared_chunk which can accommodate the arena by the first-fit
+ *     algorithm
+ *  2. create a new shared_chunk for the arena if no shared_chunk fits in 1.
  */
 int dnn_preallocate_chunks(dnn_global_context_t * ctx,
                            dnn_vbuffer_alloc_info_t * alloc_info)
 {
   int ret = RT_RET_NOERROR;
-  dnn_shared_chunk_t *chunk, *new_chunk;
+  dnn_shared_chunk_t *chunk;
+
+  if (alloc_info->vbuffer_num == 0u)
+    {
+      return ret;
+    }
 
   // step 1
-  for (uint8_t idx = 0; idx < alloc_info->vbuffer_num; idx++)
+  for (chunk = ctx->chunks; chunk != NULL; chunk = chunk->next)
     {
-      size_t vbuffer_bsize = alloc_info->bsize_list[idx];
-      for (chunk = ctx->chunks; chunk != NULL; chunk = chunk->next)
+      if (dnn_shared_chunk_accommodate(chunk, alloc_info->arena_bsize))
         {
-          if (dnn_shared_chunk_accommodate(chunk, vbuffer_bsize))
-            {
-              dnn_shared_chunk_preallocate(chunk, idx, alloc_info);
-            }
+          break;
         }
     }
 
-  /* count the total size of variable buffers that preallocation is NOT done */
-  if (dnn_vbuffer_alloc_info_remaining_bsize(alloc_info) != 0u)
+  if (chunk == NULL)
     {
-      new_chunk = dnn_create_chunk(ctx, alloc_info);    // step 2
-      if (new_chunk != NULL)
-        {
-          // step 3
-          for (uint8_t idx = 0; idx < alloc_info->vbuffer_num; idx++)
-            {
-              if (alloc_info->addr_list[idx] == NULL)
-                {
-                  // new_chunk can accommodate the remaining variable buffers
-                  dnn_shared_chunk_preallocate(new_chunk, idx, alloc_info);
-                }
-            }
-        }
-      else
+      chunk = dnn_create_chunk(ctx, alloc_info->arena_bsize);   // step 2
+    }
+
+  if (chunk != NULL)
+    {
+      dnn_shared_chunk_preallocate(chunk, alloc_info);
+      if (alloc_info->arena_bsize > ctx->peak_arena_bsize)
         {
-          dnn_err("no enough memory to create variable buffer\n");
-          ret = -ENOMEM;
+          ctx->peak_arena_bsize = alloc_info->arena_bsize;
         }
     }
+  else
+    {
+      dnn_err("no enough memory to create variable buffer\n");
+      ret = -ENOMEM;
+    }
 
   return ret;
 }
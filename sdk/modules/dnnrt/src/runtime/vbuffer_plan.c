@@ -0,0 +1,237 @@
+/****************************************************************************
+ * modules/dnnrt/src/runtime/vbuffer_plan.c
+ *
+ *   Copyright 2019 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "nnablart/runtime.h"
+#include "vbuffer_plan.h"
+
+static inline uint32_t round_up(uint32_t num, uint32_t multiple)
+{
+  uint32_t remain = num % multiple;
+  return remain == 0 ? num : num + multiple - remain;
+}
+
+int dnn_peek_vbuffers(const nn_network_t * n,
+                      dnn_vbuffer_alloc_info_t * alloc_info)
+{
+  int i;
+  int *list = (int *)NN_GET(n, n->buffers.list);
+
+  if (n->buffers.size > MAX_VBUFFER_NUM)
+    {
+      return -ENOMEM;
+    }
+
+  /* get each variable buffer size from network */
+  memset(alloc_info, 0, sizeof(*alloc_info));
+  alloc_info->vbuffer_num = n->buffers.size;
+  for (i = 0; i < alloc_info->vbuffer_num; i++)
+    {
+      if (n->version >= 3) 
+        {
+          alloc_info->bsize_list[i] = *(list + i);
+        }
+      else
+        {
+          alloc_info->bsize_list[i] = *(list + i) * sizeof(float);
+        }
+    }
+
+  return RT_RET_NOERROR;
+}
+
+/*
+ * compute the lifetime of each variable buffer as an interval of function
+ * indices in which the buffer is referenced, and pack all the buffers into
+ * a single arena so that buffers whose lifetimes overlap never share bytes.
+ * Buffers are placed in descending order of size, each at the best-fitting
+ * gap between already placed buffers that are alive at the same time.
+ * The result is stored into dnn_vbuffer_alloc_info_t::offset_list and
+ * dnn_vbuffer_alloc_info_t::arena_bsize.
+ */
+int dnn_plan_vbuffers(const nn_network_t * n,
+                      dnn_vbuffer_alloc_info_t * alloc_info)
+{
+  int first[MAX_VBUFFER_NUM];
+  int last[MAX_VBUFFER_NUM];
+  uint8_t order[MAX_VBUFFER_NUM];
+  uint8_t placed[MAX_VBUFFER_NUM];
+  int *func_list = (int *)NN_GET(n, n->functions.list);
+  int *var_list = (int *)NN_GET(n, n->variables.list);
+  int num = (int)alloc_info->vbuffer_num;
+  int end = n->functions.size;
+  int i, j, k;
+
+  for (i = 0; i < num; i++)
+    {
+      first[i] = INT_MAX;
+      last[i] = -1;
+    }
+
+  /* lifetime of buffers referenced by each function */
+  for (i = 0; i < n->functions.size; i++)
+    {
+      nn_function_t *func = (nn_function_t *) NN_GET(n, func_list[i]);
+      nn_list_t *lists[2] = { &func->inputs, &func->outputs };
+
+      for (j = 0; j < 2; j++)
+        {
+          int *ids = (int *)NN_GET(n, lists[j]->list);
+          for (k = 0; k < lists[j]->size; k++)
+            {
+              nn_variable_t *v = (nn_variable_t *) NN_GET(n, var_list[ids[k]]);
+              int b = -v->data_index - 1;
+              if (0 <= b && b < num)
+                {
+                  first[b] = first[b] < i ? first[b] : i;
+                  last[b] = last[b] > i ? last[b] : i;
+                }
+            }
+        }
+    }
+
+  /* network inputs are fed before forward, outputs are read after it */
+  for (j = 0; j < 2; j++)
+    {
+      const nn_list_t *io = j == 0 ? &n->inputs : &n->outputs;
+      int *ids = (int *)NN_GET(n, io->list);
+      for (k = 0; k < io->size; k++)
+        {
+          nn_variable_t *v = (nn_variable_t *) NN_GET(n, var_list[ids[k]]);
+          int b = -v->data_index - 1;
+          if (0 <= b && b < num)
+            {
+              if (j == 0)
+                {
+                  first[b] = 0;
+                }
+              else
+                {
+                  last[b] = end;
+                }
+            }
+        }
+    }
+
+  /* buffers the graph never refers to are kept alive all the time */
+  for (i = 0; i < num; i++)
+    {
+      if (last[i] < 0)
+        {
+          first[i] = 0;
+          last[i] = end;
+        }
+      first[i] = first[i] < last[i] ? first[i] : last[i];
+    }
+
+  /* sort by size in descending order, earlier lifetime first on a tie */
+  for (i = 0; i < num; i++)
+    {
+      order[i] = (uint8_t) i;
+    }
+  for (i = 1; i < num; i++)
+    {
+      uint8_t cur = order[i];
+      for (j = i - 1; j >= 0; j--)
+        {
+          uint8_t o = order[j];
+          if (alloc_info->bsize_list[o] > alloc_info->bsize_list[cur] ||
+              (alloc_info->bsize_list[o] == alloc_info->bsize_list[cur] &&
+               first[o] <= first[cur]))
+            {
+              break;
+            }
+          order[j + 1] = o;
+        }
+      order[j + 1] = cur;
+    }
+
+  alloc_info->arena_bsize = 0u;
+  for (i = 0; i < num; i++)
+    {
+      uint8_t b = order[i];
+      size_t bsize = round_up((uint32_t) alloc_info->bsize_list[b], 4u);
+      size_t best_offset = 0u;
+      size_t best_gap = SIZE_MAX;
+      size_t cand = 0u;
+      int conflicts = 0;
+
+      /* collect placed buffers alive together with b, sorted by offset */
+      for (j = 0; j < i; j++)
+        {
+          uint8_t o = order[j];
+          if (first[o] <= last[b] && first[b] <= last[o])
+            {
+              for (k = conflicts; k > 0 &&
+                   alloc_info->offset_list[placed[k - 1]] >
+                   alloc_info->offset_list[o]; k--)
+                {
+                  placed[k] = placed[k - 1];
+                }
+              placed[k] = o;
+              conflicts++;
+            }
+        }
+
+      /* best fit among the gaps, otherwise right after the highest one */
+      for (j = 0; j < conflicts; j++)
+        {
+          size_t off = alloc_info->offset_list[placed[j]];
+          size_t tail = off + round_up((uint32_t)
+                                       alloc_info->bsize_list[placed[j]], 4u);
+          if (off > cand && off - cand >= bsize && off - cand < best_gap)
+            {
+              best_gap = off - cand;
+              best_offset = cand;
+            }
+          cand = cand > tail ? cand : tail;
+        }
+      if (best_gap == SIZE_MAX)
+        {
+          best_offset = cand;
+        }
+
+      alloc_info->offset_list[b] = best_offset;
+      if (best_offset + bsize > alloc_info->arena_bsize)
+        {
+          alloc_info->arena_bsize = best_offset + bsize;
+        }
+    }
+
+  return RT_RET_NOERROR;
+}
@@ -0,0 +1,78 @@
+/****************************************************************************
+ * modules/dnnrt/src/runtime/vbuffer_plan.h
+ *
+ *   Copyright 2019 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef VBUFFER_PLAN_H
+#  define VBUFFER_PLAN_H
+
+#  include <stddef.h>
+#  include <stdint.h>
+#  include <nnablart/network.h>
+
+#  ifdef __cplusplus
+extern "C"
+{
+#  endif
+
+/* dnnrt does NOT support rt_context_t with buffer variables
+   with more than MAX_VBUFFER_NUM */
+#  define MAX_VBUFFER_NUM  (16)
+
+  /* structure to hold information about how to allocate
+   * dnn_shared_chunk_t::data to each rt_variable_buffer_context_t::buffer */
+  typedef struct dnn_vbuffer_alloc_info dnn_vbuffer_alloc_info_t;
+  struct dnn_vbuffer_alloc_info
+  {
+    size_t bsize_list[MAX_VBUFFER_NUM]; /* size of each variable buffer in bytes */
+    size_t offset_list[MAX_VBUFFER_NUM];        /* offset of each variable
+                                                 * buffer in the arena */
+    void *addr_list[MAX_VBUFFER_NUM];   /* address of pre-allocated buffer */
+    size_t vbuffer_num;         /* length of bsize_list/addr_list */
+    size_t arena_bsize;         /* size of the arena which accommodates all the
+                                 * variable buffers of current network */
+    uint8_t actual_alloc_count; /* how many times to allocate a shared_chunk to
+                                 * variable buffers in rt_initialize_context() */
+  };
+
+  /* these functions only read nn_network_t, so that the NuttX-side client
+   * of the multicore runtime can plan the same arena as the worker. */
+  int dnn_peek_vbuffers(const nn_network_t * net,
+                        dnn_vbuffer_alloc_info_t * alloc_info);
+  int dnn_plan_vbuffers(const nn_network_t * net,
+                        dnn_vbuffer_alloc_info_t * alloc_info);
+
+#  ifdef __cplusplus
+}
+#  endif
+
+#endif                          /* VBUFFER_PLAN_H */
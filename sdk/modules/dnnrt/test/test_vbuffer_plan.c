@@ -0,0 +1,446 @@
+/****************************************************************************
+ * modules/dnnrt/test/test_vbuffer_plan.c
+ *
+ *   Copyright 2019 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nnablart/runtime.h"
+#include "vbuffer_plan.h"
+
+#define BLOB_BSIZE (8192)
+#define MAX_IO_NUM (4)
+
+#define CHECK(cond)                                                         \
+  do {                                                                      \
+    if (!(cond)) {                                                          \
+      printf("%s:%d: %s: check failed: %s\n", __FILE__, __LINE__,          \
+             s_case, #cond);                                                \
+      s_failed++;                                                           \
+    }                                                                       \
+  } while (0)
+
+/* function of a test network. inputs/outputs are buffer indices, each
+ * buffer is referred through the variable of the same index. */
+typedef struct test_func
+{
+  int in[MAX_IO_NUM];
+  int in_num;
+  int out[MAX_IO_NUM];
+  int out_num;
+} test_func_t;
+
+typedef struct test_net
+{
+  const size_t *bsizes;
+  int buf_num;
+  const test_func_t *funcs;
+  int func_num;
+  const int *inputs;
+  int in_num;
+  const int *outputs;
+  int out_num;
+} test_net_t;
+
+static int s_blob[BLOB_BSIZE / sizeof(int)];
+static int s_blob_used;
+static const char *s_case;
+static int s_failed;
+
+static int blob_alloc(int bsize)
+{
+  int offset = s_blob_used;
+
+  s_blob_used += (bsize + 3) & ~3;
+  if (s_blob_used > BLOB_BSIZE)
+    {
+      printf("%s: network does not fit in the blob\n", s_case);
+      exit(1);
+    }
+
+  return offset;
+}
+
+static int *blob_list(nn_list_t * list, int size)
+{
+  list->size = size;
+  list->list = blob_alloc(size * sizeof(int));
+  return (int *)((char *)s_blob + list->list);
+}
+
+/* serialize test_net_t into s_blob as nn_network_t does */
+static nn_network_t *build_network(const test_net_t * t, int version)
+{
+  nn_network_t *n;
+  int *list;
+  int i, j;
+
+  memset(s_blob, 0, sizeof(s_blob));
+  s_blob_used = 0;
+  n = (nn_network_t *) ((char *)s_blob + blob_alloc(sizeof(nn_network_t)));
+  n->version = version;
+
+  list = blob_list(&n->buffers, t->buf_num);
+  for (i = 0; i < t->buf_num; i++)
+    {
+      list[i] = (int)t->bsizes[i];
+    }
+
+  list = blob_list(&n->variables, t->buf_num);
+  for (i = 0; i < t->buf_num; i++)
+    {
+      nn_variable_t *v;
+
+      list[i] = blob_alloc(sizeof(nn_variable_t));
+      v = (nn_variable_t *) ((char *)s_blob + list[i]);
+      v->data_index = -i - 1;
+    }
+
+  list = blob_list(&n->functions, t->func_num);
+  for (i = 0; i < t->func_num; i++)
+    {
+      nn_function_t *f;
+      int *ids;
+
+      list[i] = blob_alloc(sizeof(nn_function_t));
+      f = (nn_function_t *) ((char *)s_blob + list[i]);
+      ids = blob_list(&f->inputs, t->funcs[i].in_num);
+      for (j = 0; j < t->funcs[i].in_num; j++)
+        {
+          ids[j] = t->funcs[i].in[j];
+        }
+      ids = blob_list(&f->outputs, t->funcs[i].out_num);
+      for (j = 0; j < t->funcs[i].out_num; j++)
+        {
+          ids[j] = t->funcs[i].out[j];
+        }
+    }
+
+  list = blob_list(&n->inputs, t->in_num);
+  for (i = 0; i < t->in_num; i++)
+    {
+      list[i] = t->inputs[i];
+    }
+  list = blob_list(&n->outputs, t->out_num);
+  for (i = 0; i < t->out_num; i++)
+    {
+      list[i] = t->outputs[i];
+    }
+
+  return n;
+}
+
+static int plan(const test_net_t * t, dnn_vbuffer_alloc_info_t * info)
+{
+  nn_network_t *n = build_network(t, 3);
+  int ret;
+
+  ret = dnn_peek_vbuffers(n, info);
+  if (ret == RT_RET_NOERROR)
+    {
+      ret = dnn_plan_vbuffers(n, info);
+    }
+
+  return ret;
+}
+
+static size_t round4(size_t bsize)
+{
+  return (bsize + 3u) & ~(size_t) 3u;
+}
+
+static int share_bytes(const dnn_vbuffer_alloc_info_t * info, int a, int b)
+{
+  size_t a_end = info->offset_list[a] + round4(info->bsize_list[a]);
+  size_t b_end = info->offset_list[b] + round4(info->bsize_list[b]);
+
+  return info->offset_list[a] < b_end && info->offset_list[b] < a_end;
+}
+
+/* b0 -> f0 -> b1 -> f1 -> b2 -> f2 -> b3: b0/b2 and b1/b3 are never alive
+ * at the same time, so each pair shares its bytes. */
+static void test_chain(void)
+{
+  static const size_t bsizes[] = { 100, 100, 100, 100 };
+  static const test_func_t funcs[] = {
+    {{0}, 1, {1}, 1},
+    {{1}, 1, {2}, 1},
+    {{2}, 1, {3}, 1},
+  };
+  static const int inputs[] = { 0 };
+  static const int outputs[] = { 3 };
+  const test_net_t t = { bsizes, 4, funcs, 3, inputs, 1, outputs, 1 };
+  dnn_vbuffer_alloc_info_t info;
+
+  s_case = "chain";
+  CHECK(plan(&t, &info) == RT_RET_NOERROR);
+  CHECK(info.vbuffer_num == 4u);
+  CHECK(info.arena_bsize == 200u);
+  CHECK(info.offset_list[0] == 0u);
+  CHECK(info.offset_list[1] == 100u);
+  CHECK(info.offset_list[2] == 0u);
+  CHECK(info.offset_list[3] == 100u);
+}
+
+/* network inputs are alive from the first function even if only the last
+ * function reads them, and outputs are alive until the end. */
+static void test_io_lifetime(void)
+{
+  static const size_t bsizes[] = { 64, 64, 64, 64, 64 };
+  static const test_func_t funcs[] = {
+    {{1}, 1, {2}, 1},
+    {{2}, 1, {3}, 1},
+    {{0, 3}, 2, {4}, 1},
+  };
+  static const int inputs[] = { 0 };
+  static const int outputs[] = { 4 };
+  const test_net_t t = { bsizes, 5, funcs, 3, inputs, 1, outputs, 1 };
+  static const test_func_t out_funcs[] = {
+    {{0}, 1, {1}, 1},
+    {{0}, 1, {2}, 1},
+  };
+  static const int out_outputs[] = { 1, 2 };
+  const test_net_t out_t = { bsizes, 3, out_funcs, 2, inputs, 1,
+                             out_outputs, 2 };
+  dnn_vbuffer_alloc_info_t info;
+  int i;
+
+  s_case = "input lifetime";
+  CHECK(plan(&t, &info) == RT_RET_NOERROR);
+  for (i = 1; i < 5; i++)
+    {
+      CHECK(!share_bytes(&info, 0, i));
+    }
+  CHECK(info.arena_bsize == 192u);
+
+  s_case = "output lifetime";
+  CHECK(plan(&out_t, &info) == RT_RET_NOERROR);
+  CHECK(!share_bytes(&info, 1, 2));
+}
+
+/* a buffer the graph never refers to is kept alive all the time */
+static void test_unreferenced(void)
+{
+  static const size_t bsizes[] = { 32, 32, 32 };
+  static const test_func_t funcs[] = {
+    {{0}, 1, {1}, 1},
+  };
+  static const int inputs[] = { 0 };
+  static const int outputs[] = { 1 };
+  const test_net_t t = { bsizes, 3, funcs, 1, inputs, 1, outputs, 1 };
+  dnn_vbuffer_alloc_info_t info;
+
+  s_case = "unreferenced";
+  CHECK(plan(&t, &info) == RT_RET_NOERROR);
+  CHECK(!share_bytes(&info, 2, 0));
+  CHECK(!share_bytes(&info, 2, 1));
+  CHECK(info.arena_bsize == 96u);
+}
+
+/* sizes are rounded up to 4 bytes in the arena */
+static void test_round_up(void)
+{
+  static const size_t bsizes[] = { 5, 3 };
+  static const test_func_t funcs[] = {
+    {{0}, 1, {1}, 1},
+  };
+  static const int inputs[] = { 0 };
+  static const int outputs[] = { 1 };
+  const test_net_t t = { bsizes, 2, funcs, 1, inputs, 1, outputs, 1 };
+  dnn_vbuffer_alloc_info_t info;
+
+  s_case = "round up";
+  CHECK(plan(&t, &info) == RT_RET_NOERROR);
+  CHECK(info.offset_list[0] == 0u);
+  CHECK(info.offset_list[1] == 8u);
+  CHECK(info.arena_bsize == 12u);
+}
+
+/* b0(48) and b2(32) die after f1 and leave gaps of 48 and 32 bytes below
+ * b1 and b3. b4(16) goes into the smaller gap at 88, not the first at 0. */
+static void test_best_fit(void)
+{
+  static const size_t bsizes[] = { 48, 40, 32, 24, 16 };
+  static const test_func_t funcs[] = {
+    {{0, 1}, 2, {2, 3}, 2},
+    {{0, 2}, 2, {0}, 0},
+    {{0}, 0, {4}, 1},
+    {{1, 3}, 2, {0}, 0},
+  };
+  const test_net_t t = { bsizes, 5, funcs, 4, NULL, 0, NULL, 0 };
+  dnn_vbuffer_alloc_info_t info;
+
+  s_case = "best fit";
+  CHECK(plan(&t, &info) == RT_RET_NOERROR);
+  CHECK(info.offset_list[0] == 0u);
+  CHECK(info.offset_list[1] == 48u);
+  CHECK(info.offset_list[2] == 88u);
+  CHECK(info.offset_list[3] == 120u);
+  CHECK(info.offset_list[4] == 88u);
+  CHECK(info.arena_bsize == 144u);
+}
+
+/* sizes are in floats before binary format version 3, and networks with
+ * too many buffers are rejected */
+static void test_peek(void)
+{
+  static const size_t bsizes[MAX_VBUFFER_NUM + 1] = { 10, 20 };
+  const test_net_t t = { bsizes, 2, NULL, 0, NULL, 0, NULL, 0 };
+  const test_net_t too_many = { bsizes, MAX_VBUFFER_NUM + 1, NULL, 0,
+                                NULL, 0, NULL, 0 };
+  dnn_vbuffer_alloc_info_t info;
+
+  s_case = "peek";
+  CHECK(dnn_peek_vbuffers(build_network(&t, 2), &info) == RT_RET_NOERROR);
+  CHECK(info.bsize_list[0] == 10u * sizeof(float));
+  CHECK(info.bsize_list[1] == 20u * sizeof(float));
+  CHECK(dnn_peek_vbuffers(build_network(&t, 3), &info) == RT_RET_NOERROR);
+  CHECK(info.bsize_list[0] == 10u);
+  CHECK(dnn_peek_vbuffers(build_network(&too_many, 3), &info) == -ENOMEM);
+}
+
+/* random graphs: buffers alive at the same time never share bytes, and
+ * the arena is between the largest live set and the sum of all buffers */
+static void test_random(void)
+{
+  size_t bsizes[MAX_VBUFFER_NUM];
+  test_func_t funcs[12];
+  int inputs[1];
+  int outputs[1];
+  int first[MAX_VBUFFER_NUM];
+  int last[MAX_VBUFFER_NUM];
+  dnn_vbuffer_alloc_info_t info;
+  int iter, i, j, k;
+
+  s_case = "random";
+  srand(1);
+  for (iter = 0; iter < 2000; iter++)
+    {
+      int buf_num = 2 + rand() % (MAX_VBUFFER_NUM - 1);
+      int func_num = 1 + rand() % 12;
+      size_t total = 0u;
+      size_t live_max = 0u;
+      test_net_t t = { bsizes, buf_num, funcs, func_num, inputs, 1,
+                       outputs, 1 };
+
+      for (i = 0; i < buf_num; i++)
+        {
+          bsizes[i] = 1u + (size_t)(rand() % 300);
+          total += round4(bsizes[i]);
+          first[i] = INT_MAX;
+          last[i] = -1;
+        }
+      inputs[0] = rand() % buf_num;
+      outputs[0] = rand() % buf_num;
+      for (i = 0; i < func_num; i++)
+        {
+          funcs[i].in_num = 1 + rand() % 2;
+          funcs[i].out_num = 1;
+          for (j = 0; j < funcs[i].in_num; j++)
+            {
+              funcs[i].in[j] = rand() % buf_num;
+            }
+          funcs[i].out[0] = rand() % buf_num;
+        }
+
+      CHECK(plan(&t, &info) == RT_RET_NOERROR);
+
+      /* expected lifetimes */
+      for (i = 0; i < func_num; i++)
+        {
+          for (j = 0; j < funcs[i].in_num + 1; j++)
+            {
+              int b = j < funcs[i].in_num ? funcs[i].in[j] : funcs[i].out[0];
+              first[b] = first[b] < i ? first[b] : i;
+              last[b] = i;
+            }
+        }
+      first[inputs[0]] = 0;
+      last[outputs[0]] = func_num;
+      for (i = 0; i < buf_num; i++)
+        {
+          if (last[i] < 0)
+            {
+              first[i] = 0;
+              last[i] = func_num;
+            }
+          first[i] = first[i] < last[i] ? first[i] : last[i];
+        }
+
+      for (i = 0; i < buf_num; i++)
+        {
+          for (j = i + 1; j < buf_num; j++)
+            {
+              if (first[i] <= last[j] && first[j] <= last[i])
+                {
+                  CHECK(!share_bytes(&info, i, j));
+                }
+            }
+        }
+      for (k = 0; k <= func_num; k++)
+        {
+          size_t live = 0u;
+          for (i = 0; i < buf_num; i++)
+            {
+              if (first[i] <= k && k <= last[i])
+                {
+                  live += round4(bsizes[i]);
+                }
+            }
+          live_max = live > live_max ? live : live_max;
+        }
+      CHECK(live_max <= info.arena_bsize);
+      CHECK(info.arena_bsize <= total);
+      if (s_failed)
+        {
+          break;
+        }
+    }
+}
+
+int main(void)
+{
+  test_chain();
+  test_io_lifetime();
+  test_unreferenced();
+  test_round_up();
+  test_best_fit();
+  test_peek();
+  test_random();
+
+  printf("test_vbuffer_plan: %s\n", s_failed ? "FAILED" : "PASSED");
+  return s_failed ? 1 : 0;
+}
@@ -40,10 +40,13 @@
 #include <sdk/config.h>
 
 #include <stdio.h>
+#include <stdbool.h>
 #include <string.h>
 #include <fcntl.h>
 #include <time.h>
 #include <semaphore.h>
+#include <pthread.h>
+#include <sched.h>
 #include <errno.h>
 
 #include <nuttx/arch.h>
@@ -87,6 +90,16 @@
 
 #define MSEL     1
 
+#ifndef CONFIG_IMAGEPROC_JOB_STACKSIZE
+#  define CONFIG_IMAGEPROC_JOB_STACKSIZE 1024
+#endif
+
+#ifndef CONFIG_IMAGEPROC_JOB_PRIORITY
+#  define CONFIG_IMAGEPROC_JOB_PRIORITY 110
+#endif
+
+#define HALTCMD_SIZE 16
+
 /* limit size */
 #define HSIZE_MIN           (12)
 #define VSIZE_MIN           (12)
@@ -98,6 +111,9 @@
 #define ISE_DST_VSIZE_MAX   (1024)
 #define MAX_RATIO           (64)
 
+/* limit of tensor fixed point position, 1 << fp_pos must fit in int */
+#define FP_POS_MAX          (30)
+
 /* Command code */
 
 #define COPYCMD  0x4
@@ -222,6 +238,15 @@ static sem_t g_geexc;
 static int g_gfd = -1;
 static char g_gcmdbuf[256] __attribute__((aligned(16)));
 
+/* Job queue served by the worker thread */
+
+static sem_t g_jobqlock;
+static sem_t g_jobqsem;
+static imageproc_job_t *g_jobhead;
+static imageproc_job_t *g_jobtail;
+static pthread_t g_jobthread;
+static bool g_jobthread_running;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -403,8 +428,196 @@ static void *set_ab_cmd(void *cmdbuf, void *srcaddr, void *destaddr,
 
 static void *set_halt_cmd(void *cmdbuf)
 {
-  memset(cmdbuf, 0, 16);
-  return (void *)((uintptr_t)cmdbuf + 16);
+  memset(cmdbuf, 0, HALTCMD_SIZE);
+  return (void *)((uintptr_t)cmdbuf + HALTCMD_SIZE);
+}
+
+/* Validate clip and resize parameters and append a ROP command to *cmd.
+ * On success, *cmd is advanced to the next command area.
+ */
+
+static int set_clip_and_resize_cmd(void **cmd,
+                                   uint8_t *ibuf, uint16_t ihsize,
+                                   uint16_t ivsize, uint8_t *obuf,
+                                   uint16_t ohsize, uint16_t ovsize,
+                                   int bpp, imageproc_rect_t *clip_rect)
+{
+  void *next;
+  uint8_t pix_bytes;
+  uint16_t clip_width = 0, clip_height = 0;
+
+  if (bpp != 8 && bpp != 16)
+    {
+      return -EINVAL;
+    }
+
+  if ((ihsize > ISE_SRC_HSIZE_MAX || ihsize < HSIZE_MIN) ||
+      (ivsize > ISE_SRC_VSIZE_MAX || ivsize < VSIZE_MIN) ||
+      (ohsize > ISE_DST_HSIZE_MAX || ohsize < HSIZE_MIN) ||
+      (ovsize > ISE_DST_VSIZE_MAX || ovsize < VSIZE_MIN))
+    {
+      return -EINVAL;
+    }
+
+  if (clip_rect != NULL)
+    {
+      if ( (clip_rect->x2 < clip_rect->x1) || 
+           (clip_rect->y2 < clip_rect->y1) )
+        {
+          return -EINVAL;
+        }
+
+      if ((clip_rect->x2 > ihsize) ||
+          (clip_rect->y2 > ivsize) )
+        {
+          return -EINVAL;
+        }
+
+      clip_width  = clip_rect->x2 - clip_rect->x1 + 1;
+      clip_height = clip_rect->y2 - clip_rect->y1 + 1;
+
+      if ((ratio_check(clip_width,  ohsize) != 0) ||
+          (ratio_check(clip_height, ovsize) != 0))
+        {
+          return -EINVAL;
+        }
+
+      pix_bytes = bpp >> 3;
+      ibuf = ibuf + (clip_rect->x1 * pix_bytes + clip_rect->y1 * ihsize * pix_bytes);
+
+    }
+  else
+    {
+      if ((ratio_check(ihsize, ohsize) != 0) ||
+          (ratio_check(ivsize, ovsize) != 0))
+        {
+          return -EINVAL;
+        }
+      clip_width  = ihsize;
+      clip_height = ivsize;
+    }
+
+  next = set_rop_cmd(*cmd, ibuf, obuf,
+                     clip_width, clip_height, ihsize,
+                     ohsize, ovsize, ohsize,
+                     bpp, SRCCOPY, FIXEDCOLOR, 0x0080);
+  if (next == NULL)
+    {
+      return -EINVAL;
+    }
+
+  *cmd = next;
+  return 0;
+}
+
+static inline int32_t ip_round(float v)
+{
+  return (int32_t)(v >= 0.0f ? v + 0.5f : v - 0.5f);
+}
+
+static inline int32_t ip_saturate(int32_t v, int32_t min, int32_t max)
+{
+  return v < min ? min : (v > max ? max : v);
+}
+
+static inline void ip_put_elem(imageproc_tensor_t *tensor, size_t idx,
+                               float v)
+{
+  switch (tensor->type)
+    {
+      case IMAGEPROC_TENSOR_FLOAT:
+        ((float *)tensor->buf)[idx] = v;
+        break;
+
+      case IMAGEPROC_TENSOR_INT16:
+        ((int16_t *)tensor->buf)[idx] =
+          (int16_t)ip_saturate(ip_round(v), INT16_MIN, INT16_MAX);
+        break;
+
+      default:
+        ((int8_t *)tensor->buf)[idx] =
+          (int8_t)ip_saturate(ip_round(v), INT8_MIN, INT8_MAX);
+        break;
+    }
+}
+
+static void *ip_job_worker(void *arg)
+{
+  imageproc_job_t *job;
+  ssize_t ret;
+
+  for (; ; )
+    {
+      if (ip_semtake(&g_jobqsem) != OK)
+        {
+          continue;
+        }
+
+      while (ip_semtake(&g_jobqlock) != OK);
+      job = g_jobhead;
+      if (job != NULL)
+        {
+          g_jobhead = job->next;
+          if (g_jobhead == NULL)
+            {
+              g_jobtail = NULL;
+            }
+        }
+      ip_semgive(&g_jobqlock);
+
+      /* Empty queue on wake up means finalize request */
+
+      if (job == NULL)
+        {
+          break;
+        }
+
+      /* Whole command chain runs in one descriptor execution */
+
+      ret = write(g_gfd, job->cmdbuf, job->cmdlen + HALTCMD_SIZE);
+      job->result = ret < 0 ? -EFAULT : 0;
+      job->busy = 0;
+
+      if (job->callback != NULL)
+        {
+          job->callback(job, job->result, job->arg);
+        }
+      else
+        {
+          ip_semgive(&job->done);
+        }
+    }
+
+  return NULL;
+}
+
+static int ip_job_start_worker(void)
+{
+  pthread_attr_t attr;
+  struct sched_param param;
+  int ret;
+
+  if (g_jobthread_running)
+    {
+      return OK;
+    }
+
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, CONFIG_IMAGEPROC_JOB_STACKSIZE);
+  param.sched_priority = CONFIG_IMAGEPROC_JOB_PRIORITY;
+  pthread_attr_setschedparam(&attr, &param);
+
+  ret = pthread_create(&g_jobthread, &attr, ip_job_worker, NULL);
+  pthread_attr_destroy(&attr);
+  if (ret != 0)
+    {
+      return -ret;
+    }
+
+  pthread_setname_np(g_jobthread, "imageproc_job");
+  g_jobthread_running = true;
+
+  return OK;
 }
 
 /****************************************************************************
@@ -417,6 +630,11 @@ void imageproc_initialize(void)
   sem_init(&g_rotwait, 0, 0);
   sem_init(&g_geexc, 0, 1);
   sem_setprotocol(&g_rotwait, SEM_PRIO_NONE);
+  sem_init(&g_jobqlock, 0, 1);
+  sem_init(&g_jobqsem, 0, 0);
+  sem_setprotocol(&g_jobqsem, SEM_PRIO_NONE);
+  g_jobhead = NULL;
+  g_jobtail = NULL;
 
   cxd56_ge2dinitialize(GEDEVNAME);
 
@@ -435,6 +653,15 @@ void imageproc_finalize(void)
   up_disable_irq(CXD56_IRQ_ROT);
   irq_detach(CXD56_IRQ_ROT);
 
+  /* Worker drains queued jobs, and then exits on empty queue */
+
+  if (g_jobthread_running)
+    {
+      ip_semgive(&g_jobqsem);
+      pthread_join(g_jobthread, NULL);
+      g_jobthread_running = false;
+    }
+
   if (g_gfd > 0)
     {
       close(g_gfd);
@@ -446,21 +673,23 @@ void imageproc_finalize(void)
   sem_destroy(&g_rotwait);
   sem_destroy(&g_rotexc);
   sem_destroy(&g_geexc);
+  sem_destroy(&g_jobqlock);
+  sem_destroy(&g_jobqsem);
 }
 
-void imageproc_convert_yuv2rgb(uint8_t * ibuf, uint32_t hsize, uint32_t vsize)
+int imageproc_convert_yuv2rgb(uint8_t * ibuf, uint32_t hsize, uint32_t vsize)
 {
   int ret;
 
   if ((hsize & 1) || (vsize & 1))
     {
-      return;
+      return -EINVAL;
     }
 
   ret = ip_semtake(&g_rotexc);
   if (ret)
     {
-      return;
+      return ret; /* -EINTR */
     }
 
   /*
@@ -491,25 +720,48 @@ void imageproc_convert_yuv2rgb(uint8_t * ibuf, uint32_t hsize, uint32_t vsize)
   ip_semtake(&g_rotwait);
 
   ip_semgive(&g_rotexc);
+
+  return 0;
 }
 
 void imageproc_convert_yuv2gray(uint8_t *ibuf, uint8_t *obuf, size_t hsize, size_t vsize)
 {
   uint16_t *p_src = (uint16_t *) ibuf;
-  size_t ix;
-  size_t iy;
+  uint32_t *p_src32;
+  uint32_t px;
+  size_t n = hsize * vsize;
 
-  for (iy = 0; iy < vsize; iy++)
+  /* Take 2 pixels (U Y V Y) per word access if input is word aligned */
+
+  if (((uintptr_t)ibuf & 3) == 0)
     {
-      for (ix = 0; ix < hsize; ix++)
+      p_src32 = (uint32_t *)ibuf;
+      for (; n >= 2; n -= 2)
         {
-          *obuf++ = (uint8_t) ((*p_src++ & 0xff00) >> 8);
+          px = *p_src32++;
+          *obuf++ = (uint8_t)(px >> 8);
+          *obuf++ = (uint8_t)(px >> 24);
         }
+      p_src = (uint16_t *)p_src32;
+    }
+
+  while (n--)
+    {
+      *obuf++ = (uint8_t) ((*p_src++ & 0xff00) >> 8);
     }
 }
 
 int imageproc_resize(uint8_t *ibuf, uint16_t ihsize, uint16_t ivsize,
                      uint8_t *obuf, uint16_t ohsize, uint16_t ovsize, int bpp)
+{
+  return imageproc_clip_and_resize(ibuf, ihsize, ivsize,
+                                   obuf, ohsize, ovsize, bpp, NULL);
+}
+
+int imageproc_clip_and_resize(
+  uint8_t *ibuf, uint16_t ihsize, uint16_t ivsize,
+  uint8_t *obuf, uint16_t ohsize, uint16_t ovsize,
+  int bpp, imageproc_rect_t *clip_rect)
 {
   void *cmd = g_gcmdbuf;
   size_t len;
@@ -520,25 +772,6 @@ int imageproc_resize(uint8_t *ibuf, uint16_t ihsize, uint16_t ivsize,
       return -ENODEV;
     }
 
-  if (bpp != 8 && bpp != 16)
-    {
-      return -EINVAL;
-    }
-
-  if ((ihsize > ISE_SRC_HSIZE_MAX || ihsize < HSIZE_MIN) ||
-      (ivsize > ISE_SRC_VSIZE_MAX || ihsize < VSIZE_MIN) ||
-      (ohsize > ISE_DST_HSIZE_MAX || ohsize < HSIZE_MIN) ||
-      (ovsize > ISE_DST_VSIZE_MAX || ovsize < VSIZE_MIN))
-    {
-      return -EINVAL;
-    }
-
-  if ((ratio_check(ihsize, ohsize) != 0) ||
-      (ratio_check(ivsize, ovsize) != 0))
-    {
-      return -EINVAL;
-    }
-
   ret = ip_semtake(&g_geexc);
   if (ret)
     {
@@ -547,13 +780,12 @@ int imageproc_resize(uint8_t *ibuf, uint16_t ihsize, uint16_t ivsize,
 
   /* Create descriptor to graphics engine */
 
-  cmd = set_rop_cmd(cmd, ibuf, obuf, ihsize, ivsize, ihsize,
-                    ohsize, ovsize, ohsize,
-                    bpp, SRCCOPY, FIXEDCOLOR, 0x0080);
-  if (cmd == NULL)
+  ret = set_clip_and_resize_cmd(&cmd, ibuf, ihsize, ivsize,
+                                obuf, ohsize, ovsize, bpp, clip_rect);
+  if (ret)
     {
       ip_semgive(&g_geexc);
-      return -EINVAL;
+      return ret;
     }
 
   /* Terminate command */
@@ -575,109 +807,293 @@ int imageproc_resize(uint8_t *ibuf, uint16_t ihsize, uint16_t ivsize,
   return 0;
 }
 
-int imageproc_clip_and_resize(
-  uint8_t *ibuf, uint16_t ihsize, uint16_t ivsize,
-  uint8_t *obuf, uint16_t ohsize, uint16_t ovsize,
-  int bpp, imageproc_rect_t *clip_rect)
+int imageproc_convert_to_tensor(uint8_t *ibuf, uint16_t ihsize,
+                                uint16_t ivsize, imageproc_rect_t *clip_rect,
+                                uint8_t *work, imageproc_tensor_t *tensor)
 {
-  void *cmd = g_gcmdbuf;
-  size_t len;
+  uint8_t *src = ibuf;
+  uint16_t *p_rgb;
+  size_t plane;
+  size_t i;
+  uint32_t c;
+  float k;
+  float b;
   int ret;
-  uint8_t pix_bytes;
-  uint16_t clip_width = 0, clip_height = 0;
 
-  if (g_gfd <= 0)
+  if (ibuf == NULL || tensor == NULL || tensor->buf == NULL)
     {
-      return -ENODEV;
+      return -EINVAL;
     }
 
-  if (bpp != 8 && bpp != 16)
+  if (tensor->type > IMAGEPROC_TENSOR_INT8 ||
+      tensor->channel > IMAGEPROC_CHANNEL_RGB)
     {
       return -EINVAL;
     }
 
-  if ((ihsize > ISE_SRC_HSIZE_MAX || ihsize < HSIZE_MIN) ||
-      (ivsize > ISE_SRC_VSIZE_MAX || ihsize < VSIZE_MIN) ||
-      (ohsize > ISE_DST_HSIZE_MAX || ohsize < HSIZE_MIN) ||
-      (ovsize > ISE_DST_VSIZE_MAX || ovsize < VSIZE_MIN))
+  /* YUV422 pixels come in pairs, and rotator converts only even sizes */
+
+  if ((ihsize & 1) || (ivsize & 1) ||
+      (tensor->hsize & 1) || (tensor->vsize & 1))
     {
       return -EINVAL;
     }
 
-  if (clip_rect != NULL)
+  if (tensor->type != IMAGEPROC_TENSOR_FLOAT &&
+      (tensor->fp_pos > FP_POS_MAX || tensor->fp_pos < -FP_POS_MAX))
     {
-      if ( (clip_rect->x2 < clip_rect->x1) || 
-           (clip_rect->y2 < clip_rect->y1) )
+      return -EINVAL;
+    }
+
+  /* Clip and resize on graphics engine, unless the frame can be read as is.
+   * RGB conversion is done in place, so it always needs the work buffer.
+   */
+
+  if (clip_rect != NULL || tensor->channel == IMAGEPROC_CHANNEL_RGB ||
+      ihsize != tensor->hsize || ivsize != tensor->vsize)
+    {
+      if (work == NULL)
         {
           return -EINVAL;
         }
 
-      if ((clip_rect->x2 > ihsize) ||
-          (clip_rect->y2 > ivsize) )
+      ret = imageproc_clip_and_resize(ibuf, ihsize, ivsize,
+                                      work, tensor->hsize, tensor->vsize,
+                                      16, clip_rect);
+      if (ret)
         {
-          return -EINVAL;
+          return ret;
         }
+      src = work;
+    }
 
-      clip_width  = clip_rect->x2 - clip_rect->x1 + 1;
-      clip_height = clip_rect->y2 - clip_rect->y1 + 1;
+  /* Fold mean, scale and fixed point position into v = pixel * k + b */
 
-      if ((ratio_check(clip_width,  ohsize) != 0) ||
-          (ratio_check(clip_height, ovsize) != 0))
+  k = tensor->scale;
+  if (tensor->type != IMAGEPROC_TENSOR_FLOAT)
+    {
+      k = tensor->fp_pos >= 0 ? k * (float)(1 << tensor->fp_pos) :
+                                k / (float)(1 << -tensor->fp_pos);
+    }
+  b = -tensor->mean * k;
+
+  plane = (size_t)tensor->hsize * tensor->vsize;
+
+  if (tensor->channel == IMAGEPROC_CHANNEL_GRAY)
+    {
+      /* Luminance is upper byte of each YUV422 pixel */
+
+      for (i = 0; i < plane; i++)
         {
-          return -EINVAL;
+          ip_put_elem(tensor, i, (float)src[i * 2 + 1] * k + b);
         }
+      return 0;
+    }
 
-      pix_bytes = bpp >> 3;
-      ibuf = ibuf + (clip_rect->x1 * pix_bytes + clip_rect->y1 * ihsize * pix_bytes);
+  /* Let rotator convert to RGB565, then expand to 8bit per channel and
+   * scatter to R, G and B planes.
+   */
 
+  ret = imageproc_convert_yuv2rgb(src, tensor->hsize, tensor->vsize);
+  if (ret)
+    {
+      return ret;
     }
-  else
+
+  p_rgb = (uint16_t *)src;
+  for (i = 0; i < plane; i++)
     {
-      if ((ratio_check(ihsize, ohsize) != 0) ||
-          (ratio_check(ivsize, ovsize) != 0))
-        {
-          return -EINVAL;
-        }
-      clip_width  = ihsize;
-      clip_height = ivsize;
+      c = (p_rgb[i] >> 11) & 0x1f;
+      ip_put_elem(tensor, i, (float)((c << 3) | (c >> 2)) * k + b);
+      c = (p_rgb[i] >> 5) & 0x3f;
+      ip_put_elem(tensor, plane + i, (float)((c << 2) | (c >> 4)) * k + b);
+      c = p_rgb[i] & 0x1f;
+      ip_put_elem(tensor, plane * 2 + i,
+                  (float)((c << 3) | (c >> 2)) * k + b);
     }
 
-  ret = ip_semtake(&g_geexc);
+  return 0;
+}
+
+int imageproc_job_init(imageproc_job_t *job, void *cmdbuf, size_t size)
+{
+  if (job == NULL || cmdbuf == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* GE2D wants 16 byte aligned address for command buffer */
+
+  if (((uintptr_t)cmdbuf & 0xf) != 0 ||
+      size < IMAGEPROC_JOB_CMDBUF_SIZE(1))
+    {
+      return -EINVAL;
+    }
+
+  memset(job, 0, sizeof(imageproc_job_t));
+  job->cmdbuf = cmdbuf;
+  job->cmdsize = size;
+  sem_init(&job->done, 0, 0);
+  sem_setprotocol(&job->done, SEM_PRIO_NONE);
+
+  return 0;
+}
+
+int imageproc_job_add_clip_and_resize(
+  imageproc_job_t *job,
+  uint8_t *ibuf, uint16_t ihsize, uint16_t ivsize,
+  uint8_t *obuf, uint16_t ohsize, uint16_t ovsize,
+  int bpp, imageproc_rect_t *clip_rect)
+{
+  void *cmd;
+  int ret;
+
+  if (job == NULL || job->cmdbuf == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (job->busy)
+    {
+      return -EBUSY;
+    }
+
+  /* Keep room for the terminating halt command */
+
+  if (job->cmdlen + sizeof(struct ge2d_ropcmd_s) + HALTCMD_SIZE >
+      job->cmdsize)
+    {
+      return -ENOSPC;
+    }
+
+  cmd = job->cmdbuf + job->cmdlen;
+  ret = set_clip_and_resize_cmd(&cmd, ibuf, ihsize, ivsize,
+                                obuf, ohsize, ovsize, bpp, clip_rect);
   if (ret)
     {
-      return ret; /* -EINTR */
+      return ret;
     }
 
-  /* Create descriptor to graphics engine */
+  job->cmdlen = (uintptr_t)cmd - (uintptr_t)job->cmdbuf;
+  job->nops++;
 
-  cmd = set_rop_cmd(cmd, ibuf, obuf,
-                    clip_width, clip_height, ihsize,
-                    ohsize, ovsize, ohsize,
-                    bpp, SRCCOPY, FIXEDCOLOR, 0x0080);
+  return 0;
+}
+
+int imageproc_job_submit(imageproc_job_t *job, imageproc_job_cb_t callback,
+                         void *arg)
+{
+  int ret;
 
-  if (cmd == NULL)
+  if (job == NULL || job->nops == 0)
     {
-      ip_semgive(&g_geexc);
       return -EINVAL;
     }
 
-  /* Terminate command */
+  if (g_gfd <= 0)
+    {
+      return -ENODEV;
+    }
 
-  cmd = set_halt_cmd(cmd);
+  if (job->busy)
+    {
+      return -EBUSY;
+    }
 
-  /* Process resize */
+  set_halt_cmd(job->cmdbuf + job->cmdlen);
 
-  len = (uintptr_t)cmd - (uintptr_t)g_gcmdbuf;
-  ret = write(g_gfd, g_gcmdbuf, len);
-  if (ret < 0)
+  job->callback = callback;
+  job->arg = arg;
+  job->result = 0;
+  job->next = NULL;
+  job->waitable = callback == NULL;
+
+  ret = ip_semtake(&g_jobqlock);
+  if (ret)
     {
-      ip_semgive(&g_geexc);
-      return -EFAULT;
+      return ret; /* -EINTR */
     }
 
-  ip_semgive(&g_geexc);
+  ret = ip_job_start_worker();
+  if (ret)
+    {
+      ip_semgive(&g_jobqlock);
+      return ret;
+    }
+
+  job->busy = 1;
+  if (g_jobtail != NULL)
+    {
+      g_jobtail->next = job;
+    }
+  else
+    {
+      g_jobhead = job;
+    }
+  g_jobtail = job;
+
+  ip_semgive(&g_jobqlock);
+  ip_semgive(&g_jobqsem);
 
   return 0;
 }
 
+int imageproc_job_wait(imageproc_job_t *job, int timeout_ms)
+{
+  struct timespec ts;
+  int ret;
+
+  if (job == NULL || !job->waitable)
+    {
+      return -EINVAL;
+    }
 
+  if (timeout_ms == 0)
+    {
+      ret = sem_trywait(&job->done);
+    }
+  else if (timeout_ms < 0)
+    {
+      ret = sem_wait(&job->done);
+    }
+  else
+    {
+      clock_gettime(CLOCK_REALTIME, &ts);
+      ts.tv_sec  += timeout_ms / 1000;
+      ts.tv_nsec += (timeout_ms % 1000) * 1000000;
+      if (ts.tv_nsec >= 1000000000)
+        {
+          ts.tv_sec++;
+          ts.tv_nsec -= 1000000000;
+        }
+      ret = sem_timedwait(&job->done, &ts);
+    }
+
+  if (ret != 0)
+    {
+      return errno == EINTR ? -EINTR : -EBUSY;
+    }
+
+  job->waitable = 0;
+
+  return job->result;
+}
+
+int imageproc_job_destroy(imageproc_job_t *job)
+{
+  if (job == NULL || job->cmdbuf == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (job->busy)
+    {
+      return -EBUSY;
+    }
+
+  sem_destroy(&job->done);
+  job->cmdbuf = NULL;
+  job->waitable = 0;
+
+  return 0;
+}
@@ -56,6 +56,8 @@
  * Included Files
  ****************************************************************************/
 
+#include <sdk/config.h>
+
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -91,6 +93,17 @@
 
 /** @} */
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+/** @name Packet length of result */
+/** @{ */
+
+/*! \brief StopBB result (#AUDRLT_STOPBBCMPLT) packet length */
+
+#define  LENGTH_AUDRLT_STOPBBCMPLT  3
+
+/** @} */
+#endif
+
 /** Check xLOUD volume range */
 
 #define CHECK_XLOUD_VOLUME_RANGE(vol)  \
@@ -327,6 +340,20 @@ typedef enum
   AS_SET_BBSTS_WITH_MPP_NUM
 } AsSetBBStsWithMpp;
 
+/** Select post filter function (low latency mode only) */
+
+typedef enum
+{
+  /*! \brief no post filter, through */
+
+  AS_SET_BBSTS_WITH_POSTPROC_NONE = 0,
+
+  /*! \brief User defined post filter active */
+
+  AS_SET_BBSTS_WITH_POSTPROC_ACTIVE,
+  AS_SET_BBSTS_WITH_POSTPROC_NUM
+} AsSetBBStsWithPostProc;
+
 /** InitMFE Command (#AUDCMD_INITMFE) parameter */
 
 typedef struct
@@ -464,13 +491,58 @@ typedef struct
   uint8_t  reserved6;
 } StopBBParam;
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+/** StopBB Result (#AUDRLT_STOPBBCMPLT) parameter */
+
+typedef struct
+{
+  /*! \brief [out] Minimum latency of SP/HP output [us]
+   *
+   * Time from capture done of I2S-in frame to render done of it,
+   * measured between StartBB and StopBB. Delay of codec and analog
+   * part is not included. Saturated at 65535 us, and 0 if no frame
+   * has been rendered.
+   */
+
+  uint32_t min_latency;
+
+  /*! \brief [out] Maximum latency of SP/HP output [us]
+   *
+   * Saturated at 65535 us.
+   */
+
+  uint32_t max_latency;
+} StopBBCmpltParam;
+
+/** InitPostproc API (AS_InitPostprocEffector()) parameter */
+
+typedef struct
+{
+  /*! \brief [in] Command packet addr to post filter DSP */
+
+  uint8_t  *addr;
+
+  /*! \brief [in] Command packet size */
+
+  uint32_t size;
+} AsInitEffectorPostProc;
+
+/** SetPostproc API (AS_SetPostprocEffector()) parameter */
+
+typedef AsInitEffectorPostProc AsSetEffectorPostProc;
+#endif
+
 /** SetBaseBandStatus Command (#AUDCMD_SETBASEBANDSTATUS) parameter */
 
 typedef struct
 {
-  /*! \brief [in] reserved */
+  /*! \brief [in] Select post filter function
+   *
+   * Use #AsSetBBStsWithPostProc enum type.
+   * Valid only in low latency mode, otherwise reserved.
+   */
 
-  uint8_t  reserved1;
+  uint8_t  with_PostProc;
 
   /*! \brief [in] Select MPP function
    *
@@ -561,6 +633,12 @@ typedef struct
   /*! \brief [in] Memory pool id of mfe output data */
 
   uint8_t mfe_out;
+
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+  /*! \brief [in] Memory pool id of post filter command to DSP */
+
+  uint8_t postproc_dsp;
+#endif
 } AsEffectorPoolId_t;
 
 /** Activate API parameter */
@@ -617,6 +695,34 @@ bool AS_CreateEffector(FAR AsCreateEffectorParam_t *param);
  */
 bool AS_DeleteEffector(void);
 
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+/**
+ * @brief Init post filter of sound effector
+ *
+ * Available in baseband ready state. Result is notified with
+ * #AUDRLT_INITMPPCMPLT.
+ *
+ * @param[in] initppparam: Command packet to post filter DSP
+ *
+ * @retval     true  : success
+ * @retval     false : failure
+ */
+bool AS_InitPostprocEffector(FAR AsInitEffectorPostProc *initppparam);
+
+/**
+ * @brief Set parameter of post filter of sound effector
+ *
+ * Available in baseband ready and active state. Result is notified with
+ * #AUDRLT_SETMPPCMPLT without waiting for the reply from DSP.
+ *
+ * @param[in] setppparam: Command packet to post filter DSP
+ *
+ * @retval     true  : success
+ * @retval     false : failure
+ */
+bool AS_SetPostprocEffector(FAR AsSetEffectorPostProc *setppparam);
+#endif
+
 #endif  /* __SONY_APPS_INCLUDE_AUDIOUTIL_AUDIO_EFFECTOR_API_H */
 /**
  * @}
@@ -1005,6 +1005,20 @@ typedef struct
      */
 
     SetBaseBandStatusParam set_baseband_status_param;
+
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+    /*! \brief [in] for AS_InitPostprocEffector()
+     * (header.command_code==#AUDCMD_INITMPP)
+     */
+
+    AsInitEffectorPostProc init_postproc_param;
+
+    /*! \brief [in] for AS_SetPostprocEffector()
+     * (header.command_code==#AUDCMD_SETMPPPARAM)
+     */
+
+    AsSetEffectorPostProc set_postproc_param;
+#endif
 #endif
 #ifdef AS_FEATURE_PLAYER_ENABLE
     /*! \brief [in] for SetPlayerStatus
@@ -1543,6 +1557,14 @@ typedef struct {
      */
 
     ErrorResponseParam error_response_param;
+
+#ifdef CONFIG_AUDIOUTILS_SOUND_EFFECTOR_LOW_LATENCY
+    /*! \brief [out] for StopBB completion
+     * (header.result_code==#AUDRLT_STOPBBCMPLT)
+     */
+
+    StopBBCmpltParam stop_bb_cmplt_param;
+#endif
   };
 
 #if !defined(__CC_ARM)
@@ -166,8 +166,9 @@
 #define MSG_AUD_PLY_CMD_STOP            (MSG_AUD_PLY_REQ | MSG_SET_SUBTYPE(0x03))
 #define MSG_AUD_PLY_CMD_DEACT           (MSG_AUD_PLY_REQ | MSG_SET_SUBTYPE(0x04))
 #define MSG_AUD_PLY_CMD_SETGAIN         (MSG_AUD_PLY_REQ | MSG_SET_SUBTYPE(0x05))
+#define MSG_AUD_PLY_CMD_SETNEXT         (MSG_AUD_PLY_REQ | MSG_SET_SUBTYPE(0x06))
 
-#define LAST_AUD_PLY_MSG    (MSG_AUD_PLY_CMD_SETGAIN + 1)
+#define LAST_AUD_PLY_MSG    (MSG_AUD_PLY_CMD_SETNEXT + 1)
 #define AUD_PLY_MSG_NUM     (LAST_AUD_PLY_MSG & MSG_TYPE_SUBTYPE)
 
 #define MSG_AUD_PLY_CMD_NEXT_REQ        (MSG_AUD_PLY_RES | MSG_SET_SUBTYPE(0x00))
@@ -310,8 +311,9 @@
 #define MSG_AUD_MIX_CMD_CLKRECOVERY (MSG_AUD_MIX_REQ | MSG_SET_SUBTYPE(0x05))
 #define MSG_AUD_MIX_CMD_INITMPP     (MSG_AUD_MIX_REQ | MSG_SET_SUBTYPE(0x06))
 #define MSG_AUD_MIX_CMD_SETMPP      (MSG_AUD_MIX_REQ | MSG_SET_SUBTYPE(0x07))
+#define MSG_AUD_MIX_CMD_ADPCLKRCV   (MSG_AUD_MIX_REQ | MSG_SET_SUBTYPE(0x08))
 
-#define LAST_AUD_MIX_MSG   (MSG_AUD_MIX_CMD_SETMPP + 1)
+#define LAST_AUD_MIX_MSG   (MSG_AUD_MIX_CMD_ADPCLKRCV + 1)
 #define AUD_MIX_MSG_NUM    (LAST_AUD_MIX_MSG & MSG_TYPE_SUBTYPE)
 
 #define MSG_AUD_MIX_RST    (MSG_AUD_MIX_RES | MSG_SET_SUBTYPE(0x00))
@@ -341,8 +343,11 @@
 #define MSG_AUD_SEF_CMD_DMA_OUT_DONE (MSG_AUD_SEF_REQ | MSG_SET_SUBTYPE(0x07))
 #define MSG_AUD_SEF_CMD_SETPARAM     (MSG_AUD_SEF_REQ | MSG_SET_SUBTYPE(0x08))
 #define MSG_AUD_SEF_CMD_CMPLT        (MSG_AUD_SEF_REQ | MSG_SET_SUBTYPE(0x09))
+#define MSG_AUD_SEF_CMD_POSTPROC_DONE (MSG_AUD_SEF_REQ | MSG_SET_SUBTYPE(0x0a))
+#define MSG_AUD_SEF_CMD_INITPOSTPROC  (MSG_AUD_SEF_REQ | MSG_SET_SUBTYPE(0x0b))
+#define MSG_AUD_SEF_CMD_SETPOSTPROC   (MSG_AUD_SEF_REQ | MSG_SET_SUBTYPE(0x0c))
 
-#define LAST_AUD_SEF_MSG    (MSG_AUD_SEF_CMD_CMPLT + 1)
+#define LAST_AUD_SEF_MSG    (MSG_AUD_SEF_CMD_SETPOSTPROC + 1)
 #define AUD_SEF_MSG_NUM     (LAST_AUD_SEF_MSG & MSG_TYPE_SUBTYPE)
 
 #define MSG_AUD_SEF_RST     (MSG_AUD_SEF_RES | MSG_SET_SUBTYPE(0x00))
@@ -164,6 +164,10 @@ enum AsOutputMixDoneCmdType
 
   OutputMixSetPostDone,
 
+  /*! \brief Set adaptive clock recovery done */
+
+  OutputMixSetAdpClkRcvDone,
+
   OutputMixDoneCmdTypeNum
 };
 
@@ -345,6 +349,43 @@ typedef struct
 
 } AsFrameTermFineControl;
 
+/** Adaptive clock recovery function parameter */
+
+typedef struct
+{
+  /*! \brief [in] Enable(1) or disable(0) */
+
+  uint8_t  enable;
+
+  /*! \brief [in] Maximum correction of output period [ppm] */
+
+  uint16_t max_ppm;
+
+  /*! \brief [in] Source buffer to be monitored
+   *
+   * Use CMN_SimpleFifoHandle (refer to include file) which the source
+   * writes into at its own clock, e.g. simple_fifo_handler of
+   * input device handler of player.
+   */
+
+  void *simple_fifo_handler;
+
+  /*! \brief [in] Target fill level [byte]
+   *
+   * 0 means the level at the start of rendering.
+   */
+
+  uint32_t target_level;
+
+  /*! \brief [in] Allowed deviation from target level [byte]
+   *
+   * Out of the band, maximum correction is applied.
+   */
+
+  uint32_t band;
+
+} AsAdaptiveClockRecovery;
+
 /** Init postproc parameter */
 
 typedef struct
@@ -378,6 +419,7 @@ typedef struct
     AsFrameTermFineControl  fterm_param;
     AsInitPostProc          initpp_param;
     AsSetPostProc           setpp_param;
+    AsAdaptiveClockRecovery adpclk_param;
   };
 } OutputMixerCommand;
 
@@ -453,6 +495,25 @@ bool AS_SendDataOutputMixer(FAR AsSendDataOutputMixer *sendparam);
 
 bool AS_FrameTermFineControlOutputMixer(uint8_t handle, FAR AsFrameTermFineControl *ftermparam);
 
+/**
+ * @brief Set adaptive clock recovery parameters
+ *
+ * @details Output mixer measures fill level of the source buffer at
+ *          every output period, and drives output period by PI control
+ *          so that the level is kept around the target. Correction is
+ *          applied by inserting or removing one sample per output
+ *          period at a rate given in ppm. While enabled, settings by
+ *          AS_FrameTermFineControlOutputMixer() are ignored.
+ *          (CONFIG_AUDIOUTILS_OUTPUTMIX_ADAPTIVE_CLKRCV)
+ *
+ * @param[in] param: adaptive clock recovery parameters
+ *
+ * @retval     true  : success
+ * @retval     false : failure
+ */
+
+bool AS_AdaptiveClockRecoveryOutputMixer(uint8_t handle, FAR AsAdaptiveClockRecovery *adpclkparam);
+
 /**
  * @brief Init Postproces DSP
  *
@@ -149,6 +149,14 @@ typedef enum
 
   AsPlayerEventSetGain,
 
+  /*! \brief Set next track (CONFIG_AUDIOUTILS_PLAYER_GAPLESS) */
+
+  AsPlayerEventSetNext,
+
+  /*! \brief Next track started (CONFIG_AUDIOUTILS_PLAYER_GAPLESS) */
+
+  AsPlayerEventNextTrack,
+
 } AsPlayerEvent;
 
 /** player id */
@@ -198,6 +206,10 @@ typedef enum
   /*! \brief RAM */
 
   AS_SETPLAYER_INPUTDEVICE_RAM,
+
+  /*! \brief File descriptor read by the SDK (CONFIG_AUDIOUTILS_PLAYER_FILE_INPUT) */
+
+  AS_SETPLAYER_INPUTDEVICE_FILE,
   AS_SETPLAYER_INPUTDEVICE_NUM
 
 } AsSetPlayerInputDevice;
@@ -306,6 +318,44 @@ typedef struct
   uint32_t  notification_threshold_size;
 } AsPlayerInputDeviceHdlrForRAM;
 
+/* for AsPlayerInputDeviceHdlrForFile */
+
+/** File input end callback function
+ * @param[in] result : 0 when the end of file was read,
+ *                     negative errno value when read failed
+ */
+
+typedef void (*AudioFileInputEndCallbackFunction)(int result);
+
+/** internal of file_handler (used in AsPlayerInputDeviceHdlr) parameter */
+
+typedef struct
+{
+  /*! \brief [in] Set file descriptor of es data
+   *
+   * Must be opened for reading. Reading starts from the current file
+   * offset and ends at the end of file. The descriptor is not closed
+   * by the player.
+   */
+
+  int fd;
+
+  /*! \brief [in] Set bit rate of es data [bps]
+   *
+   * Used to size the read-ahead requests. When 0, the worst case
+   * bit rate of the codec set by InitPlayer is assumed.
+   */
+
+  uint32_t bit_rate;
+
+  /*! \brief [in] Set callback function,
+   * Call this function when all es data was read from the file
+   * or read failed. (NULL : no notification)
+   */
+
+  AudioFileInputEndCallbackFunction callback_function;
+} AsPlayerInputDeviceHdlrForFile;
+
 /** SetPlayerStatus Command (#AUDCMD_SETPLAYERSTATUS) parameter */
 
 #if defined(__CC_ARM)
@@ -338,7 +388,16 @@ typedef struct
 
   /*! \brief [in] Set Player Input device handler, refer following. */
 
-  AsPlayerInputDeviceHdlrForRAM* ram_handler;
+  union
+  {
+    /*! \brief [in] for #AS_SETPLAYER_INPUTDEVICE_RAM */
+
+    AsPlayerInputDeviceHdlrForRAM* ram_handler;
+
+    /*! \brief [in] for #AS_SETPLAYER_INPUTDEVICE_FILE */
+
+    AsPlayerInputDeviceHdlrForFile* file_handler;
+  };
 
 } AsActivatePlayerParam;
 
@@ -441,6 +500,35 @@ typedef struct
 
 } AsInitPlayerParam;
 
+/** SetNextPlayer Command (AS_SetNextPlayer) parameter */
+
+typedef struct
+{
+  /*! \brief [in] Parameters of the next track
+   *
+   * dsp_path is not used, the loaded decoder continues.
+   */
+
+  AsInitPlayerParam init_param;
+
+  /*! \brief [in] Set input device handler of the next track
+   *
+   * Use the same type as the input device of ActivatePlayer.
+   */
+
+  union
+  {
+    /*! \brief [in] for #AS_SETPLAYER_INPUTDEVICE_RAM */
+
+    AsPlayerInputDeviceHdlrForRAM* ram_handler;
+
+    /*! \brief [in] for #AS_SETPLAYER_INPUTDEVICE_FILE */
+
+    AsPlayerInputDeviceHdlrForFile* file_handler;
+  };
+
+} AsSetNextPlayerParam;
+
 /** PlayPlayer Command (#AUDCMD_PLAYPLAYER, #AUDCMD_PLAYSUBPLAYER) parameter */
 
 typedef union
@@ -565,6 +653,12 @@ typedef struct
      */
   
     AsSetGainParam set_gain_param;
+
+    /*! \brief [in] for SetNextPlayer
+     * (Object Interface==AS_SetNextPlayer)
+     */
+
+    AsSetNextPlayerParam set_next_param;
   
     /*! \brief [in] for deactivate player
      * (header.command_code==#AUDCMD_SETREADYSTATUS)
@@ -614,6 +708,15 @@ typedef struct
   /*! \brief [in] Memory pool id of src work area */
 
   MemMgrLite::PoolId src_work;
+
+#ifdef CONFIG_AUDIOUTILS_PLAYER_PCM_BY_HANDLE
+  /*! \brief [in] Memory pool id of pcm data parameter sent by reference.
+   *  Segment size must be sizeof(#AsPcmDataParam) or more.
+   *  NullPoolId sends it by copy.
+   */
+
+  MemMgrLite::PoolId pcm_param;
+#endif
 } AsPlayerPoolId_t;
 
 
@@ -784,6 +887,34 @@ bool AS_SetPlayerGain(AsPlayerId id, FAR AsSetGainParam *gainparam);
 
 bool AS_RequestNextPlayerProcess(AsPlayerId id, FAR AsRequestNextParam *nextparam);
 
+/**
+ * @brief Set next track of (sub)player for gapless playback
+ *
+ * @details The next track is started while the current track is played.
+ *          Its input device handler is started and its head is parsed
+ *          in advance. At the end of the current track, the player
+ *          continues with the next track without stopping the decoder.
+ *          The end of the track is the end of the file for
+ *          #AS_SETPLAYER_INPUTDEVICE_FILE, and the end of es data after
+ *          #AS_STOPPLAYER_ESEND for #AS_SETPLAYER_INPUTDEVICE_RAM. Running
+ *          out of es data without them is an underflow as usual.
+ *          Accepted only when codec type, sampling rate, channel number
+ *          and bit length are the same as the current track.
+ *          Completion of this command is notified by #AsPlayerEventSetNext,
+ *          and the start of the next track by #AsPlayerEventNextTrack.
+ *          If the player is waiting for the end of es data by
+ *          #AS_STOPPLAYER_ESEND, the stop is completed at the start of the
+ *          next track instead, and the player keeps playing.
+ *          (CONFIG_AUDIOUTILS_PLAYER_GAPLESS)
+ *
+ * @param[in] nextparam: Parameters of the next track
+ *
+ * @retval     true  : success
+ * @retval     false : failure
+ */
+
+bool AS_SetNextPlayer(AsPlayerId id, FAR AsSetNextPlayerParam *nextparam);
+
 /**
  * @brief Deactivate (sub)player
  *
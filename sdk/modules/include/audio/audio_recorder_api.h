@@ -148,6 +148,12 @@ typedef enum
   /*! \brief RAM */
 
   AS_SETRECDR_STS_OUTPUTDEVICE_RAM,
+
+  /*! \brief File descriptor written by the SDK
+   *  (CONFIG_AUDIOUTILS_RECORDER_FILE_OUTPUT)
+   */
+
+  AS_SETRECDR_STS_OUTPUTDEVICE_FILE,
   AS_SETRECDR_STS_OUTPUTDEVICE_NUM
 } AsSetRecorderStsOutputDevice;
 
@@ -232,8 +238,50 @@ typedef struct
   AudioSimpleFifoWriteDoneCallbackFunction callback_function;
 } AsRecorderOutputDeviceHdlr;
 
+/* for AsRecorderOutputDeviceHdlrForFile */
+
+/** internal of file_handler
+ * (used in AsSetRecorderStatusParam) parameter
+ */
+
+typedef struct
+{
+  /*! \brief [in] Set file descriptor for recorded data
+   *
+   * Must be opened for writing. Writing starts from the current file
+   * offset. The descriptor is not closed by the recorder.
+   */
+
+  int fd;
+
+  /*! \brief [in] Set size to allocate at start [byte]
+   *
+   * The file is extended by this size when recording starts and
+   * truncated to the recorded size when recording stops.
+   * (0 : not allocated)
+   */
+
+  uint32_t prealloc_size;
+
+  /*! \brief [in] Write RIFF/WAVE header (LPCM only)
+   *
+   * The header is written at start and its sizes are updated
+   * when recording stops. (0 : raw data only)
+   */
+
+  uint8_t  wav_header;
+
+  /*! \brief [in] reserved */
+
+  uint8_t  reserved[3];
+} AsRecorderOutputDeviceHdlrForFile;
+
 /** SetRecorderStatus Command (#AUDCMD_SETRECORDERSTATUS) parameter */
 
+#if defined(__CC_ARM)
+#pragma anon_unions
+#endif
+
 typedef struct
 {
   /*! \brief [in] Select Recorder input device
@@ -264,7 +312,16 @@ typedef struct
 
   /*! \brief [in] Set Recorder output device handler, refer following. */
 
-  AsRecorderOutputDeviceHdlr*  output_device_handler;
+  union
+  {
+    /*! \brief [in] for #AS_SETRECDR_STS_OUTPUTDEVICE_RAM */
+
+    AsRecorderOutputDeviceHdlr*  output_device_handler;
+
+    /*! \brief [in] for #AS_SETRECDR_STS_OUTPUTDEVICE_FILE */
+
+    AsRecorderOutputDeviceHdlrForFile*  file_handler;
+  };
 
 } AsActivateRecorderParam;
 
@@ -39,6 +39,10 @@
 #include "memutils/s_stl/queue.h"
 #include "audio/audio_high_level_api.h"
 
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+class TrackDb;
+#endif
+
 /* Track information */
 
 struct Track
@@ -70,6 +74,10 @@ struct Track
   /*! \brief Codec type of the track */
 
   uint8_t   codec_type;
+
+  /*! \brief Duration of the track in msec (0 if unknown) */
+
+  uint32_t  duration;
 };
 
 /* Playlist class definition */
@@ -121,9 +129,32 @@ public:
 
     ListTypeUser,
 
+    /*! \brief Codec type categorized track list. */
+
+    ListTypeCodec,
+
     NumOfListType,
   };
 
+  enum UpdateMode
+  {
+    /*! \brief Write provisional metadata without reading audio files. */
+
+    UpdateModeSimple = 0,
+
+    /*! \brief Read metadata from header of all audio files. */
+
+    UpdateModeScan,
+
+    /*! \brief Read metadata from header of audio files which are
+     *         added or modified since last update.
+     */
+
+    UpdateModeIncremental,
+
+    NumOfUpdateMode,
+  };
+
   /**
    * @brief Playlist Constructor
    *
@@ -139,6 +170,9 @@ public:
   {
     strncpy(m_track_db_file_name, file_name, sizeof(m_track_db_file_name));
     memset(m_playlist_path, 0, sizeof(m_playlist_path));
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+    m_track_db = NULL;
+#endif
   }
 
   /**
@@ -148,6 +182,9 @@ public:
   ~Playlist()
   {
     close();
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+    closeTrackDb();
+#endif
   }
 
   /**
@@ -187,8 +224,10 @@ public:
    * @brief Select playlist to play
    * @note If type is ListTypeAllTrack, key_str is not cared.
    *
-   * @param[in] type:    ListTypeAllTrack, ListTypeArtist, ListTypeAlbum, ListTypeUser
-   * @param[in] key_str: Key string to select playlist. Author name, album name, etc...
+   * @param[in] type:    ListTypeAllTrack, ListTypeArtist, ListTypeAlbum, ListTypeUser,
+   *                     ListTypeCodec
+   * @param[in] key_str: Key string to select playlist. Author name, album name,
+   *                     codec name(mp3, wav, aac, opus), etc...
    *
    * @retval     true  : success
    * @retval     false : failure
@@ -201,8 +240,10 @@ public:
    * @details Create or update playlist. Target playlist should be selected by parameters.
    * @note If type is ListTypeAllTrack, key_str is not cared.
    *
-   * @param[in] type:    ListTypeAllTrack, ListTypeArtist, ListTypeAlbum, ListTypeUser
-   * @param[in] key_str: Key string to filter playlist. Author name, album name, etc...
+   * @param[in] type:    ListTypeAllTrack, ListTypeArtist, ListTypeAlbum, ListTypeUser,
+   *                     ListTypeCodec
+   * @param[in] key_str: Key string to filter playlist. Author name, album name,
+   *                     codec name(mp3, wav, aac, opus), etc...
    *
    * @retval     true  : success
    * @retval     false : failure
@@ -248,6 +289,22 @@ public:
 
   bool updateTrackDb(const char *audiofile_root_path);
 
+  /**
+   * @brief Update track database with metadata
+   * @details Create or update all track playlist by tracks in path/to/.
+   *          Channel number, bit length, sampling rate and duration are
+   *          read from header of wav, mp3 and aac(ADTS) files.
+   *          Artist and album names in existing track database are kept.
+   *
+   * @param[in] audiofile_root_path: Path to audio data file.
+   * @param[in] mode: UpdateModeSimple, UpdateModeScan, UpdateModeIncremental
+   *
+   * @retval     true  : success
+   * @retval     false : failure
+   */
+
+  bool updateTrackDb(const char *audiofile_root_path, UpdateMode mode);
+
   /**
    * @brief Delete all playlist
    * @note Delete playlist which is created internally.
@@ -309,16 +366,25 @@ private:
   bool open(FAR const char *mode);
   bool close(void);
   bool readLine(FAR char *line, uint32_t line_size);
+  bool reloadTrackDb(void);
   bool isTargetTrack(ListType       type,
                      FAR const char *key_str,
                      FAR Track      *track);
   bool loadAliasList(void);
   bool shuffleList(int idx_top);
   bool parseTrackInfo(FAR Track *track, FAR char *line, uint32_t line_size);
+  bool parseCodecType(FAR const char *str, FAR uint8_t *codec_type);
   bool getFileName(ListType       type,
                    FAR const char *key_str,
                    FAR char       *file_name,
                    uint8_t        max_length);
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+  bool openTrackDb(bool rebuild);
+  void closeTrackDb(void);
+  bool writeAliasList(ListType       type,
+                      FAR const char *key_str,
+                      FAR FILE       *list_fp);
+#endif
 
   static const int  FileNameMaxLength = 128;
   static const int  LineMaxLength     = 256;
@@ -332,6 +398,9 @@ private:
   char       m_line_buffer[LineMaxLength];
   char       m_track_db_file_name[FileNameMaxLength];
   FAR FILE   *m_track_db_fp;
+#ifdef CONFIG_AUDIOUTILS_PLAYLIST_BINARY_DB
+  FAR TrackDb *m_track_db;
+#endif
 
   s_std::Queue<uint32_t, 256> m_alias_list;
 };
@@ -59,6 +59,10 @@ extern "C"
 
 #  define DNNRT_IMPLEMENT (0)
 
+/** Wait until the submitted forward propagation completes
+ *  (see dnn_runtime_forward_poll()) */
+#  define DNN_POLL_FOREVER (0xffffffffu)
+
 /**
  * @defgroup dnnrt_datatype Data Types
  * @{
@@ -88,8 +92,23 @@ typedef struct dnn_mallinfo
   size_t total_bytes;
   size_t used_bytes;
   size_t largest_bytes;
+  size_t arena_bytes;      /**< Bytes of arenas holding variable buffers */
+  size_t peak_arena_bytes; /**< Largest arena planned for a network */
 } dnn_mallinfo_t;
 
+/**
+ * @typedef dnn_layer_profile_t
+ * structure to obtain profile of a layer
+ */
+typedef struct dnn_layer_profile
+{
+  unsigned short function_type; /**< nn_function_type_t of the layer */
+  unsigned long cycles;         /**< CPU cycles spent in the last forward (0 if not measured by cycle counter) */
+  unsigned long time_ns;        /**< Time spent in the last forward in nanoseconds */
+  size_t scratch_bytes;         /**< Scratch buffer the layer requires per CPU */
+  size_t output_bytes;          /**< Total size of the output variables */
+} dnn_layer_profile_t;
+
 /** @} dnnrt_datatype */
 
 /********************************************************************************
@@ -166,6 +185,63 @@ int dnn_runtime_finalize(dnn_runtime_t * rt);
 int dnn_runtime_forward(dnn_runtime_t * rt, const void *inputs[],
                         unsigned char input_num);
 
+/**
+ * Execute forward propagation for each of batch_num input sets,
+ * and store each output into a buffer given by applications.
+ *
+ * @param [in,out] rt:        dnnrt_runtime_t object
+ * @param [in]     inputs:    an array of batch_num * input_num pointers to input buffers. <br>
+ *                            inputs[b * input_num + i] is the i-th input of the b-th set.
+ * @param [in]     input_num: length of each input set
+ * @param [out]    outputs:   an array of batch_num * dnn_runtime_output_num(rt) pointers <br>
+ *                            to buffers receiving the outputs in the same order as inputs. <br>
+ *                            A NULL entry leaves that output in dnn_runtime_output_buffer().
+ * @param [in]     batch_num: number of input sets
+ *
+ * @return 0 on success, otherwise returns error code in rt_return_value_t or errno_t.
+ * @note If CONFIG_DNN_RT_MP=n, the output variables are bound to outputs[] while <br>
+ *       each set is processed, so the results are written there without copying. <br>
+ *       If CONFIG_DNN_RT_MP=y, the results are copied from dnn_runtime_output_buffer().
+ */
+int dnn_runtime_forward_batch(dnn_runtime_t * rt, const void *inputs[],
+                              unsigned char input_num, void *outputs[],
+                              unsigned short batch_num);
+
+/**
+ * Start forward propagation without waiting for its completion.
+ *
+ * @param [in,out] rt:        dnnrt_runtime_t object
+ * @param [in]     inputs:    an array of pointers to input buffers
+ * @param [in]     input_num: length of inputs
+ *
+ * @return 0 on success, otherwise returns error code in errno_t. <br>
+ *         -EBUSY if rt has a submitted forward propagation which is not polled yet, <br>
+ *         or CONFIG_DNN_RT_ASYNC_DEPTH of them are outstanding.
+ * @note Forward propagations of different dnn_runtime_t objects can be submitted <br>
+ *       one after another, and they are processed in the submitted order. <br>
+ *       Input buffers must be kept until dnn_runtime_forward_poll() returns its result, <br>
+ *       so applications can prepare the next input in another buffer meanwhile. <br>
+ *       If CONFIG_DNN_RT_MP=y, other dnnrt APIs return -EBUSY until all of them are polled. <br>
+ *       If CONFIG_DNN_RT_MP=n, the forward propagation completes in this function.
+ */
+int dnn_runtime_forward_submit(dnn_runtime_t * rt, const void *inputs[],
+                               unsigned char input_num);
+
+/**
+ * Obtain the result of forward propagation started by dnn_runtime_forward_submit().
+ *
+ * @param [in,out] rt: dnnrt_runtime_t object
+ * @param [in]     ms: time to wait in milliseconds. <br>
+ *                     0 means polling without blocking, DNN_POLL_FOREVER waits until completion.
+ *
+ * @return result of dnn_runtime_forward() on completion. <br>
+ *         -EAGAIN or -ETIMEDOUT if it is still in progress. <br>
+ *         -EPERM if no forward propagation of rt is submitted.
+ * @note Forward propagations submitted before the one of rt are completed first, <br>
+ *       and their results are kept until they are polled.
+ */
+int dnn_runtime_forward_poll(dnn_runtime_t * rt, unsigned int ms);
+
 /**
  * Return the number of inputs which this network needs.
  *
@@ -291,10 +367,31 @@ nn_variable_t *dnn_runtime_output_variable(dnn_runtime_t * rt,
  */
 void *dnn_runtime_output_buffer(dnn_runtime_t * rt, unsigned char output_index);
 
+/**
+ * Obtain profile of each layer recorded by the last dnn_runtime_forward().
+ *
+ * @param [in,out] rt:      dnnrt_runtime_t object
+ * @param [out]    profile: array to store profile of each layer in order of functions
+ * @param [in]     length:  number of elements in profile
+ *
+ * @return number of layers in the network on success, otherwise returns error code in errno_t. <br>
+ *         -EPERM if CONFIG_DNN_RT_PROFILE=n
+ *
+ * @note At most length elements are stored even if the network has more layers.
+ * @note CONFIG_DNN_RT_PROFILE depends on CONFIG_DNN_RT_MP=n, so this function
+ *       always returns -EPERM on multicore processing.
+ */
+int dnn_runtime_profile(dnn_runtime_t * rt, dnn_layer_profile_t * profile,
+                        unsigned short length);
+
 /**
  * Obtain information about memory allocation in the Nuttx-side heap
  *
- * @param [out] info: pointer to store memory allocation stats
+ * @param [out] info: pointer to store memory allocation stats.<br>
+ *                    arena_bytes and peak_arena_bytes report the arenas
+ *                    into which variable buffers are packed by lifetime.<br>
+ *                    If CONFIG_DNN_RT_MP=y, they report the arenas which
+ *                    the worker plans for the initialized runtimes.
  *
  * @return 0 on success. otherwise -EINVAL.
  */
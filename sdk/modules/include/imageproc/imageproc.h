@@ -36,6 +36,8 @@
 #define __IMAGEPROC_H__
 
 #include <stdint.h>
+#include <stddef.h>
+#include <semaphore.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -59,6 +61,80 @@ struct imageproc_rect_s {
 };
 typedef struct imageproc_rect_s imageproc_rect_t;
 
+/**
+ * Element type of the tensor written by imageproc_convert_to_tensor()
+ */
+enum imageproc_tensor_type_e {
+  IMAGEPROC_TENSOR_FLOAT = 0, /**< 32bit floating point */
+  IMAGEPROC_TENSOR_INT16,     /**< 16bit fixed point (Q format by fp_pos) */
+  IMAGEPROC_TENSOR_INT8,      /**< 8bit fixed point (Q format by fp_pos) */
+};
+
+/**
+ * Channel layout of the tensor written by imageproc_convert_to_tensor()
+ */
+enum imageproc_tensor_channel_e {
+  IMAGEPROC_CHANNEL_GRAY = 0, /**< 1 channel, luminance (Y) only */
+  IMAGEPROC_CHANNEL_RGB,      /**< 3 channels, planar R, G, B (CHW order) */
+};
+
+/**
+ * Destination of imageproc_convert_to_tensor().
+ *
+ * Each output element is computed as (pixel - mean) * scale, where pixel is
+ * in range 0..255. For fixed point types the result is multiplied by
+ * 2^fp_pos, rounded and saturated to the element type.
+ */
+struct imageproc_tensor_s {
+  void    *buf;     /**< Output buffer (e.g. dnn_runtime_input_buffer()) */
+  uint16_t hsize;   /**< Tensor width */
+  uint16_t vsize;   /**< Tensor height */
+  uint8_t  type;    /**< Element type, enum imageproc_tensor_type_e */
+  uint8_t  channel; /**< Channel layout, enum imageproc_tensor_channel_e */
+  int8_t   fp_pos;  /**< Fixed point position for INT16/INT8 types */
+  float    mean;    /**< Value subtracted from each pixel */
+  float    scale;   /**< Value multiplied after mean subtraction */
+};
+typedef struct imageproc_tensor_s imageproc_tensor_t;
+
+/**
+ * Command buffer size for an imageproc job holding @a n operations
+ */
+#define IMAGEPROC_JOB_CMDBUF_SIZE(n) ((n) * 48 + 16)
+
+struct imageproc_job_s;
+
+/**
+ * Job completion callback, called on the imageproc worker thread
+ *
+ * @param [in] job: Completed job
+ * @param [in] result: 0 on success, otherwise error code
+ * @param [in] arg: Argument given to imageproc_job_submit()
+ */
+typedef void (*imageproc_job_cb_t)(struct imageproc_job_s *job, int result,
+                                   void *arg);
+
+/**
+ * Queueable graphics engine job.
+ *
+ * All members are private to imageproc. A job must not be touched by the
+ * caller from imageproc_job_submit() until it is completed.
+ */
+struct imageproc_job_s {
+  struct imageproc_job_s *next; /**< Next job in the queue */
+  uint8_t *cmdbuf;              /**< Command buffer, 16 bytes aligned */
+  size_t   cmdsize;             /**< Size of command buffer */
+  size_t   cmdlen;              /**< Length of queued commands */
+  int      nops;                /**< Number of queued operations */
+  int      result;              /**< Result of the job */
+  volatile int busy;            /**< Non-zero while submitted */
+  int      waitable;            /**< Submitted without callback, not waited */
+  imageproc_job_cb_t callback;  /**< Completion callback */
+  void    *arg;                 /**< Argument for callback */
+  sem_t    done;                /**< Posted on completion */
+};
+typedef struct imageproc_job_s imageproc_job_t;
+
 /**
  * Initialize imageproc library
  */
@@ -79,9 +155,11 @@ void imageproc_finalize(void);
  * @param [in,out] ibuf: image
  * @param [in] hsize: Horizontal size
  * @param [in] vsize: Vertical size
+ *
+ * @return 0 on success, -EINVAL if a size is odd, otherwise error code.
  */
 
-void imageproc_convert_yuv2rgb(uint8_t *ibuf, uint32_t hsize, uint32_t vsize);
+int imageproc_convert_yuv2rgb(uint8_t *ibuf, uint32_t hsize, uint32_t vsize);
 
 /**
  * Convert color format (YUV to grayscale)
@@ -226,6 +304,116 @@ int imageproc_clip_and_resize(
   uint8_t *obuf, uint16_t ohsize, uint16_t ovsize,
   int bpp, imageproc_rect_t *clip_rect);
 
+/**
+ * Convert camera frame to DNN model input
+ *
+ * Clip @a clip_rect from YUV422 image @a ibuf, resize it to the tensor size
+ * with the graphics engine, and write luminance or RGB values normalized
+ * by mean and scale directly into @a tensor->buf in a single pass.
+ *
+ * Resizing has the same limitations as imageproc_clip_and_resize().
+ * @a work must hold tensor->hsize * tensor->vsize * 2 bytes. It may be
+ * NULL only if @a clip_rect is NULL, the channel is gray and the input
+ * size equals the tensor size. Input and tensor sizes must be even, and
+ * fp_pos of fixed point types must be in -30 to 30.
+ *
+ * @param [in] ibuf: Input image (YUV422)
+ * @param [in] ihsize: Input horizontal size
+ * @param [in] ivsize: Input vertical size
+ * @param [in] clip_rect: Clipping rectangle on input image, or NULL
+ * @param [in] work: Work buffer for resized image
+ * @param [in,out] tensor: Output tensor description
+ *
+ * @return 0 on success, -EINVAL on invalid parameters, otherwise error code.
+ */
+
+int imageproc_convert_to_tensor(uint8_t *ibuf, uint16_t ihsize,
+                                uint16_t ivsize, imageproc_rect_t *clip_rect,
+                                uint8_t *work, imageproc_tensor_t *tensor);
+
+/**
+ * Initialize imageproc job
+ *
+ * Prepare @a job to build a command chain in @a cmdbuf. Use
+ * IMAGEPROC_JOB_CMDBUF_SIZE() to know the required size. The command
+ * buffer must be 16 bytes aligned and kept valid until the job is completed.
+ * Completed job can be initialized again to reuse it. Call
+ * imageproc_job_destroy() when the job is no longer used.
+ *
+ * @param [out] job: Job
+ * @param [in] cmdbuf: Command buffer
+ * @param [in] size: Size of @a cmdbuf
+ *
+ * @return 0 on success, otherwise error code.
+ */
+
+int imageproc_job_init(imageproc_job_t *job, void *cmdbuf, size_t size);
+
+/**
+ * Add clip and resize operation to imageproc job
+ *
+ * Parameters are same as imageproc_clip_and_resize(). The operation is
+ * only queued in the job, it runs on imageproc_job_submit().
+ *
+ * @return 0 on success, -ENOSPC if the command buffer is full,
+ *         otherwise error code.
+ */
+
+int imageproc_job_add_clip_and_resize(
+  imageproc_job_t *job,
+  uint8_t *ibuf, uint16_t ihsize, uint16_t ivsize,
+  uint8_t *obuf, uint16_t ohsize, uint16_t ovsize,
+  int bpp, imageproc_rect_t *clip_rect);
+
+/**
+ * Submit imageproc job
+ *
+ * Queue all operations in @a job to the graphics engine as one command
+ * chain and return immediately. Jobs are processed in submitted order.
+ * @a callback is called on the worker thread when the job is completed,
+ * and it can be NULL if imageproc_job_wait() is used instead.
+ *
+ * @param [in] job: Job
+ * @param [in] callback: Completion callback, or NULL
+ * @param [in] arg: Argument for @a callback
+ *
+ * @return 0 on success, otherwise error code.
+ */
+
+int imageproc_job_submit(imageproc_job_t *job, imageproc_job_cb_t callback,
+                         void *arg);
+
+/**
+ * Wait for imageproc job completion
+ *
+ * Only for jobs submitted without callback. The result can be obtained
+ * once per submission.
+ *
+ * @param [in] job: Submitted job
+ * @param [in] timeout_ms: 0 to poll, negative to wait forever,
+ *                         otherwise timeout in milliseconds.
+ *
+ * @return Result of the job, -EBUSY if not completed by the timeout,
+ *         -EINVAL if the job is not submitted without callback or its
+ *         result is already obtained.
+ */
+
+int imageproc_job_wait(imageproc_job_t *job, int timeout_ms);
+
+/**
+ * Destroy imageproc job
+ *
+ * Release the resources of @a job initialized by imageproc_job_init().
+ * The command buffer is not freed, it belongs to the caller.
+ *
+ * @param [in] job: Job which is not submitted or already completed
+ *
+ * @return 0 on success, -EBUSY if the job is not completed yet,
+ *         otherwise error code.
+ */
+
+int imageproc_job_destroy(imageproc_job_t *job);
+
 /** @} imageproc_funcs */
 /** @} imageproc */
 
@@ -154,6 +154,9 @@ public:
   static PoolSize  getPoolSize(PoolId id) { return findPool(id)->getPoolSize(); }
   static NumSeg  getPoolNumSegs(PoolId id) { return findPool(id)->getPoolNumSegs(); }
   static NumSeg  getPoolNumAvailSegs(PoolId id) { return findPool(id)->getPoolNumAvailSegs(); }
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_POOL
+  static PoolSize  getPoolFreeSize(PoolId id);
+#endif
 #ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_FENCE
   static bool  isPoolFenceEnable(PoolId id) { return findPool(id)->isPoolFenceEnable(); }
 #endif
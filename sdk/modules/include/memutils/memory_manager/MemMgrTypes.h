@@ -105,6 +105,8 @@ enum
   /** the type number of fixed pools. (Now only support this type.) */
   BasicType,
   RingBufType,
+  /** the type number of variable size (power-of-two size class) pools. */
+  VarSizeType,
   /** Number of types. */
   NumPoolTypes  /* number of pool types */
 };
@@ -43,8 +43,31 @@
  * - By using virtual function 4 bytes size increases for each instance.
  */
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+/* Segment caches are held for each CPU, one for the task context
+ * and one for the interrupt context.
+ */
+
+#ifdef CONFIG_SMP
+#define MEMMGR_NUM_SEG_CACHES  (CONFIG_SMP_NCPUS * 2)
+#else
+#define MEMMGR_NUM_SEG_CACHES  2
+#endif
+#define MEMMGR_SEG_CACHE_DEPTH CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE_DEPTH
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE */
+
 namespace MemMgrLite {
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+/*****************************************************************
+ * Segment cache (magazine) of one execution context
+ *****************************************************************/
+struct SegCache {
+  NumSeg  count;                          /* number of cached segments */
+  NumSeg  segs[MEMMGR_SEG_CACHE_DEPTH];   /* cached segment numbers */
+}; /* struct SegCache */
+#endif
+
 /*****************************************************************
  * Memory pool base class (16 or 20bytes)
  *****************************************************************/
@@ -62,6 +85,11 @@ protected:
 		if (m_seg_no_que.que_area() == NULL || m_ref_cnt_array == NULL) {
 			return true;
 		}
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+		if (m_seg_cache == NULL) {
+			return true;
+		}
+#endif
 		return false;
 	}
 
@@ -70,7 +98,11 @@ protected:
 	PoolAddr	getPoolAddr() const { return m_attr.addr; }
 	PoolSize	getPoolSize() const { return m_attr.size; }
 	NumSeg		getPoolNumSegs() const { return m_attr.num_segs; }
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+	NumSeg		getPoolNumAvailSegs() const;	/* takes the pool lock */
+#else
 	NumSeg		getPoolNumAvailSegs() const { return m_seg_no_que.size(); }
+#endif
 #ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_FENCE
 	bool		isPoolFenceEnable() const { return m_attr.fence; }
 	void		initPoolFence();
@@ -79,6 +111,20 @@ protected:
 #ifdef USE_MEMMGR_MULTI_CORE
 	LockId		getPoolLockId() const { return m_attr.spl_id; }
 #endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+  /* A pool shared between CPUs is guarded by the inter-CPU spin lock.
+   * The caches are guarded only by the local dispatch lock, so such
+   * a pool does not use them.
+   */
+
+	bool		isSegCacheEnable() const {
+#ifdef USE_MEMMGR_MULTI_CORE
+		return getPoolLockId() == NullLockId;
+#else
+		return true;
+#endif
+	}
+#endif
 
   /* Get and update of segment reference counter value. */
 
@@ -108,6 +154,30 @@ protected:
 
 	void	freeSeg(MemHandleBase& mh);
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+  /* Get/return a segment through the cache of the current context.
+   * Interrupts are not disabled unless the cache has to be refilled
+   * from (or drained to) the segment number queue.
+   */
+
+	MemHandleProxy	allocSegCached();
+	void	freeSegCached(MemHandleBase& mh);
+
+  /* Return all cached segments to the segment number queue.
+   * Exclusive control should be done on the caller side.
+   */
+
+	void	flushSegCache();
+
+	NumSeg	getNumCachedSegs() const;
+
+private:
+	void	refillSegCache(SegCache& cache, bool isr);
+	void	drainSegCache(SegCache& cache, bool isr);
+	void	moveToSegCache(SegCache& cache);
+	void	moveFromSegCache(SegCache& cache);
+#endif
+
 protected:
   /* In the case of a static pool, it points to the corresponding part
    * of MemoryPoolLayouts.
@@ -130,6 +200,14 @@ protected:
    */
 
 	SegRefCnt* const	m_ref_cnt_array;
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+  /* Pointer to segment cache array (MEMMGR_NUM_SEG_CACHES entries).
+   * The area is prepared separately like the queue data.
+   */
+
+	SegCache* const		m_seg_cache;
+#endif
 }; /* class MemPool */
 
 } /* namespace MemMgrLite */
@@ -48,7 +48,7 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define DRM_TO_CACHED_VA(drm) (void*)(drm)
+#define DRM_TO_CACHED_VA(drm) (void*)(uintptr_t)(drm)
 
 /*****************************************************************
  * Type characteristic
@@ -159,6 +159,67 @@ public:
   /* Transmission of message packet.(task context, address range parameter) */
   static err_t send(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, const void* param, size_t param_size);
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER
+  /** Send a parameter held in a memory segment by reference.
+   *  Only the memory handle is copied into the queue and
+   *  the segment is kept until the receiver discards the packet by pop().
+   *  The receiver refers to the parameter by MsgPacket::peekParamByHandle().
+   *  @param[in] dest   Destination id
+   *  @param[in] pri    Priority
+   *  @param[in] type   Message Type
+   *  @param[in] reply  Reply id
+   *  @param[in] mh     Memory handle of the segment holding the parameter
+   *  @return err_t error code.
+   */
+  static err_t sendByHandle(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, const MemMgrLite::MemHandle& mh)
+    {
+      return send(dest, pri, type, reply, MsgHandleParam(mh));
+    }
+
+  /** Send a copy of an object by reference.
+   *  The object is copied into a segment allocated from the pool,
+   *  and only the memory handle of the segment is queued.
+   *  The receiver must take it out by MsgPacket::moveParamByHandle().
+   *  @param[in] dest   Destination id
+   *  @param[in] pri    Priority
+   *  @param[in] type   Message Type
+   *  @param[in] reply  Reply id
+   *  @param[in] pool   Pool id of the segment to hold the object
+   *  @param[in] param  Object to send
+   *  @return err_t error code. Error of MemHandle::allocSeg() if no segment.
+   */
+  template<typename T>
+  static err_t sendByHandle(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, MemMgrLite::PoolId pool, const T& param)
+    {
+      MemMgrLite::MemHandle mh;
+      err_t                 err_code = mh.allocSeg(pool, sizeof(T));
+
+      if (err_code != ERR_OK)
+        {
+          return err_code;
+        }
+
+      FAR T* obj = new (mh.getVa()) T(param);
+
+      /* pop() destructs the object unless the receiver takes it out */
+
+      err_code = send(dest, pri, type, reply,
+                      MsgHandleParam(mh, &MsgHandleParam::destruct<T>));
+      if (err_code != ERR_OK)
+        {
+          obj->~T();
+        }
+
+      return err_code;
+    }
+
+  /* Transmission of message packet by reference.(non task context) */
+  static err_t sendIsrByHandle(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, const MemMgrLite::MemHandle& mh)
+    {
+      return sendIsr(dest, pri, type, reply, MsgHandleParam(mh));
+    }
+#endif
+
   /* Transmission of message packet.(non task context, no parameters) */
   static err_t sendIsr(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply);
 
@@ -186,6 +247,14 @@ public:
 
   static void dump();
 
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+  /* Dump display of the statistics of all message queues.
+   * The statistics are cleared after displayed when clear is true.
+   */
+
+  static err_t dumpStats(bool clear);
+#endif
+
 }; /* class MsgLib */
 
 #include "MsgNotify.h"    /* User implemented by processor */
@@ -38,10 +38,14 @@
 
 #include <new>			/* placement new */
 #include <stdio.h>		/* printf */
+#include <sdk/config.h>
 #include "memutils/common_utils/common_types.h"	/* MIN, uintN_t */
 #include "memutils/common_utils/common_assert.h"	/* D_ASSERT */
 //#include "SpinLock.h"		/* MEMORY_BARRIER */
 #include "memutils/message/type_holder.h"	/* TypeHolder */
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER
+#include "memutils/memory_manager/MemHandle.h"	/* MemHandle */
+#endif
 
 #ifdef USE_MULTI_CORE
 #include "get_cpu_id.h"		/* GET_CPU_ID */
@@ -87,6 +91,11 @@ public:
   /* Parameter is formatted with type. */
 
 	static const MsgFlags MsgFlagTypedParam = 0x40;
+
+  /* Parameter is a memory handle referring to the parameter body. */
+
+	static const MsgFlags MsgFlagHandleParam = 0x20;
+
 	MsgPacketHeader(MsgType type, MsgQueId reply, MsgFlags flags, uint16_t size = 0) :
 		m_type(type),
 		m_reply(reply),
@@ -100,6 +109,11 @@ public:
 	MsgFlags getFlags() const { return m_flags; }
 	uint16_t getParamSize() const { return m_param_size; }
 	void     popParamNoDestruct() { m_param_size = 0; }
+	bool     isHandleParam() const { return (m_flags & MsgFlagHandleParam) != 0; }
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+	uint32_t getStamp() const { return m_stamp; }
+	void     setStamp(uint32_t stamp) { m_stamp = stamp; }
+#endif
 
 protected:
 	bool isSelfCpu() const { return GET_CPU_ID() == getSrcCpu(); }
@@ -111,6 +125,9 @@ protected:
 	MsgCpuId	m_src_cpu;
 	MsgFlags	m_flags;
 	uint16_t	m_param_size;
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+	uint32_t	m_stamp;	/* cycle counter at push */
+#endif
 }; /* class MsgPacketHeader */
 
 /*****************************************************************
@@ -134,6 +151,49 @@ private:
 	size_t		m_param_size;
 };
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER
+/*****************************************************************
+ * Class indicating that the parameter is passed by reference
+ * to a memory segment. Only the memory handle is stored in
+ * the queue, and its reference count is held until the packet
+ * is discarded by MsgQueBlock::pop().
+ *****************************************************************/
+class MsgHandleParam {
+public:
+	typedef void (*Destructor)(void* obj);
+
+	explicit MsgHandleParam(const MemMgrLite::MemHandle& mh, Destructor destruct = NULL) :
+		m_mh(mh),
+		m_destruct(destruct) {}
+	const MemMgrLite::MemHandle&	getHandle() const { return m_mh; }
+	Destructor			getDestructor() const { return m_destruct; }
+
+  /* Destructor of an object copied into the segment. */
+
+	template<typename T>
+	static void destruct(void* obj) { static_cast<T*>(obj)->~T(); }
+
+private:
+	const MemMgrLite::MemHandle&	m_mh;
+	Destructor			m_destruct;
+};
+
+/*****************************************************************
+ * Parameter stored in a packet for MsgHandleParam.
+ * m_destruct is set if the segment holds an object copied by
+ * MsgLib::sendByHandle() with a pool id, so that the object is
+ * destructed before the segment is released.
+ *****************************************************************/
+struct MsgHandleBody {
+	MsgHandleBody(const MemMgrLite::MemHandle& mh, MsgHandleParam::Destructor destruct) :
+		m_mh(mh),
+		m_destruct(destruct) {}
+
+	MemMgrLite::MemHandle		m_mh;
+	MsgHandleParam::Destructor	m_destruct;
+};
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER */
+
 /*****************************************************************
  * Message Packet Class
  * In the instance copy of this class,
@@ -178,6 +238,67 @@ public:
 		m_param_size = 0;
 	}
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER
+  /* Refer to the memory handle of a parameter sent by reference. */
+
+	const MemMgrLite::MemHandle& peekHandle() const {
+		return peekHandleBody().m_mh;
+	}
+
+  /* Borrowed view of a parameter sent by reference.
+   * It is valid until the packet is discarded by pop().
+   */
+
+	template<typename T>
+	const T& peekParamByHandle() const {
+		const MemMgrLite::MemHandle& mh = peekHandle();
+		D_ASSERT2(sizeof(T) <= mh.getSize(), AssertParamLog(AssertIdSizeError, sizeof(T), mh.getSize()));
+		return *static_cast<const T*>(mh.getVa());
+	}
+
+  /* Take out an object sent by MsgLib::sendByHandle() with a pool id.
+   * The object in the segment is destructed and the memory handle
+   * held by the packet is released.
+   */
+
+	template<typename T>
+	T moveParamByHandle() {
+		T* p = const_cast<T*>(&peekParamByHandle<T>());
+		T param = *p;
+		p->~T();
+		refHandleBody().m_destruct = NULL;
+		popHandle();
+		return param;
+	}
+
+  /* Take over the memory handle from the packet.
+   * An object copied into the segment is taken over with it,
+   * and the receiver is responsible to destruct it.
+   */
+
+	MemMgrLite::MemHandle moveHandle() {
+		MemMgrLite::MemHandle mh = peekHandle();
+		refHandleBody().m_destruct = NULL;
+		popHandle();
+		return mh;
+	}
+
+  /* Release the memory handle held by the packet.
+   * An object copied into the segment is destructed before it.
+   */
+
+	void popHandle() {
+		MsgHandleBody& body = refHandleBody();
+		if (body.m_destruct != NULL) {
+			/* The destructor is an address in the image of the sender. */
+			D_ASSERT(isSelfCpu());
+			body.m_destruct(body.m_mh.getVa());
+		}
+		body.~MsgHandleBody();
+		m_param_size = 0;
+	}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER */
+
 	void dump() const {
 		printf("T:%04x, R:%04x, C:%02x, F:%02x, S:%04x, P:",
 			m_type, m_reply, m_src_cpu, m_flags, m_param_size);
@@ -217,6 +338,31 @@ protected:
 		m_flags &= ~MsgFlagWaitParam; /* Clear the parameter write wait flag. */
 	}
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER
+  /* Store only the memory handle. (The reference count is incremented)
+   * The destructor of an object in the segment is stored with it.
+   */
+
+	void setParam(const MsgHandleParam& param, bool /* type_check */) {
+		D_ASSERT(param.getHandle().isAvail());
+		new (&m_param[0]) MsgHandleBody(param.getHandle(), param.getDestructor());
+		m_flags |= MsgFlagHandleParam;
+		m_param_size = sizeof(MsgHandleBody);
+		MEMORY_BARRIER();
+		m_flags &= ~MsgFlagWaitParam; /* Clear the parameter write wait flag. */
+	}
+
+	const MsgHandleBody& peekHandleBody() const {
+		D_ASSERT2(isHandleParam() && sizeof(MsgHandleBody) == getParamSize(),
+			AssertParamLog(AssertIdSizeError, sizeof(MsgHandleBody), getParamSize()));
+		return *reinterpret_cast<const MsgHandleBody*>(&m_param[0]);
+	}
+
+	MsgHandleBody& refHandleBody() {
+		return const_cast<MsgHandleBody&>(peekHandleBody());
+	}
+#endif
+
 	bool isTypeCheckEnable() const { return MSG_PARAM_TYPE_MATCH_CHECK && isTypedParam(); }
 
   /* Reference parameters with arbitrary types without error checking. */
@@ -81,6 +81,7 @@ public:
 
 	MsgPacket* frontMsg() { return &front<MsgPacket>(); }
 	MsgPacket* backMsg()  { return &back<MsgPacket>(); }
+	MsgPacket* atMsg(uint16_t n) { return &writable_at<MsgPacket>(n); }
 }; /* class MsgQue */
 
 #endif /* MSG_QUE_H_INCLUDED */
@@ -56,12 +56,16 @@
 #include "memutils/message/cache.h"
 #include "memutils/message/MsgQue.h"
 #include "memutils/message/MsgLog.h"
+#include "memutils/message/MsgStats.h"
 #ifdef USE_MULTI_CORE
 #include "SpinLockManager.h"	/* InterCpuLock::SpinLockId */
 #endif
 
 #include <semaphore.h>
 
+/* Default number of message packets received at once by recvBatch() */
+#define MSG_RECV_BATCH_NUM	4
+
 /*****************************************************************
  * Message queue block class
  *****************************************************************/
@@ -89,6 +93,35 @@ public:
 
   err_t pop();
 
+  /** Receive up to max message packets with one wakeup.
+   * Waits for the first packet like recv(), then takes the packets
+   * that are already ready in priority order under a single lock.
+   * The received packets must be discarded by popBatch().
+   * A high priority packet which arrives after this call is not part
+   * of the batch. Check hasNewHighMsg() between the packets to handle
+   * it before the rest of the batch.
+   * @param[in] ms timeout time(millisecond)
+   * @param[out] **packets array of received message packets.
+   * @param[in] max number of elements of packets.
+   * @param[out] *num number of received message packets.
+   * @return err_t error code
+   */
+  err_t recvBatch(uint32_t ms, FAR MsgPacket **packets, uint16_t max, FAR uint16_t *num);
+
+  /* Get whether a high priority packet which is not in the batch
+   * received by recvBatch() has arrived.
+   */
+
+  bool hasNewHighMsg(FAR MsgPacket * const *packets, uint16_t num);
+
+  /* Discard the first done packets of num packets received by
+   * recvBatch(). The other packets are left in the queue and are
+   * received again. A parameter which the receiver has not taken is
+   * discarded without calling its destructor.
+   */
+
+  err_t popBatch(FAR MsgPacket * const *packets, uint16_t num, uint16_t done);
+
   /* Get CPU-ID of queue owner (recipient). */
 
 	MsgCpuId getOwner() const { return m_owner; }
@@ -341,6 +374,16 @@ inline size_t MsgQueBlock::getSendSize<MsgRangedParam>(const MsgRangedParam& par
 }
 
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER
+/* Send message size(Memory handle parameter). */
+
+template<>
+inline size_t MsgQueBlock::getSendSize<MsgHandleParam>(const MsgHandleParam& /* param */, bool /* type_check */)
+{
+	return sizeof(MsgPacketHeader) + sizeof(MsgHandleBody);
+}
+#endif
+
 /*****************************************************************
  * Class for acquiring message packet information
  *****************************************************************/
@@ -362,6 +405,14 @@ struct MsgPacketInfo<MsgRangedParam> {
 	static const bool null_param = false;
 };
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER
+template<>
+struct MsgPacketInfo<MsgHandleParam> {
+	static const bool typed_param = false;
+	static const bool null_param = false;
+};
+#endif
+
 /*****************************************************************
  * Message sending process from task context
  *****************************************************************/
@@ -504,6 +555,7 @@ inline MsgPacket* MsgQueBlock::pushHeader(MsgPri pri, const MsgPacketHeader& hea
 
 	MsgPacket* msg = m_que[pri].pushHeader(header);
 	if (msg) {
+		MSG_STATS_PUSH(m_id, pri, m_que[pri].size(), msg);
 		if (m_que[pri].size() > m_tally.max_queuing[pri]) {
 			m_tally.max_queuing[pri] = m_que[pri].size();
       /* Leave peak value, message type etc in the log. */
@@ -637,6 +689,7 @@ retry:  /* Wait to receive. */
     }
 
   DUMP_MSG_SEQ_LOCK(MsgSeqLog('r', m_id, pri, m_que[pri].size(), msg));
+  MSG_STATS_RECV(m_id, pri, msg);
 
   *packet = msg;
 
@@ -661,6 +714,17 @@ inline err_t MsgQueBlock::pop()
 
   MsgPacket* msg = m_cur_que->frontMsg();
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER
+  /* The memory handle of a parameter sent by reference is released
+   * here, unless the receiver has taken it over.
+   */
+
+  if (msg->isHandleParam() && msg->getParamSize() != 0)
+    {
+      msg->popHandle();
+    }
+#endif
+
   if (msg->getParamSize() != 0)
     {
       return ERR_MEM_BUSY;
@@ -698,6 +762,190 @@ inline err_t MsgQueBlock::pop()
   return ERR_OK;
 }
 
+/*****************************************************************
+ * Receive message packets in a batch
+ *****************************************************************/
+inline err_t MsgQueBlock::recvBatch(uint32_t ms, FAR MsgPacket **packets, uint16_t max, FAR uint16_t *num)
+{
+  D_ASSERT2(max != 0, AssertParamLog(AssertIdBadParam, max));
+
+  /* The first packet is received in the same way as recv(). */
+
+  err_t err = recv(ms, &packets[0]);
+  if (err != ERR_OK)
+    {
+      return err;
+    }
+
+  /* Take the following packets in the order that recv() would return
+   * them. When the first packet is a normal priority one, the batch
+   * ends at the arrival of a high priority packet.
+   * A packet waiting for parameter writing ends the batch too.
+   */
+
+  uint16_t cnt = 1;
+  MsgPri   pri = (m_cur_que == &m_que[MsgPriHigh]) ? MsgPriHigh : MsgPriNormal;
+  uint16_t idx = 1;
+  uint16_t num_high = (pri == MsgPriHigh) ? 1 : 0;
+
+  lock();
+
+  while (cnt < max)
+    {
+      if (idx >= m_que[pri].size())
+        {
+          if (pri == MsgPriNormal)
+            {
+              break;
+            }
+          pri = MsgPriNormal;
+          idx = 0;
+          continue;
+        }
+
+      if (pri == MsgPriNormal && m_que[MsgPriHigh].size() != 0 && m_cur_que != &m_que[MsgPriHigh])
+        {
+          break;
+        }
+
+      MsgPacket* msg = m_que[pri].atMsg(idx);
+      if (msg->getFlags() & MsgPacket::MsgFlagWaitParam)
+        {
+          break;
+        }
+
+      packets[cnt++] = msg;
+      num_high = (pri == MsgPriHigh) ? cnt : num_high;
+      ++idx;
+    }
+
+  unlock();
+
+  /* Consume the semaphore count of each added packet.
+   * A packet whose sender has not signaled yet is left in the queue
+   * together with the packets after it.
+   */
+
+  uint16_t taken = 1;
+  while (taken < cnt)
+    {
+      if (!Chateau_PollingWaitSemaphore(m_count_sem))
+        {
+          break;
+        }
+      DUMP_MSG_SEQ_LOCK(MsgSeqLog('r', m_id, (taken < num_high) ? MsgPriHigh : MsgPriNormal, 0, packets[taken]));
+      MSG_STATS_RECV(m_id, (taken < num_high) ? MsgPriHigh : MsgPriNormal, packets[taken]);
+      ++taken;
+    }
+
+  *num = taken;
+
+  return ERR_OK;
+}
+
+/*****************************************************************
+ * Check arrival of high priority packet during a batch
+ *****************************************************************/
+inline bool MsgQueBlock::hasNewHighMsg(FAR MsgPacket * const *packets, uint16_t num)
+{
+  /* The high priority packets of the batch are at the head of it
+   * and at the front of the high priority queue.
+   */
+
+  lock();
+
+  uint16_t size = m_que[MsgPriHigh].size();
+  uint16_t high = 0;
+
+  while (high < num && high < size && m_que[MsgPriHigh].atMsg(high) == packets[high])
+    {
+      ++high;
+    }
+
+  unlock();
+
+  return size > high;
+}
+
+/*****************************************************************
+ * Discard message packets received in a batch
+ *****************************************************************/
+inline err_t MsgQueBlock::popBatch(FAR MsgPacket * const *packets, uint16_t num, uint16_t done)
+{
+  /* Check if own CPU is owned, and check Packet Received */
+
+  if (!(isOwn() && m_cur_que != NULL && done != 0 && done <= num))
+    {
+      return ERR_STS;
+    }
+
+  /* Release the parameters which the receiver has not taken.
+   * Unlike pop(), the batch can not be left half discarded, so the
+   * parameter of other than a memory handle is dropped.
+   */
+
+  for (uint16_t i = 0; i < done; i++)
+    {
+      MsgPacket* msg = packets[i];
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER
+      if (msg->isHandleParam() && msg->getParamSize() != 0)
+        {
+          msg->popHandle();
+        }
+#endif
+
+      if (msg->getParamSize() != 0)
+        {
+          msg->popParamNoDestruct();
+        }
+    }
+
+  lock();
+
+  /* The packets are the fronts of the queues in received order. */
+
+  for (uint16_t i = 0; i < done; i++)
+    {
+      MsgPacket* msg = packets[i];
+      MsgQue*    que = (m_que[MsgPriHigh].size() != 0 && m_que[MsgPriHigh].frontMsg() == msg) ?
+                         &m_que[MsgPriHigh] : &m_que[MsgPriNormal];
+
+      if (que->frontMsg() != msg || que->pop() == false)
+        {
+          m_cur_que = NULL;
+          unlock();
+          return ERR_QUE_FREE;
+        }
+
+      /* Same as pop(), clear the cache of the discarded packet area. */
+
+#if MSG_FILL_VALUE_AFTER_POP == 0x00
+      if (isShare())
+        {
+          Dcache_clear(msg, que->elem_size());
+        }
+#else
+      if (isShare())
+        {
+          Dcache_flush_clear(msg, que->elem_size());
+        }
+#endif
+    }
+
+  m_cur_que = NULL; /* Make the packet unreceived state. */
+  unlock();
+
+  /* Recover the semaphore count of the packets left in the queue. */
+
+  for (uint16_t i = done; i < num; i++)
+    {
+      Chateau_SignalSemaphoreTask(m_count_sem);
+    }
+
+  return ERR_OK;
+}
+
 /*****************************************************************
  * Lock queue
  *****************************************************************/
@@ -0,0 +1,153 @@
+/****************************************************************************
+ * modules/include/memutils/message/MsgStats.h
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef MSG_STATS_H_INCLUDED
+#define MSG_STATS_H_INCLUDED
+
+#include <sdk/config.h>
+#include "memutils/message/MsgPacket.h"	/* NumMsgPri */
+
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+#include <string.h>		/* memset */
+#include <arch/chip/perf.h>	/* up_perf_gettime */
+
+/* Number of latency histogram bins.
+ * Bin n counts the packets received within [2^(n-1), 2^n) microseconds
+ * after pushed, and the last bin counts all the slower packets.
+ * Only packets pushed on the receiving CPU are counted, because
+ * the cycle counter of each CPU is not synchronized.
+ */
+
+#define MSG_STATS_LATENCY_BINS	16
+
+/*****************************************************************
+ * Statistics of a message queue
+ *
+ * The table is a static variable of each CPU and is not shared.
+ * high_water is recorded on the CPU which pushes the message, and
+ * the other members are recorded on the CPU which receives it.
+ * So for a queue owned by another CPU, a CPU sees only the
+ * high-water mark of its own pushes, and the owner CPU sees the
+ * received counts and the latency but not the remote pushes.
+ *****************************************************************/
+struct MsgQueStats {
+	struct TypeCount {
+		uint16_t	type;		/* message type */
+		uint16_t	resv;		/* reserved */
+		uint32_t	count;		/* received count */
+	};
+
+	uint32_t	recv_count[NumMsgPri];		/* received count */
+	uint32_t	max_latency[NumMsgPri];		/* max latency (usec) */
+	uint32_t	latency[NumMsgPri][MSG_STATS_LATENCY_BINS];	/* latency histogram */
+	uint16_t	high_water[NumMsgPri];		/* max stored count */
+	uint16_t	num_types;			/* used entries of types */
+	uint16_t	resv;				/* reserved */
+	TypeCount	types[CONFIG_MEMUTILS_MESSAGE_STATS_NUM_TYPES];	/* per message type */
+	uint32_t	other_types;			/* count of types over the table */
+public:
+  /* Time stamp of push. A single read of the free-running cycle
+   * counter, so that it is cheap enough for pushes from ISRs.
+   */
+
+	static uint32_t getStamp() { return up_perf_gettime(); }
+
+  /* Start the cycle counter of the calling CPU. */
+
+	static void init();
+
+  /* Statistics of the queue id. NULL when id is out of the table. */
+
+	static MsgQueStats* get(uint16_t id);
+
+	void clear() { memset(this, 0x00, sizeof(*this)); }
+
+	void recordPush(uint8_t pri, uint16_t stored) {
+		high_water[pri] = MAX(high_water[pri], stored);
+	}
+
+	void recordRecv(uint8_t pri, uint16_t type, uint32_t stamp, bool same_cpu) {
+		++recv_count[pri];
+		if (same_cpu) {
+			uint32_t lat = (getStamp() - stamp) / s_cycles_per_us;
+			uint32_t bin = 0;
+			while (bin < MSG_STATS_LATENCY_BINS - 1 && (lat >> bin) != 0) {
+				++bin;
+			}
+			++latency[pri][bin];
+			max_latency[pri] = MAX(max_latency[pri], lat);
+		}
+
+		for (uint16_t i = 0; i < num_types; ++i) {
+			if (types[i].type == type) {
+				++types[i].count;
+				return;
+			}
+		}
+		if (num_types < CONFIG_MEMUTILS_MESSAGE_STATS_NUM_TYPES) {
+			types[num_types].type  = type;
+			types[num_types].count = 1;
+			++num_types;
+		} else {
+			++other_types;
+		}
+	}
+
+	void dump(uint16_t id) const;
+
+private:
+	static uint32_t	s_cycles_per_us;	/* cycle counter frequency (MHz) */
+}; /* struct MsgQueStats */
+
+/* Record at pushHeader() and recv(). */
+
+#define MSG_STATS_PUSH(id, pri, stored, msg)					\
+	do {									\
+		MsgQueStats* _stats_ = MsgQueStats::get(id);			\
+		(msg)->setStamp(MsgQueStats::getStamp());			\
+		if (_stats_) { _stats_->recordPush(pri, stored); }		\
+	} while (0)
+#define MSG_STATS_RECV(id, pri, msg)						\
+	do {									\
+		MsgQueStats* _stats_ = MsgQueStats::get(id);			\
+		if (_stats_) { _stats_->recordRecv(pri, (msg)->getType(), (msg)->getStamp(), \
+					(msg)->getSrcCpu() == GET_CPU_ID()); }		\
+	} while (0)
+#else
+#define MSG_STATS_PUSH(id, pri, stored, msg)
+#define MSG_STATS_RECV(id, pri, msg)
+#endif /* CONFIG_MEMUTILS_MESSAGE_STATS */
+
+#endif /* MSG_STATS_H_INCLUDED */
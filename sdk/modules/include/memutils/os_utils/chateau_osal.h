@@ -98,6 +98,9 @@ static INLINE Chateau_task_pri_t Chateau_GetTaskPriority() {
 #define Chateau_DelayTask(ms)		dly_tsk(ms)
 #define Chateau_YieldTask()             F_ASSERT(rot_rdq(TPRI_SELF) == E_OK)
 #define Chateau_IsTaskContext()		(!sns_ctx())
+#define Chateau_IsInterruptContext()	(sns_ctx())
+#define Chateau_LockDispatch()		dis_dsp()
+#define Chateau_UnlockDispatch()	ena_dsp()
 
 #define Chateau_GetSystemTime(n) do{ SYSTIM s = 0; get_tim(&s); (n) = (unsigned)s; }while(0)
 #define Chateau_GetInterruptMask()		sns_loc()
@@ -178,6 +181,9 @@ static INLINE Chateau_task_pri_t Chateau_GetTaskPriority() {
 #define Chateau_DelayTask(ms)   SYS_DelayTask(ms)
 #define Chateau_YieldTask()     F_ASSERT(SYS_YieldTask() == 0)
 #define Chateau_IsTaskContext()	(SYS_IsInTaskContext())
+#define Chateau_IsInterruptContext()	(!SYS_IsInTaskContext())
+#define Chateau_LockDispatch()		SYS_DisableDispatch()
+#define Chateau_UnlockDispatch()	SYS_EnableDispatch()
 
 #define Chateau_GetSystemTime(n) do{ SYS_Time s = 0; SYS_GetTime(&s); (n) = (unsigned)s; }while(0)
 #define Chateau_GetInterruptMask()		SYS_GetInterruptMask()
@@ -236,6 +242,9 @@ static INLINE size_t Chateau_CountSemaphore(Chateau_sem_handle_t h) {
 
 #define Chateau_GetInterruptMask() (0)
 #define Chateau_IsTaskContext() (getpid() != 0)
+#define Chateau_IsInterruptContext() up_interrupt_context()
+#define Chateau_LockDispatch() sched_lock()
+#define Chateau_UnlockDispatch() sched_unlock()
 
 #define Chateau_LockInterrupt(pContext)					\
     do {                                                                \
@@ -274,6 +283,7 @@ typedef sem_t	Chateau_sem_handle_t;
 #define Chateau_SignalSemaphoreIsr(h)   F_ASSERT(sem_post(&h)		== 0)
 #define Chateau_TimedWaitSemaphore(h, tm)        (sem_timedwait(&h, &tm)	== 0)
 #define Chateau_WaitSemaphore(h)        (sem_wait(&h)	== 0)
+#define Chateau_PollingWaitSemaphore(h) (sem_trywait(&h)	== 0)
 //static INLINE bool Chateau_TimedWaitSemaphore(Chateau_sem_handle_t h,uint32_t ms) {
 //	if(ms != TIME_FOREVER){
 //		timespec t;
@@ -293,6 +303,9 @@ typedef short	Chateau_sem_handle_t;
 #define Chateau_LockInterruptIsr(pContext)	loc_cpu()
 #define Chateau_UnlockInterruptIsr(pContext)	unl_cpu()
 #define Chateau_IsTaskContext()			1
+#define Chateau_IsInterruptContext()		0
+#define Chateau_LockDispatch()
+#define Chateau_UnlockDispatch()
 #define Chateau_GetInterruptMask()		sns_loc()
 #define Chateau_LockInterrupt(h)		loc_cpu()
 #define Chateau_UnlockInterrupt(h)		unl_cpu()
@@ -49,6 +49,8 @@
    -------------------------------------------------------------------------- */
 
 #include <sys/time.h>
+#include "sensing/sensor_api.h"
+#include "sensing/logical_sensor/physical_command.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -93,12 +95,24 @@ extern "C" {
  */
 #define SEC_PER_US                    1000000
 
- /**
+/**
  * @def NS_PER_US
  * @brief nanosecond -> microsecond
  */
 #define NS_PER_US                     1000
 
+/**
+ * @def MS_PER_US
+ * @brief millisecond -> microsecond
+ */
+#define MS_PER_US                     1000
+
+/**
+ * @def TAP_BLOCK_TIME_MASK
+ * @brief Valid bits of time stamp of sensor_command_data_mh_t (ms)
+ */
+#define TAP_BLOCK_TIME_MASK           0xffffff
+
 /** @} tap_lib_defs */
 
 /* --------------------------------------------------------------------------
@@ -172,6 +186,8 @@ public:
   int close(void);
   int write(ST_TAP_ACCEL*);
   int write(ST_TAP_ACCEL*, uint64_t);
+  int write(FAR const ThreeAxisSample*, int, uint64_t, int, FAR int*, int);
+  int write(FAR sensor_command_data_mh_t*, FAR int*, int);
 
   TapClass();
   ~TapClass(){};
@@ -194,7 +210,7 @@ private:
   int          mTapCnt;          /**< Detect tap Count. */
   E_TAP_STATE  mState;           /**< Holds IDLE or TAP state */
 
-  float        mR[TAP_BUF_LEN];  /**< Set sqrt value */
+  float        mR[TAP_BUF_LEN];  /**< Set squared magnitude */
   float        mX[TAP_BUF_LEN];  /**< Accel Data(x)  */
   float        mY[TAP_BUF_LEN];  /**< Accel Data(y)  */
   float        mZ[TAP_BUF_LEN];  /**< Accel Data(z)  */
@@ -207,9 +223,18 @@ private:
 
   uint64_t     mStartTime;        /**< Time to use for continuous tap detection. */
 
+  float        mPeakThres2;      /**< Square of mPeakThres */
+  float        mLongThres2;      /**< Square of mLongThres */
+
+  bool         mBlockStarted;    /**< Block time stamp is valid */
+  uint32_t     mBlockRawTime;    /**< (msec) Last 24bit block time stamp */
+  uint64_t     mBlockTime;       /**< (msec) Extended block time stamp */
+
   /* private methods */
-  float calcR(int i0, int j0);
+  float calcR2(int i0, int j0);
   bool detect(float x, float y, float z);
+  bool detect2(float x, float y, float z, float r2);
+  int update(bool detectflg, uint64_t endTime);
   float getIndex(int idx);
 
 };
@@ -258,6 +283,24 @@ int TapWrite(FAR TapClass *ins, FAR ST_TAP_ACCEL *accelData);
 int TapWrite_timestamp(FAR TapClass *ins, FAR ST_TAP_ACCEL *accelData, 
                        uint64_t time_stamp);
 
+/**
+ * @brief      Detect tap from a block of accel samples.
+ *             Time stamp of each sample is derived from the time stamp
+ *             of the block (time of the first sample, in msec) and
+ *             the sampling rate.
+ * @param[in]  ins : instance address of TapClass
+ * @param[in]  command : Accel samples (ThreeAxisSample) with time stamp,
+ *                       sampling rate and number of samples
+ * @param[out] tapcnts : tapcnt of each tap series which ends in the block,
+ *                       in order of time
+ * @param[in]  max_num : length of tapcnts. At most one series ends
+ *                       at each sample, so the number of samples
+ *                       is enough not to lose any of them.
+ * @return     number of tap series stored in tapcnts or error code.
+ */
+int TapWrite_block(FAR TapClass *ins, FAR sensor_command_data_mh_t *command,
+                   FAR int *tapcnts, int max_num);
+
 /** @} tap_lib_funcs */
 /** @} tap_lib */
 
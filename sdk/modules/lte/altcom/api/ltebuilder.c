@@ -152,6 +152,11 @@ static struct buffpool_blockset_s g_blk_settings[] =
   {
     APICMDGW_RECVBUFF_SIZE_MAX, 1
   },
+#ifdef CONFIG_LTE_APICMDGW_COALESCE
+  {
+    CONFIG_LTE_APICMDGW_FRAME_SIZE, 1
+  },
+#endif
   {
     APICMD_TRANSACTION_SIZE_MAX, 1
   }
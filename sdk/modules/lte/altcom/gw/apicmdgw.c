@@ -78,6 +78,21 @@
 
 #define APICMDGW_GET_RESCMDID(cmdid) (cmdid | 0x01 << 15)
 
+/* Number of hash buckets of the wait table. Must be power of 2. */
+
+#define APICMDGW_WAITTBL_HASH_NUM    (16)
+#define APICMDGW_WAITTBL_HASH(transid) \
+  ((transid) & (APICMDGW_WAITTBL_HASH_NUM - 1))
+
+#ifdef CONFIG_LTE_APICMDGW_COALESCE
+#  define APICMDGW_FRAME_SIZE_MAX    (CONFIG_LTE_APICMDGW_FRAME_SIZE)
+#  if defined(CONFIG_MODEM_ALTMDM_MAX_PACKET_SIZE)
+#    if (CONFIG_LTE_APICMDGW_FRAME_SIZE > CONFIG_MODEM_ALTMDM_MAX_PACKET_SIZE)
+#      error LTE_APICMDGW_FRAME_SIZE must not exceed MODEM_ALTMDM_MAX_PACKET_SIZE
+#    endif
+#  endif
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -95,12 +110,23 @@ struct apicmdgw_blockinf_s
   FAR struct apicmdgw_blockinf_s  *next;
 };
 
+/* Send request queued until a sending task writes it to the HAL. */
+
+struct apicmdgw_sendreq_s
+{
+  FAR const uint8_t               *data;
+  uint32_t                        len;
+  int32_t                         result;
+  bool                            done;
+  FAR struct apicmdgw_sendreq_s   *next;
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 static bool                           g_isinit        = false;
-static FAR struct apicmdgw_blockinf_s *g_blkinfotbl   = NULL;
+static FAR struct apicmdgw_blockinf_s *g_blkinfotbl[APICMDGW_WAITTBL_HASH_NUM];
 static sys_mutex_t                    g_blkinfotbl_mtx;
 static sys_task_t                     g_rcvtask;
 static uint8_t                        g_seqid_counter = 0;
@@ -109,6 +135,14 @@ static sys_mutex_t                    g_delwaitcondmtx;
 static FAR struct hal_if_s            *g_hal_if       = NULL;
 static FAR struct evtdisp_s           *g_evtdisp      = NULL;
 static sys_cremtx_s                   g_mtxparam;
+static FAR struct apicmdgw_sendreq_s  *g_sendqhead    = NULL;
+static FAR struct apicmdgw_sendreq_s  *g_sendqtail    = NULL;
+static bool                           g_sendqbusy     = false;
+static sys_thread_cond_t              g_sendqcond;
+static sys_mutex_t                    g_sendqmtx;
+#ifdef CONFIG_LTE_APICMDGW_COALESCE
+static FAR uint8_t                    *g_framebuff    = NULL;
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -300,19 +334,51 @@ void apicmdgw_errhandle(FAR struct apicmd_cmdhdr_s *evthdr)
 
 static void apicmdgw_addtable(FAR struct apicmdgw_blockinf_s *tbl)
 {
+  FAR struct apicmdgw_blockinf_s **bucket;
+
   sys_lock_mutex(&g_blkinfotbl_mtx);
 
-  if (!g_blkinfotbl)
-    {
-      g_blkinfotbl = tbl;
-    }
-  else
+  bucket       = &g_blkinfotbl[APICMDGW_WAITTBL_HASH(tbl->transid)];
+  tbl->next    = *bucket;
+  *bucket      = tbl;
+
+  sys_unlock_mutex(&g_blkinfotbl_mtx);
+}
+
+/****************************************************************************
+ * Name: apicmdgw_unlinktable
+ *
+ * Description:
+ *   Unlink wait table from waittablelist.
+ *   The caller must hold g_blkinfotbl_mtx.
+ *
+ * Input Parameters:
+ *   tbl    waittable.
+ *
+ * Returned Value:
+ *   If @tbl is found and unlinked, return true.
+ *   Otherwise false is returned.
+ *
+ ****************************************************************************/
+
+static bool apicmdgw_unlinktable(FAR struct apicmdgw_blockinf_s *tbl)
+{
+  FAR struct apicmdgw_blockinf_s **target;
+
+  target = &g_blkinfotbl[APICMDGW_WAITTBL_HASH(tbl->transid)];
+  while (*target)
     {
-      tbl->next    = g_blkinfotbl;
-      g_blkinfotbl = tbl;
+      if (*target == tbl)
+        {
+          *target = tbl->next;
+          tbl->next = NULL;
+          return true;
+        }
+
+      target = &(*target)->next;
     }
 
-  sys_unlock_mutex(&g_blkinfotbl_mtx);
+  return false;
 }
 
 /****************************************************************************
@@ -331,35 +397,14 @@ static void apicmdgw_addtable(FAR struct apicmdgw_blockinf_s *tbl)
 
 static void apicmdgw_remtable(FAR struct apicmdgw_blockinf_s *tbl)
 {
-  FAR struct apicmdgw_blockinf_s *tmptbl;
-
-  DBGIF_ASSERT(g_blkinfotbl, "table list is null.\n");
+  bool found;
 
   sys_lock_mutex(&g_blkinfotbl_mtx);
 
-  tmptbl = g_blkinfotbl;
-  if (tmptbl == tbl)
-    {
-      g_blkinfotbl = g_blkinfotbl->next;
-    }
-  else
-    {
-      while(tmptbl->next)
-        {
-          if (tmptbl->next == tbl)
-            {
-              tmptbl->next = tmptbl->next->next;
-              tmptbl = tbl;
-              break;
-            }
-
-          tmptbl = tmptbl->next;
-        }
-    }
-
-  DBGIF_ASSERT(tmptbl == tbl, "Can not find a table from the table list.");
-  sys_delete_thread_cond_mutex(&tmptbl->waitcond, &tmptbl->waitcondmtx);
-  BUFFPOOL_FREE(tmptbl);
+  found = apicmdgw_unlinktable(tbl);
+  DBGIF_ASSERT(found, "Can not find a table from the table list.");
+  sys_delete_thread_cond_mutex(&tbl->waitcond, &tbl->waitcondmtx);
+  BUFFPOOL_FREE(tbl);
 
   sys_unlock_mutex(&g_blkinfotbl_mtx);
 }
@@ -386,17 +431,15 @@ static bool apicmdgw_writetable(uint16_t cmdid,
   uint16_t transid, FAR uint8_t *data, uint16_t datalen)
 {
   int32_t                        ret;
-  bool                           result = false;
-  FAR struct apicmdgw_blockinf_s *tbl   = NULL;
+  FAR struct apicmdgw_blockinf_s *tbl = NULL;
 
   sys_lock_mutex(&g_blkinfotbl_mtx);
 
-  tbl = g_blkinfotbl;
+  tbl = g_blkinfotbl[APICMDGW_WAITTBL_HASH(transid)];
   while(tbl)
     {
       if (tbl->transid == transid && tbl->cmdid == cmdid)
         {
-          result = true;
           break;
         }
 
@@ -423,7 +466,7 @@ static bool apicmdgw_writetable(uint16_t cmdid,
 
   sys_unlock_mutex(&g_blkinfotbl_mtx);
 
-  return result;
+  return tbl != NULL;
 }
 
 /****************************************************************************
@@ -433,32 +476,177 @@ static bool apicmdgw_writetable(uint16_t cmdid,
  *   Release all waiting tasks.
  *
  * Input Parameters:
- *   None.
+ *   result    Result to set to all wait tables.
  *
  * Returned Value:
  *   None.
  *
  ****************************************************************************/
 
-static void apicmdgw_relcondwaitall(void)
+static void apicmdgw_relcondwaitall(int32_t result)
 {
-  int32_t ret;
+  int32_t                        ret;
+  uint8_t                        i;
   FAR struct apicmdgw_blockinf_s *tmptbl;
 
   sys_lock_mutex(&g_blkinfotbl_mtx);
 
-  tmptbl = g_blkinfotbl;
-  while(tmptbl)
+  for (i = 0; i < APICMDGW_WAITTBL_HASH_NUM; i++)
     {
-      ret = sys_signal_thread_cond(&tmptbl->waitcond, &tmptbl->waitcondmtx);
-      DBGIF_ASSERT(0 == ret, "sys_signal_thread_cond().\n");
-
-      tmptbl = tmptbl->next;
+      for (tmptbl = g_blkinfotbl[i]; tmptbl; tmptbl = tmptbl->next)
+        {
+          tmptbl->result = result;
+          ret = sys_signal_thread_cond(&tmptbl->waitcond,
+                                       &tmptbl->waitcondmtx);
+          DBGIF_ASSERT(0 == ret, "sys_signal_thread_cond().\n");
+        }
     }
 
   sys_unlock_mutex(&g_blkinfotbl_mtx);
 }
 
+/****************************************************************************
+ * Name: apicmdgw_flushsendq
+ *
+ * Description:
+ *   Write queued send requests to the HAL. When coalescing is enabled,
+ *   consecutive requests are packed into one transfer as far as they fit
+ *   in the frame buffer.
+ *
+ * Input Parameters:
+ *   req    Head of send requests to write.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+static void apicmdgw_flushsendq(FAR struct apicmdgw_sendreq_s *req)
+{
+  int32_t                       ret;
+#ifdef CONFIG_LTE_APICMDGW_COALESCE
+  FAR struct apicmdgw_sendreq_s *first;
+  uint32_t                      framelen;
+#endif
+
+  g_hal_if->lock(g_hal_if);
+
+  while (req)
+    {
+#ifdef CONFIG_LTE_APICMDGW_COALESCE
+      if (req->next &&
+          req->len + req->next->len <= APICMDGW_FRAME_SIZE_MAX)
+        {
+          first    = req;
+          framelen = 0;
+          while (req && framelen + req->len <= APICMDGW_FRAME_SIZE_MAX)
+            {
+              memcpy(g_framebuff + framelen, req->data, req->len);
+              framelen += req->len;
+              req = req->next;
+            }
+
+          ret = g_hal_if->send(g_hal_if, g_framebuff, framelen);
+          if (0 > ret)
+            {
+              DBGIF_LOG1_ERROR("hal_if->send() failed:%d\n", ret);
+            }
+
+          for (; first != req; first = first->next)
+            {
+              first->result = (0 > ret) ? ret : (int32_t)first->len;
+            }
+
+          continue;
+        }
+#endif
+
+      ret = g_hal_if->send(g_hal_if, req->data, req->len);
+      if (0 > ret)
+        {
+          DBGIF_LOG1_ERROR("hal_if->send() failed:%d\n", ret);
+        }
+
+      req->result = ret;
+      req = req->next;
+    }
+
+  g_hal_if->unlock(g_hal_if);
+}
+
+/****************************************************************************
+ * Name: apicmdgw_sendframe
+ *
+ * Description:
+ *   Send api command through the send queue.
+ *   The first task finding the queue idle writes all queued requests,
+ *   including those of other tasks, and the others wait for it.
+ *
+ * Input Parameters:
+ *   data    Api command to send including header.
+ *   len     Length of @data.
+ *
+ * Returned Value:
+ *   On success, the length of the sent data in bytes is returned.
+ *   On failure, negative value is returned.
+ *
+ ****************************************************************************/
+
+static int32_t apicmdgw_sendframe(FAR const uint8_t *data, uint32_t len)
+{
+  struct apicmdgw_sendreq_s     req;
+  FAR struct apicmdgw_sendreq_s *list;
+
+  req.data   = data;
+  req.len    = len;
+  req.result = -ECONNABORTED;
+  req.done   = false;
+  req.next   = NULL;
+
+  sys_lock_mutex(&g_sendqmtx);
+
+  if (g_sendqtail)
+    {
+      g_sendqtail->next = &req;
+    }
+  else
+    {
+      g_sendqhead = &req;
+    }
+
+  g_sendqtail = &req;
+
+  while (!req.done)
+    {
+      if (g_sendqbusy)
+        {
+          sys_thread_cond_wait(&g_sendqcond, &g_sendqmtx);
+          continue;
+        }
+
+      g_sendqbusy = true;
+      list        = g_sendqhead;
+      g_sendqhead = NULL;
+      g_sendqtail = NULL;
+
+      sys_unlock_mutex(&g_sendqmtx);
+      apicmdgw_flushsendq(list);
+      sys_lock_mutex(&g_sendqmtx);
+
+      for (; list; list = list->next)
+        {
+          list->done = true;
+        }
+
+      g_sendqbusy = false;
+      sys_thread_cond_broadcast(&g_sendqcond);
+    }
+
+  sys_unlock_mutex(&g_sendqmtx);
+
+  return req.result;
+}
+
 /****************************************************************************
  * Name: apicmdgw_recvtask
  *
@@ -708,6 +896,14 @@ int32_t apicmdgw_init(FAR struct apicmdgw_set_s *set)
   ret = sys_create_mutex(&g_blkinfotbl_mtx, &g_mtxparam);
   DBGIF_ASSERT(0 == ret, "sys_create_mutex().\n");
 
+  ret = sys_create_thread_cond_mutex(&g_sendqcond, &g_sendqmtx);
+  DBGIF_ASSERT(0 == ret, "sys_create_thread_cond_mutex().\n");
+
+#ifdef CONFIG_LTE_APICMDGW_COALESCE
+  g_framebuff = (FAR uint8_t *)BUFFPOOL_ALLOC_NOZERO(APICMDGW_FRAME_SIZE_MAX);
+  DBGIF_ASSERT(g_framebuff, "BUFFPOOL_ALLOC_NOZERO().\n");
+#endif
+
   ret = sys_create_task(&g_rcvtask, &taskset);
   DBGIF_ASSERT(0 == ret, "sys_create_task().\n");
 
@@ -754,11 +950,18 @@ int32_t apicmdgw_fin(void)
   sys_unlock_mutex(&g_delwaitcondmtx);
 
   sys_delete_thread_cond_mutex(&g_delwaitcond, &g_delwaitcondmtx);
-  apicmdgw_relcondwaitall();
+  apicmdgw_relcondwaitall(-ECONNABORTED);
 
   ret = sys_delete_mutex(&g_blkinfotbl_mtx);
   DBGIF_ASSERT(0 == ret, "sys_delete_mutex().\n");
 
+  sys_delete_thread_cond_mutex(&g_sendqcond, &g_sendqmtx);
+
+#ifdef CONFIG_LTE_APICMDGW_COALESCE
+  BUFFPOOL_FREE(g_framebuff);
+  g_framebuff = NULL;
+#endif
+
   g_hal_if       = NULL;
   g_evtdisp      = NULL;
 
@@ -842,10 +1045,7 @@ int32_t apicmdgw_send(FAR uint8_t *cmd, FAR uint8_t *respbuff,
 
       sys_lock_mutex(&blocktbl->waitcondmtx);
 
-      g_hal_if->lock(g_hal_if);
-      ret = g_hal_if->send(g_hal_if, (FAR uint8_t *)hdr_ptr, sendlen);
-      g_hal_if->unlock(g_hal_if);
-
+      ret = apicmdgw_sendframe((FAR uint8_t *)hdr_ptr, sendlen);
       if (0 > ret)
         {
           DBGIF_LOG_ERROR("hal_if->send() failed.\n");
@@ -881,10 +1081,7 @@ int32_t apicmdgw_send(FAR uint8_t *cmd, FAR uint8_t *respbuff,
     {
       /* Send only */
 
-      g_hal_if->lock(g_hal_if);
-      ret = g_hal_if->send(g_hal_if, (FAR uint8_t *)hdr_ptr, sendlen);
-      g_hal_if->unlock(g_hal_if);
-
+      ret = apicmdgw_sendframe((FAR uint8_t *)hdr_ptr, sendlen);
       if (0 > ret)
         {
           DBGIF_LOG_ERROR("hal_if->send() failed.\n");
@@ -917,22 +1114,9 @@ int32_t apicmdgw_send(FAR uint8_t *cmd, FAR uint8_t *respbuff,
 
 int32_t apicmdgw_sendabort(void)
 {
-  int32_t                        ret = 0;
-  FAR struct apicmdgw_blockinf_s *tbl = NULL;
-
-  sys_lock_mutex(&g_blkinfotbl_mtx);
-
-  tbl = g_blkinfotbl;
-  while (tbl)
-    {
-      tbl->result = -ENETDOWN;
-      tbl = tbl->next;
-    }
+  apicmdgw_relcondwaitall(-ENETDOWN);
 
-  sys_unlock_mutex(&g_blkinfotbl_mtx);
-  apicmdgw_relcondwaitall();
-
-  return ret;
+  return 0;
 }
 
 /****************************************************************************
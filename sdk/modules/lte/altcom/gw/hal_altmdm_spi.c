@@ -461,7 +461,7 @@ FAR struct hal_if_s *hal_altmdm_spi_create(void)
     }
   
   obj->buff =
-    (FAR uint8_t *)BUFFPOOL_ALLOC(HAL_ALTMDM_SPI_BUFFER_SIZE_MAX);
+    (FAR uint8_t *)BUFFPOOL_ALLOC_NOZERO(HAL_ALTMDM_SPI_BUFFER_SIZE_MAX);
   if (!obj->buff)
     {
       DBGIF_LOG_ERROR("Failed to allocate memory\n");
@@ -48,6 +48,8 @@
 
 #define BUFFPOOL_ALLOC(reqsize) \
   (buffpool_alloc(g_buffpoolwrapper_obj, reqsize))
+#define BUFFPOOL_ALLOC_NOZERO(reqsize) \
+  (buffpool_alloc_nozero(g_buffpoolwrapper_obj, reqsize))
 #define BUFFPOOL_FREE(buff) (buffpool_free(g_buffpoolwrapper_obj, buff))
 
 /****************************************************************************
@@ -701,6 +701,24 @@ int32_t sys_thread_cond_timedwait(FAR sys_thread_cond_t *cond,
 
 int32_t sys_thread_cond_signal(FAR sys_thread_cond_t *cond);
 
+/****************************************************************************
+ * Name: sys_thread_cond_broadcast
+ *
+ * Description:
+ *   The sys_thread_cond_broadcast() function shall unblock all threads
+ *   currently blocked on the specified condition variable cond.
+ *
+ * Input Parameters:
+ *   cond        Condition variable.
+ *
+ * Returned Value:
+ *   If successful, shall return zero.
+ *   Otherwise negative value is returned.
+ *
+ ****************************************************************************/
+
+int32_t sys_thread_cond_broadcast(FAR sys_thread_cond_t *cond);
+
 
 /****************************************************************************
  * Inline Functions
@@ -53,6 +53,17 @@ struct buffpool_blockset_s
   uint16_t num;
 };
 
+/* Usage statistics of one size class. */
+
+struct buffpool_stat_s
+{
+  uint32_t size;       /* Buffer size of this class */
+  uint16_t num;        /* Number of buffers */
+  uint16_t used;       /* Number of buffers in use */
+  uint16_t highwater;  /* Maximum number of buffers used at once */
+  uint32_t spillcnt;   /* Allocations served here as smaller class was full */
+};
+
 typedef FAR void *buffpool_t;
 
 /****************************************************************************
@@ -100,6 +111,7 @@ int32_t buffpool_delete(buffpool_t thiz);
  *
  * Description:
  *   Allocate buffer from bufferpool.
+ *   The first @reqsize bytes of the buffer are filled by 0.
  *   This function is blocking.
  *
  * Input Parameters:
@@ -114,6 +126,26 @@ int32_t buffpool_delete(buffpool_t thiz);
 
 FAR void *buffpool_alloc(buffpool_t thiz, uint32_t reqsize);
 
+/****************************************************************************
+ * Name: buffpool_alloc_nozero
+ *
+ * Description:
+ *   Allocate buffer from bufferpool without clearing its contents.
+ *   Use this when the caller overwrites the whole buffer.
+ *   This function is blocking.
+ *
+ * Input Parameters:
+ *   thiz     Object of bufferpool.
+ *   reqsize  Buffer size.
+ *
+ * Returned Value:
+ *   Buffer address.
+ *   If can't get available buffer, returned NULL.
+ *
+ ****************************************************************************/
+
+FAR void *buffpool_alloc_nozero(buffpool_t thiz, uint32_t reqsize);
+
 /****************************************************************************
  * Name: buffpool_free
  *
@@ -133,4 +165,28 @@ FAR void *buffpool_alloc(buffpool_t thiz, uint32_t reqsize);
 
 int32_t buffpool_free(buffpool_t thiz, FAR void *buff);
 
+/****************************************************************************
+ * Name: buffpool_getstat
+ *
+ * Description:
+ *   Get usage statistics of each size class for tuning the block sets
+ *   given to buffpool_create().
+ *
+ * Input Parameters:
+ *   thiz     Object of bufferpool.
+ *   stat     Array to store statistics in ascending order of size.
+ *   statnum  Number of elements of @stat.
+ *   waitcnt  Pointer to store the number of times an allocation had to
+ *            wait for free. May be NULL.
+ *
+ * Returned Value:
+ *   Number of size classes in the bufferpool.
+ *   Otherwise errno is returned.
+ *
+ ****************************************************************************/
+
+int32_t buffpool_getstat(buffpool_t thiz,
+  FAR struct buffpool_stat_s stat[], uint8_t statnum,
+  FAR uint32_t *waitcnt);
+
 #endif /* __MODULES_LTE_INCLUDE_UTIL_BUFFPOOL_H */
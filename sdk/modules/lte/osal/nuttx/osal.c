@@ -1282,3 +1282,33 @@ int32_t sys_thread_cond_signal(FAR sys_thread_cond_t *cond)
 
   return 0;
 }
+
+/****************************************************************************
+ * Name: sys_thread_cond_broadcast
+ *
+ * Description:
+ *   The pthread_cond_broadcast() function shall unblock all threads
+ *   currently blocked on the specified condition variable cond.
+ *
+ * Input Parameters:
+ *   cond        Condition variable.
+ *
+ * Returned Value:
+ *   If successful, shall return zero.
+ *   Otherwise negative value is returned.
+ *
+ ****************************************************************************/
+
+int32_t sys_thread_cond_broadcast(FAR sys_thread_cond_t *cond)
+{
+  int32_t ret;
+
+  ret = pthread_cond_broadcast(cond);
+  if (ret != 0)
+    {
+      DBGIF_LOG1_ERROR("Failed to broadcast thread condition:%d\n", ret);
+      return -ret;
+    }
+
+  return 0;
+}
@@ -49,19 +49,39 @@
 
 #define BUFFPOOL_LOCK(handle)   do { sys_lock_mutex(&(handle)); } while (0)
 #define BUFFPOOL_UNLOCK(handle) do { sys_unlock_mutex(&(handle)); } while (0)
-#define BUFFPOOL_PULL_BUFFINFO(info, pullpos) \
-  do { info = pullpos; pullpos = (pullpos)->next; } while (0)
-#define BUFFPOOL_PUSH_BUFFINFO(info, pushpos) \
-  do { (info)->next = pushpos; pushpos = info; } while (0)
+#define BUFFPOOL_PULL_BUFFHDR(hdr, pullpos) \
+  do { hdr = pullpos; pullpos = (pullpos)->next; } while (0)
+#define BUFFPOOL_PUSH_BUFFHDR(hdr, pushpos) \
+  do { (hdr)->next = pushpos; pushpos = hdr; } while (0)
+
+/* Number of size classes is limited by the bit width of availmap. */
+
+#define BUFFPOOL_BLOCK_MAX      (32)
+
+/* Buffers are placed with this alignment after their header. */
+
+#define BUFFPOOL_ALIGN          (sizeof(struct buffpool_buffhdr_s))
+#define BUFFPOOL_ROUNDUP(v) \
+  (((v) + BUFFPOOL_ALIGN - 1) & ~(BUFFPOOL_ALIGN - 1))
+
+/* In use buffer has a header pointing to itself instead of free link. */
+
+#define BUFFPOOL_HDR_INUSE(hdr) ((hdr)->next == (hdr))
+
+#define BUFFPOOL_BUFF2HDR(buff) \
+  ((FAR struct buffpool_buffhdr_s *)(buff) - 1)
+#define BUFFPOOL_HDR2BUFF(hdr)  ((FAR void *)((hdr) + 1))
 
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
-struct buffpool_buffinfo_s
+/* Header embedded in front of each buffer. */
+
+struct buffpool_buffhdr_s
 {
-  FAR int8_t                     *buffaddr;
-  FAR struct buffpool_buffinfo_s *next;
+  FAR struct buffpool_blockinfo_s *blkinfo;
+  FAR struct buffpool_buffhdr_s   *next;
 };
 
 struct buffpool_blockinfo_s
@@ -69,9 +89,12 @@ struct buffpool_blockinfo_s
   FAR int8_t                      *buffer;
   FAR int8_t                      *endaddr;
   uint32_t                        size;
-  FAR struct buffpool_buffinfo_s  *freelist;
-  FAR struct buffpool_buffinfo_s  *alloclist;
-  FAR struct buffpool_blockinfo_s *next;
+  uint16_t                        num;
+  uint16_t                        used;
+  uint16_t                        highwater;
+  uint32_t                        spillcnt;
+  FAR struct buffpool_buffhdr_s   *freelist;
+  FAR struct buffpool_table_s     *table;
 };
 
 struct buffpool_table_s
@@ -79,61 +102,42 @@ struct buffpool_table_s
   sys_mutex_t                     buffmtx;
   sys_thread_cond_t               getwaitcond;
   sys_mutex_t                     getwaitcondmtx;
-  FAR struct buffpool_blockinfo_s *startblkinfo;
+  uint8_t                         blknum;
+  uint32_t                        availmap;
+  uint32_t                        waitcnt;
+  uint8_t                         log2idx[33];
+  struct buffpool_blockinfo_s     blkinfo[BUFFPOOL_BLOCK_MAX];
 };
 
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
 
-static void buffpool_deletebuffinfo(FAR struct buffpool_buffinfo_s *table);
 static void buffpool_deleteblockinfo(FAR struct buffpool_table_s *table);
-static struct buffpool_blockinfo_s *buffpool_createblockinfo(
+static int32_t buffpool_createblockinfo(FAR struct buffpool_table_s *table,
+  FAR struct buffpool_blockinfo_s *blkinfo,
   FAR struct buffpool_blockset_s *blkset);
-static void buffpool_insertblockinfo(FAR struct buffpool_table_s *table,
-  FAR struct buffpool_blockinfo_s *blkinfo);
+static void buffpool_insertblockset(
+  FAR struct buffpool_blockset_s *sorted[], uint8_t num,
+  FAR struct buffpool_blockset_s *blkset);
+static uint8_t buffpool_log2ceil(uint32_t size);
 static bool buffpool_getbuffer(
   FAR struct buffpool_table_s *table, uint32_t size, FAR int8_t **buffaddr);
+static FAR void *buffpool_allocbuffer(buffpool_t thiz, uint32_t reqsize,
+  bool zeroclear);
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
-/****************************************************************************
- * Name: buffpool_deletebuffinfo
- *
- * Description:
- *   Delete link list of buffpool_buffinfo_s.
- *
- * Input Parameters:
- *   table  Start address of linked list to delete.
- *
- * Returned Value:
- *   None.
- *
- ****************************************************************************/
-
-static void buffpool_deletebuffinfo(FAR struct buffpool_buffinfo_s *table)
-{
-  FAR struct buffpool_buffinfo_s *target = table;
-  FAR struct buffpool_buffinfo_s *next   = NULL;
-
-  while (target)
-    {
-      next = target->next;
-      SYS_FREE(target);
-      target = next;
-    }
-}
-
 /****************************************************************************
  * Name: buffpool_deleteblockinfo
  *
  * Description:
- *   Delete link list of buffpool_blockinfo_s.
+ *   Delete buffers of all size classes.
  *
  * Input Parameters:
- *   table  Start address of linked list to delete.
+ *   table  Pointer of data table.
  *
  * Returned Value:
  *   None.
@@ -142,159 +146,130 @@ static void buffpool_deletebuffinfo(FAR struct buffpool_buffinfo_s *table)
 
 static void buffpool_deleteblockinfo(FAR struct buffpool_table_s *table)
 {
-  FAR struct buffpool_blockinfo_s *target = table->startblkinfo;
-  FAR struct buffpool_blockinfo_s *next   = NULL;
+  uint8_t idx;
 
-  while (target)
+  for (idx = 0; idx < table->blknum; idx++)
     {
-      next = target->next;
-      buffpool_deletebuffinfo(target->freelist);
-      buffpool_deletebuffinfo(target->alloclist);
-      SYS_FREE(target->buffer);
-      SYS_FREE(target);
-      target = next;
+      SYS_FREE(table->blkinfo[idx].buffer);
+      table->blkinfo[idx].buffer = NULL;
     }
+
+  table->blknum = 0;
 }
 
 /****************************************************************************
  * Name: buffpool_createblockinfo
  *
  * Description:
- *   Create buffpool_blockinfo_s object.
+ *   Setup buffpool_blockinfo_s object and its buffers.
+ *   Each buffer is preceded by a header pointing to its block info,
+ *   so that free can find the block without searching.
  *
  * Input Parameters:
- *   blkset  Size and number of create object.
+ *   table    Pointer of data table.
+ *   blkinfo  Block info to setup.
+ *   blkset   Size and number of create object.
  *
  * Returned Value:
- *   Pointer of struct buffpool_blockinfo_s.
- *   If create failed, returned NULL.
+ *   If the process succeeds, it returns 0.
+ *   Otherwise errno is returned.
  *
  * Assumptions/Limitations:
  *   The size and num elements of @blkset must not be 0.
  *
  ****************************************************************************/
 
-static FAR struct buffpool_blockinfo_s *buffpool_createblockinfo(
+static int32_t buffpool_createblockinfo(FAR struct buffpool_table_s *table,
+  FAR struct buffpool_blockinfo_s *blkinfo,
   FAR struct buffpool_blockset_s *blkset)
 {
-  FAR struct buffpool_blockinfo_s *blkinfo         = NULL;
-  FAR struct buffpool_buffinfo_s  **targetbuffinfo = NULL;
-  uint32_t                        num              = 0;
+  FAR struct buffpool_buffhdr_s **targethdr = NULL;
+  FAR struct buffpool_buffhdr_s *hdr        = NULL;
+  uint32_t                      stride      = 0;
+  uint32_t                      num         = 0;
 
   if (USHRT_MAX < (blkset->size * blkset->num))
   {
     DBGIF_LOG2_ERROR("Unexpected value. size:%u, num:%u\n", blkset->size, blkset->num);
-    goto errout;
+    return -EINVAL;
   }
 
-  /* Allocate block info. */
-
-  blkinfo = (FAR struct buffpool_blockinfo_s *)
-    SYS_MALLOC(sizeof(struct buffpool_blockinfo_s));
-  if (!blkinfo)
-    {
-      DBGIF_LOG_ERROR("Block info allocate failed.\n");
-      goto errout;
-    }
-
   memset(blkinfo, 0, sizeof(struct buffpool_blockinfo_s));
-  blkinfo->size = blkset->size;
+  blkinfo->size  = blkset->size;
+  blkinfo->num   = blkset->num;
+  blkinfo->table = table;
 
   /* Allocate main buffer. */
 
-  blkinfo->buffer = (FAR int8_t *)SYS_MALLOC(blkset->size * blkset->num);
+  stride = sizeof(struct buffpool_buffhdr_s) +
+    BUFFPOOL_ROUNDUP(blkset->size);
+  blkinfo->buffer = (FAR int8_t *)SYS_MALLOC(stride * blkset->num);
   if (!blkinfo->buffer)
     {
       DBGIF_LOG2_ERROR("Buffer allocate failed. block size:%u, num:%u\n", blkset->size, blkset->num);
-      goto errout_with_blkinfofree;
+      return -ENOMEM;
     }
 
-  blkinfo->endaddr = blkinfo->buffer + (blkset->size * blkset->num);
+  blkinfo->endaddr = blkinfo->buffer + (stride * blkset->num);
 
-  /* Allocate and setting buffer info arry. */
+  /* Link all buffers to free list. */
 
-  targetbuffinfo = &blkinfo->freelist;
+  targethdr = &blkinfo->freelist;
 
   for (num = 0; num < blkset->num; num++)
     {
-      *targetbuffinfo = (FAR struct buffpool_buffinfo_s *)
-        SYS_MALLOC(sizeof(struct buffpool_buffinfo_s));
-      if (!(*targetbuffinfo))
-        {
-          DBGIF_LOG2_ERROR("Buffer info allocate failed. size:%u, num:%u\n", blkset->size, blkset->num);
-          goto errout_with_buffinfofree;
-        }
-
-      (*targetbuffinfo)->buffaddr = blkinfo->buffer + (blkset->size * num);
-      targetbuffinfo = &(*targetbuffinfo)->next;
+      hdr = (FAR struct buffpool_buffhdr_s *)(blkinfo->buffer + stride * num);
+      hdr->blkinfo = blkinfo;
+      *targethdr = hdr;
+      targethdr = &hdr->next;
     }
 
-  *targetbuffinfo = NULL;
-
-  return blkinfo;
+  *targethdr = NULL;
 
-errout_with_buffinfofree:
-  buffpool_deletebuffinfo(blkinfo->freelist);
-  SYS_FREE(blkinfo->buffer);
-errout_with_blkinfofree:
-  SYS_FREE(blkinfo);
-errout:
-  return NULL;
+  return 0;
 }
 
 /****************************************************************************
- * Name: buffpool_insertblockinfo
+ * Name: buffpool_insertblockset
  *
  * Description:
- *   Insert new buffpool_blockinfo_s into buffpool_table_s.
+ *   Insert block set into the list sorted by size.
  *   Inserts are done in ascending order.
  *
  * Input Parameters:
- *   table    Pointer of data table.
- *   blkinfo  Pointer of new buffpool_blockinfo_s.
+ *   sorted  List of block set sorted by size.
+ *   num     Number of valid entries in @sorted.
+ *   blkset  Block set to insert.
  *
  * Returned Value:
  *   None.
  *
  ****************************************************************************/
 
-static void buffpool_insertblockinfo(FAR struct buffpool_table_s *table,
-  FAR struct buffpool_blockinfo_s *blkinfo)
+static void buffpool_insertblockset(
+  FAR struct buffpool_blockset_s *sorted[], uint8_t num,
+  FAR struct buffpool_blockset_s *blkset)
 {
-  FAR struct buffpool_blockinfo_s *blkinfonow = NULL;
-
-  if (!table->startblkinfo)
-    {
-      table->startblkinfo = blkinfo;
-    }
-  else if (blkinfo->size < table->startblkinfo->size)
+  while (num > 0 && blkset->size < sorted[num - 1]->size)
     {
-      blkinfo->next = table->startblkinfo;
-      table->startblkinfo = blkinfo;
+      sorted[num] = sorted[num - 1];
+      num--;
     }
-  else
-    {
-      /* blkinfo is always greater than blkinfonow */
 
-      blkinfonow = table->startblkinfo;
-      while (1)
-        {
-          if (!blkinfonow->next)
-            {
-              blkinfonow->next = blkinfo;
-              return;
-            }
-
-          if (blkinfo->size < blkinfonow->next->size)
-            {
-              blkinfo->next = blkinfonow->next;
-              blkinfonow->next = blkinfo;
-              return;
-            }
-
-          blkinfonow = blkinfonow->next;
-        }
-    }
+  sorted[num] = blkset;
+}
+
+/****************************************************************************
+ * Name: buffpool_log2ceil
+ *
+ * Description:
+ *   Get the smallest n which satisfies size <= 2^n.
+ *
+ ****************************************************************************/
+
+static uint8_t buffpool_log2ceil(uint32_t size)
+{
+  return size <= 1 ? 0 : (uint8_t)(32 - __builtin_clz(size - 1));
 }
 
 /****************************************************************************
@@ -302,6 +277,8 @@ static void buffpool_insertblockinfo(FAR struct buffpool_table_s *table,
  *
  * Description:
  *   Get free buffers from the table.
+ *   Size class is looked up by log2 index, and the first class having free
+ *   buffers is found by the availability bitmap.
  *
  * Input Parameters:
  *   table     Pointer of data table.
@@ -318,53 +295,132 @@ static void buffpool_insertblockinfo(FAR struct buffpool_table_s *table,
 static bool buffpool_getbuffer(
   FAR struct buffpool_table_s *table, uint32_t size, FAR int8_t **buffaddr)
 {
-  FAR struct buffpool_blockinfo_s *blkinfo  = NULL;
-  FAR struct buffpool_buffinfo_s  *buffinfo = NULL;
-  bool                            result    = false;
+  FAR struct buffpool_blockinfo_s *blkinfo = NULL;
+  FAR struct buffpool_buffhdr_s   *hdr     = NULL;
+  uint8_t                         fitidx   = 0;
+  uint8_t                         idx      = 0;
+  uint32_t                        avail    = 0;
+
+  /* log2idx gives the first class not smaller than the previous power of
+   * two, so at most the classes within one power of two are skipped.
+   */
+
+  fitidx = table->log2idx[buffpool_log2ceil(size)];
+  while (fitidx < table->blknum && table->blkinfo[fitidx].size < size)
+    {
+      fitidx++;
+    }
 
-  blkinfo = table->startblkinfo;
-  while (blkinfo)
+  if (fitidx >= table->blknum)
     {
-      if (blkinfo->size < size)
-        {
-          blkinfo = blkinfo->next;
-          continue;
-        }
+      DBGIF_LOG1_ERROR("There is no buffer of size to satisfy the request. reqsize:%u\n", size);
+      return false;
+    }
+
+  BUFFPOOL_LOCK(table->buffmtx);
 
-      result = true;
-      BUFFPOOL_LOCK(table->buffmtx);
+  avail = table->availmap & ~((1u << fitidx) - 1);
+  if (avail)
+    {
+      idx = (uint8_t)__builtin_ctz(avail);
+      blkinfo = &table->blkinfo[idx];
 
-      if (blkinfo->freelist)
+      BUFFPOOL_PULL_BUFFHDR(hdr, blkinfo->freelist);
+      hdr->next = hdr;
+      if (!blkinfo->freelist)
         {
-          BUFFPOOL_PULL_BUFFINFO(buffinfo, blkinfo->freelist);
-          BUFFPOOL_PUSH_BUFFINFO(buffinfo, blkinfo->alloclist);
+          table->availmap &= ~(1u << idx);
+        }
 
-          *buffaddr = buffinfo->buffaddr;
-          memset(*buffaddr, 0, blkinfo->size);
-          DBGIF_LOG2_DEBUG("Successful get buffer. size:%u(%u)\n", blkinfo->size, size);
+      blkinfo->used++;
+      if (blkinfo->highwater < blkinfo->used)
+        {
+          blkinfo->highwater = blkinfo->used;
         }
 
-      BUFFPOOL_UNLOCK(table->buffmtx);
-      if (buffinfo)
+      if (idx != fitidx)
         {
-          return result;
+          blkinfo->spillcnt++;
         }
 
-      blkinfo = blkinfo->next;
+      *buffaddr = (FAR int8_t *)BUFFPOOL_HDR2BUFF(hdr);
+      DBGIF_LOG2_DEBUG("Successful get buffer. size:%u(%u)\n", blkinfo->size, size);
     }
-
-  if (result == false)
+  else
     {
-      DBGIF_LOG1_ERROR("There is no buffer of size to satisfy the request. reqsize:%u\n", size);
+      table->waitcnt++;
     }
-  else
+
+  BUFFPOOL_UNLOCK(table->buffmtx);
+
+  if (!hdr)
     {
       DBGIF_LOG1_WARNING("All buffers that satisfy the request are in use. reqsize:%u\n", size);
     }
 
+  return true;
+}
+
+/****************************************************************************
+ * Name: buffpool_allocbuffer
+ *
+ * Description:
+ *   Allocate buffer from bufferpool, waiting for free if necessary.
+ *
+ * Input Parameters:
+ *   thiz       Object of bufferpool.
+ *   reqsize    Buffer size.
+ *   zeroclear  Fill @reqsize bytes of the buffer by 0.
+ *
+ * Returned Value:
+ *   Buffer address.
+ *   If can't get available buffer
+ *   and  if @reqsize value is under 1, returned NULL.
+ *
+ ****************************************************************************/
+
+static FAR void *buffpool_allocbuffer(buffpool_t thiz, uint32_t reqsize,
+  bool zeroclear)
+{
+  FAR struct buffpool_table_s *table  = NULL;
+  FAR int8_t                  *result = NULL;
+
+  if (!thiz)
+    {
+      DBGIF_LOG_ERROR("Incorrect argument.\n");
+      return NULL;
+    }
+
+  if (!reqsize)
+    {
+      DBGIF_LOG_INFO("Allocation request size is 0.\n");
+      return NULL;
+    }
+
+  table = (FAR struct buffpool_table_s *)thiz;
+  do
+    {
+      if (!buffpool_getbuffer(table, reqsize, &result))
+        {
+          break;
+        }
+
+      if (result)
+        {
+          break;
+        }
+    }
+  while (sys_wait_thread_cond(&table->getwaitcond, &table->getwaitcondmtx,
+                              SYS_TIMEO_FEVR) == 0);
+
+  if (result && zeroclear)
+    {
+      memset(result, 0, reqsize);
+    }
+
   return result;
 }
-  
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -388,11 +444,14 @@ static bool buffpool_getbuffer(
 buffpool_t buffpool_create(
   FAR struct buffpool_blockset_s set[], uint8_t setnum)
 {
-  FAR struct buffpool_table_s     *table    = NULL;
-  FAR struct buffpool_blockinfo_s *blkinfo  = NULL;
-  int8_t                          num       = 0;
-  sys_cremtx_s                    mtx_param;
-  
+  FAR struct buffpool_table_s    *table = NULL;
+  FAR struct buffpool_blockset_s *sorted[BUFFPOOL_BLOCK_MAX];
+  uint8_t                        sortnum = 0;
+  uint8_t                        num     = 0;
+  uint8_t                        bit     = 0;
+  int32_t                        ret     = 0;
+  sys_cremtx_s                   mtx_param;
+
   if (!set || !setnum)
     {
       DBGIF_LOG_ERROR("Incorrect argument.\n");
@@ -400,15 +459,27 @@ buffpool_t buffpool_create(
       goto errout;
     }
 
+  /* Sort valid block sets in ascending order of size. */
+
   for (num = 0; num < setnum; num++)
     {
-      if (set[num].size && set[num].num)
+      if (set[num].size == 0 || set[num].num == 0)
         {
-          break;
+          continue;
         }
+
+      if (BUFFPOOL_BLOCK_MAX <= sortnum)
+        {
+          DBGIF_LOG1_ERROR("Too many block sets. max:%d\n", BUFFPOOL_BLOCK_MAX);
+          errno = EINVAL;
+          goto errout;
+        }
+
+      buffpool_insertblockset(sorted, sortnum, &set[num]);
+      sortnum++;
     }
 
-  if (setnum <= num)
+  if (!sortnum)
     {
       DBGIF_LOG_ERROR("Incorrect argument.\n");
       errno = EINVAL;
@@ -416,7 +487,7 @@ buffpool_t buffpool_create(
     }
 
   /* Create data table. */
-  
+
   table = (FAR struct buffpool_table_s *)
     SYS_MALLOC(sizeof(struct buffpool_table_s));
   if (!table)
@@ -450,33 +521,40 @@ buffpool_t buffpool_create(
 
   /* Create block data. */
 
-  for (num = 0; num < setnum; num++)
+  for (num = 0; num < sortnum; num++)
     {
-      if (set[num].size == 0 || set[num].num == 0)
+      ret = buffpool_createblockinfo(table, &table->blkinfo[num],
+                                     sorted[num]);
+      if (ret < 0)
         {
-          continue;
+          errno = -ret;
+          goto errout_with_blkinfodelete;
         }
 
-      blkinfo = buffpool_createblockinfo(&set[num]);
-      if (!blkinfo)
+      table->blknum++;
+      table->availmap |= 1u << num;
+    }
+
+  /* Build size class index. log2idx[n] is the first class larger than
+   * 2^(n-1), i.e. the first candidate for requests in (2^(n-1), 2^n].
+   */
+
+  num = 0;
+  for (bit = 0; bit < sizeof(table->log2idx); bit++)
+    {
+      while (num < table->blknum &&
+             buffpool_log2ceil(table->blkinfo[num].size) < bit)
         {
-          errno = ENOMEM;
-          goto errout_with_blkinfodelete;
+          num++;
         }
 
-      /* Insert table in ascending order. */
-
-      buffpool_insertblockinfo(table, blkinfo);
+      table->log2idx[bit] = num;
     }
 
   return (buffpool_t)table;
 
 errout_with_blkinfodelete:
-  if (table->startblkinfo)
-    {
-      buffpool_deleteblockinfo(table);
-    }
-
+  buffpool_deleteblockinfo(table);
   sys_delete_thread_cond_mutex(&table->getwaitcond, &table->getwaitcondmtx);
 errout_with_mtxdelete:
   sys_delete_mutex(&table->buffmtx);
@@ -525,6 +603,7 @@ int32_t buffpool_delete(buffpool_t thiz)
  *
  * Description:
  *   Allocate buffer from bufferpool.
+ *   The first @reqsize bytes of the buffer are filled by 0.
  *   This function is blocking.
  *
  * Input Parameters:
@@ -540,38 +619,30 @@ int32_t buffpool_delete(buffpool_t thiz)
 
 FAR void *buffpool_alloc(buffpool_t thiz, uint32_t reqsize)
 {
-  FAR struct buffpool_table_s *table  = NULL;
-  FAR int8_t                  *result = NULL;
-
-  if (!thiz)
-    {
-      DBGIF_LOG_ERROR("Incorrect argument.\n");
-      return NULL;
-    }
-
-  if (!reqsize)
-    {
-      DBGIF_LOG_INFO("Allocation request size is 0.\n");
-      return NULL;
-    }
-
-  table = (FAR struct buffpool_table_s *)thiz;
-  do
-    {
-      if (!buffpool_getbuffer(table, reqsize, &result))
-        {
-          break;
-        }
+  return buffpool_allocbuffer(thiz, reqsize, true);
+}
 
-      if (result)
-        {
-          break;
-        }
-    }
-  while (sys_wait_thread_cond(&table->getwaitcond, &table->getwaitcondmtx,
-                              SYS_TIMEO_FEVR) == 0);
+/****************************************************************************
+ * Name: buffpool_alloc_nozero
+ *
+ * Description:
+ *   Allocate buffer from bufferpool without clearing its contents.
+ *   This function is blocking.
+ *
+ * Input Parameters:
+ *   thiz     Object of bufferpool.
+ *   reqsize  Buffer size.
+ *
+ * Returned Value:
+ *   Buffer address.
+ *   If can't get available buffer
+ *   and  if @reqsize value is under 1, returned NULL.
+ *
+ ****************************************************************************/
 
-  return result;
+FAR void *buffpool_alloc_nozero(buffpool_t thiz, uint32_t reqsize)
+{
+  return buffpool_allocbuffer(thiz, reqsize, false);
 }
 
 /****************************************************************************
@@ -593,10 +664,10 @@ FAR void *buffpool_alloc(buffpool_t thiz, uint32_t reqsize)
 
 int32_t buffpool_free(buffpool_t thiz, FAR void *buff)
 {
-  FAR struct buffpool_table_s     *table       = NULL;
-  FAR struct buffpool_blockinfo_s *blkinfo     = NULL;
-  FAR struct buffpool_buffinfo_s  *buffinfo    = NULL;
-  FAR struct buffpool_buffinfo_s  *tmpbuffinfo = NULL;
+  FAR struct buffpool_table_s     *table   = NULL;
+  FAR struct buffpool_blockinfo_s *blkinfo = NULL;
+  FAR struct buffpool_buffhdr_s   *hdr     = NULL;
+  uint8_t                         idx      = 0;
 
   if (!thiz)
     {
@@ -611,45 +682,83 @@ int32_t buffpool_free(buffpool_t thiz, FAR void *buff)
     }
 
   table = (FAR struct buffpool_table_s *)thiz;
-  blkinfo = table->startblkinfo;
-  while (blkinfo)
-    {
-      if ((uintptr_t)blkinfo->buffer <= (uintptr_t)buff &&
-        (uintptr_t)buff < (uintptr_t)blkinfo->endaddr)
-        {
-          break;
-        }
+  hdr = BUFFPOOL_BUFF2HDR(buff);
+  blkinfo = hdr->blkinfo;
+
+  DBGIF_ASSERT(blkinfo >= &table->blkinfo[0] &&
+               blkinfo < &table->blkinfo[table->blknum] &&
+               (uintptr_t)blkinfo->buffer <= (uintptr_t)hdr &&
+               (uintptr_t)hdr < (uintptr_t)blkinfo->endaddr,
+               "The given buffer is not from the buffer pool.");
+
+  BUFFPOOL_LOCK(table->buffmtx);
+
+  DBGIF_ASSERT(BUFFPOOL_HDR_INUSE(hdr), "Given buffer is unused.");
+
+  idx = (uint8_t)(blkinfo - &table->blkinfo[0]);
+  BUFFPOOL_PUSH_BUFFHDR(hdr, blkinfo->freelist);
+  table->availmap |= 1u << idx;
+  blkinfo->used--;
+
+  BUFFPOOL_UNLOCK(table->buffmtx);
+  sys_signal_thread_cond(&table->getwaitcond, &table->getwaitcondmtx);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: buffpool_getstat
+ *
+ * Description:
+ *   Get usage statistics of each size class for tuning the block sets
+ *   given to buffpool_create().
+ *
+ * Input Parameters:
+ *   thiz     Object of bufferpool.
+ *   stat     Array to store statistics in ascending order of size.
+ *   statnum  Number of elements of @stat.
+ *   waitcnt  Pointer to store the number of times an allocation had to
+ *            wait for free. May be NULL.
+ *
+ * Returned Value:
+ *   Number of size classes in the bufferpool.
+ *   Otherwise errno is returned.
+ *
+ ****************************************************************************/
 
-      blkinfo = blkinfo->next;
+int32_t buffpool_getstat(buffpool_t thiz,
+  FAR struct buffpool_stat_s stat[], uint8_t statnum,
+  FAR uint32_t *waitcnt)
+{
+  FAR struct buffpool_table_s     *table   = NULL;
+  FAR struct buffpool_blockinfo_s *blkinfo = NULL;
+  uint8_t                         idx      = 0;
+
+  if (!thiz || (!stat && statnum))
+    {
+      DBGIF_LOG_ERROR("Incorrect argument.\n");
+      return -EINVAL;
     }
 
-  DBGIF_ASSERT(blkinfo, "The given buffer is not from the buffer pool.");
+  table = (FAR struct buffpool_table_s *)thiz;
 
   BUFFPOOL_LOCK(table->buffmtx);
-  if (blkinfo->alloclist->buffaddr == buff)
+
+  for (idx = 0; idx < table->blknum && idx < statnum; idx++)
     {
-      BUFFPOOL_PULL_BUFFINFO(tmpbuffinfo, blkinfo->alloclist);
-      BUFFPOOL_PUSH_BUFFINFO(tmpbuffinfo, blkinfo->freelist);
+      blkinfo = &table->blkinfo[idx];
+      stat[idx].size      = blkinfo->size;
+      stat[idx].num       = blkinfo->num;
+      stat[idx].used      = blkinfo->used;
+      stat[idx].highwater = blkinfo->highwater;
+      stat[idx].spillcnt  = blkinfo->spillcnt;
     }
-  else
-    {
-      buffinfo = blkinfo->alloclist;
-      while (buffinfo->next)
-        {
-          if (buffinfo->next->buffaddr == buff)
-            {
-              BUFFPOOL_PULL_BUFFINFO(tmpbuffinfo, buffinfo->next);
-              BUFFPOOL_PUSH_BUFFINFO(tmpbuffinfo, blkinfo->freelist);
-              break;
-            }
-
-          buffinfo = buffinfo->next;
-        }
 
-      DBGIF_ASSERT(blkinfo->freelist == tmpbuffinfo, "Given buffer is unused.");
+  if (waitcnt)
+    {
+      *waitcnt = table->waitcnt;
     }
 
   BUFFPOOL_UNLOCK(table->buffmtx);
-  sys_signal_thread_cond(&table->getwaitcond, &table->getwaitcondmtx);
-  return 0;
+
+  return table->blknum;
 }
@@ -39,6 +39,9 @@
 #include "memutils/memory_manager/MemMgrTypes.h"
 
 #include "memutils/os_utils/chateau_osal.h"
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+#include <nuttx/irq.h>
+#endif
 namespace MemMgrLite {
 static uint32_t context;
 static inline bool isDisableInt() { return Chateau_GetInterruptMask(); }
@@ -59,6 +62,29 @@ private:
 	bool m_locked;
 }; /* class InterruptLock */
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+/*****************************************************************
+ * Segment cache lock class
+ * The segment cache of a context is touched only by the context
+ * itself, so in the task context it is enough to disable dispatch.
+ * Interrupts are kept enabled.
+ * In the interrupt context, the cache is shared by all interrupt
+ * handlers of the CPU, so interrupts are disabled against nesting.
+ * The previous state is restored, not enabled unconditionally.
+ *****************************************************************/
+class SegCacheLock : CopyGuard {
+public:
+	SegCacheLock() : m_isr(Chateau_IsInterruptContext()), m_flags(0) {
+		if (m_isr) m_flags = up_irq_save(); else Chateau_LockDispatch();
+	}
+	~SegCacheLock() { if (m_isr) up_irq_restore(m_flags); else Chateau_UnlockDispatch(); }
+	bool isIsr() const { return m_isr; }
+private:
+	bool		m_isr;
+	irqstate_t	m_flags;
+}; /* class SegCacheLock */
+#endif
+
 /*****************************************************************
  * Scoped lock class
  *****************************************************************/
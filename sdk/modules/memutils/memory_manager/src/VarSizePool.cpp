@@ -0,0 +1,323 @@
+/****************************************************************************
+ * modules/memutils/memory_manager/src/VarSizePool.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include "FastMemAlloc.h"
+#include "ScopedLock.h"
+#include "VarSizePool.h"
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_POOL
+
+namespace MemMgrLite {
+
+/*****************************************************************
+ * Constructor
+ * The pool area is divided into the largest possible blocks.
+ * Since blocks are carved out from the top in descending order of
+ * size, every block is aligned to its own size.
+ *****************************************************************/
+VarSizePool::VarSizePool(const PoolSectionAttr& attr, FastMemAlloc& fma) :
+  MemPool(attr, fma),
+  m_seg_desc(static_cast<SegDesc*>(fma.alloc(sizeof(SegDesc) * attr.num_segs, sizeof(uint32_t)))),
+  m_free_map(static_cast<uint32_t*>(fma.alloc(sizeof(uint32_t) * VARSIZE_FREE_MAP_WORDS(attr.size), sizeof(uint32_t)))),
+  m_free_size(0)
+{
+  for (uint32_t i = 0; i < VARSIZE_NUM_CLASSES; ++i)
+    {
+      m_free_head[i] = NullOffset;
+    }
+
+  if (isFailed())
+    {
+      return;
+    }
+
+  memset(m_free_map, 0x00, sizeof(uint32_t) * VARSIZE_FREE_MAP_WORDS(attr.size));
+
+  uint32_t offset = 0;
+
+  for (int32_t order = VARSIZE_NUM_CLASSES - 1; order >= 0; --order)
+    {
+      while (getPoolSize() - offset >= getClassSize(order))
+        {
+          pushFreeBlock(offset, order);
+          offset += getClassSize(order);
+        }
+    }
+
+#ifdef USE_MEMMGR_DEBUG_OUTPUT
+  printf("VarSizePool: created. [fma.rest=%08x free=%08x] ", fma.rest(), m_free_size);
+  attr.printInfo();
+#endif
+}
+
+/*****************************************************************
+ * Destructor
+ *****************************************************************/
+VarSizePool::~VarSizePool()
+{
+#ifdef USE_MEMMGR_DEBUG_OUTPUT
+  printf("~VarSizePool: PoolId=%d\n", getPoolId());
+#endif
+}
+
+/*****************************************************************
+ * Get a segment of the smallest size class that fits
+ * Like the fixed size pools, a pool shared between CPUs is guarded
+ * by its spin lock in addition to disabling interrupts.
+ *****************************************************************/
+err_t VarSizePool::allocSeg(size_t size_for_check, MemHandleProxy &proxy)
+{
+  if (size_for_check > VARSIZE_MAX_SEG_SIZE)
+    {
+      return ERR_DATA_SIZE;
+    }
+
+  uint32_t order = 0;
+
+  while (getClassSize(order) < size_for_check)
+    {
+      ++order;
+    }
+
+#ifdef USE_MEMMGR_MULTI_CORE
+  ScopedLock lock(getPoolLockId());
+#else
+  ScopedLock lock;
+#endif
+
+  if (m_seg_no_que.empty())
+    {
+      return ERR_MEM_EMPTY;
+    }
+
+  uint32_t offset = allocBlock(order);
+
+  if (offset == NullOffset)
+    {
+      return ERR_MEM_EMPTY;
+    }
+
+  NumSeg seg_no = m_seg_no_que.top();
+
+  m_seg_desc[seg_no - 1].offset = offset;
+  m_seg_desc[seg_no - 1].order  = static_cast<uint8_t>(order);
+
+  proxy = MemPool::allocSeg();
+
+  return ERR_OK;
+}
+
+/*****************************************************************
+ * Free a segment and return its block when the last reference
+ * is released
+ *****************************************************************/
+void VarSizePool::freeSeg(MemHandleBase& mh)
+{
+  NumSeg seg_no = mh.getSegNo();
+
+#ifdef USE_MEMMGR_MULTI_CORE
+  ScopedLock lock(getPoolLockId());
+#else
+  ScopedLock lock;
+#endif
+
+  if (getSegRefCnt(seg_no) == 1)
+    {
+      freeBlock(m_seg_desc[seg_no - 1].offset, m_seg_desc[seg_no - 1].order);
+    }
+
+  MemPool::freeSeg(mh);
+}
+
+/*****************************************************************
+ * Address of a segment
+ *****************************************************************/
+PoolAddr VarSizePool::getSegAddr(const MemHandleBase& mh) const
+{
+  NumSeg seg_no = mh.getSegNo();
+  D_ASSERT(seg_no != NullSegNo && seg_no <= getPoolNumSegs());
+
+  return getPoolAddr() + m_seg_desc[seg_no - 1].offset;
+}
+
+/*****************************************************************
+ * Size of a segment (the size of its size class)
+ *****************************************************************/
+PoolSize VarSizePool::getSegSize(const MemHandleBase& mh) const
+{
+  NumSeg seg_no = mh.getSegNo();
+  D_ASSERT(seg_no != NullSegNo && seg_no <= getPoolNumSegs());
+
+  return getClassSize(m_seg_desc[seg_no - 1].order);
+}
+
+/*****************************************************************
+ * Link a free block at the head of the list of the size class
+ *****************************************************************/
+void VarSizePool::pushFreeBlock(uint32_t offset, uint32_t order)
+{
+  FreeBlock* blk = getFreeBlock(offset);
+
+  blk->next  = m_free_head[order];
+  blk->prev  = NullOffset;
+  blk->order = order;
+
+  if (m_free_head[order] != NullOffset)
+    {
+      getFreeBlock(m_free_head[order])->prev = offset;
+    }
+
+  m_free_head[order] = offset;
+
+  uint32_t bit = offset >> VARSIZE_MIN_ORDER;
+  m_free_map[bit / 32] |= (1u << (bit % 32));
+
+  m_free_size += getClassSize(order);
+}
+
+/*****************************************************************
+ * Unlink a free block from the list of the size class
+ *****************************************************************/
+void VarSizePool::removeFreeBlock(uint32_t offset, uint32_t order)
+{
+  FreeBlock* blk = getFreeBlock(offset);
+
+  if (blk->prev != NullOffset)
+    {
+      getFreeBlock(blk->prev)->next = blk->next;
+    }
+  else
+    {
+      m_free_head[order] = blk->next;
+    }
+
+  if (blk->next != NullOffset)
+    {
+      getFreeBlock(blk->next)->prev = blk->prev;
+    }
+
+  uint32_t bit = offset >> VARSIZE_MIN_ORDER;
+  m_free_map[bit / 32] &= ~(1u << (bit % 32));
+
+  m_free_size -= getClassSize(order);
+}
+
+/*****************************************************************
+ * Take a block of the size class. A larger block is split
+ * into halves when no block of the class is free.
+ * Exclusive control should be done on the caller side.
+ *****************************************************************/
+uint32_t VarSizePool::allocBlock(uint32_t order)
+{
+  uint32_t found = order;
+
+  while (found < VARSIZE_NUM_CLASSES && m_free_head[found] == NullOffset)
+    {
+      ++found;
+    }
+
+  if (found == VARSIZE_NUM_CLASSES)
+    {
+      return NullOffset;
+    }
+
+  uint32_t offset = m_free_head[found];
+  removeFreeBlock(offset, found);
+
+  while (found > order)
+    {
+      --found;
+      pushFreeBlock(offset + getClassSize(found), found);
+    }
+
+  return offset;
+}
+
+/*****************************************************************
+ * Return a block, merging it with its free buddy as long as
+ * the merged block stays inside the pool area.
+ * Exclusive control should be done on the caller side.
+ *****************************************************************/
+void VarSizePool::freeBlock(uint32_t offset, uint32_t order)
+{
+  while (order + 1 < VARSIZE_NUM_CLASSES)
+    {
+      uint32_t buddy = offset ^ getClassSize(order);
+      uint32_t base  = offset & ~(getClassSize(order + 1) - 1);
+
+      if (base + getClassSize(order + 1) > getPoolSize())
+        {
+          break;
+        }
+
+      if (!isFreeHead(buddy) || getFreeBlock(buddy)->order != order)
+        {
+          break;
+        }
+
+      removeFreeBlock(buddy, order);
+      offset = base;
+      ++order;
+    }
+
+  pushFreeBlock(offset, order);
+}
+
+/*****************************************************************
+ * Total size of free blocks of a variable size pool
+ *****************************************************************/
+PoolSize Manager::getPoolFreeSize(PoolId id)
+{
+  MemPool* pool = findPool(id);
+
+  if (pool->getPoolType() != VarSizeType)
+    {
+      return pool->getPoolNumAvailSegs() * (pool->getPoolSize() / pool->getPoolNumSegs());
+    }
+
+#ifdef USE_MEMMGR_MULTI_CORE
+  ScopedLock lock(pool->getPoolLockId());
+#else
+  ScopedLock lock;
+#endif
+  return static_cast<VarSizePool*>(pool)->getFreeSize();
+}
+
+} /* end of namespace MemMgrLite */
+
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_POOL */
+
+/* VarSizePool.cxx */
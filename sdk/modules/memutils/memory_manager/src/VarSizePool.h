@@ -0,0 +1,131 @@
+/****************************************************************************
+ * modules/memutils/memory_manager/src/VarSizePool.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef VARSIZEPOOL_H_INCLUDED
+#define VARSIZEPOOL_H_INCLUDED
+
+#include "memutils/common_utils/common_errcode.h"
+#include "memutils/memory_manager/MemManager.h"
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_POOL
+
+/* Size classes are 2^MIN_ORDER, 2^(MIN_ORDER+1), ... bytes. */
+
+#define VARSIZE_MIN_ORDER    CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_MIN_ORDER
+#define VARSIZE_NUM_CLASSES  CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_NUM_CLASSES
+#define VARSIZE_MIN_SEG_SIZE (1u << VARSIZE_MIN_ORDER)
+#define VARSIZE_MAX_SEG_SIZE (VARSIZE_MIN_SEG_SIZE << (VARSIZE_NUM_CLASSES - 1))
+
+/* One bit per minimum size block, to mark the head of a free block. */
+
+#define VARSIZE_FREE_MAP_WORDS(size) \
+  ((((size) >> VARSIZE_MIN_ORDER) + 31) / 32)
+
+namespace MemMgrLite {
+
+/*****************************************************************
+ * Variable size memory pool class
+ *
+ * Segments of power-of-two size classes are carved out of one pool
+ * area with the buddy system. The segment number of MemHandle
+ * points to a descriptor that holds the offset and the size class
+ * of the segment, so num_segs of the pool attribute is the maximum
+ * number of segments allocated at the same time.
+ *****************************************************************/
+class VarSizePool : public MemPool {
+	friend class Manager;
+protected:
+	VarSizePool(const PoolSectionAttr& attr, FastMemAlloc& fma);
+	~VarSizePool();
+
+	bool isFailed() {
+		return MemPool::isFailed() || m_seg_desc == NULL || m_free_map == NULL;
+	}
+
+  /* allocate a memory segment of the size class for size_for_check */
+  err_t allocSeg(size_t size_for_check, MemHandleProxy &proxy);
+
+	/* free a memory segment */
+	void 		freeSeg(MemHandleBase& mh);
+
+	PoolAddr	getSegAddr(const MemHandleBase& mh) const;
+	PoolSize	getSegSize(const MemHandleBase& mh) const;
+
+	/* total size of free blocks */
+	PoolSize	getFreeSize() const { return m_free_size; }
+
+private:
+	struct SegDesc {
+		uint32_t	offset;	/* offset from the pool address */
+		uint8_t		order;	/* size class (0 origin) */
+	}; /* struct SegDesc */
+
+  /* Header written at the top of a free block. */
+
+	struct FreeBlock {
+		uint32_t	next;
+		uint32_t	prev;
+		uint32_t	order;
+	}; /* struct FreeBlock */
+
+	static const uint32_t NullOffset = 0xffffffff;
+
+	static PoolSize	getClassSize(uint32_t order) { return VARSIZE_MIN_SEG_SIZE << order; }
+
+	FreeBlock*	getFreeBlock(uint32_t offset) const {
+		return static_cast<FreeBlock*>(translatePoolAddrToVa(getPoolAddr() + offset));
+	}
+
+	bool	isFreeHead(uint32_t offset) const {
+		uint32_t bit = offset >> VARSIZE_MIN_ORDER;
+		return (m_free_map[bit / 32] & (1u << (bit % 32))) != 0;
+	}
+
+	void	pushFreeBlock(uint32_t offset, uint32_t order);
+	void	removeFreeBlock(uint32_t offset, uint32_t order);
+	uint32_t	allocBlock(uint32_t order);
+	void	freeBlock(uint32_t offset, uint32_t order);
+
+	SegDesc* const	m_seg_desc;	/* segment descriptors (num_segs entries) */
+	uint32_t* const	m_free_map;	/* free block head bitmap */
+	uint32_t	m_free_head[VARSIZE_NUM_CLASSES];	/* free list of each class */
+	PoolSize	m_free_size;
+}; /* class VarSizePool */
+
+} /* namespace MemMgrLite */
+
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_POOL */
+
+#endif /* VARSIZEPOOL_H_INCLUDED */
@@ -36,6 +36,7 @@
 #include "ScopedLock.h"
 #include "memutils/memory_manager/MemHandleBase.h"
 #include "BasicPool.h"
+#include "VarSizePool.h"
 
 namespace MemMgrLite {
 
@@ -56,6 +57,13 @@ err_t Manager::allocSeg(PoolId id, size_t size_for_check, MemHandleProxy &proxy)
 {
   MemPool* pool = findPool(id);
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_POOL
+  if (pool->getPoolType() == VarSizeType)
+    {
+      return static_cast<VarSizePool*>(pool)->allocSeg(size_for_check, proxy);
+    }
+#endif
+
 #ifdef USE_MEMMGR_RINGBUF_POOL
   /* 仮想関数を使用しない方針なので、該当プール型にダウンキャストする */
   switch (pool->getPoolType()) {
@@ -83,8 +91,24 @@ err_t BasicPool::allocSeg(size_t size_for_check, MemHandleProxy &proxy)
       return ERR_DATA_SIZE;
     }
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+  if (isSegCacheEnable())
+    {
+      proxy = MemPool::allocSegCached();
+    }
+  else
+    {
+#ifdef USE_MEMMGR_MULTI_CORE
+      ScopedLock lock(getPoolLockId());
+#else
+      ScopedLock lock;
+#endif
+      proxy = MemPool::allocSeg();
+    }
+#else
   ScopedLock lock;
   proxy = MemPool::allocSeg();
+#endif
 
   if (proxy == 0)
     {
@@ -37,6 +37,7 @@
 #include "FastMemAlloc.h"  /* FastMemAlloc class */
 #include "memutils/memory_manager/Manager.h"
 #include "BasicPool.h"
+#include "VarSizePool.h"
 
 namespace MemMgrLite {
 
@@ -46,6 +47,21 @@ namespace MemMgrLite {
 MemPool* Manager::createPool(const PoolSectionAttr& attr, FastMemAlloc& fma)
 {
   MemPool* pool = NULL;
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_POOL
+  if (attr.type == VarSizeType)
+    {
+      VarSizePool* var_pool = new(fma, sizeof(uint32_t)) VarSizePool(attr, fma);
+
+      /* コンストラクタ内でエラー? */
+      if (var_pool && var_pool->isFailed())
+        {
+          var_pool = NULL;
+        }
+      return var_pool;
+    }
+#endif
+
 #ifdef USE_MEMMGR_RINGBUF_POOL
   switch (attr.type) {
   case BasicType:
@@ -92,8 +108,11 @@ MemPool::MemPool(const PoolSectionAttr& attr, FastMemAlloc& fma) :
   m_attr(attr),
   m_seg_no_que(fma.alloc(sizeof(NumSeg) * attr.num_segs, sizeof(NumSeg)), attr.num_segs),
   m_ref_cnt_array(static_cast<SegRefCnt*>(fma.alloc(sizeof(SegRefCnt) * attr.num_segs, sizeof(SegRefCnt))))
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+  , m_seg_cache(static_cast<SegCache*>(fma.alloc(sizeof(SegCache) * MEMMGR_NUM_SEG_CACHES, sizeof(NumSeg))))
+#endif
 {
-  if (m_seg_no_que.que_area() && m_ref_cnt_array) { /* alloc成功 ? */
+  if (!isFailed()) { /* alloc成功 ? */
     /* 使用可能なセグメント番号(1 origin)を設定 */
     for (uint32_t i = 1; i <= static_cast<uint32_t>(attr.num_segs); ++i) {
       (void)m_seg_no_que.push(static_cast<NumSeg>(i));
@@ -102,6 +121,11 @@ MemPool::MemPool(const PoolSectionAttr& attr, FastMemAlloc& fma) :
     /* 参照カウンタ配列を初期化 */
     memset(m_ref_cnt_array, 0x00, sizeof(SegRefCnt) * attr.num_segs);
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+    /* セグメントキャッシュは空の状態から開始する */
+    memset(m_seg_cache, 0x00, sizeof(SegCache) * MEMMGR_NUM_SEG_CACHES);
+#endif
+
 #ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_FENCE
     if (isPoolFenceEnable()) {
       initPoolFence();  /* プールフェンスを初期化 */
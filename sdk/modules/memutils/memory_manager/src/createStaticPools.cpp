@@ -48,7 +48,7 @@ err_t Manager::createStaticPools(uint8_t sec_no, NumLayout layout_no, void* work
   printf("Manager::createStaticPools(layout_no=%d, work_area=%08x, area_size=%08x)\n",
     layout_no, work_area, area_size);
 #endif
-  if (reinterpret_cast<uint32_t>(work_area) % sizeof(uint32_t) != 0)
+  if (reinterpret_cast<uintptr_t>(work_area) % sizeof(uint32_t) != 0)
     {
       return ERR_ADR_ALIGN;
     }
@@ -35,6 +35,7 @@
 
 #include "memutils/memory_manager/Manager.h"
 #include "BasicPool.h"
+#include "VarSizePool.h"
 
 namespace MemMgrLite {
 
@@ -44,6 +45,18 @@ namespace MemMgrLite {
  *****************************************************************/
 void Manager::destroyPool(MemPool* pool)
 {
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+	/* キャッシュ中のセグメントをキューに戻してからリークを検査する */
+	pool->flushSegCache();
+#endif
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_POOL
+	if (pool->getPoolType() == VarSizeType) {
+		static_cast<VarSizePool*>(pool)->~VarSizePool();
+		return;
+	}
+#endif
+
 #ifdef USE_MEMMGR_RINGBUF_POOL
 	/* 仮想関数を使用しない方針なので、該当プール型にダウンキャストする */
 	switch (pool->getPoolType()) {
@@ -36,6 +36,7 @@
 #include "ScopedLock.h"
 #include "memutils/memory_manager/MemHandleBase.h"
 #include "BasicPool.h"
+#include "VarSizePool.h"
 
 namespace MemMgrLite {
 
@@ -46,6 +47,13 @@ void Manager::freeSeg(MemHandleBase& mh)
 {
 	MemPool* pool = findPool(mh.getPoolId());
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_POOL
+	if (pool->getPoolType() == VarSizeType) {
+		static_cast<VarSizePool*>(pool)->freeSeg(mh);
+		return;
+	}
+#endif
+
 #ifdef USE_MEMMGR_RINGBUF_POOL
 	/* 仮想関数を使用しない方針なので、該当プール型にダウンキャストする */
 	switch (pool->getPoolType()) {
@@ -70,8 +78,21 @@ void Manager::freeSeg(MemHandleBase& mh)
  *****************************************************************/
 void BasicPool::freeSeg(MemHandleBase& mh)
 {
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+	if (isSegCacheEnable()) {
+		MemPool::freeSegCached(mh);
+	} else {
+#ifdef USE_MEMMGR_MULTI_CORE
+		ScopedLock lock(getPoolLockId());
+#else
+		ScopedLock lock;
+#endif
+		MemPool::freeSeg(mh);
+	}
+#else
 	ScopedLock lock;
 	MemPool::freeSeg(mh);
+#endif
 }
 
 /*****************************************************************
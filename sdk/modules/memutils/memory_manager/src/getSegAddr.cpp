@@ -35,6 +35,7 @@
 
 #include "memutils/memory_manager/MemHandleBase.h"
 #include "BasicPool.h"
+#include "VarSizePool.h"
 
 namespace MemMgrLite {
 
@@ -45,6 +46,12 @@ PoolAddr Manager::getSegAddr(const MemHandleBase& mh)
 {
 	MemPool* pool = findPool(mh.getPoolId());
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_POOL
+	if (pool->getPoolType() == VarSizeType) {
+		return static_cast<VarSizePool*>(pool)->getSegAddr(mh);
+	}
+#endif
+
 #ifdef USE_MEMMGR_RINGBUF_POOL
 	/* 仮想関数を使用しない方針なので、該当プール型にダウンキャストする */
 	switch (pool->getPoolType()) {
@@ -63,9 +63,26 @@ void MemPool::incSegRefCnt(NumSeg seg_no)
 	NumSeg ref_idx = seg_no - 1;
 	D_ASSERT(m_ref_cnt_array[ref_idx] != 0);	/* 使用中のはず */
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+	if (isSegCacheEnable()) {
+		/* キャッシュ使用時は解放側がロックを取らないため、アトミックに加算する */
+		SegRefCnt cnt = __atomic_add_fetch(&m_ref_cnt_array[ref_idx], 1, __ATOMIC_ACQ_REL);
+		D_ASSERT(cnt != 0);	/* ラップチェック */
+		(void)cnt;
+	} else {
+#ifdef USE_MEMMGR_MULTI_CORE
+		ScopedLock lock(getPoolLockId());
+#else
+		ScopedLock lock;
+#endif
+		++m_ref_cnt_array[ref_idx];
+		D_ASSERT(m_ref_cnt_array[ref_idx] != 0);	/* ラップチェック */
+	}
+#else
 	ScopedLock lock;
 	++m_ref_cnt_array[ref_idx];
 	D_ASSERT(m_ref_cnt_array[ref_idx] != 0);	/* ラップチェック */
+#endif
 }
 
 } /* end of namespace MemMgrLite */
@@ -0,0 +1,239 @@
+/****************************************************************************
+ * modules/memutils/memory_manager/src/segCache.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "ScopedLock.h"
+#include "memutils/memory_manager/MemHandleBase.h"
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE
+
+/* Number of segments moved between a cache and the segment number
+ * queue at once. Half of the depth is used so that alternate alloc
+ * and free at the boundary do not take the lock every time.
+ */
+
+#define SEG_CACHE_BATCH  ((MEMMGR_SEG_CACHE_DEPTH + 1) / 2)
+
+namespace MemMgrLite {
+
+/*****************************************************************
+ * Index of the segment cache for the current context
+ * Without CONFIG_SMP, only pools used by a single CPU come here
+ * (see MemPool::isSegCacheEnable()), so the index need not
+ * distinguish ASMP CPUs.
+ *****************************************************************/
+static inline uint32_t getSegCacheIndex(bool isr)
+{
+#ifdef CONFIG_SMP
+  return up_cpu_index() * 2 + (isr ? 1 : 0);
+#else
+  return isr ? 1 : 0;
+#endif
+}
+
+/*****************************************************************
+ * Get a segment from the cache of the current context
+ *****************************************************************/
+MemHandleProxy MemPool::allocSegCached()
+{
+  SegCacheLock lock;
+  SegCache& cache = m_seg_cache[getSegCacheIndex(lock.isIsr())];
+
+  if (cache.count == 0)
+    {
+      refillSegCache(cache, lock.isIsr());
+
+      if (cache.count == 0)
+        {
+          return 0;
+        }
+    }
+
+  NumSeg seg_no = cache.segs[--cache.count];
+
+  D_ASSERT(m_ref_cnt_array[seg_no - 1] == 0);  /* It should be unused. */
+  __atomic_store_n(&m_ref_cnt_array[seg_no - 1], 1, __ATOMIC_RELEASE);
+
+  return MemHandleBase::makeMemHandleProxy(getPoolId(), seg_no, 0);
+}
+
+/*****************************************************************
+ * Subtract the reference counter and put the segment into
+ * the cache of the current context if there is no reference.
+ *****************************************************************/
+void MemPool::freeSegCached(MemHandleBase& mh)
+{
+  NumSeg seg_no = mh.getSegNo();
+  D_ASSERT(seg_no != NullSegNo && seg_no <= getPoolNumSegs());
+  D_ASSERT(m_ref_cnt_array[seg_no - 1] != 0);  /* It should be in use. */
+
+  if (__atomic_sub_fetch(&m_ref_cnt_array[seg_no - 1], 1, __ATOMIC_ACQ_REL) == 0)
+    {
+      SegCacheLock lock;
+      SegCache& cache = m_seg_cache[getSegCacheIndex(lock.isIsr())];
+
+      if (cache.count == MEMMGR_SEG_CACHE_DEPTH)
+        {
+          drainSegCache(cache, lock.isIsr());
+        }
+
+      cache.segs[cache.count++] = seg_no;
+    }
+
+  mh.clear();
+}
+
+/*****************************************************************
+ * Move segments from the segment number queue to the cache.
+ * If the queue is empty in the task context, take the segments
+ * held by the interrupt context cache of the same CPU instead.
+ * It can be touched safely while interrupts are disabled.
+ * In the interrupt context, SegCacheLock has already disabled
+ * interrupts. ScopedLock is not taken there, because it enables
+ * interrupts on release regardless of the previous state.
+ *****************************************************************/
+void MemPool::refillSegCache(SegCache& cache, bool isr)
+{
+  if (isr)
+    {
+      moveToSegCache(cache);
+      return;
+    }
+
+  ScopedLock lock;
+
+  moveToSegCache(cache);
+
+  if (cache.count == 0)
+    {
+      SegCache& isr_cache = m_seg_cache[getSegCacheIndex(true)];
+
+      while (cache.count < SEG_CACHE_BATCH && isr_cache.count != 0)
+        {
+          cache.segs[cache.count++] = isr_cache.segs[--isr_cache.count];
+        }
+    }
+}
+
+/*****************************************************************
+ * Move segments from the cache to the segment number queue
+ *****************************************************************/
+void MemPool::drainSegCache(SegCache& cache, bool isr)
+{
+  if (isr)
+    {
+      moveFromSegCache(cache);
+      return;
+    }
+
+  ScopedLock lock;
+
+  moveFromSegCache(cache);
+}
+
+/*****************************************************************
+ * Move a batch of segments between the segment number queue and
+ * the cache. Exclusive control should be done on the caller side.
+ *****************************************************************/
+void MemPool::moveToSegCache(SegCache& cache)
+{
+  while (cache.count < SEG_CACHE_BATCH && !m_seg_no_que.empty())
+    {
+      cache.segs[cache.count++] = m_seg_no_que.top();
+      m_seg_no_que.pop();
+    }
+}
+
+void MemPool::moveFromSegCache(SegCache& cache)
+{
+  while (cache.count > MEMMGR_SEG_CACHE_DEPTH - SEG_CACHE_BATCH)
+    {
+      D_ASSERT(m_seg_no_que.full() == false);
+      (void)m_seg_no_que.push(cache.segs[--cache.count]);
+    }
+}
+
+/*****************************************************************
+ * Return all cached segments to the segment number queue.
+ * Exclusive control should be done on the caller side.
+ *****************************************************************/
+void MemPool::flushSegCache()
+{
+  for (uint32_t i = 0; i < MEMMGR_NUM_SEG_CACHES; ++i)
+    {
+      SegCache& cache = m_seg_cache[i];
+
+      while (cache.count != 0)
+        {
+          (void)m_seg_no_que.push(cache.segs[--cache.count]);
+        }
+    }
+}
+
+/*****************************************************************
+ * Number of available segments, including the cached ones.
+ * The queue and the caches are read under the pool lock, so that
+ * a segment moved between them is not counted twice or missed.
+ *****************************************************************/
+NumSeg MemPool::getPoolNumAvailSegs() const
+{
+#ifdef USE_MEMMGR_MULTI_CORE
+  ScopedLock lock(getPoolLockId());
+#else
+  ScopedLock lock;
+#endif
+
+  return static_cast<NumSeg>(m_seg_no_que.size() + getNumCachedSegs());
+}
+
+/*****************************************************************
+ * Number of segments held by all caches
+ *****************************************************************/
+NumSeg MemPool::getNumCachedSegs() const
+{
+  uint32_t num = 0;
+
+  for (uint32_t i = 0; i < MEMMGR_NUM_SEG_CACHES; ++i)
+    {
+      num += m_seg_cache[i].count;
+    }
+
+  return static_cast<NumSeg>(num);
+}
+
+} /* end of namespace MemMgrLite */
+
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE */
+
+/* segCache.cxx */
@@ -53,6 +53,32 @@ UseSegThreshold     = false
 UseRingBufPool      = false
 UseRingBufThreshold = false
 
+#####################################################################
+# Parameters of segment cache
+#
+# Set the same values as CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE,
+# CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE_DEPTH and CONFIG_SMP_NCPUS
+# (1 if CONFIG_SMP is not set) in the config file.
+# NumSegCaches is 2 (task and interrupt context) per CPU.
+#
+
+UseSegCache         = false if !defined?(UseSegCache)
+SegCacheDepth       = 4     if !defined?(SegCacheDepth)
+SmpNumCpus          = 1     if !defined?(SmpNumCpus)
+NumSegCaches        = 2 * SmpNumCpus
+
+#####################################################################
+# Parameters of variable size pool
+#
+# Set the same values as CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_POOL,
+# CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_MIN_ORDER and
+# CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_NUM_CLASSES in the config file.
+#
+
+UseVarSizePool      = false if !defined?(UseVarSizePool)
+VarSizeMinOrder     = 6     if !defined?(VarSizeMinOrder)
+VarSizeNumClasses   = 12    if !defined?(VarSizeNumClasses)
+
 #####################################################################
 # Fixed parameters of pool layout
 #
@@ -79,6 +105,7 @@ EnableOutputMacro = false
 
 Basic   = "BasicType"
 RingBuf = "RingBufType"
+VarSize = "VarSizeType"
 
 MinNameSize   = 3
 FenceSize     = 4
@@ -360,7 +387,8 @@ class PoolEntry < BaseEntry
     abort("Area not found at #{name}")         if !area_entry
     abort("Not RAM area found at #{name}")     if !area_entry.dev_entry.ram
     abort("Redefine name found at #{name}")    if MemoryDevices[name]
-    abort("Bad pool type found at #{name}")    if type != Basic and type != RingBuf
+    abort("Bad pool type found at #{name}")    if type != Basic and type != RingBuf and type != VarSize
+    abort("Don't use VarSize type at #{name}") if type == VarSize and !UseVarSizePool
     abort("Don't use RingBuf type at #{name}") if type == RingBuf and !UseRingBufPool
     abort("Bad pool align found at #{name}")   if align % MinAlign != 0 or align == 0
     abort("Too big pool align at #{name}")     if align >= area_entry.last_addr
@@ -383,9 +411,9 @@ end
 
 #######################################################################
 class PoolEntryFixParam < BaseEntry
-  def initialize(name, area, align, size, seg, fence)
+  def initialize(name, area, align, size, seg, fence, type = Basic)
     @area_entry = FixedAreas[area]
-    @type = Basic
+    @type = type
     @align = align
     @num_seg = seg
     @skip_size = 0
@@ -396,6 +424,8 @@ class PoolEntryFixParam < BaseEntry
     abort("Area not found at #{name}")         if !area_entry
     abort("Not RAM area found at #{name}")     if !area_entry.dev_entry.ram
     abort("Redefine name found at #{name}")    if MemoryDevices[name]
+    abort("Bad pool type found at #{name}")    if type != Basic and type != VarSize
+    abort("Don't use VarSize type at #{name}") if type == VarSize and !UseVarSizePool
     abort("Bad pool align found at #{name}")   if align % MinAlign != 0 or align == 0
     abort("Too big pool align at #{name}")     if align >= area_entry.last_addr
     if size != RemainderSize
@@ -421,6 +451,10 @@ end
 #  - RingBufPool area                              : To be determined(MemPool Area+alpha)
 #  - Data area of the segment number queue         : Number of segments * sizeof(NumSeg)
 #  - Reference counter area                        : Number of segments * sizeof(SegRefCnt)
+#  - Segment cache area (UseSegCache only)         : Number of caches * (depth + 1) * sizeof(NumSeg)
+#  - VarSizePool area                              : MemPool area + 12 + 4 * number of size classes
+#  - Segment descriptor area (VarSizePool only)    : 0-3 + Number of segments * 8
+#  - Free block bitmap area (VarSizePool only)     : 4 * ((pool size / min segment size + 31) / 32)
 NumSegSize              = UseOver255Segments ? 2 : 1
 SegRefCntSize           = 1
 PoolAttrSize            = round_up(10 + NumSegSize + (UseFence ? 1 : 0) + (UseMultiCore ? 1 : 0), 4)
@@ -428,6 +462,16 @@ MemPoolDataSize         = 12 + 4 * NumSegSize   # 16 or 20
 BasicPoolDataSize       = MemPoolDataSize
 RingBufPoolDataSize     = MemPoolDataSize + 32  # Tentative value for details unexamined
 RingBufPoolSegDataSize  = 8                     # Tentative value for details unexamined
+SegCacheDataSize        = UseSegCache ? (4 + (NumSegSize - 1) + NumSegCaches * (SegCacheDepth + 1) * NumSegSize) : 0
+VarSizePoolDataSize     = MemPoolDataSize + 12 + 4 * VarSizeNumClasses
+VarSizeSegDescSize      = 8
+
+#######################################################################
+def var_size_pool_work_size(pool)
+  work_size  = 3 + pool.num_seg * VarSizeSegDescSize
+  work_size += 4 * (((pool.size >> VarSizeMinOrder) + 31) / 32)
+  return work_size
+end
 
 #######################################################################
 class PoolLayout
@@ -460,9 +504,16 @@ class PoolLayout
     layout_work_size = 0
     @pools.each do |pool|
       pool_work_size = (UseCopiedPoolAttr) ? PoolAttrSize : 0
-      pool_work_size += (pool.type == Basic) ? BasicPoolDataSize : RingBufPoolDataSize
+      if pool.type == Basic
+        pool_work_size += BasicPoolDataSize
+      elsif pool.type == VarSize
+        pool_work_size += VarSizePoolDataSize + var_size_pool_work_size(pool)
+      else
+        pool_work_size += RingBufPoolDataSize
+      end
       pool_work_size += pool.num_seg * NumSegSize    # Data area of the segment number queue
       pool_work_size += pool.num_seg * SegRefCntSize # Reference counter area
+      pool_work_size += SegCacheDataSize             # Segment cache area
       # Round up to the MinAlign unit and integrate
       layout_work_size += round_up(pool_work_size, MinAlign)
     end
@@ -513,7 +564,7 @@ class PoolAreas
       io.print("#define NUM_DYN_POOLS  #{NumDynamicPools}\n")
       io.print("#define DYN_POOL_WORK_SIZE(attr) \\\n")
       io.print(" ROUND_UP(sizeof(MemMgrLite::PoolAttr) + #{BasicPoolDataSize} +")
-      io.print(" #{NumSegSize} * (attr).num_segs + #{SegRefCntSize} * (attr).num_segs, 4)\n")
+      io.print(" #{NumSegSize} * (attr).num_segs + #{SegRefCntSize} * (attr).num_segs + #{SegCacheDataSize}, 4)\n")
     end
 
     io.print("\n/*\n * Pool areas\n */\n")
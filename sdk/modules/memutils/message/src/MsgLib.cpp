@@ -145,6 +145,10 @@ err_t MsgLib::initPerCpu()
   uint32_t context   = 0;
   bool     init_done = false;
 
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+  MsgQueStats::init();
+#endif
+
   Chateau_LockInterrupt(&context);
   const FAR MsgQueDef* src = MsgqPoolDefs;
   MsgQueBlock* mqb = static_cast<FAR MsgQueBlock*>(DRM_TO_CACHED_VA(msgq_top_drm));
@@ -0,0 +1,164 @@
+/****************************************************************************
+ * modules/memutils/message/src/MsgStats.cpp
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include "memutils/message/Message.h"
+#include "memutils/message/msgq_stats.h"
+
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+
+/* Statistics of each message queue ID. (Index 0 is not used)
+ * Local to this CPU. See MsgQueStats for what each CPU records.
+ */
+
+static MsgQueStats s_msgq_stats[CONFIG_MEMUTILS_MESSAGE_STATS_NUM_QUEUES];
+
+uint32_t MsgQueStats::s_cycles_per_us = 1;
+
+/*****************************************************************
+ * Start the cycle counter used for the time stamp of push
+ *****************************************************************/
+void MsgQueStats::init()
+{
+  up_perf_init(NULL);
+
+  s_cycles_per_us = up_perf_getfreq() / 1000000;
+  if (s_cycles_per_us == 0)
+    {
+      s_cycles_per_us = 1;
+    }
+}
+
+/*****************************************************************
+ * Get the statistics of the message queue
+ *****************************************************************/
+MsgQueStats* MsgQueStats::get(uint16_t id)
+{
+  if (id >= CONFIG_MEMUTILS_MESSAGE_STATS_NUM_QUEUES)
+    {
+      return NULL;
+    }
+
+  return &s_msgq_stats[id];
+}
+
+/*****************************************************************
+ * Dump display of the statistics
+ *****************************************************************/
+void MsgQueStats::dump(uint16_t id) const
+{
+  static const char* pri_name[NumMsgPri] = { "normal", "high" };
+
+  printf("ID:%d\n", id);
+
+  for (int pri = 0; pri < NumMsgPri; ++pri)
+    {
+      if (recv_count[pri] == 0 && high_water[pri] == 0)
+        {
+          continue;
+        }
+
+      printf("  %s: recv=%u, high_water=%u, max_latency=%uus\n",
+        pri_name[pri], recv_count[pri], high_water[pri], max_latency[pri]);
+      printf("    latency(<2^n us):");
+      for (int bin = 0; bin < MSG_STATS_LATENCY_BINS; ++bin)
+        {
+          printf(" %u", latency[pri][bin]);
+        }
+      printf("\n");
+    }
+
+  for (uint16_t i = 0; i < num_types; ++i)
+    {
+      printf("  type=%04x: %u\n", types[i].type, types[i].count);
+    }
+
+  if (other_types != 0)
+    {
+      printf("  other types: %u\n", other_types);
+    }
+}
+
+/*****************************************************************
+ * Dump display of the statistics of all message queues
+ *****************************************************************/
+err_t MsgLib::dumpStats(bool clear)
+{
+  if (msgq_top_drm == 0)
+    {
+      return ERR_STS;
+    }
+
+  printf("Statistics recorded on CPU%d\n", GET_CPU_ID());
+
+  for (uint32_t id = 1; id < num_msg_pools; ++id)
+    {
+      MsgQueStats* stats = MsgQueStats::get(id);
+      if (stats == NULL)
+        {
+          printf("ID:%d and later are out of the statistics table\n", id);
+          break;
+        }
+
+      stats->dump(id);
+
+      if (clear)
+        {
+          uint32_t context = 0;
+
+          Chateau_LockInterrupt(&context);
+          stats->clear();
+          Chateau_UnlockInterrupt(&context);
+        }
+    }
+
+  return ERR_OK;
+}
+
+#endif /* CONFIG_MEMUTILS_MESSAGE_STATS */
+
+/*****************************************************************
+ * C interface for the statistics command
+ *****************************************************************/
+extern "C" int msgq_stats_dump(bool clear)
+{
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+  return MsgLib::dumpStats(clear);
+#else
+  return ERR_STS;
+#endif
+}
+
+/* end of MsgStats.cpp */
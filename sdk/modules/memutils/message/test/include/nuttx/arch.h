@@ -0,0 +1,52 @@
+/****************************************************************************
+ * modules/memutils/message/test/include/nuttx/arch.h
+ *
+ *   Copyright 2026 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Interrupt and scheduler control used by chateau_osal.h. The test runs
+ * in a single task, so there is nothing to lock.
+ */
+
+#ifndef __TEST_INCLUDE_NUTTX_ARCH_H
+#define __TEST_INCLUDE_NUTTX_ARCH_H
+
+#include <stdbool.h>
+
+static inline void up_irq_disable(void) {}
+static inline void up_irq_enable(void) {}
+static inline void up_enable_irq(int irq) {}
+static inline void up_disable_irq(int irq) {}
+static inline bool up_interrupt_context(void) { return false; }
+static inline int sched_lock(void) { return 0; }
+static inline int sched_unlock(void) { return 0; }
+
+#endif /* __TEST_INCLUDE_NUTTX_ARCH_H */
@@ -0,0 +1,49 @@
+/****************************************************************************
+ * modules/memutils/message/test/include/sdk/config.h
+ *
+ *   Copyright 2026 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Configuration of the host test. The test runs MemMgrLite and MsgLib
+ * in a single task on the host, on behalf of NuttX.
+ */
+
+#ifndef __TEST_INCLUDE_SDK_CONFIG_H
+#define __TEST_INCLUDE_SDK_CONFIG_H
+
+#define FAR
+
+#define CONFIG_MEMUTILS_MEMORY_MANAGER 1
+#define CONFIG_MEMUTILS_MEMORY_MANAGER_USE_FENCE 1
+#define CONFIG_MEMUTILS_MEMORY_MANAGER_NUM_FIXED_AREA_FENCES 0
+#define CONFIG_MEMUTILS_MESSAGE 1
+
+#endif /* __TEST_INCLUDE_SDK_CONFIG_H */
@@ -0,0 +1,91 @@
+/****************************************************************************
+ * modules/memutils/message/test/include/semaphore.h
+ *
+ *   Copyright 2026 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Counting semaphore with the semcount member of NuttX sem_t, which
+ * MsgQueBlock clears directly. Waiting never blocks, since the test
+ * receives only the messages it has sent from the same task.
+ */
+
+#ifndef __TEST_INCLUDE_SEMAPHORE_H
+#define __TEST_INCLUDE_SEMAPHORE_H
+
+#include <errno.h>
+#include <stdint.h>
+#include <time.h>
+
+typedef struct
+{
+  volatile int16_t semcount;
+} sem_t;
+
+static inline int sem_init(sem_t *sem, int pshared, unsigned int value)
+{
+  sem->semcount = value;
+  return 0;
+}
+
+static inline int sem_destroy(sem_t *sem)
+{
+  return 0;
+}
+
+static inline int sem_post(sem_t *sem)
+{
+  sem->semcount++;
+  return 0;
+}
+
+static inline int sem_trywait(sem_t *sem)
+{
+  if (sem->semcount <= 0)
+    {
+      errno = EAGAIN;
+      return -1;
+    }
+
+  sem->semcount--;
+  return 0;
+}
+
+static inline int sem_wait(sem_t *sem)
+{
+  return sem_trywait(sem);
+}
+
+static inline int sem_timedwait(sem_t *sem, const struct timespec *abstime)
+{
+  return sem_trywait(sem);
+}
+
+#endif /* __TEST_INCLUDE_SEMAPHORE_H */
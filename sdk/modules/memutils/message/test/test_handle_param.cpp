@@ -0,0 +1,488 @@
+/****************************************************************************
+ * modules/memutils/message/test/test_handle_param.cpp
+ *
+ *   Copyright 2026 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <sys/mman.h>
+
+#include "memutils/memory_manager/MemHandle.h"
+#include "memutils/message/Message.h"
+
+using namespace MemMgrLite;
+
+/* Memory layout of the test. The message queue and the memory manager
+ * keep addresses in 32 bits, so they are placed in an area mapped at a
+ * fixed address below 4GB.
+ */
+
+#define TEST_AREA_ADDR        0x20000000
+#define TEST_AREA_SIZE        0x00010000
+
+#define MSGQ_TOP_DRM          TEST_AREA_ADDR
+#define MSGQ_TEST_N_QUE_DRM   (TEST_AREA_ADDR + 0x1000)
+#define MSGQ_TEST_N_SIZE      64
+#define MSGQ_TEST_N_NUM       4
+
+#define MEMMGR_DATA_AREA_ADDR (TEST_AREA_ADDR + 0x2000)
+#define MEMMGR_DATA_AREA_SIZE 0x1000
+#define MEMMGR_WORK_AREA_ADDR (TEST_AREA_ADDR + 0x3000)
+#define MEMMGR_WORK_AREA_SIZE 0x1000
+
+#define PARAM_POOL_ADDR       (TEST_AREA_ADDR + 0x4000)
+#define PARAM_POOL_NUM_SEG    2
+#define PARAM_POOL_SEG_SIZE   64
+#define PCM_POOL_ADDR         (TEST_AREA_ADDR + 0x5000)
+#define PCM_POOL_NUM_SEG      4
+#define PCM_POOL_SEG_SIZE     256
+
+#define MSGQ_NULL             0
+#define MSGQ_TEST             1
+#define NUM_MSGQ_POOLS        2
+
+#define MSG_TEST_DATA         0x0101
+
+#define SECTION_NO0           0
+#define NUM_MEM_SECTIONS      1
+#define NUM_MEM_POOLS         3
+
+#define CHECK(cond)                                                         \
+  do {                                                                      \
+    if (!(cond)) {                                                          \
+      printf("%s:%d: %s: check failed: %s\n", __FILE__, __LINE__,          \
+             s_case, #cond);                                                \
+      s_failed++;                                                           \
+    }                                                                       \
+  } while (0)
+
+/* Same shape as AsPcmDataParam, which holds the handle of pcm data. */
+
+struct TestPcmParam
+{
+  MemHandle mh;
+  uint32_t  size;
+  bool      is_end;
+};
+
+extern const MsgQueDef MsgqPoolDefs[NUM_MSGQ_POOLS] =
+{
+  /* n_drm, n_size, n_num, h_drm, h_size, h_num */
+  { 0x00000000, 0, 0, 0x00000000, 0, 0, 0 }, /* MSGQ_NULL */
+  { MSGQ_TEST_N_QUE_DRM, MSGQ_TEST_N_SIZE, MSGQ_TEST_N_NUM,
+    0xffffffff, 0, 0 },                      /* MSGQ_TEST */
+};
+
+static const PoolId s_param_pool = { 1, SECTION_NO0 };
+static const PoolId s_pcm_pool   = { 2, SECTION_NO0 };
+
+static const PoolSectionAttr s_pool_attr[NUM_MEM_POOLS] =
+{
+  /* pool_ID     type       seg                 fence  addr */
+  { s_param_pool, BasicType, PARAM_POOL_NUM_SEG, false, PARAM_POOL_ADDR,
+    PARAM_POOL_NUM_SEG * PARAM_POOL_SEG_SIZE },
+  { s_pcm_pool,   BasicType, PCM_POOL_NUM_SEG,   false, PCM_POOL_ADDR,
+    PCM_POOL_NUM_SEG * PCM_POOL_SEG_SIZE },
+  { NullPoolId, 0, 0, false, 0, 0 },
+};
+
+/* What pool_layout.h and fixed_fence.h generated for an application
+ * define.
+ */
+
+namespace MemMgrLite {
+
+MemPool  *static_pools_block[NUM_MEM_SECTIONS][NUM_MEM_POOLS];
+MemPool **static_pools[NUM_MEM_SECTIONS] = { static_pools_block[0] };
+uint8_t   layout_no[NUM_MEM_SECTIONS] = { BadLayoutNo };
+uint8_t   pool_num[NUM_MEM_SECTIONS] = { NUM_MEM_POOLS };
+
+extern PoolAddr const FixedAreaFences[] = {
+};
+
+}  /* end of namespace MemMgrLite */
+
+static MsgQueBlock *s_que;
+static const char  *s_case;
+static int          s_failed;
+
+static bool init_libraries(void)
+{
+  void *area = mmap((void *)TEST_AREA_ADDR, TEST_AREA_SIZE,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                    -1, 0);
+  if (area != (void *)TEST_AREA_ADDR)
+    {
+      printf("cannot map the test area at 0x%08x\n", TEST_AREA_ADDR);
+      return false;
+    }
+
+  if (MsgLib::initFirst(NUM_MSGQ_POOLS, MSGQ_TOP_DRM) != ERR_OK ||
+      MsgLib::initPerCpu() != ERR_OK ||
+      MsgLib::referMsgQueBlock(MSGQ_TEST, &s_que) != ERR_OK)
+    {
+      printf("cannot initialize MsgLib\n");
+      return false;
+    }
+
+  void *data_area = translatePoolAddrToVa(MEMMGR_DATA_AREA_ADDR);
+
+  if (Manager::initFirst(data_area, MEMMGR_DATA_AREA_SIZE) != ERR_OK ||
+      Manager::initPerCpu(data_area, static_pools, pool_num,
+                          layout_no) != ERR_OK ||
+      Manager::createStaticPools(SECTION_NO0, 0,
+                                 translatePoolAddrToVa(MEMMGR_WORK_AREA_ADDR),
+                                 MEMMGR_WORK_AREA_SIZE,
+                                 s_pool_attr) != ERR_OK)
+    {
+      printf("cannot initialize MemMgrLite\n");
+      return false;
+    }
+
+  return true;
+}
+
+static FAR MsgPacket *recv_one(void)
+{
+  FAR MsgPacket *msg = NULL;
+
+  if (s_que->recv(0, &msg) != ERR_OK)
+    {
+      return NULL;
+    }
+
+  return msg;
+}
+
+static bool pools_are_free(void)
+{
+  return Manager::getPoolNumAvailSegs(s_param_pool) == PARAM_POOL_NUM_SEG &&
+         Manager::getPoolNumAvailSegs(s_pcm_pool) == PCM_POOL_NUM_SEG;
+}
+
+/* The packet holds a reference until pop() discards it. */
+
+static void test_send_handle(void)
+{
+  s_case = "send_handle";
+
+  {
+    MemHandle mh;
+
+    CHECK(mh.allocSeg(s_pcm_pool, PCM_POOL_SEG_SIZE) == ERR_OK);
+    static_cast<uint8_t *>(mh.getVa())[0] = 0x5a;
+
+    CHECK(MsgLib::sendByHandle(MSGQ_TEST, MsgPriNormal, MSG_TEST_DATA,
+                               MSGQ_NULL, mh) == ERR_OK);
+    CHECK(mh.getRefCnt() == 2);
+  }
+
+  FAR MsgPacket *msg = recv_one();
+
+  CHECK(msg != NULL);
+  if (msg == NULL)
+    {
+      return;
+    }
+
+  CHECK(msg->getType() == MSG_TEST_DATA);
+  CHECK(msg->isHandleParam());
+  CHECK(msg->peekHandle().getRefCnt() == 1);
+  CHECK(msg->peekParamByHandle<uint8_t>() == 0x5a);
+
+  CHECK(s_que->pop() == ERR_OK);
+  CHECK(pools_are_free());
+}
+
+/* moveHandle() hands the reference over to the receiver. */
+
+static void test_move_handle(void)
+{
+  s_case = "move_handle";
+
+  {
+    MemHandle mh;
+
+    CHECK(mh.allocSeg(s_pcm_pool, PCM_POOL_SEG_SIZE) == ERR_OK);
+    CHECK(MsgLib::sendByHandle(MSGQ_TEST, MsgPriNormal, MSG_TEST_DATA,
+                               MSGQ_NULL, mh) == ERR_OK);
+  }
+
+  FAR MsgPacket *msg = recv_one();
+
+  CHECK(msg != NULL);
+  if (msg == NULL)
+    {
+      return;
+    }
+
+  {
+    MemHandle taken = msg->moveHandle();
+
+    CHECK(msg->getParamSize() == 0);
+    CHECK(s_que->pop() == ERR_OK);
+    CHECK(taken.getRefCnt() == 1);
+    CHECK(Manager::getPoolNumAvailSegs(s_pcm_pool) == PCM_POOL_NUM_SEG - 1);
+  }
+
+  CHECK(pools_are_free());
+}
+
+/* An object sent with a pool id is copied into a segment of the pool.
+ * The handle it holds is passed on to the receiver with it.
+ */
+
+static void test_send_object(void)
+{
+  s_case = "send_object";
+
+  {
+    TestPcmParam param;
+
+    CHECK(param.mh.allocSeg(s_pcm_pool, PCM_POOL_SEG_SIZE) == ERR_OK);
+    param.size   = 128;
+    param.is_end = true;
+
+    CHECK(MsgLib::sendByHandle<TestPcmParam>(MSGQ_TEST,
+                                             MsgPriNormal,
+                                             MSG_TEST_DATA,
+                                             MSGQ_NULL,
+                                             s_param_pool,
+                                             param) == ERR_OK);
+    CHECK(param.mh.getRefCnt() == 2);
+    CHECK(Manager::getPoolNumAvailSegs(s_param_pool) ==
+          PARAM_POOL_NUM_SEG - 1);
+  }
+
+  FAR MsgPacket *msg = recv_one();
+
+  CHECK(msg != NULL);
+  if (msg == NULL)
+    {
+      return;
+    }
+
+  CHECK(msg->isHandleParam());
+  CHECK(msg->peekParamByHandle<TestPcmParam>().mh.getRefCnt() == 1);
+
+  {
+    TestPcmParam param = msg->moveParamByHandle<TestPcmParam>();
+
+    CHECK(param.size == 128);
+    CHECK(param.is_end);
+    CHECK(param.mh.getRefCnt() == 1);
+    CHECK(Manager::getPoolNumAvailSegs(s_param_pool) == PARAM_POOL_NUM_SEG);
+    CHECK(s_que->pop() == ERR_OK);
+    CHECK(param.mh.getRefCnt() == 1);
+  }
+
+  CHECK(pools_are_free());
+}
+
+/* pop() destructs an object which the receiver did not take out,
+ * so the handle it holds is released as well.
+ */
+
+static void test_pop_object(void)
+{
+  s_case = "pop_object";
+
+  {
+    TestPcmParam param;
+
+    CHECK(param.mh.allocSeg(s_pcm_pool, PCM_POOL_SEG_SIZE) == ERR_OK);
+    CHECK(MsgLib::sendByHandle<TestPcmParam>(MSGQ_TEST,
+                                             MsgPriNormal,
+                                             MSG_TEST_DATA,
+                                             MSGQ_NULL,
+                                             s_param_pool,
+                                             param) == ERR_OK);
+  }
+
+  FAR MsgPacket *msg = recv_one();
+
+  CHECK(msg != NULL);
+  if (msg == NULL)
+    {
+      return;
+    }
+
+  CHECK(msg->peekParamByHandle<TestPcmParam>().mh.getRefCnt() == 1);
+  CHECK(s_que->pop() == ERR_OK);
+  CHECK(pools_are_free());
+}
+
+/* Without a free segment, nothing is sent and no reference is left. */
+
+static void test_pool_empty(void)
+{
+  s_case = "pool_empty";
+
+  MemHandle    fill[PARAM_POOL_NUM_SEG];
+  TestPcmParam param;
+
+  for (int i = 0; i < PARAM_POOL_NUM_SEG; i++)
+    {
+      CHECK(fill[i].allocSeg(s_param_pool, PARAM_POOL_SEG_SIZE) == ERR_OK);
+    }
+
+  CHECK(param.mh.allocSeg(s_pcm_pool, PCM_POOL_SEG_SIZE) == ERR_OK);
+  CHECK(MsgLib::sendByHandle<TestPcmParam>(MSGQ_TEST,
+                                           MsgPriNormal,
+                                           MSG_TEST_DATA,
+                                           MSGQ_NULL,
+                                           s_param_pool,
+                                           param) == ERR_MEM_EMPTY);
+  CHECK(param.mh.getRefCnt() == 1);
+  CHECK(recv_one() == NULL);
+}
+
+/* popBatch() releases parameters left in the discarded packets and
+ * leaves the rest of the batch to be received again.
+ */
+
+static void test_pop_batch(void)
+{
+  s_case = "pop_batch";
+
+  FAR MsgPacket *msg[MSG_RECV_BATCH_NUM];
+  uint16_t       num = 0;
+
+  {
+    TestPcmParam param;
+
+    CHECK(param.mh.allocSeg(s_pcm_pool, PCM_POOL_SEG_SIZE) == ERR_OK);
+    CHECK(MsgLib::sendByHandle<TestPcmParam>(MSGQ_TEST,
+                                             MsgPriNormal,
+                                             MSG_TEST_DATA,
+                                             MSGQ_NULL,
+                                             s_param_pool,
+                                             param) == ERR_OK);
+  }
+
+  for (uint32_t data = 2; data <= 3; data++)
+    {
+      CHECK(MsgLib::send<uint32_t>(MSGQ_TEST,
+                                   MsgPriNormal,
+                                   MSG_TEST_DATA,
+                                   MSGQ_NULL,
+                                   data) == ERR_OK);
+    }
+
+  CHECK(s_que->recvBatch(0, msg, MSG_RECV_BATCH_NUM, &num) == ERR_OK);
+  CHECK(num == 3);
+  if (num != 3)
+    {
+      return;
+    }
+
+  CHECK(!s_que->hasNewHighMsg(msg, num));
+
+  /* Neither parameter is taken by the receiver. */
+
+  CHECK(s_que->popBatch(msg, num, 2) == ERR_OK);
+  CHECK(pools_are_free());
+
+  FAR MsgPacket *rest = recv_one();
+
+  CHECK(rest != NULL);
+  if (rest == NULL)
+    {
+      return;
+    }
+
+  CHECK(rest->moveParam<uint32_t>() == 3);
+  CHECK(s_que->pop() == ERR_OK);
+  CHECK(recv_one() == NULL);
+}
+
+/* The copying path is left as it is. */
+
+static void test_send_copy(void)
+{
+  s_case = "send_copy";
+
+  {
+    TestPcmParam param;
+
+    CHECK(param.mh.allocSeg(s_pcm_pool, PCM_POOL_SEG_SIZE) == ERR_OK);
+    param.size   = 64;
+    param.is_end = false;
+
+    CHECK(MsgLib::send<TestPcmParam>(MSGQ_TEST,
+                                     MsgPriNormal,
+                                     MSG_TEST_DATA,
+                                     MSGQ_NULL,
+                                     param) == ERR_OK);
+    CHECK(param.mh.getRefCnt() == 2);
+  }
+
+  FAR MsgPacket *msg = recv_one();
+
+  CHECK(msg != NULL);
+  if (msg == NULL)
+    {
+      return;
+    }
+
+  CHECK(!msg->isHandleParam());
+
+  {
+    TestPcmParam param = msg->moveParam<TestPcmParam>();
+
+    CHECK(param.size == 64);
+    CHECK(param.mh.getRefCnt() == 1);
+    CHECK(s_que->pop() == ERR_OK);
+  }
+
+  CHECK(pools_are_free());
+}
+
+int main(void)
+{
+  if (!init_libraries())
+    {
+      return 1;
+    }
+
+  test_send_handle();
+  test_move_handle();
+  test_send_object();
+  test_pop_object();
+  test_pool_empty();
+  CHECK(pools_are_free());
+  test_send_copy();
+  test_pop_batch();
+
+  printf("test_handle_param: %s\n", s_failed ? "FAILED" : "PASSED");
+  return s_failed ? 1 : 0;
+}
@@ -183,6 +183,7 @@ def getMsgQueParam(line, dup_chk)
 	n_size	= line[1];
 	raise("Bad n_size at #{id}") if n_size < MIN_PACKET_SIZE or n_size > MAX_PACKET_SIZE or n_size % 4 != 0
 	n_size += 4 if MsgParamTypeMatchCheck == true and n_size > MIN_PACKET_SIZE
+	n_size += 4 if defined?(MsgStats) and MsgStats == true	# Time stamp in the packet header
 
 	n_num	= line[2];
 	raise("Bad n_num at #{id}") if n_num == 0 or n_num > MAX_PACKET_NUM
@@ -190,6 +191,7 @@ def getMsgQueParam(line, dup_chk)
 	h_size	= line[3];
 	raise("Bad h_size at #{id}") if h_size != 0 and (h_size < MIN_PACKET_SIZE or h_size > MAX_PACKET_SIZE or h_size % 4 != 0)
 	h_size += 4 if MsgParamTypeMatchCheck == true and h_size > MIN_PACKET_SIZE
+	h_size += 4 if defined?(MsgStats) and MsgStats == true and h_size != 0	# Time stamp in the packet header
 
 	h_num	= line[4];
 	raise("Bad h_num at #{id}") if h_num > MAX_PACKET_NUM or (h_size > 0 and h_num == 0) or (h_size == 0 and h_num > 0)
@@ -119,19 +119,33 @@ void SensorManager::run(void)
 {
   err_t        err_code;
   MsgQueBlock* que;
-  MsgPacket*   msg;
+  MsgPacket*   msg[MSG_RECV_BATCH_NUM];
+  uint16_t     num;
 
   err_code = MsgLib::referMsgQueBlock(m_selfMId, &que);
   F_ASSERT(err_code == ERR_OK);
 
   while(1)
     {
-      err_code = que->recv(TIME_FOREVER, &msg);
+      err_code = que->recvBatch(TIME_FOREVER, msg, MSG_RECV_BATCH_NUM, &num);
       F_ASSERT(err_code == ERR_OK);
 
-      parse(msg);
+      /* Stop the batch when a high priority message arrives.
+       * The rest of the batch is received again after it.
+       */
 
-      err_code = que->pop();
+      uint16_t done = 0;
+      while (done < num)
+        {
+          parse(msg[done++]);
+
+          if (done < num && que->hasNewHighMsg(msg, num))
+            {
+              break;
+            }
+        }
+
+      err_code = que->popBatch(msg, num, done);
       F_ASSERT(err_code == ERR_OK);
     }
 }
@@ -38,7 +38,6 @@
  ****************************************************************************/
 
 #include <stdio.h>
-#include <math.h>
 #include <debug.h>
 #include "sensing/tap.h"
 
@@ -204,6 +203,37 @@ int TapWrite(FAR TapClass *ins, FAR ST_TAP_ACCEL *accelData)
   return ret;
 }
 
+/****************************************************************************
+ * Name: TapWrite_block
+ *
+ * Description:
+ *   TapClass::write() call with a block of accel samples.
+ *
+ * Input Parameters:
+ *   TapClass*                  Object of TapClass.
+ *   sensor_command_data_mh_t*  Accel samples(ThreeAxisSample)
+ *   tapcnts                    tapcnt of each tap series
+ *   max_num                    Length of tapcnts
+ *
+ * Returned Value:
+ *   TapClass::write() result
+ *     D_SA_STATUS_E_INVALID_ARGS   Parameter error
+ *     num                          number of tap series in tapcnts
+ *
+ * Assumptions/Limitations:
+ *   -
+ *
+ ****************************************************************************/
+int TapWrite_block(FAR TapClass *ins, FAR sensor_command_data_mh_t *command,
+                   FAR int *tapcnts, int max_num)
+{
+  int ret = 0;
+
+  ret = ins->write(command, tapcnts, max_num);
+
+  return ret;
+}
+
 /****************************************************************************
  *Tap Class
  ****************************************************************************/
@@ -239,6 +269,7 @@ TapClass::TapClass()
   mIndex          = 0;
   mDetectionCount = 0;
   mStab           = 0;
+  mBlockStarted   = false;
 }
 
 /****************************************************************************
@@ -262,17 +293,20 @@ int TapClass::open(ST_TAP_OPEN *OpenParam)
 {
   _info("TapClass::open() called.\n");
 
-  /* Param Check */
+  /* Param Check
+   * Thresholds are compared as squared values, so they must not be
+   * negative. Written as negated ranges to reject NaN as well.
+   */
 
-  if (OpenParam->peak_thres < TAP_PEAK_THRES_MIN ||
-    OpenParam->peak_thres > TAP_PEAK_THRES_MAX)
+  if (!(OpenParam->peak_thres >= TAP_PEAK_THRES_MIN &&
+    OpenParam->peak_thres <= TAP_PEAK_THRES_MAX))
     {
       _err("[ERROR] peak_thres : %f\n", OpenParam->peak_thres);
       return D_SA_STATUS_E_INVALID_ARGS;
     }
 
-  if (OpenParam->long_thres < TAP_LONG_THRES_MIN ||
-    OpenParam->long_thres > TAP_LONG_THRES_MAX)
+  if (!(OpenParam->long_thres >= TAP_LONG_THRES_MIN &&
+    OpenParam->long_thres <= TAP_LONG_THRES_MAX))
     {
       _err("[ERROR] long_thres : %f\n", OpenParam->long_thres);
       return D_SA_STATUS_E_INVALID_ARGS;
@@ -291,6 +325,8 @@ int TapClass::open(ST_TAP_OPEN *OpenParam)
   mPeakThres  = OpenParam->peak_thres;
   mLongThres  = OpenParam->long_thres;
   mStabFrame  = OpenParam->stab_frame;
+  mPeakThres2 = mPeakThres * mPeakThres;
+  mLongThres2 = mLongThres * mLongThres;
   mTapCnt     = 0;
   mState      = E_TAP_STATE_IDLE;
 
@@ -305,6 +341,7 @@ int TapClass::open(ST_TAP_OPEN *OpenParam)
   mIndex          = 0;
   mDetectionCount = 0;
   mStab           = 0;
+  mBlockStarted   = false;
 
   return D_SA_STATUS_OK;
 }
@@ -356,8 +393,6 @@ int TapClass::write(ST_TAP_ACCEL* accelData)
   _info("TapClass::write(acc) called.\n");
   
   bool              detectflg     = false;
-  int               tapcnt        = 0;
-  uint64_t          elapsedTime   = 0;
   uint64_t          endTime       = 0;
   struct   timespec ts;
 
@@ -388,87 +423,8 @@ int TapClass::write(ST_TAP_ACCEL* accelData)
   detectflg = detect(accelData->accel_x, accelData->accel_y, accelData->accel_z);
 
   /* State determination */
-  
-  switch (mState){
-  case E_TAP_STATE_IDLE:
-    if(true == detectflg)
-      {
-
-        /* Detect Tap */
-
-        mTapCnt++;
-
-        /* Transition to tap state */
-
-        mState = E_TAP_STATE_TAP;
-
-        /* Time update */
-
-        mStartTime = endTime;
-      }
-    else
-      {
-
-        /* Notify number of taps */
-
-        tapcnt = mTapCnt;
-        mTapCnt = 0;
-      }
-    break;
-
-  case E_TAP_STATE_TAP:
-    
-    /* Calculate the time difference (Unit: microseconds) */
-
-    elapsedTime = endTime - mStartTime;
-    if (true == detectflg)
-      {
-
-        /* Detect Tap */
-
-        if (elapsedTime > mTapPeriod)
-          {
-
-            /* Notify the number of previous taps once and update it to 1 */
-
-            tapcnt = mTapCnt;
-            mTapCnt = 1;
 
-            /* Time update */
-
-            mStartTime = endTime;
-          } 
-        else
-          {
-
-            /* In time */
-            
-            mTapCnt++;
-
-            /* Time update */
-            
-            mStartTime = endTime;
-          }
-      }
-    else
-      {
-        if (elapsedTime > mTapPeriod)
-          {
-        
-            /* TimeOut */
-
-            tapcnt  = mTapCnt;
-            mTapCnt = 0;
-            mState  = E_TAP_STATE_IDLE;
-          }
-      }
-    break;
-  default:
-    break;
-  }
-
-  /* Return number of taps */
-  return tapcnt;
+  return update(detectflg, endTime);
 }
 
 /****************************************************************************
@@ -494,8 +450,6 @@ int TapClass::write(ST_TAP_ACCEL* accelData)
 int TapClass::write(ST_TAP_ACCEL *accelData, uint64_t time_stamp)
 {
   bool detectflg         = false;
-  int tapcnt             = 0;
-  uint64_t elapsedTime   = 0;
   uint64_t endTime       = time_stamp;
 
   _info("accel_x %.3f accel_y %.3f accel_z %.3f timestamp %llu \n",
@@ -515,8 +469,177 @@ int TapClass::write(ST_TAP_ACCEL *accelData, uint64_t time_stamp)
   detectflg = detect(accelData->accel_x, accelData->accel_y, accelData->accel_z);
 
   /* State determination */
-  
-  switch (mState){
+
+  return update(detectflg, endTime);
+}
+
+/****************************************************************************
+ * Name: write
+ *
+ * Description:
+ *   Detect tap from a block of accel samples.
+ *
+ * Input Parameters:
+ *   ThreeAxisSample*    Accel samples
+ *   sample_num          Number of samples
+ *   time_stamp          (usec) Time stamp of the first sample
+ *   fs                  (Hz) Sampling rate
+ *   tapcnts             tapcnt of each tap series which ends in the block
+ *   max_num             Length of tapcnts
+ *
+ * Returned Value:
+ *   D_SA_STATUS_E_INVALID_ARGS   Parameter error
+ *   num                          number of tap series in tapcnts
+ *
+ * Assumptions/Limitations:
+ *   Samples must be consecutive, because the time stamp of each sample
+ *   is calculated from its index. Series beyond max_num are dropped.
+ *
+ ****************************************************************************/
+int TapClass::write(FAR const ThreeAxisSample *data, int sample_num,
+                    uint64_t time_stamp, int fs, FAR int *tapcnts,
+                    int max_num)
+{
+  float r2[TAP_BUF_LEN];
+  int   series = 0;
+  int   cnt;
+  int   num;
+
+  if (NULL == data || sample_num < 0 || fs <= 0 ||
+      NULL == tapcnts || max_num < 0)
+    {
+      _err("Invalid block. data %p num %d fs %d\n", data, sample_num, fs);
+      return D_SA_STATUS_E_INVALID_ARGS;
+    }
+
+  for (int base = 0; base < sample_num; base += TAP_BUF_LEN)
+    {
+      num = sample_num - base;
+      if (num > TAP_BUF_LEN)
+        {
+          num = TAP_BUF_LEN;
+        }
+
+      /* Squared magnitude of each sample. This pass has no dependency
+       * between samples, so that the compiler can vectorize it.
+       */
+
+      for (int i = 0; i < num; i++)
+        {
+          r2[i] = data[base + i].ax * data[base + i].ax +
+                  data[base + i].ay * data[base + i].ay +
+                  data[base + i].az * data[base + i].az;
+        }
+
+      for (int i = 0; i < num; i++)
+        {
+          bool detectflg = detect2(data[base + i].ax,
+                                   data[base + i].ay,
+                                   data[base + i].az,
+                                   r2[i]);
+
+          cnt = update(detectflg,
+                       time_stamp +
+                       (uint64_t)(base + i) * SEC_PER_US / fs);
+          if (cnt > 0)
+            {
+              if (series < max_num)
+                {
+                  tapcnts[series++] = cnt;
+                }
+              else
+                {
+                  _warn("tap series dropped. tapcnt %d\n", cnt);
+                }
+            }
+        }
+    }
+
+  return series;
+}
+
+/****************************************************************************
+ * Name: write
+ *
+ * Description:
+ *   Detect tap from accel samples sent by the sensor manager.
+ *
+ * Input Parameters:
+ *   sensor_command_data_mh_t*  Accel samples(ThreeAxisSample)
+ *   tapcnts                    tapcnt of each tap series
+ *   max_num                    Length of tapcnts
+ *
+ * Returned Value:
+ *   D_SA_STATUS_E_INVALID_ARGS   Parameter error
+ *   num                          number of tap series in tapcnts
+ *
+ * Assumptions/Limitations:
+ *   The time stamp of the command is the time of the first sample in
+ *   msec, and wraps around at 24bit. It is extended here, so the
+ *   interval between blocks must be shorter than the wrap around.
+ *
+ ****************************************************************************/
+int TapClass::write(FAR sensor_command_data_mh_t *command,
+                    FAR int *tapcnts, int max_num)
+{
+  uint32_t rawtime;
+
+  if (NULL == command)
+    {
+      _err("command is NULL\n");
+      return D_SA_STATUS_E_INVALID_ARGS;
+    }
+
+  /* Extend the 24bit time stamp to keep the elapsed time monotonic. */
+
+  rawtime = command->time & TAP_BLOCK_TIME_MASK;
+  if (mBlockStarted)
+    {
+      mBlockTime += (rawtime - mBlockRawTime) & TAP_BLOCK_TIME_MASK;
+    }
+  else
+    {
+      mBlockTime    = rawtime;
+      mBlockStarted = true;
+    }
+
+  mBlockRawTime = rawtime;
+
+  return write(reinterpret_cast<FAR const ThreeAxisSample *>
+                 (command->mh.getVa()),
+               command->size,
+               mBlockTime * MS_PER_US,
+               command->fs,
+               tapcnts,
+               max_num);
+}
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+/****************************************************************************
+ * Name: update
+ *
+ * Description:
+ *   Update the tap state by the result of detection.
+ *
+ * Input Parameters:
+ *   detectflg  - result of detect()
+ *   endTime    - (usec) time stamp of the sample
+ *
+ * Returned Value:
+ *   tapcnt     - number of taps
+ *
+ * Assumptions/Limitations:
+ *   -
+ *
+ ****************************************************************************/
+int TapClass::update(bool detectflg, uint64_t endTime)
+{
+  int      tapcnt      = 0;
+  uint64_t elapsedTime = 0;
+
+  switch(mState){
   case E_TAP_STATE_IDLE:
     if (true == detectflg)
       {
@@ -598,10 +721,7 @@ int TapClass::write(ST_TAP_ACCEL *accelData, uint64_t time_stamp)
 }
 
 /****************************************************************************
- * Private Functions
- ****************************************************************************/
-/****************************************************************************
- * Name: calcR
+ * Name: calcR2
  *
  * Description:
  *   
@@ -611,22 +731,22 @@ int TapClass::write(ST_TAP_ACCEL *accelData, uint64_t time_stamp)
  *   j0   - detection count
  *
  * Returned Value:
- *   Sqrt Result.
+ *   Squared distance. Compared with the squared threshold
+ *   instead of taking sqrt.
  *
  * Assumptions/Limitations:
  *   -
  *
  ****************************************************************************/
-float TapClass::calcR(int i0, int j0)
+float TapClass::calcR2(int i0, int j0)
 {
   int i    = getIndex(i0);
   int j    = getIndex(j0);
   float dx = mX[i] - mX[j];
   float dy = mY[i] - mY[j];
   float dz = mY[i] - mY[j];
-  float r  = sqrt(dx * dx + dy * dy + dz * dz);
 
-  return r;
+  return dx * dx + dy * dy + dz * dz;
 }
 
 /****************************************************************************
@@ -649,6 +769,32 @@ float TapClass::calcR(int i0, int j0)
  *
  ****************************************************************************/
 bool TapClass::detect(float x, float y, float z)
+{
+  return detect2(x, y, z, x * x + y * y + z * z);
+}
+
+/****************************************************************************
+ * Name: detect2
+ *
+ * Description:
+ *   It judges whether it detects tap, by the squared magnitude
+ *   of the sample.
+ *
+ * Input Parameters:
+ *   x   - accel data(x)
+ *   y   - accel data(y)
+ *   z   - accel data(z)
+ *   r2  - x * x + y * y + z * z
+ *
+ * Returned Value:
+ *   true   - detect tap
+ *   false  - not detect tap
+ *
+ * Assumptions/Limitations:
+ *   -
+ *
+ ****************************************************************************/
+bool TapClass::detect2(float x, float y, float z, float r2)
 {
 
   int index = mIndex;
@@ -660,11 +806,11 @@ bool TapClass::detect(float x, float y, float z)
   mX[index] = x;
   mY[index] = y;
   mZ[index] = z;
-  mR[index] = sqrt(x * x + y * y + z * z);
+  mR[index] = r2;
 
   if (mDetectionCount == 0)
     {
-      if (mR[index] > mPeakThres)
+      if (mR[index] > mPeakThres2)
         {
           mDetectionCount = TAP_DETECTION_COUNT;
         }
@@ -672,12 +818,12 @@ bool TapClass::detect(float x, float y, float z)
     }
 
   mDetectionCount--;
-  if (mR[index] > mPeakThres)
+  if (mR[index] > mPeakThres2)
     {
       return false;
     }
 
-  if (calcR(0, TAP_DETECTION_COUNT - mDetectionCount) > mLongThres)
+  if (calcR2(0, TAP_DETECTION_COUNT - mDetectionCount) > mLongThres2)
     {
       mStab = 0;
       return false;
@@ -126,15 +126,12 @@ struct tap_mng_three_axis_s
 struct tap_mng_acc_data_buf
 {
   struct    tap_mng_three_axis_s acc_data[(TAP_MNG_ACC_SAMPLING_FREQ * TAP_MNG_FIFO_NUM)];
+  ThreeAxisSample block[(TAP_MNG_ACC_SAMPLING_FREQ * TAP_MNG_FIFO_NUM)];
+  bool      valid[(TAP_MNG_ACC_SAMPLING_FREQ * TAP_MNG_FIFO_NUM)];
+  int       tapcnts[(TAP_MNG_ACC_SAMPLING_FREQ * TAP_MNG_FIFO_NUM)];
   uint64_t  time_stamp;
 };
 
-struct tap_mng_inlibdata
-{
-  ST_TAP_ACCEL  accel;
-  uint64_t      timestamp;
-};
-
 static sem_t                 g_tap_mng_node_lock;
 static sem_t                 g_tap_mng_acccmd_lock;
 static sem_t                 g_tap_mng_acccmd_complete;
@@ -254,14 +251,17 @@ static void TapMngTapLibRun(void)
 {
   struct tap_mng_node         *p_node      = NULL;
   int                         fd           = -1;
-  int                         tapCnt       = 0;
+  int                         series       = 0;
   int                         icnt         = 0;
+  int                         i            = 0;
   int                         ret          = 0;
   int                         rsize        = 0;
   int                         acc_data_num = 0;
+  int                         valid_num    = 0;
+  int                         run_num      = 0;
+  uint64_t                    block_time   = 0;
   struct tap_mng_acc_data_buf *data        = NULL;
   struct tap_mng_three_axis_s *ta          = NULL;
-  struct tap_mng_inlibdata    indata       = {0};
   sigset_t                    set          = {0};
   struct siginfo              siginfo      = {0};
   struct timespec             ts           = {0};
@@ -354,42 +354,84 @@ static void TapMngTapLibRun(void)
 
           data->time_stamp = (ts.tv_sec * SEC_PER_US) + (ts.tv_nsec / NS_PER_US);
 
+          /* convert samples into a block at the same index, so that the
+           * time of each sample is kept. Samples whose axes have zero
+           * are not valid and split the block into runs.
+           */
+
+          valid_num = 0;
           ta = (struct tap_mng_three_axis_s *)&data->acc_data;
           for (icnt = 0; icnt < acc_data_num; icnt++, ta++)
             {
-              if (ta->x && ta->y && ta->z)
+              data->valid[icnt] = (ta->x && ta->y && ta->z);
+              if (data->valid[icnt])
                 {
-                  memset(&indata, 0, sizeof(struct tap_mng_inlibdata));
-                  indata.accel.accel_x = TAP_MNG_ACCEL_CONVERT(ta->x);
-                  indata.accel.accel_y = TAP_MNG_ACCEL_CONVERT(ta->y);
-                  indata.accel.accel_z = TAP_MNG_ACCEL_CONVERT(ta->z);
+                  data->block[icnt].ax = TAP_MNG_ACCEL_CONVERT(ta->x);
+                  data->block[icnt].ay = TAP_MNG_ACCEL_CONVERT(ta->y);
+                  data->block[icnt].az = TAP_MNG_ACCEL_CONVERT(ta->z);
+                  valid_num++;
+                }
+            }
+
+          if (valid_num == 0)
+            {
+              continue;
+            }
+
+          /* time of the first sample in the FIFO */
 
-                  indata.timestamp = data->time_stamp - (1000000 / TAP_MNG_ACC_SAMPLING_FREQ) * (acc_data_num - icnt + 1);
+          block_time = data->time_stamp -
+                       (1000000 / TAP_MNG_ACC_SAMPLING_FREQ) *
+                       (acc_data_num + 1);
 
-                  TAP_MNG_NODE_LOCK();
+          TAP_MNG_NODE_LOCK();
 
-                  if (NULL == g_head)
+          if (NULL == g_head)
+            {
+              _err("L%d g_head is NULL \n", __LINE__);
+              TAP_MNG_NODE_UNLOCK();
+              continue;
+            }
+
+          p_node = g_head;
+          do
+            {
+              /* Tap Library call, once per run of valid samples */
+
+              for (icnt = 0; icnt < acc_data_num; icnt += run_num)
+                {
+                  run_num = 1;
+                  if (!data->valid[icnt])
                     {
-                      _err("L%d g_head is NULL \n", __LINE__);
-                      TAP_MNG_NODE_UNLOCK();
                       continue;
                     }
 
-                  p_node = g_head;
-                  do
+                  while (icnt + run_num < acc_data_num &&
+                         data->valid[icnt + run_num])
                     {
-                      /* Tap Library call */
-                      tapCnt = TapWrite_timestamp(p_node->tap, &indata.accel, indata.timestamp);
-                      if (tapCnt > 0)
-                        {
-                          p_node->cbs(tapCnt);
-                        }
-                      p_node = p_node->next;
-                    } while (NULL != p_node);
-
-                  TAP_MNG_NODE_UNLOCK();
+                      run_num++;
+                    }
+
+                  series = p_node->tap->write(&data->block[icnt], run_num,
+                                              block_time +
+                                              (1000000 /
+                                               TAP_MNG_ACC_SAMPLING_FREQ) *
+                                              icnt,
+                                              TAP_MNG_ACC_SAMPLING_FREQ,
+                                              data->tapcnts, run_num);
+
+                  /* notify every tap series which ends in the run */
+
+                  for (i = 0; i < series; i++)
+                    {
+                      p_node->cbs(data->tapcnts[i]);
+                    }
                 }
-            }
+
+              p_node = p_node->next;
+            } while (NULL != p_node);
+
+          TAP_MNG_NODE_UNLOCK();
         }
       /* receive signal from tap manager api */
 
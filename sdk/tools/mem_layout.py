@@ -61,6 +61,31 @@ UseSegThreshold     = False
 UseRingBufPool      = False
 UseRingBufThreshold = False
 
+#
+# Parameters of segment cache
+#
+# Set the same values as CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE,
+# CONFIG_MEMUTILS_MEMORY_MANAGER_SEG_CACHE_DEPTH and CONFIG_SMP_NCPUS
+# (1 if CONFIG_SMP is not set).
+# NumSegCaches is 2 (task and interrupt context) per CPU.
+#
+
+UseSegCache         = False
+SegCacheDepth       = 4
+SmpNumCpus          = 1
+
+#
+# Parameters of variable size pool
+#
+# Set the same values as CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_POOL,
+# CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_MIN_ORDER and
+# CONFIG_MEMUTILS_MEMORY_MANAGER_VARSIZE_NUM_CLASSES.
+#
+
+UseVarSizePool      = False
+VarSizeMinOrder     = 6
+VarSizeNumClasses   = 12
+
 #
 # Fixed parameters of pool layout
 #
@@ -84,6 +109,7 @@ EnableOutputMacro = False
 
 Basic   = "BasicType"
 RingBuf = "RingBufType"
+VarSize = "VarSizeType"
 
 MinNameSize   = 3
 FenceSize     = 4
@@ -380,9 +406,12 @@ class PoolEntry(BaseEntry):
         if MemoryDevices.at[name]:
             sys.stderr.write("Redefine name found at {0}".format(name))
             sys.exit()
-        if type != Basic and type != RingBuf:
+        if type != Basic and type != RingBuf and type != VarSize:
             sys.stderr.write("Bad pool type found at {0}".format(name))
             sys.exit()
+        if type == VarSize and not UseVarSizePool:
+            sys.stderr.write("Don't use VarSize type at {0}".format(name))
+            sys.exit()
         if type == RingBuf and not UseRingBufPool:
             sys.stderr.write("Don't use RingBuf type at {0}".format(name))
             sys.exit()
@@ -417,9 +446,9 @@ class PoolEntry(BaseEntry):
 
 
 class PoolEntryFixParam(BaseEntry):
-    def __init__(self, section, layout_no, name, area, align, size, seg, fence):
+    def __init__(self, section, layout_no, name, area, align, size, seg, fence, type = Basic):
         self.area_entry = FixedAreas.at(area)
-        self.type       = Basic
+        self.type       = type
         self.align      = align
         self.num_seg    = seg
         self.skip_size  = 0
@@ -440,6 +469,12 @@ class PoolEntryFixParam(BaseEntry):
         if MemoryDevices.at(name):
             sys.stderr.write("Redefine name found at {0}".format(name))
             sys.exit()
+        if type != Basic and type != VarSize:
+            sys.stderr.write("Bad pool type found at {0}".format(name))
+            sys.exit()
+        if type == VarSize and not UseVarSizePool:
+            sys.stderr.write("Don't use VarSize type at {0}".format(name))
+            sys.exit()
         if (align % MinAlign) != 0 or align == 0:
             sys.stderr.write("Bad pool align found at {0}".format(name))
             sys.exit()
@@ -475,6 +510,10 @@ class PoolEntryFixParam(BaseEntry):
 #  - RingBufPool area                              : To be determined(MemPool Area+alpha)
 #  - Data area of the segment number queue         : Number of segments * sizeof(NumSeg)
 #  - Reference counter area                        : Number of segments * sizeof(SegRefCnt)
+#  - Segment cache area (UseSegCache only)         : Number of caches * (depth + 1) * sizeof(NumSeg)
+#  - VarSizePool area                              : MemPool area + 12 + 4 * number of size classes
+#  - Segment descriptor area (VarSizePool only)    : 0-3 + Number of segments * 8
+#  - Free block bitmap area (VarSizePool only)     : 4 * ((pool size / min segment size + 31) / 32)
 NumSegSize              = 2 if UseOver255Segments else 1
 SegRefCntSize           = 1
 PoolAttrSize            = round_up(10 + NumSegSize + (1 if UseFence else 0) + (1 if UseMultiCore else 0), 4)
@@ -482,6 +521,16 @@ MemPoolDataSize         = 12 + 4 * NumSegSize   # 16 or 20
 BasicPoolDataSize       = MemPoolDataSize
 RingBufPoolDataSize     = MemPoolDataSize + 32  # Tentative value for details unexamined
 RingBufPoolSegDataSize  = 8                     # Tentative value for details unexamined
+NumSegCaches            = 2 * SmpNumCpus
+SegCacheDataSize        = (4 + (NumSegSize - 1) + NumSegCaches * (SegCacheDepth + 1) * NumSegSize) if UseSegCache else 0
+VarSizePoolDataSize     = MemPoolDataSize + 12 + 4 * VarSizeNumClasses
+VarSizeSegDescSize      = 8
+
+
+def var_size_pool_work_size(pool):
+    work_size  = 3 + pool.num_seg * VarSizeSegDescSize
+    work_size += 4 * (((pool.size >> VarSizeMinOrder) + 31) // 32)
+    return work_size
 
 
 class PoolLayout:
@@ -518,9 +567,15 @@ class PoolLayout:
         for pool in self.pools:
             if section == pool.section:
                 pool_work_size  = PoolAttrSize if UseCopiedPoolAttr else 0
-                pool_work_size += BasicPoolDataSize if pool.type == Basic else RingBufPoolDataSize
+                if pool.type == Basic:
+                    pool_work_size += BasicPoolDataSize
+                elif pool.type == VarSize:
+                    pool_work_size += VarSizePoolDataSize + var_size_pool_work_size(pool)
+                else:
+                    pool_work_size += RingBufPoolDataSize
                 pool_work_size += pool.num_seg * NumSegSize    # Data area of the segment number queue
                 pool_work_size += pool.num_seg * SegRefCntSize # Reference counter area
+                pool_work_size += SegCacheDataSize             # Segment cache area
                 # Round up to the MinAlign unit and integrate
                 layout_work_size += round_up(pool_work_size, MinAlign)
                 if layout_work_size > FixedAreas.memmgr_work_size():
@@ -634,7 +689,7 @@ class PoolAreas:
             io.write("#define NUM_DYN_POOLS  {0}\n".format(NumDynamicPools))
             io.write("#define DYN_POOL_WORK_SIZE(attr) \\\n")
             io.write(" ROUND_UP(sizeof(MemMgrLite::PoolAttr) + #{} +".format(BasicPoolDataSize))
-            io.write(" {0} * (attr).num_segs + {1} * (attr).num_segs, 4)\n".format(NumSegSize, SegRefCntSize))
+            io.write(" {0} * (attr).num_segs + {1} * (attr).num_segs + {2}, 4)\n".format(NumSegSize, SegRefCntSize, SegCacheDataSize))
 
         io.write("\n/*\n * Pool areas\n */\n")
         for layout in self.layouts:
@@ -53,6 +53,7 @@ USE_MULTI_CORE = False
 
 MsgFillValueAfterPop   = 0x00
 MsgParamTypeMatchCheck = False
+MsgStats               = False     # Same as CONFIG_MEMUTILS_MESSAGE_STATS
 MsgQuePool             = []
 SpinLockPool           = []
 
@@ -160,6 +161,8 @@ def getMsgQueParam(line, dup_chk):
         raise ValueError("Bad n_size at {0}".format(id))
     if MsgParamTypeMatchCheck == True and n_size > MIN_PACKET_SIZE:
         n_size += 4
+    if MsgStats == True:
+        n_size += 4     # Time stamp in the packet header
 
     n_num   = line[2]
     if n_num == 0 or n_num > MAX_PACKET_NUM:
@@ -171,6 +174,8 @@ def getMsgQueParam(line, dup_chk):
 
     if MsgParamTypeMatchCheck == True and h_size > MIN_PACKET_SIZE:
         h_size += 4
+    if MsgStats == True and h_size != 0:
+        h_size += 4     # Time stamp in the packet header
 
     h_num = line[4]
     if h_num > MAX_PACKET_NUM or (h_size > 0 and h_num == 0) or (h_size == 0 and h_num > 0):
@@ -398,6 +403,9 @@ try:
     if not MsgParamTypeMatchCheck in [True, False]:
         raise ValueError("Bad MsgParamTypeMatchCheck.")
 
+    if not MsgStats in [True, False]:
+        raise ValueError("Bad MsgStats.")
+
 except Exception as e:
     die(e)
 except ValueError as e: